@@ -6,11 +6,26 @@
 #include "core/event/InputEvents.h"
 #include "core/event/ApplicationStateEvents.h"
 
+#include "core/rendering/TextureCache.h"
+
 #include "core/utility/CommonUtility.h"
 #include "core/utility/DebugUtility.h"
 #include "core/utility/Timer.h"
 #include "core/utility/Assert.h"
 #include "core/utility/Performance.h"
+#include "core/utility/AllocationTracker.h"
+#include "core/utility/FrameArena.h"
+
+//std
+#include <atomic>
+#include <csignal>
+#include <thread>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#endif
 
 //ImGUI
 #include "imgui/imgui.h"
@@ -19,8 +34,49 @@
 
 namespace CoreEngine
 {
+namespace
+{
+    // Set by Ctrl+C / Ctrl+Break, the headless loop turns it into Stop() on the main thread so the layers shut down normally
+    std::atomic<bool> g_interrupt_requested {false};
+
+#ifdef _WIN32
+    BOOL WINAPI ConsoleCtrlHandler(DWORD ctrl_type)
+    {
+        if (ctrl_type != CTRL_C_EVENT && ctrl_type != CTRL_BREAK_EVENT)
+            return FALSE;
+        g_interrupt_requested.store(true, std::memory_order::relaxed);
+        return TRUE;
+    }
+#else
+    void InterruptSignalHandler(int)
+    {
+        g_interrupt_requested.store(true, std::memory_order::relaxed);
+    }
+#endif
+
+    void InstallInterruptHandler() noexcept
+    {
+        g_interrupt_requested.store(false, std::memory_order::relaxed);
+    #ifdef _WIN32
+        SetConsoleCtrlHandler(ConsoleCtrlHandler, TRUE);
+    #else
+        std::signal(SIGINT, InterruptSignalHandler);
+        std::signal(SIGTERM, InterruptSignalHandler);
+    #endif
+    }
+
+    void RemoveInterruptHandler() noexcept
+    {
+    #ifdef _WIN32
+        SetConsoleCtrlHandler(ConsoleCtrlHandler, FALSE);
+    #else
+        std::signal(SIGINT, SIG_DFL);
+        std::signal(SIGTERM, SIG_DFL);
+    #endif
+    }
+}
     //Constructor
-    Application::Application(ApplicationConfig config) noexcept : m_original_config(config), m_vsync_is_on(config.m_enable_vsync)
+    Application::Application(ApplicationConfig config) noexcept : m_original_config(config), m_vsync_is_on(config.m_enable_vsync), m_idle_frame_pacing_is_on(config.m_enable_idle_frame_pacing)
     {
         s_application_instance_ptr = this;
     }
@@ -28,34 +84,64 @@ namespace CoreEngine
     Application::~Application()
     {
         m_window_layer_stacks.clear();
+        m_headless_layer_stack.clear();
         s_application_instance_ptr = nullptr;
-        glfwTerminate();
+        if (! m_original_config.m_headless)
+        {
+            glfwTerminate();
+        }
     }
 
     void Application::Run() noexcept
     {
         m_stop_flag = false;
 
+        if (m_original_config.m_headless)
+        {
+            RunHeadless();
+            return;
+        }
+
+        ScopeProfiler::SetThreadName("Main");
         Timer frame_timer {};
 
         while (! m_stop_flag)
         {
-            ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("Main Loop()  ");
+            // Aggregates everything recorded during the previous iteration, including its "Main Loop()" scope
+            ScopeProfiler::EndFrame();
+            AllocationTracker::EndFrame();
+            ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("Main Loop()");
 
             constexpr Units::MicroSecond min_dt (1L);
             constexpr Units::MicroSecond max_dt (100'000L);
             m_frame_delta_time = std::clamp<Units::MicroSecond>(frame_timer.GetElapsedAndRestart<Units::MicroSecond>(), min_dt, max_dt);
 
+            uint32_t frames_rendered = 0;
+
             for (std::unique_ptr<WindowLayerStack>& wls : m_window_layer_stacks)
             {
+                //////////////////////////////////////////////// 
+                //--------- Pacing
+                //////////////////////////////////////////////// 
+                Units::MicroSecond update_delta_time = m_frame_delta_time;
+                if (m_idle_frame_pacing_is_on)
+                {
+                    if (GetTimeUntilWindowIsDue(*wls) > Units::MicroSecond(0))
+                    {
+                        continue;
+                    }
+                    update_delta_time = std::clamp<Units::MicroSecond>(wls->m_update_timer.GetElapsedAndRestart<Units::MicroSecond>(), min_dt, max_dt);
+                    wls->m_input_redraw_frames_left = std::max(wls->m_input_redraw_frames_left - 1, 0);
+                }
+
                 //////////////////////////////////////////////// 
                 //--------- Updating
                 //////////////////////////////////////////////// 
                 {
-                    ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME( wls->m_window_ptr->GetTitle() + std::string(" : OnUpdate()     ") );
+                    ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME_TAGGED("OnUpdate()", wls->m_window_ptr->GetHandle());
                     for (std::unique_ptr<Basic_Layer>& layer : wls->m_layer_stack)
                     {
-                        layer->OnUpdate(m_frame_delta_time);
+                        layer->OnUpdate(update_delta_time);
                     }
                 }
 
@@ -68,8 +154,9 @@ namespace CoreEngine
                 //--------- Rendering
                 //////////////////////////////////////////////// 
                 wls->m_window_ptr->BeginFrame();
+                TextureCache::Get().ProcessCompletedUploads(); // Textures decoded for this window's context
                 {
-                    ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME( wls->m_window_ptr->GetTitle() + std::string(" : OnRender()     ") );
+                    ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME_TAGGED("OnRender()", wls->m_window_ptr->GetHandle());
                     for (std::unique_ptr<Basic_Layer>& layer : wls->m_layer_stack)
                     {
                         layer->OnRender();
@@ -80,7 +167,7 @@ namespace CoreEngine
                 //--------- Gui Rendering
                 //////////////////////////////////////////////// 
                 {
-                    ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME( wls->m_window_ptr->GetTitle() + std::string(" : OnImGuiRender()") );
+                    ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME_TAGGED("OnImGuiRender()", wls->m_window_ptr->GetHandle());
                     wls->m_window_ptr->BeginImGuiFrame();
                     for (std::unique_ptr<Basic_Layer>& layer : wls->m_layer_stack)
                     {
@@ -90,32 +177,40 @@ namespace CoreEngine
                 }
 
                 {
-                    ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME(wls->m_window_ptr->GetTitle() + std::string(" : FinishFrame()  "));
+                    ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME_TAGGED("FinishFrame()", wls->m_window_ptr->GetHandle());
                     wls->m_window_ptr->FinishFrame();
                 }
+                frames_rendered++;
             }
 
             //////////////////////////////////////////////// 
             //--------- Events
             //////////////////////////////////////////////// 
             {
+                Timer wait_timer {};
                 if (m_original_config.m_use_glfw_await_events)
                 {
                     ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("AwaitEvents()");
                     glfwWaitEvents();
                 }
+                else if (m_idle_frame_pacing_is_on)
+                {
+                    ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("PaceEvents()");
+                    WaitEventsUntilNextDueWindow();
+                }
                 else 
                 {
-                    ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("PollEvents() ");
+                    ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("PollEvents()");
                     glfwPollEvents();
                 }
+                UpdateFramePacingStatistics(wait_timer.GetElapsed<Units::MicroSecond>(), frames_rendered);
             }
 
             //////////////////////////////////////////////// 
             //--------- Deleting windows
             //////////////////////////////////////////////// 
             {
-                ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("Add Layers() ");
+                ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("Add Layers()");
                 for (auto rit = m_window_layer_stacks_to_delete_next_frame.rbegin(); rit != m_window_layer_stacks_to_delete_next_frame.rend(); ++rit)
                 {
                     const auto handle  = *rit;
@@ -138,6 +233,7 @@ namespace CoreEngine
                     m_window_layer_stacks.emplace_back(std::make_unique<WindowLayerStack>(std::make_unique<Window>(request.first)));
                     Window::Handle new_handle = m_window_layer_stacks.back()->m_window_ptr->GetHandle();
                     WindowLayerStack* new_wls = m_window_layer_stacks.back().get();
+                    ScopeProfiler::SetTagName(new_handle, request.first.m_title);
 
                     glfwMakeContextCurrent(new_wls->m_window_ptr->GetGLFWwindow());
                     glfwSwapInterval(m_vsync_is_on);
@@ -150,6 +246,11 @@ namespace CoreEngine
                 }
                 m_window_creations_to_add_next_frame.clear();
             }
+
+            //////////////////////////////////////////////// 
+            //--------- Frame temporaries
+            //////////////////////////////////////////////// 
+            FrameArena::GetThreadLocal().Reset();
         }
     }
 
@@ -161,6 +262,7 @@ namespace CoreEngine
         {
             RaiseEvent(window_layerstack->m_window_ptr->GetHandle(), ApplicationShutdownEvent {});
         }
+        RaiseEvent(m_headless_handle, ApplicationShutdownEvent {});
     }
 
     void Application::QueueDeleteWindowLayerStack(Window::Handle group_handle) noexcept
@@ -181,6 +283,8 @@ namespace CoreEngine
     void Application::SetVsync(bool on) noexcept
     {
         m_vsync_is_on = on;
+        if (m_original_config.m_headless) return;
+
         GLFWwindow* context = glfwGetCurrentContext();
         for (std::unique_ptr<WindowLayerStack>& wls : m_window_layer_stacks)
         {
@@ -199,6 +303,26 @@ namespace CoreEngine
     {
         return m_frame_delta_time;
     }
+
+    bool Application::GetIsHeadless() const noexcept
+    {
+        return m_original_config.m_headless;
+    }
+
+    void Application::SetIdleFramePacing(bool on) noexcept
+    {
+        m_idle_frame_pacing_is_on = on;
+    }
+
+    bool Application::GetIdleFramePacingIsOn() const noexcept
+    {
+        return m_idle_frame_pacing_is_on;
+    }
+
+    Application::FramePacingStatistics Application::GetFramePacingStatistics() const noexcept
+    {
+        return m_frame_pacing_statistics;
+    }
     
     /////////////////////////////////////////////// 
     // Application creation
@@ -209,6 +333,17 @@ namespace CoreEngine
         {
             ENGINE_ASSERT(false && "At Application::Create() called multiple times. Only one Application instance is allowed.");
         }
+
+        if (config.m_headless)
+        {
+            if (config.m_debug_launch_with_console)
+            {
+                CoreEngine::DebugUtility::ForceInitConsole();
+                CoreEngine::DebugUtility::EnableDebugMessages();
+            }
+            return Application {config};
+        }
+
         if (! glfwInit())
         {
             throw std::runtime_error("At Application::Create(): failed to initialize GLFW.");
@@ -281,6 +416,7 @@ namespace CoreEngine
         glfwMakeContextCurrent(window);
         glViewport(0, 0, width, height);
         const Window::Handle handle = s_application_instance_ptr->FindWindowHandleFromGlfwWindow(window);
+        s_application_instance_ptr->m_window_layer_stacks[s_application_instance_ptr->FindWindowLayerStackIndexFromWindowHandle(handle)]->m_input_redraw_frames_left = INPUT_REDRAW_FRAMES;
         s_application_instance_ptr->RaiseEvent(handle, FramebufferResizeEvent {width, height});
     }
 
@@ -321,4 +457,140 @@ namespace CoreEngine
 
         ENGINE_ASSERT(false && "Failed to find window layer stack index from Handle: GLFWwindow not part of window layer stack.");
     }
+
+    Units::MicroSecond Application::GetTimeUntilWindowIsDue(const WindowLayerStack& wls) const noexcept
+    {
+        Units::MicroSecond until_redraw = MAX_IDLE_WAIT;
+        if (wls.m_input_redraw_frames_left > 0)
+        {
+            until_redraw = Units::MicroSecond(0);
+        }
+        else
+        {
+            for (const std::unique_ptr<Basic_Layer>& layer : wls.m_layer_stack)
+            {
+                until_redraw = std::min(until_redraw, layer->GetTimeUntilNextRedraw());
+            }
+        }
+
+        // The cap only ever delays, it never causes a redraw on its own
+        const float max_fps = wls.m_window_ptr->GetMaxFramesPerSecond();
+        if (max_fps > 0.0f)
+        {
+            const Units::MicroSecond frame_interval (static_cast<int64_t>(1'000'000.0f / max_fps));
+            until_redraw = std::max(until_redraw, frame_interval - wls.m_update_timer.GetElapsed<Units::MicroSecond>());
+        }
+
+        return std::max(until_redraw, Units::MicroSecond(0));
+    }
+
+    void Application::WaitEventsUntilNextDueWindow() noexcept
+    {
+        Units::MicroSecond wait_time = MAX_IDLE_WAIT;
+        if (! m_window_creations_to_add_next_frame.empty() || ! m_window_layer_stacks_to_delete_next_frame.empty())
+        {
+            wait_time = Units::MicroSecond(0);
+        }
+        for (const std::unique_ptr<WindowLayerStack>& wls : m_window_layer_stacks)
+        {
+            wait_time = std::min(wait_time, GetTimeUntilWindowIsDue(*wls));
+        }
+        if (ScopeProfiler::GetIsTracing())
+        {
+            wait_time = std::min(wait_time, TRACE_DRAIN_INTERVAL);
+        }
+
+        if (wait_time > Units::MicroSecond(0))
+        {
+            glfwWaitEventsTimeout(Units::Convert<Units::Second>(wait_time).Get());
+        }
+        else
+        {
+            glfwPollEvents();
+        }
+
+        // Input for the tool windows mostly goes through the ImGui callbacks, so its queue tells which window got any
+        for (std::unique_ptr<WindowLayerStack>& wls : m_window_layer_stacks)
+        {
+            if (wls->m_window_ptr->HasPendingImGuiInput())
+            {
+                wls->m_input_redraw_frames_left = INPUT_REDRAW_FRAMES;
+            }
+        }
+    }
+
+    void Application::UpdateFramePacingStatistics(Units::MicroSecond time_waited, uint32_t frames_rendered) noexcept
+    {
+        m_pacing_time_waited += time_waited;
+        m_pacing_loop_count++;
+        m_pacing_frame_count += frames_rendered;
+
+        const Units::MicroSecond elapsed = m_pacing_statistics_timer.GetElapsed<Units::MicroSecond>();
+        constexpr Units::MicroSecond STATISTICS_WINDOW (500'000L);
+        if (elapsed < STATISTICS_WINDOW)
+        {
+            return;
+        }
+
+        const float elapsed_seconds = static_cast<float>(Units::Convert<Units::Second>(elapsed).Get());
+        m_frame_pacing_statistics.m_idle_cpu_percentage        = 100.0f * static_cast<float>(m_pacing_time_waited.Get()) / static_cast<float>(elapsed.Get());
+        m_frame_pacing_statistics.m_loop_iterations_per_second = static_cast<float>(m_pacing_loop_count)  / elapsed_seconds;
+        m_frame_pacing_statistics.m_frames_per_second          = static_cast<float>(m_pacing_frame_count) / elapsed_seconds;
+
+        m_pacing_time_waited = Units::MicroSecond(0);
+        m_pacing_loop_count  = 0;
+        m_pacing_frame_count = 0;
+        m_pacing_statistics_timer.Restart();
+    }
+    void Application::RunHeadless() noexcept
+    {
+        ScopeProfiler::SetThreadName("Main");
+        Timer frame_timer {};
+        InstallInterruptHandler();
+
+        while (! m_stop_flag)
+        {
+            // Removed right away, a second Ctrl+C while shutting down terminates as usual
+            if (g_interrupt_requested.exchange(false, std::memory_order::relaxed))
+            {
+                std::cout << "Interrupted, stopping" << std::endl;
+                RemoveInterruptHandler();
+                Stop();
+                break;
+            }
+
+            ScopeProfiler::EndFrame();
+            AllocationTracker::EndFrame();
+            ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("Headless Loop()");
+
+            constexpr Units::MicroSecond min_dt (1L);
+            constexpr Units::MicroSecond max_dt (100'000L);
+            m_frame_delta_time = std::clamp<Units::MicroSecond>(frame_timer.GetElapsedAndRestart<Units::MicroSecond>(), min_dt, max_dt);
+
+            {
+                ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("OnUpdate()");
+                for (std::unique_ptr<Basic_Layer>& layer : m_headless_layer_stack)
+                {
+                    layer->OnUpdate(m_frame_delta_time);
+                }
+            }
+
+            if (! m_window_creations_to_add_next_frame.empty())
+            {
+                ENGINE_DEBUG_PRINT("Ignored " << m_window_creations_to_add_next_frame.size() << " window creation(s): the application runs headless.");
+                m_window_creations_to_add_next_frame.clear();
+            }
+
+            // No events to wait for, the layers simply get updated at a fixed rate
+            const Units::MicroSecond time_to_wait = m_original_config.m_headless_update_interval - frame_timer.GetElapsed<Units::MicroSecond>();
+            if (time_to_wait > Units::MicroSecond(0))
+            {
+                ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("Sleep()");
+                std::this_thread::sleep_for(std::chrono::microseconds(time_to_wait.Get()));
+            }
+            UpdateFramePacingStatistics(std::max(time_to_wait, Units::MicroSecond(0)), 0);
+            FrameArena::GetThreadLocal().Reset();
+        }
+        RemoveInterruptHandler();
+    }
 }
\ No newline at end of file
@@ -14,6 +14,7 @@
 #include "core/application/Window.h"
 
 #include "core/utility/Units.h"
+#include "core/utility/Timer.h"
 
 #include "imgui/imgui.h"
 
@@ -32,6 +33,16 @@ namespace CoreEngine
             bool                    m_enable_vsync                     {false};
             bool                    m_debug_launch_with_console        {true};
             bool                    m_use_glfw_await_events            {false};
+            bool                    m_enable_idle_frame_pacing         {false}; // Windows are only updated & redrawn when a layer or input asks for it
+            bool                    m_headless                         {false}; // No GLFW, GL or windows; only the headless layers get updated
+            Units::MicroSecond      m_headless_update_interval         {16'667L};
+        };
+
+        struct FramePacingStatistics
+        {
+            float m_idle_cpu_percentage       = 0.0f; // Share of the main loop spent waiting for events
+            float m_loop_iterations_per_second = 0.0f;
+            float m_frames_per_second          = 0.0f; // Summed over all windows
         };
 
         /////////////////////////////////////////////// 
@@ -59,6 +70,12 @@ namespace CoreEngine
 
         [[nodiscard]] Units::MicroSecond GetLastFrameTime() const noexcept;
 
+        [[nodiscard]] bool GetIsHeadless() const noexcept;
+
+        void SetIdleFramePacing(bool on) noexcept;
+        [[nodiscard]] bool GetIdleFramePacingIsOn() const noexcept;
+        [[nodiscard]] FramePacingStatistics GetFramePacingStatistics() const noexcept;
+
         template <typename TLayer, typename... Args>
         requires std::is_constructible_v<TLayer, Args...>
         void AddLayerToExistingWindow(Window::Handle group_handle, Args&&... args)
@@ -67,6 +84,14 @@ namespace CoreEngine
             m_window_layer_stacks[index]->m_layer_stack.emplace_back(std::make_unique<TLayer>(std::forward<Args>(args)...));
         }
 
+        // Headless layers share one handle without a window and only get OnUpdate() & OnEvent(), never OnRender() or OnImGuiRender()
+        template <typename TLayer, typename... Args>
+        requires std::is_constructible_v<TLayer, Window::Handle, Args...>
+        inline void PushHeadlessLayer(Args&&... args)
+        {
+            m_headless_layer_stack.emplace_back(std::make_unique<TLayer>(m_headless_handle, std::forward<Args>(args)...));
+        }
+
         using LayerFactory = std::function<std::unique_ptr<Basic_Layer>(Window::Handle)>;
         
         template <typename TLayer, typename... Args>
@@ -87,9 +112,11 @@ namespace CoreEngine
         requires std::is_base_of_v<Basic_Event, TEvent>
         inline void RaiseEvent(Window::Handle handle, TEvent&& event) noexcept
         {
-            const size_t index = FindWindowLayerStackIndexFromWindowHandle(handle);
+            std::vector<std::unique_ptr<Basic_Layer>>& layer_stack = handle == m_headless_handle 
+                ? m_headless_layer_stack 
+                : m_window_layer_stacks[FindWindowLayerStackIndexFromWindowHandle(handle)]->m_layer_stack;
 
-            for (auto it = m_window_layer_stacks[index]->m_layer_stack.rbegin(); it != m_window_layer_stacks[index]->m_layer_stack.rend(); ++it)
+            for (auto it = layer_stack.rbegin(); it != layer_stack.rend(); ++it)
             {
                 if (event.GetIsHandled())
                 {
@@ -115,14 +142,31 @@ namespace CoreEngine
         //////////////////////////////////////////////// 
         //--------- Member variables
         //////////////////////////////////////////////// 
+        // ImGui needs a few frames after input until hover states, popups etc. have settled
+        static constexpr int INPUT_REDRAW_FRAMES = 3;
+        static constexpr Units::MicroSecond MAX_IDLE_WAIT {100'000L};
+        // Service threads keep recording while the windows idle; a trace must not overflow their buffers
+        static constexpr Units::MicroSecond TRACE_DRAIN_INTERVAL {10'000L};
+
         struct WindowLayerStack
         {
             std::unique_ptr<Window>                   m_window_ptr;
             std::vector<std::unique_ptr<Basic_Layer>> m_layer_stack;
+            Timer                                     m_update_timer {};
+            int                                       m_input_redraw_frames_left = INPUT_REDRAW_FRAMES;
         };
 
+        [[nodiscard]] Units::MicroSecond GetTimeUntilWindowIsDue(const WindowLayerStack& wls) const noexcept;
+        void WaitEventsUntilNextDueWindow() noexcept;
+        void UpdateFramePacingStatistics(Units::MicroSecond time_waited, uint32_t frames_rendered) noexcept;
+
+        void RunHeadless() noexcept;
+
         std::vector<std::unique_ptr<WindowLayerStack>> m_window_layer_stacks;
 
+        Window::Handle                            m_headless_handle {};
+        std::vector<std::unique_ptr<Basic_Layer>> m_headless_layer_stack;
+
         std::vector<Window::Handle> m_window_layer_stacks_to_delete_next_frame;
         std::vector<std::pair<Window::WindowCreationConfig, std::vector<LayerFactory>>> m_window_creations_to_add_next_frame;
 
@@ -130,6 +174,13 @@ namespace CoreEngine
         Units::MicroSecond        m_frame_delta_time {0};
         ApplicationConfig         m_original_config  {};
         bool                      m_vsync_is_on      {false};
+        bool                      m_idle_frame_pacing_is_on {false};
+
+        Timer                     m_pacing_statistics_timer {};
+        Units::MicroSecond        m_pacing_time_waited      {0};
+        uint32_t                  m_pacing_loop_count       {0};
+        uint32_t                  m_pacing_frame_count      {0};
+        FramePacingStatistics     m_frame_pacing_statistics {};
         
         //////////////////////////////////////////////// 
         //--------- Instance
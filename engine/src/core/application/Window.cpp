@@ -2,6 +2,7 @@
 
 #include "core/utility/Assert.h"
 #include "core/application/Application.h"
+#include "core/rendering/GpuProfiler.h"
 
 #include "default_fonts/JetBrainsMono.h"
 
@@ -24,7 +25,7 @@
 
 namespace CoreEngine
 {
-    Window::Window(WindowCreationConfig config) noexcept
+    Window::Window(WindowCreationConfig config) noexcept : m_max_frames_per_second(std::max(config.m_max_frames_per_second, 0.0f))
     {
     ///////////////////////////////
     // GLFW
@@ -142,7 +143,7 @@ namespace CoreEngine
     ///////////////////////////////
     // Move
     ///////////////////////////////
-    Window::Window(Window&& other) noexcept : m_handle(other.m_handle), m_window_ptr(other.m_window_ptr), m_imgui_context(other.m_imgui_context)
+    Window::Window(Window&& other) noexcept : m_handle(other.m_handle), m_window_ptr(other.m_window_ptr), m_imgui_context(other.m_imgui_context), m_max_frames_per_second(other.m_max_frames_per_second)
     {
         other.m_window_ptr    = nullptr;
         other.m_imgui_context = nullptr;
@@ -157,6 +158,7 @@ namespace CoreEngine
             m_window_ptr          = other.m_window_ptr;
             m_imgui_context       = other.m_imgui_context;
             m_handle              = other.m_handle;
+            m_max_frames_per_second = other.m_max_frames_per_second;
 
             other.m_window_ptr    = nullptr;
             other.m_imgui_context = nullptr;
@@ -181,6 +183,7 @@ namespace CoreEngine
     void Window::BeginFrame() noexcept
     {
         glfwMakeContextCurrent(m_window_ptr);
+        GpuProfiler::BeginFrame(m_handle);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
     }
 
@@ -204,7 +207,10 @@ namespace CoreEngine
         glfwMakeContextCurrent(m_window_ptr);
         ImGui::SetCurrentContext(m_imgui_context);
         ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            ENGINE_PERFORMANCE_MEASURE_GPU_SCOPE_TIME("ImGui RenderDrawData()");
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
 
         if (ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
         {
@@ -258,12 +264,29 @@ namespace CoreEngine
         return true;
     }
 
+    void Window::SetMaxFramesPerSecond(float max_fps) noexcept
+    {
+        m_max_frames_per_second = std::max(max_fps, 0.0f);
+    }
+
+    float Window::GetMaxFramesPerSecond() const noexcept
+    {
+        return m_max_frames_per_second;
+    }
+
+    bool Window::HasPendingImGuiInput() const noexcept
+    {
+        return m_imgui_context && m_imgui_context->InputEventsQueue.Size > 0;
+    }
+
     ///////////////////////////////
     // Private
     ///////////////////////////////
     void Window::DestroyContexts() noexcept
     {
         glfwMakeContextCurrent(m_window_ptr);
+        if (m_window_ptr)
+            GpuProfiler::OnContextDestroyed(m_handle);
 
         ImGui::SetCurrentContext(m_imgui_context);
 
@@ -35,6 +35,7 @@ namespace CoreEngine
             std::uint8_t            m_MSAA_sample_count {0};
             bool                    m_is_windowed_fullscren = false;
             bool                    m_has_transparent_framebuffer = false;
+            float                   m_max_frames_per_second = 0.0f; // Only with idle frame pacing, 0 = uncapped
         };
 
         struct Handle 
@@ -47,6 +48,7 @@ namespace CoreEngine
             void Invalidate() noexcept { m_value = INVALID; }
         private:
             friend class Window;
+            friend class Application; // Handle of the headless layers
             explicit Handle() noexcept : m_value(s_handle_counter++) {}
             static inline uint32_t s_handle_counter {1};
             uint32_t m_value = INVALID;
@@ -78,6 +80,13 @@ namespace CoreEngine
 
         [[nodiscard]] bool IsVisible() const noexcept;
 
+        // Cap for the idle frame pacing of the Application, independent of vsync; 0 = uncapped
+        void SetMaxFramesPerSecond(float max_fps) noexcept;
+        [[nodiscard]] float GetMaxFramesPerSecond() const noexcept;
+
+        // Input that arrived since the last ImGui frame
+        [[nodiscard]] bool HasPendingImGuiInput() const noexcept;
+
     ///////////////////////////////
     // Copying forbidden
     ///////////////////////////////
@@ -93,5 +102,6 @@ namespace CoreEngine
         Handle          m_handle {};
         GLFWwindow*     m_window_ptr      = nullptr;
         ImGuiContext*   m_imgui_context   = nullptr;
+        float           m_max_frames_per_second = 0.0f;
     };
 }
\ No newline at end of file
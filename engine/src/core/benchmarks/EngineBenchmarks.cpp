@@ -0,0 +1,374 @@
+#include "core/benchmarks/EngineBenchmarks.h"
+
+#include "core/utility/Benchmark.h"
+#include "core/utility/FrustumCulling.h"
+#include "core/utility/MathUtility.h"
+
+#include "core/model/BoxModel.h"
+#include "core/rendering/IndirectDraw3D_RenderPipeline.h"
+#include "core/scene/Camera.h"
+#include "core/scene/Scene3D.h"
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace CoreEngine
+{
+namespace
+{
+    constexpr uint32_t DATASET_SEED  = 0xA5F417u;
+    constexpr size_t   DATASET_SIZE  = 4096; // Power of two, indexed with & (DATASET_SIZE - 1)
+    constexpr float    WORLD_EXTENTS = 500.0f;
+
+    ////////////////////////////////////////////////
+    //--------- Synthetic datasets
+    ////////////////////////////////////////////////
+    class DatasetGenerator
+    {
+    public:
+        explicit DatasetGenerator(uint32_t seed) noexcept : m_rng(seed) {}
+
+        [[nodiscard]] float Float(float min, float max) noexcept { return std::uniform_real_distribution<float>(min, max)(m_rng); }
+        [[nodiscard]] glm::vec3 Position() noexcept { return glm::vec3(Float(-WORLD_EXTENTS, WORLD_EXTENTS), Float(-WORLD_EXTENTS, WORLD_EXTENTS), Float(-WORLD_EXTENTS, WORLD_EXTENTS)); }
+        [[nodiscard]] glm::vec3 HalfExtents() noexcept { return glm::vec3(Float(0.5f, 10.0f), Float(0.5f, 10.0f), Float(0.5f, 10.0f)); }
+        [[nodiscard]] glm::vec3 Direction() noexcept { return glm::normalize(glm::vec3(Float(-1.0f, 1.0f), Float(-1.0f, 1.0f), Float(-1.0f, 1.0f)) + glm::vec3(0.0f, 0.0f, 1e-3f)); }
+        [[nodiscard]] glm::quat Rotation() noexcept { return glm::normalize(glm::quat(Float(-1.0f, 1.0f), Float(-1.0f, 1.0f), Float(-1.0f, 1.0f), Float(-1.0f, 1.0f) + 1e-3f)); }
+
+        [[nodiscard]] MathUtility::Ray3D Ray() noexcept
+        {
+            return MathUtility::Ray3D { .m_origin = Position(), .m_direction_normalized = Direction(), .m_max_ray_length = 2.0f * WORLD_EXTENTS };
+        }
+
+        [[nodiscard]] glm::mat4 ModelMatrix() noexcept
+        {
+            return glm::translate(glm::mat4(1.0f), Position()) * glm::mat4_cast(Rotation()) * glm::scale(glm::mat4(1.0f), glm::vec3(Float(0.5f, 2.0f)));
+        }
+
+    private:
+        std::mt19937 m_rng;
+    };
+
+    [[nodiscard]] glm::mat4 CreateViewProjection() noexcept
+    {
+        const CameraReverseZ camera (glm::vec3(0.0f, 20.0f, -WORLD_EXTENTS), 16.0f / 9.0f, 70.0f, 0.1f);
+        return camera.CalculateCameraMatrix(glm::vec3(0.0f));
+    }
+
+    [[nodiscard]] std::vector<MathUtility::Ray3D> CreateRays() noexcept
+    {
+        DatasetGenerator generator (DATASET_SEED);
+        std::vector<MathUtility::Ray3D> rays (DATASET_SIZE);
+        for (MathUtility::Ray3D& ray : rays) ray = generator.Ray();
+        return rays;
+    }
+
+    // Boxes only: no files involved and the same mesh size everywhere
+    [[nodiscard]] std::vector<std::unique_ptr<Basic_Model>> CreateBoxModels(size_t amount) noexcept
+    {
+        DatasetGenerator generator (DATASET_SEED + 1);
+        std::vector<std::unique_ptr<Basic_Model>> models;
+        models.reserve(amount);
+        for (size_t i = 0; i < amount; i++)
+        {
+            models.push_back(std::make_unique<BoxModel>(generator.HalfExtents(), generator.Position(), generator.Rotation(), glm::vec3(1.0f)));
+        }
+        return models;
+    }
+
+    void FillSceneWithBoxes(Scene3D& scene, size_t amount) noexcept
+    {
+        DatasetGenerator generator (DATASET_SEED + 2);
+        for (size_t i = 0; i < amount; i++)
+        {
+            Scene3D_ObjectBuilder builder = scene.CreateObjectBuilder();
+            builder.SetPosition(generator.Position());
+            builder.SetRotation(generator.Rotation());
+            builder.SetName("Box " + std::to_string(i));
+            builder.RenderAndCollision_SetBox(generator.HalfExtents(), glm::vec3(1.0f));
+            scene.AddObjectFromBuilder(std::move(builder));
+        }
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Baselines
+    ////////////////////////////////////////////////
+    // The scalar per-mesh cull IndirectDraw3D_RenderPipeline used before CullingMode::CPU, without any GL calls: one
+    // transform per mesh & draw commands for the meshes inside the frustum. Returns the amount of culled meshes.
+    [[nodiscard]] size_t BuildTransformsAndDrawCommands(std::span<Basic_Model* const> model_vec, const glm::mat4& view_projection,
+        std::vector<glm::mat4>& out_mesh_transforms, std::pmr::vector<DrawElementsIndirectCommand>& out_draw_commands) noexcept
+    {
+        size_t amount_meshes {0};
+        for (const Basic_Model* model_ptr : model_vec)
+        {
+            amount_meshes += model_ptr->GetMeshVectorConstReference().size();
+        }
+
+        out_mesh_transforms.clear();
+        out_mesh_transforms.reserve(amount_meshes);
+
+        out_draw_commands.clear();
+        out_draw_commands.reserve(amount_meshes);
+        //Offsets for draw command
+        GLuint offset_indices  {0};
+        GLint  offset_vertices {0};
+        GLuint offset_mesh     {0};
+
+        size_t culled_mesh_counter {0};
+
+        const MathUtility::ViewProjectionPlanes_ReverseZ frustum_planes = MathUtility::ExtractProjectionPlanesFromVP(view_projection);
+
+        for (const Basic_Model* model_ptr : model_vec)
+        {
+            const glm::mat4 model_mat   = model_ptr->GetModelMatrix();
+
+            for (const Mesh& mesh : model_ptr->GetMeshVectorConstReference())
+            {
+                out_mesh_transforms.push_back(model_mat);
+
+                const MathUtility::AABB world_space_aabb = MathUtility::AABB::CreateWorldSpaceAABB(model_mat, mesh.GetLocalAABBHalfExtents(), mesh.GetLocalCenter());
+
+                const GLuint mesh_indices_count  = mesh.GetIndicesConstReference().size();
+                const GLuint mesh_vertices_count = mesh.GetAmountVertices();
+
+                if (MathUtility::AABBIsInFrustum(frustum_planes, world_space_aabb))
+                {
+                    //Create draw command
+                    DrawElementsIndirectCommand cmd;
+                    cmd.count = mesh.GetIndicesConstReference().size();  // Number of indices to draw
+                    cmd.instanceCount = 1;                               // One instance per model (can be >1 for instancing)
+                    cmd.firstIndex    = offset_indices;                  // Offset in index buffer
+                    cmd.baseVertex    = offset_vertices;                 // Offset in vertex buffer
+                    cmd.baseInstance  = offset_mesh;                     // Model index for SSBO lookup
+
+                    out_draw_commands.push_back(cmd);
+                }
+                else 
+                {
+                    culled_mesh_counter++;
+                }
+
+                //Update offsets for next cmd
+                offset_indices  += mesh_indices_count;
+                offset_vertices += mesh_vertices_count;
+                offset_mesh     += 1;
+            }
+        }
+
+        return culled_mesh_counter;
+    }
+
+    ////////////////////////////////////////////////
+    //--------- MathUtility
+    ////////////////////////////////////////////////
+    void RegisterMathUtilityBenchmarks()
+    {
+        Benchmark::Register("MathUtility/RaySphereIntersect", [](Benchmark::State& state) {
+            const std::vector<MathUtility::Ray3D> rays = CreateRays();
+            DatasetGenerator generator (DATASET_SEED + 3);
+            std::vector<MathUtility::Sphere> spheres (DATASET_SIZE);
+            for (MathUtility::Sphere& sphere : spheres) sphere = MathUtility::Sphere { generator.Position(), generator.Float(1.0f, 50.0f) };
+
+            size_t i = 0;
+            while (state.KeepRunning())
+            {
+                Benchmark::DoNotOptimize(MathUtility::RaySphereIntersect(rays[i], spheres[i]));
+                i = (i + 1) & (DATASET_SIZE - 1);
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.GetIterations()));
+        });
+
+        Benchmark::Register("MathUtility/RayAABBIntersect", [](Benchmark::State& state) {
+            const std::vector<MathUtility::Ray3D> rays = CreateRays();
+            DatasetGenerator generator (DATASET_SEED + 4);
+            std::vector<MathUtility::AABB> aabbs (DATASET_SIZE);
+            for (MathUtility::AABB& aabb : aabbs) aabb = MathUtility::AABB { generator.HalfExtents() * 5.0f, generator.Position() };
+
+            size_t i = 0;
+            while (state.KeepRunning())
+            {
+                Benchmark::DoNotOptimize(MathUtility::RayAABBIntersect(rays[i], aabbs[i]));
+                i = (i + 1) & (DATASET_SIZE - 1);
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.GetIterations()));
+        });
+
+        Benchmark::Register("MathUtility/RayTriangleIntersect", [](Benchmark::State& state) {
+            const std::vector<MathUtility::Ray3D> rays = CreateRays();
+            DatasetGenerator generator (DATASET_SEED + 5);
+            std::vector<MathUtility::Triangle> triangles (DATASET_SIZE);
+            for (MathUtility::Triangle& triangle : triangles)
+            {
+                const glm::vec3 center = generator.Position();
+                triangle = MathUtility::Triangle { center + generator.HalfExtents() * 4.0f, center - generator.HalfExtents() * 4.0f, center + generator.Direction() * 20.0f };
+            }
+
+            size_t i = 0;
+            while (state.KeepRunning())
+            {
+                Benchmark::DoNotOptimize(MathUtility::RayTriangleIntersect(rays[i], triangles[i]));
+                i = (i + 1) & (DATASET_SIZE - 1);
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.GetIterations()));
+        });
+
+        Benchmark::Register("MathUtility/ExtractProjectionPlanesFromVP", [](Benchmark::State& state) {
+            glm::mat4 view_projection = CreateViewProjection();
+            while (state.KeepRunning())
+            {
+                Benchmark::DoNotOptimize(view_projection);
+                Benchmark::DoNotOptimize(MathUtility::ExtractProjectionPlanesFromVP(view_projection));
+            }
+        });
+
+        Benchmark::Register("MathUtility/AABBIsInFrustum", [](Benchmark::State& state) {
+            const MathUtility::ViewProjectionPlanes_ReverseZ planes = MathUtility::ExtractProjectionPlanesFromVP(CreateViewProjection());
+            DatasetGenerator generator (DATASET_SEED + 6);
+            std::vector<MathUtility::AABB> aabbs (DATASET_SIZE);
+            for (MathUtility::AABB& aabb : aabbs) aabb = MathUtility::AABB { generator.HalfExtents(), generator.Position() };
+
+            size_t i = 0;
+            while (state.KeepRunning())
+            {
+                Benchmark::DoNotOptimize(MathUtility::AABBIsInFrustum(planes, aabbs[i]));
+                i = (i + 1) & (DATASET_SIZE - 1);
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.GetIterations()));
+        });
+
+        Benchmark::Register("MathUtility/SphereIsInFrustum", [](Benchmark::State& state) {
+            const MathUtility::ViewProjectionPlanes_ReverseZ planes = MathUtility::ExtractProjectionPlanesFromVP(CreateViewProjection());
+            DatasetGenerator generator (DATASET_SEED + 7);
+            std::vector<MathUtility::Sphere> spheres (DATASET_SIZE);
+            for (MathUtility::Sphere& sphere : spheres) sphere = MathUtility::Sphere { generator.Position(), generator.Float(1.0f, 20.0f) };
+
+            size_t i = 0;
+            while (state.KeepRunning())
+            {
+                Benchmark::DoNotOptimize(MathUtility::SphereIsInFrustum(planes, spheres[i]));
+                i = (i + 1) & (DATASET_SIZE - 1);
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.GetIterations()));
+        });
+
+        Benchmark::Register("MathUtility/AABB::CreateWorldSpaceAABB", [](Benchmark::State& state) {
+            DatasetGenerator generator (DATASET_SEED + 8);
+            std::vector<glm::mat4> model_matrices (DATASET_SIZE);
+            std::vector<MathUtility::AABB> local_aabbs (DATASET_SIZE);
+            for (size_t i = 0; i < DATASET_SIZE; i++)
+            {
+                model_matrices[i] = generator.ModelMatrix();
+                local_aabbs[i]    = MathUtility::AABB { generator.HalfExtents(), generator.Position() * 0.01f };
+            }
+
+            size_t i = 0;
+            while (state.KeepRunning())
+            {
+                Benchmark::DoNotOptimize(MathUtility::AABB::CreateWorldSpaceAABB(model_matrices[i], local_aabbs[i].m_half_extents, local_aabbs[i].m_center));
+                i = (i + 1) & (DATASET_SIZE - 1);
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.GetIterations()));
+        });
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Rendering (CPU side)
+    ////////////////////////////////////////////////
+    void RegisterRenderingBenchmarks()
+    {
+        Benchmark::Register("IndirectDraw3D/BuildTransformsAndDrawCommands", [](Benchmark::State& state) {
+            const std::vector<std::unique_ptr<Basic_Model>> models = CreateBoxModels(static_cast<size_t>(state.GetArgument()));
+            std::vector<Basic_Model*> model_ptrs;
+            for (const std::unique_ptr<Basic_Model>& model : models) model_ptrs.push_back(model.get());
+
+            const glm::mat4 view_projection = CreateViewProjection();
+            std::vector<glm::mat4> mesh_transforms;
+            std::pmr::vector<DrawElementsIndirectCommand> draw_commands;
+
+            while (state.KeepRunning())
+            {
+                Benchmark::DoNotOptimize(BuildTransformsAndDrawCommands(model_ptrs, view_projection, mesh_transforms, draw_commands));
+                Benchmark::DoNotOptimize(draw_commands.data());
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.GetIterations()) * state.GetArgument());
+        }, {256, 4096, 32768});
+
+        // Same boxes & camera as above, what the CullingMode::CPU path does per frame for a static scene
+        Benchmark::Register("IndirectDraw3D/FrustumCulling::CullAABBs", [](Benchmark::State& state) {
+            const std::vector<std::unique_ptr<Basic_Model>> models = CreateBoxModels(static_cast<size_t>(state.GetArgument()));
+            FrustumCulling::AABB_SoA world_aabbs;
+            world_aabbs.Resize(models.size());
+            for (size_t i = 0; i < models.size(); i++) world_aabbs.Set(i, models[i]->GetWorldSpaceAABB());
+
+            const glm::mat4 view_projection = CreateViewProjection();
+            std::pmr::vector<uint32_t> visible_indices;
+
+            while (state.KeepRunning())
+            {
+                FrustumCulling::CullAABBs(FrustumCulling::ExtractNormalizedPlanes(view_projection), world_aabbs, visible_indices);
+                Benchmark::DoNotOptimize(visible_indices.data());
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.GetIterations()) * state.GetArgument());
+        }, {256, 4096, 32768});
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Scene
+    ////////////////////////////////////////////////
+    void RegisterSceneBenchmarks()
+    {
+        Benchmark::Register("Scene3D/RaycastSelect", [](Benchmark::State& state) {
+            Scene3D scene;
+            FillSceneWithBoxes(scene, static_cast<size_t>(state.GetArgument()));
+            const std::vector<MathUtility::Ray3D> rays = CreateRays();
+
+            size_t i = 0;
+            while (state.KeepRunning())
+            {
+                Benchmark::DoNotOptimize(scene.RaycastSelect(rays[i]));
+                i = (i + 1) & (DATASET_SIZE - 1);
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.GetIterations()));
+        }, {64, 1024});
+
+        Benchmark::Register("Scene3D/SerializeToString", [](Benchmark::State& state) {
+            Scene3D scene;
+            FillSceneWithBoxes(scene, static_cast<size_t>(state.GetArgument()));
+            const CameraReverseZ camera (glm::vec3(0.0f), 16.0f / 9.0f, 70.0f, 0.1f);
+
+            while (state.KeepRunning())
+            {
+                Benchmark::DoNotOptimize(scene.SerializeToString(camera));
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.GetIterations()) * state.GetArgument());
+        }, {64, 1024});
+
+        Benchmark::Register("Scene3D/LoadFromSerializedString", [](Benchmark::State& state) {
+            std::string serialized;
+            {
+                Scene3D scene;
+                FillSceneWithBoxes(scene, static_cast<size_t>(state.GetArgument()));
+                serialized = scene.SerializeToString(CameraReverseZ(glm::vec3(0.0f), 16.0f / 9.0f, 70.0f, 0.1f));
+            }
+
+            Scene3D scene;
+            while (state.KeepRunning())
+            {
+                scene.LoadFromSerializedString(serialized, std::nullopt);
+                Benchmark::DoNotOptimize(scene.GetAmountObjects());
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.GetIterations()) * state.GetArgument());
+        }, {64, 1024});
+    }
+}
+    void RegisterEngineBenchmarks()
+    {
+        RegisterMathUtilityBenchmarks();
+        RegisterRenderingBenchmarks();
+        RegisterSceneBenchmarks();
+    }
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace CoreEngine
+{
+    // Registers the GL free engine hot paths with Benchmark::Register(). All datasets are synthetic with fixed seeds,
+    // so two runs (or two builds) measure exactly the same work.
+    void RegisterEngineBenchmarks();
+}
@@ -3,12 +3,15 @@
 //Own includes
 #include "core/utility/PhysicsUtility.h"
 #include "core/utility/CommonUtility.h"
+#include "core/utility/FrameArena.h"
 #include "core/utility/Performance.h"
 
 #include "core/application/Application.h"
 
 #include "core/model/PointsModel.h"
 
+#include "core/rendering/GpuProfiler.h"
+
 //GLFW
 #define GLFW_INCLUDE_NONE
 #include "GLFW/glfw3.h"
@@ -228,7 +231,7 @@ namespace CoreEngine
         if (ObjectCreation_HasFlag(m_object_creation_flags, ObjectCreationFlag::TRIANGLE_POINTS))
         {
             m_draw_points_pipelines.SetCameraMatrix(cam_matrix);
-            std::vector<glm::vec3> points;
+            std::pmr::vector<glm::vec3> points (&FrameArena::GetThreadLocal());
             points.reserve(m_triangle_point_creation_data.m_points.size());
             for (const Vertex& point : m_triangle_point_creation_data.m_points)
             {
@@ -627,11 +630,17 @@ namespace CoreEngine
             ImGui::TextUnformatted("Logged Frametimes:");
             ImGui::PopStyleColor();
 
-            PerFrameScopeTimes::SortData();
-            const std::vector<PerFrameScopeTimes::ScopeTimeData>& scope_times = PerFrameScopeTimes::GetScopeTimeDataConstRef();
-            for (auto rit = scope_times.rbegin(); rit != scope_times.rend(); ++rit)
+            for (const ScopeProfiler::ScopeStatistics& statistics : ScopeProfiler::GetStatisticsConstRef())
             {
-                ImGui::TextUnformatted(rit->ToString().c_str());
+                ImGui::TextUnformatted(statistics.ToString().c_str());
+            }
+
+            for (const GpuProfiler::ContextStatistics& context : GpuProfiler::GetContextStatistics())
+            {
+                if (context.m_is_available)
+                    ImGui::Text("GPU @ %s: %.1f µs/frame", ScopeProfiler::GetTagName(context.m_tag).c_str(), context.m_last_readback_us);
+                else
+                    ImGui::Text("GPU @ %s: no timer queries", ScopeProfiler::GetTagName(context.m_tag).c_str());
             }
 
             ImGui::PushStyleColor(ImGuiCol_Text, COLOR_ORANGE);
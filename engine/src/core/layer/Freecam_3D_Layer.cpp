@@ -44,7 +44,7 @@ namespace CoreEngine
         //---- Frame camera matrix
         const glm::mat4 cam_matrix = m_camera.CalculateCameraMatrix();
 
-        //---- If an object was added / deleted, Update the entire data - else just update transformations
+        //---- If an object was added / deleted, upload just the changed models - else just update transformations
         if (m_scene.GetAndResetObjectVecChangeFlag())  { m_pipeline.SetSceneData(m_scene.GetRenderModelVector(), m_scene.GetLightVectorConstRef()); } 
         else                                           { m_pipeline.UpdateModelTransforms(m_scene.GetRenderModelVector(), cam_matrix); }
 
@@ -91,6 +91,14 @@ namespace CoreEngine
             Application::Get()->SetVsync(vsync_now);
         }
 
+        bool gpu_culling_now = m_pipeline.GetCullingMode() == IndirectDraw3D_RenderPipeline::CullingMode::GPU;
+        ImGui::BeginDisabled(! IndirectDraw3D_RenderPipeline::GpuCullingIsSupported());
+        if (ImGui::Checkbox("GPU Frustum Culling", &gpu_culling_now))
+        {
+            m_pipeline.SetCullingMode(gpu_culling_now ? IndirectDraw3D_RenderPipeline::CullingMode::GPU : IndirectDraw3D_RenderPipeline::CullingMode::CPU);
+        }
+        ImGui::EndDisabled();
+
         ImGui::SliderFloat(":Speed-factor ", &m_physics_speed_scale, 0.01f, 20.0f);
 
         float fov = m_camera.GetFovDeg();
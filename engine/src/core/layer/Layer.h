@@ -21,7 +21,12 @@ namespace CoreEngine
 
         virtual void OnUpdate(Units::MicroSecond delta_time) noexcept    = 0;
         virtual void OnEvent(Basic_Event& event) noexcept                = 0;
+        // Never called for headless layers (Application::PushHeadlessLayer()), they have no window or GL context
         virtual void OnRender() noexcept                                 = 0;
         virtual void OnImGuiRender() noexcept                            = 0;
+
+        // Queried by the idle frame pacing of the Application: how long until the layer needs its next update & redraw.
+        // Zero = as soon as possible, which is also the default so layers that don't care keep redrawing every loop.
+        [[nodiscard]] virtual Units::MicroSecond GetTimeUntilNextRedraw() const noexcept { return Units::MicroSecond(0); }
     };
 }
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "core/model/AssetManager.h"
+
+#include "core/utility/CommonUtility.h"
+
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace CoreEngine
+{
+    AssetManager& AssetManager::Get() noexcept
+    {
+        static AssetManager s_asset_manager;
+        return s_asset_manager;
+    }
+
+    std::shared_ptr<const AssetManager::ModelAsset> AssetManager::GetModel(const std::string& path, const glm::vec3& natural_scale, const ModelImporter& importer) noexcept
+    {
+        std::error_code error;
+        const std::filesystem::path canonical_path = std::filesystem::weakly_canonical(path, error);
+        const std::filesystem::file_time_type last_write_time = error ? std::filesystem::file_time_type{} : std::filesystem::last_write_time(canonical_path, error);
+        const uintmax_t file_size = error ? 0 : std::filesystem::file_size(canonical_path, error);
+        if (error)
+        {
+            return std::make_shared<const ModelAsset>(importer());
+        }
+
+        //Only hashed again if the file looks changed
+        std::string canonical_path_string = canonical_path.string();
+        const auto [stamp_it, is_new_path] = m_file_stamps.try_emplace(canonical_path_string);
+        FileStamp& stamp = stamp_it->second;
+        if (is_new_path || stamp.m_last_write_time != last_write_time || stamp.m_file_size != file_size)
+        {
+            size_t content_hash {0};
+            try {
+                content_hash = std::hash<std::string_view>{}(CommonUtility::ReadFileToString(canonical_path_string.c_str()));
+            } catch (...) {
+                m_file_stamps.erase(stamp_it);
+                return std::make_shared<const ModelAsset>(importer());
+            }
+
+            //Assets of the old content are out of date
+            if (! is_new_path && stamp.m_content_hash != content_hash)
+            {
+                std::erase_if(m_models, [&](const auto& entry) { return entry.first.m_canonical_path == canonical_path_string; });
+            }
+            stamp = FileStamp{ last_write_time, file_size, content_hash };
+        }
+
+        std::shared_ptr<const ModelAsset>& asset = m_models[ModelKey{ std::move(canonical_path_string), stamp.m_content_hash, natural_scale }];
+        if (! asset)
+        {
+            asset = std::make_shared<const ModelAsset>(importer());
+        }
+        return asset;
+    }
+
+    void AssetManager::Clear() noexcept
+    {
+        m_file_stamps.clear();
+        m_models.clear();
+    }
+
+    size_t AssetManager::GetAmountCachedModels() const noexcept
+    {
+        return m_models.size();
+    }
+
+    size_t AssetManager::ModelKeyHash::operator()(const ModelKey& key) const noexcept
+    {
+        size_t hash = std::hash<std::string>{}(key.m_canonical_path);
+        hash ^= key.m_content_hash + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+        for (int i = 0; i < 3; i++)
+        {
+            hash ^= std::hash<float>{}(key.m_natural_scale[i]) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+}
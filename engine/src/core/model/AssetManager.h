@@ -0,0 +1,73 @@
+#pragma once
+
+#include "core/model/Mesh.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CoreEngine
+{
+    ////////////////////////////////////////////////
+    //--------- Asset manager
+    ////////////////////////////////////////////////
+    // Imported model files, shared by every PathModel of the same file instead of importing it again. Cached by canonical
+    // path, file content & natural scale (baked into the vertices). The path stays part of the key since identical files in
+    // different directories can resolve different .mtl / .bin / texture files. A file whose size or write time changed is
+    // hashed again & re-imported if its content did change. Only the model file itself is stamped, changes to the files it
+    // references aren't detected - Clear() the cache to pick those up. Main thread only.
+    class AssetManager final
+    {
+    public:
+        struct ModelAsset
+        {
+            std::vector<Mesh> m_meshes;                      // Centered locally, copies share their MeshData
+            glm::vec3         m_aabb_half_extents {0.0f};
+        };
+        using ModelImporter = std::function<ModelAsset()>;
+
+        [[nodiscard]] static AssetManager& Get() noexcept;
+
+        // Cached asset of the file, otherwise the result of importer. Not cached if the file can't be read
+        [[nodiscard]] std::shared_ptr<const ModelAsset> GetModel(const std::string& path, const glm::vec3& natural_scale, const ModelImporter& importer) noexcept;
+
+        // Drops the cache's references, models using an asset keep it alive
+        void Clear() noexcept;
+        [[nodiscard]] size_t GetAmountCachedModels() const noexcept;
+
+        AssetManager(const AssetManager&)            = delete;
+        AssetManager& operator=(const AssetManager&) = delete;
+
+    private:
+        AssetManager() noexcept = default;
+
+        struct FileStamp
+        {
+            std::filesystem::file_time_type m_last_write_time {};
+            uintmax_t                       m_file_size       = 0;
+            size_t                          m_content_hash    = 0;
+        };
+
+        struct ModelKey
+        {
+            std::string m_canonical_path;
+            size_t      m_content_hash = 0;
+            glm::vec3   m_natural_scale {1.0f};
+
+            [[nodiscard]] bool operator==(const ModelKey&) const noexcept = default;
+        };
+
+        struct ModelKeyHash
+        {
+            [[nodiscard]] size_t operator()(const ModelKey& key) const noexcept;
+        };
+
+        std::unordered_map<std::string, FileStamp>                                    m_file_stamps; // Canonical path ->
+        std::unordered_map<ModelKey, std::shared_ptr<const ModelAsset>, ModelKeyHash> m_models;
+    };
+}
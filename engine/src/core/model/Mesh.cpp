@@ -1,31 +1,80 @@
 #include "core/model/Mesh.h"
 
+//GLM
+#include <glm/gtc/packing.hpp>
+
 namespace CoreEngine
 {
+namespace
+{
+    [[nodiscard]] glm::vec2 EncodeOctahedral(const glm::vec3& normal) noexcept
+    {
+        const float length_l1 = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+        if (length_l1 == 0.0f)
+            return glm::vec2(0.0f);
+
+        const glm::vec3 n = normal / length_l1;
+        if (n.z >= 0.0f)
+            return glm::vec2(n.x, n.y);
+
+        //Lower hemisphere folded over the diagonals
+        return glm::vec2((1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f), (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f));
+    }
+
+    //Same as in shader_IndirectDraw3D.vert
+    [[nodiscard]] glm::vec3 DecodeOctahedral(const glm::vec2& encoded) noexcept
+    {
+        glm::vec3 n (encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+        const float t = std::max(-n.z, 0.0f);
+        n.x += n.x >= 0.0f ? -t : t;
+        n.y += n.y >= 0.0f ? -t : t;
+        return glm::normalize(n);
+    }
+
+    [[nodiscard]] Vertex DecodePackedVertex(const PackedVertex& packed, const glm::vec3& position_min, const glm::vec3& position_extent) noexcept
+    {
+        return Vertex
+        {
+            .m_position = position_min + position_extent * glm::vec3(glm::unpackUnorm2x16(packed.m_position_xy), glm::unpackUnorm2x16(packed.m_position_z).x),
+            .m_normal   = DecodeOctahedral(glm::unpackSnorm2x16(packed.m_normal)),
+            .m_tex_uv   = glm::unpackHalf2x16(packed.m_tex_uv)
+        };
+    }
+}
     Mesh::Mesh(std::vector<Vertex>&& vertices, std::vector<GLuint>&& indices, std::shared_ptr<MaterialPBR> material) noexcept 
-    : m_vertices(std::move(vertices)), m_indices(std::move(indices)), m_material(std::move(material)) 
+    : m_data(std::make_shared<MeshData>(std::move(vertices), std::move(indices))), m_material(std::move(material)) 
     {
         CalculateAABBExtentsAndLocalCenter();
     }
 
     std::vector<Vertex>& Mesh::GetVerticesReference() noexcept 
     { 
-        return m_vertices; 
+        //The caller may change the vertices, the packed copy would be out of date
+        MeshData& data = GetUniqueData();
+        RestoreReleasedVertices();
+        data.m_packed_vertices.clear();
+        return data.m_vertices; 
     }
 
     const std::vector<Vertex>& Mesh::GetVerticesConstReference() const noexcept 
     { 
-        return m_vertices; 
+        RestoreReleasedVertices();
+        return m_data->m_vertices; 
+    }
+
+    size_t Mesh::GetAmountVertices() const noexcept
+    {
+        return m_data->m_packed_vertices.empty() ? m_data->m_vertices.size() : m_data->m_packed_vertices.size();
     }
 
     std::vector<GLuint>& Mesh::GetIndicesReference() noexcept 
     {
-        return m_indices;  
+        return GetUniqueData().m_indices;  
     }
 
     const std::vector<GLuint>& Mesh::GetIndicesConstReference() const noexcept 
     { 
-        return m_indices;  
+        return m_data->m_indices;  
     }
 
     std::shared_ptr<MaterialPBR> Mesh::GetMaterialSharedPtr() noexcept 
@@ -38,15 +87,45 @@ namespace CoreEngine
         return m_material;  
     }
 
+    std::shared_ptr<const MeshData> Mesh::GetSharedData() const noexcept
+    {
+        return m_data;
+    }
+
     void Mesh::SetVertices(std::vector<Vertex>&& vertices) noexcept 
     { 
-        m_vertices = std::move(vertices); 
+        //No need to copy the vertices that are replaced anyway
+        if (m_data.use_count() == 1) { m_data->m_vertices = std::move(vertices); m_data->m_packed_vertices.clear(); }
+        else                         { m_data = std::make_shared<MeshData>(std::move(vertices), m_data->m_indices); }
         CalculateAABBExtentsAndLocalCenter(); 
     }
 
     void Mesh::SetIndices(std::vector<GLuint>&& indices) noexcept 
     { 
-        m_indices  = std::move(indices); 
+        if (m_data.use_count() == 1) { m_data->m_indices = std::move(indices); }
+        else                         { m_data = std::make_shared<MeshData>(m_data->m_vertices, std::move(indices), m_data->m_packed_vertices, m_data->m_packed_position_min, m_data->m_packed_position_extent); }
+    }
+
+    MeshData& Mesh::GetUniqueData() noexcept
+    {
+        if (m_data.use_count() != 1)
+        {
+            m_data = std::make_shared<MeshData>(*m_data);
+        }
+        return *m_data;
+    }
+
+    void Mesh::RestoreReleasedVertices() const noexcept
+    {
+        MeshData& data = *m_data;
+        if (! data.m_vertices.empty() || data.m_packed_vertices.empty())
+            return;
+
+        data.m_vertices.reserve(data.m_packed_vertices.size());
+        for (const PackedVertex& packed : data.m_packed_vertices)
+        {
+            data.m_vertices.push_back(DecodePackedVertex(packed, data.m_packed_position_min, data.m_packed_position_extent));
+        }
     }
 
     void Mesh::SetMaterial(std::shared_ptr<MaterialPBR> material) noexcept 
@@ -59,7 +138,14 @@ namespace CoreEngine
         glm::vec3 max {std::numeric_limits<float>::lowest()};
         glm::vec3 min {std::numeric_limits<float>::max()};
 
-        for(const Vertex& vertex : m_vertices)
+        //Released vertices aren't decoded for this, the packing bounds are the AABB
+        if (m_data->m_vertices.empty() && ! m_data->m_packed_vertices.empty())
+        {
+            min = m_data->m_packed_position_min;
+            max = m_data->m_packed_position_min + m_data->m_packed_position_extent;
+        }
+
+        for(const Vertex& vertex : m_data->m_vertices)
         {
             max = glm::max(max, vertex.m_position);
             min = glm::min(min, vertex.m_position);
@@ -83,4 +169,78 @@ namespace CoreEngine
     {
         m_local_center = center;
     }
-}
\ No newline at end of file
+
+    bool Mesh::PackVertices(const VertexPackingTolerance& tolerance) noexcept
+    {
+        if (HasPackedVertices())
+            return true;
+
+        const std::vector<Vertex>& vertices = m_data->m_vertices;
+        if (vertices.empty())
+            return false;
+
+        glm::vec3 min {std::numeric_limits<float>::max()};
+        glm::vec3 max {std::numeric_limits<float>::lowest()};
+        for (const Vertex& vertex : vertices)
+        {
+            min = glm::min(min, vertex.m_position);
+            max = glm::max(max, vertex.m_position);
+        }
+        const glm::vec3 extent      = max - min;
+        const glm::vec3 safe_extent = glm::max(extent, glm::vec3(std::numeric_limits<float>::min()));
+        //Relative to the extent: unorm16 over the bounds is off by up to half a step, whatever the mesh's size. Never below
+        //float precision at the mesh's coordinates, or a flat axis far from the origin would fail
+        const glm::vec3 max_position_error = glm::max(extent * tolerance.m_max_position_error, glm::max(glm::abs(min), glm::abs(max)) * 4.0f * std::numeric_limits<float>::epsilon());
+
+        std::vector<PackedVertex> packed_vertices;
+        packed_vertices.reserve(vertices.size());
+        for (const Vertex& vertex : vertices)
+        {
+            const glm::vec3 unorm_position = (vertex.m_position - min) / safe_extent;
+            const PackedVertex packed 
+            {
+                .m_position_xy = glm::packUnorm2x16(glm::vec2(unorm_position.x, unorm_position.y)),
+                .m_position_z  = glm::packUnorm2x16(glm::vec2(unorm_position.z, 0.0f)),
+                .m_normal      = glm::packSnorm2x16(EncodeOctahedral(vertex.m_normal)),
+                .m_tex_uv      = glm::packHalf2x16(vertex.m_tex_uv)
+            };
+
+            //Precision check against the decoded vertex
+            const glm::vec3 decoded_position = min + extent * glm::vec3(glm::unpackUnorm2x16(packed.m_position_xy), glm::unpackUnorm2x16(packed.m_position_z).x);
+            const glm::vec2 decoded_tex_uv   = glm::unpackHalf2x16(packed.m_tex_uv);
+            const float     normal_length    = glm::length(vertex.m_normal);
+            const bool normal_is_precise     = normal_length == 0.0f || glm::dot(DecodeOctahedral(glm::unpackSnorm2x16(packed.m_normal)), vertex.m_normal / normal_length) >= tolerance.m_min_normal_dot;
+
+            if (glm::any(glm::greaterThan(glm::abs(decoded_position - vertex.m_position), max_position_error)) ||
+                glm::any(glm::greaterThan(glm::abs(decoded_tex_uv - vertex.m_tex_uv), glm::vec2(tolerance.m_max_tex_uv_error))) ||
+                ! normal_is_precise)
+            {
+                return false;
+            }
+            packed_vertices.push_back(packed);
+        }
+
+        //Swapped out instead of cleared, so the memory is actually freed
+        MeshData& data = GetUniqueData();
+        data.m_packed_vertices        = std::move(packed_vertices);
+        data.m_packed_position_min    = min;
+        data.m_packed_position_extent = extent;
+        std::vector<Vertex>().swap(data.m_vertices);
+        return true;
+    }
+
+    void Mesh::DropPackedVertices() noexcept
+    {
+        if (HasPackedVertices())
+        {
+            MeshData& data = GetUniqueData();
+            RestoreReleasedVertices();
+            data.m_packed_vertices.clear();
+        }
+    }
+
+    bool Mesh::HasPackedVertices() const noexcept
+    {
+        return ! m_data->m_packed_vertices.empty();
+    }
+}
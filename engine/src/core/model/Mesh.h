@@ -27,17 +27,53 @@ namespace CoreEngine
 
     static_assert(sizeof(Vertex) == 32, "Vertex must be 32 bytes");
 
+    //Compact Vertex for IndirectDraw3D. Position as 16 bit unorm within the mesh's position bounds, normal octahedral
+    //encoded as 2x16 bit snorm, uv as 2 halfs. Same packing as GLSL's pack*2x16(), x in the low 16 bits
+    struct PackedVertex
+    {
+        GLuint m_position_xy;
+        GLuint m_position_z; // High 16 bits unused
+        GLuint m_normal;
+        GLuint m_tex_uv;
+    };
+
+    static_assert(sizeof(PackedVertex) == 16, "PackedVertex must be 16 bytes");
+
+    //Largest errors the packed vertices may have compared to the full ones
+    struct VertexPackingTolerance
+    {
+        float m_max_position_error = 1.0f / 65535.0f;  // Fraction of the mesh's extent per axis, one unorm16 step
+        float m_max_tex_uv_error   = 1.0f / 2048.0f;   // Halfs keep this up to |uv| < 2, tiling uvs beyond fail
+        float m_min_normal_dot     = 0.9999f;          // Cosine of the largest angle error
+    };
+
+    //Geometry of a Mesh, shared by its copies & never changed while shared, apart from restoring released vertices
+    struct MeshData
+    {
+        std::vector<Vertex>       m_vertices; // Empty while released for m_packed_vertices, see Mesh::PackVertices()
+        std::vector<GLuint>       m_indices;
+
+        //Optional packed form of m_vertices, see Mesh::PackVertices(). Positions decode as min + extent * unorm
+        std::vector<PackedVertex> m_packed_vertices;
+        glm::vec3                 m_packed_position_min    {0.0f};
+        glm::vec3                 m_packed_position_extent {0.0f};
+    };
+
+    //Copies share the MeshData, an O(1) reference bump. The non const accessors & setters copy it first if it is shared
     class Mesh 
     {
     public:
         explicit Mesh(std::vector<Vertex>&& vertices, std::vector<GLuint>&& indices, std::shared_ptr<MaterialPBR> material) noexcept;
 
+        //Both decode released vertices from the packed ones first
         [[nodiscard]] std::vector<Vertex>& GetVerticesReference()                      noexcept;
         [[nodiscard]] const std::vector<Vertex>& GetVerticesConstReference()    const  noexcept;
+        [[nodiscard]] size_t GetAmountVertices()                                const  noexcept;
         [[nodiscard]] std::vector<GLuint>& GetIndicesReference()                       noexcept;
         [[nodiscard]] const std::vector<GLuint>& GetIndicesConstReference()     const  noexcept;
         [[nodiscard]] std::shared_ptr<MaterialPBR> GetMaterialSharedPtr()                   noexcept;
         [[nodiscard]] const std::shared_ptr<MaterialPBR> GetMaterialConstSharedPtr() const  noexcept;
+        [[nodiscard]] std::shared_ptr<const MeshData> GetSharedData()               const  noexcept;
 
         void SetVertices(std::vector<Vertex>&& vertices)  noexcept;
         void SetIndices(std::vector<GLuint>&& indices)    noexcept;
@@ -49,9 +85,20 @@ namespace CoreEngine
 
         void SetLocalCenter(const glm::vec3& center) noexcept; //Should only be called if vertices are changed outside Mesh
 
+        //Replaces the vertices by packed ones, which IndirectDraw3D then draws instead, & releases the full vertices. False &
+        //nothing changed if a packed vertex is off by more than the tolerance. Dropped again by any vertex change. Reading
+        //the vertices afterwards (picking, collision shapes) decodes them again, within the tolerance of the originals
+        bool PackVertices(const VertexPackingTolerance& tolerance = {}) noexcept;
+        void DropPackedVertices() noexcept;
+        [[nodiscard]] bool HasPackedVertices() const noexcept;
+
     private:
-        std::vector<Vertex> m_vertices;
-        std::vector<GLuint> m_indices;
+        //Copy on write, the only place MeshData is changed
+        [[nodiscard]] MeshData& GetUniqueData() noexcept;
+        //Decodes released vertices back into m_vertices. Doesn't change the geometry, so allowed on shared data
+        void RestoreReleasedVertices() const noexcept;
+
+        std::shared_ptr<MeshData> m_data;
         std::shared_ptr<MaterialPBR> m_material;
 
         glm::vec3 m_local_center{};
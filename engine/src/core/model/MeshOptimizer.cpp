@@ -0,0 +1,275 @@
+#include "core/model/MeshOptimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+
+namespace CoreEngine
+{
+namespace
+{
+    //Triangles using each vertex, compressed: the triangles of vertex v are triangles[offsets[v], offsets[v + 1])
+    struct VertexTriangles
+    {
+        std::vector<GLuint> m_offsets;
+        std::vector<GLuint> m_triangles;
+    };
+
+    [[nodiscard]] VertexTriangles BuildVertexTriangles(std::span<const GLuint> indices, size_t amount_vertices) noexcept
+    {
+        VertexTriangles adjacency;
+        adjacency.m_offsets.assign(amount_vertices + 1, 0);
+        for (const GLuint index : indices)
+        {
+            adjacency.m_offsets[index + 1]++;
+        }
+        std::partial_sum(adjacency.m_offsets.begin(), adjacency.m_offsets.end(), adjacency.m_offsets.begin());
+
+        adjacency.m_triangles.resize(indices.size());
+        std::vector<GLuint> fill (adjacency.m_offsets.begin(), adjacency.m_offsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); i++)
+        {
+            adjacency.m_triangles[fill[indices[i]]++] = static_cast<GLuint>(i / 3);
+        }
+        return adjacency;
+    }
+
+    [[nodiscard]] bool IsTriangleList(std::span<const GLuint> indices, size_t amount_vertices) noexcept
+    {
+        return indices.size() % 3 == 0 && std::all_of(indices.begin(), indices.end(), [&](GLuint index) { return index < amount_vertices; });
+    }
+}
+    float MeshOptimizer::CalculateACMR(std::span<const GLuint> indices, size_t amount_vertices, size_t cache_size) noexcept
+    {
+        if (indices.size() < 3 || ! IsTriangleList(indices, amount_vertices))
+            return 0.0f;
+
+        //A vertex is in the FIFO while fewer than cache_size misses happened since it was inserted
+        constexpr size_t never_inserted = SIZE_MAX;
+        std::vector<size_t> inserted_at (amount_vertices, never_inserted);
+        size_t amount_misses = 0;
+        for (const GLuint index : indices)
+        {
+            if (inserted_at[index] == never_inserted || amount_misses - inserted_at[index] >= cache_size)
+            {
+                inserted_at[index] = amount_misses;
+                amount_misses++;
+            }
+        }
+        return static_cast<float>(amount_misses) / static_cast<float>(indices.size() / 3);
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(std::vector<GLuint>& indices, size_t amount_vertices, size_t cache_size, std::vector<size_t>& out_cluster_starts) noexcept
+    {
+        out_cluster_starts.clear();
+        const size_t amount_triangles = indices.size() / 3;
+        if (amount_triangles == 0)
+            return;
+
+        const VertexTriangles adjacency = BuildVertexTriangles(indices, amount_vertices);
+
+        std::vector<GLuint> live_triangles (amount_vertices);
+        for (size_t v = 0; v < amount_vertices; v++)
+        {
+            live_triangles[v] = adjacency.m_offsets[v + 1] - adjacency.m_offsets[v];
+        }
+
+        //Time stamps: a vertex is in cache if time - cache_time <= cache_size
+        std::vector<size_t> cache_time (amount_vertices, 0);
+        size_t time = cache_size + 1;
+
+        std::vector<bool>   is_emitted (amount_triangles, false);
+        std::vector<GLuint> dead_end_stack;
+        std::vector<GLuint> candidates;
+        std::vector<GLuint> output;
+        output.reserve(indices.size());
+
+        int64_t fanning_vertex = 0;
+        size_t  cursor         = 1;
+        out_cluster_starts.push_back(0);
+
+        while (fanning_vertex >= 0)
+        {
+            //Emit every remaining triangle around the fanning vertex
+            candidates.clear();
+            for (GLuint a = adjacency.m_offsets[fanning_vertex]; a < adjacency.m_offsets[fanning_vertex + 1]; a++)
+            {
+                const GLuint triangle = adjacency.m_triangles[a];
+                if (is_emitted[triangle])
+                    continue;
+
+                for (size_t corner = 0; corner < 3; corner++)
+                {
+                    const GLuint v = indices[triangle * 3 + corner];
+                    output.push_back(v);
+                    dead_end_stack.push_back(v);
+                    candidates.push_back(v);
+                    live_triangles[v]--;
+                    if (time - cache_time[v] > cache_size)
+                    {
+                        cache_time[v] = time;
+                        time++;
+                    }
+                }
+                is_emitted[triangle] = true;
+            }
+
+            //Next fanning vertex: the candidate that stays in cache longest while its remaining triangles are emitted
+            int64_t best_vertex   = -1;
+            int64_t best_priority = -1;
+            for (const GLuint v : candidates)
+            {
+                if (live_triangles[v] == 0)
+                    continue;
+
+                int64_t priority = 0;
+                if (time - cache_time[v] + 2 * size_t(live_triangles[v]) <= cache_size)
+                {
+                    priority = static_cast<int64_t>(time - cache_time[v]);
+                }
+                if (priority > best_priority)
+                {
+                    best_priority = priority;
+                    best_vertex   = v;
+                }
+            }
+            if (best_vertex >= 0)
+            {
+                fanning_vertex = best_vertex;
+                continue;
+            }
+
+            //Dead end: a recently used vertex with live triangles, otherwise the next one in input order
+            fanning_vertex = -1;
+            while (! dead_end_stack.empty())
+            {
+                const GLuint v = dead_end_stack.back();
+                dead_end_stack.pop_back();
+                if (live_triangles[v] > 0)
+                {
+                    fanning_vertex = v;
+                    break;
+                }
+            }
+            while (fanning_vertex < 0 && cursor < amount_vertices)
+            {
+                if (live_triangles[cursor] > 0)
+                {
+                    fanning_vertex = static_cast<int64_t>(cursor);
+                }
+                cursor++;
+            }
+
+            //The jump is a cache hard boundary, clusters can be reordered there at no cost
+            if (fanning_vertex >= 0 && output.size() / 3 != out_cluster_starts.back() && time - cache_time[fanning_vertex] > cache_size)
+            {
+                out_cluster_starts.push_back(output.size() / 3);
+            }
+        }
+
+        indices = std::move(output);
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(std::vector<GLuint>& indices, std::span<const Vertex> vertices, std::span<const size_t> cluster_starts) noexcept
+    {
+        const size_t amount_triangles = indices.size() / 3;
+        const size_t amount_clusters  = cluster_starts.size();
+        if (amount_clusters < 2)
+            return;
+
+        const auto TriangleCorners = [&](size_t triangle) {
+            return std::array<glm::vec3, 3>{ vertices[indices[triangle * 3]].m_position, vertices[indices[triangle * 3 + 1]].m_position, vertices[indices[triangle * 3 + 2]].m_position };
+        };
+
+        //Area weighted centroid of the whole mesh
+        glm::vec3 mesh_centroid {0.0f};
+        float     mesh_area     {0.0f};
+        for (size_t triangle = 0; triangle < amount_triangles; triangle++)
+        {
+            const auto [a, b, c] = TriangleCorners(triangle);
+            const float area = glm::length(glm::cross(b - a, c - a));
+            mesh_centroid += area * (a + b + c) / 3.0f;
+            mesh_area     += area;
+        }
+        mesh_centroid = mesh_area > 0.0f ? mesh_centroid / mesh_area : glm::vec3(0.0f);
+
+        //Occlusion potential: how far the cluster lies outwards along its own average normal
+        std::vector<float> occlusion_potentials (amount_clusters, 0.0f);
+        for (size_t cluster = 0; cluster < amount_clusters; cluster++)
+        {
+            const size_t end = cluster + 1 < amount_clusters ? cluster_starts[cluster + 1] : amount_triangles;
+            glm::vec3 centroid {0.0f};
+            glm::vec3 normal   {0.0f}; // Area weighted, the length of a cross product is twice the area
+            float     area     {0.0f};
+            for (size_t triangle = cluster_starts[cluster]; triangle < end; triangle++)
+            {
+                const auto [a, b, c] = TriangleCorners(triangle);
+                const glm::vec3 cross = glm::cross(b - a, c - a);
+                const float triangle_area = glm::length(cross);
+                centroid += triangle_area * (a + b + c) / 3.0f;
+                normal   += cross;
+                area     += triangle_area;
+            }
+            if (area > 0.0f)
+            {
+                occlusion_potentials[cluster] = glm::dot(centroid / area - mesh_centroid, normal / area);
+            }
+        }
+
+        std::vector<size_t> cluster_order (amount_clusters);
+        std::iota(cluster_order.begin(), cluster_order.end(), 0);
+        std::stable_sort(cluster_order.begin(), cluster_order.end(), [&](size_t a, size_t b) { return occlusion_potentials[a] > occlusion_potentials[b]; });
+
+        std::vector<GLuint> output;
+        output.reserve(indices.size());
+        for (const size_t cluster : cluster_order)
+        {
+            const size_t end = cluster + 1 < amount_clusters ? cluster_starts[cluster + 1] : amount_triangles;
+            output.insert(output.end(), indices.begin() + cluster_starts[cluster] * 3, indices.begin() + end * 3);
+        }
+        indices = std::move(output);
+    }
+
+    size_t MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<GLuint>& indices) noexcept
+    {
+        constexpr GLuint unused = UINT32_MAX;
+        std::vector<GLuint> remap (vertices.size(), unused);
+        std::vector<Vertex> reordered;
+        reordered.reserve(vertices.size());
+
+        for (GLuint& index : indices)
+        {
+            if (remap[index] == unused)
+            {
+                remap[index] = static_cast<GLuint>(reordered.size());
+                reordered.push_back(vertices[index]);
+            }
+            index = remap[index];
+        }
+
+        const size_t amount_removed = vertices.size() - reordered.size();
+        vertices = std::move(reordered);
+        return amount_removed;
+    }
+
+    MeshOptimizer::Statistics MeshOptimizer::Optimize(std::vector<Vertex>& vertices, std::vector<GLuint>& indices, size_t cache_size) noexcept
+    {
+        Statistics statistics {};
+        if (indices.empty() || ! IsTriangleList(indices, vertices.size()))
+            return statistics;
+
+        statistics.m_amount_triangles = indices.size() / 3;
+        statistics.m_acmr_before      = CalculateACMR(indices, vertices.size(), cache_size);
+
+        std::vector<size_t> cluster_starts;
+        OptimizeVertexCache(indices, vertices.size(), cache_size, cluster_starts);
+        OptimizeOverdraw(indices, vertices, cluster_starts);
+        statistics.m_amount_clusters = cluster_starts.size();
+
+        //Remapping doesn't change the ACMR
+        statistics.m_acmr_after              = CalculateACMR(indices, vertices.size(), cache_size);
+        statistics.m_amount_removed_vertices = OptimizeVertexFetch(vertices, indices);
+        return statistics;
+    }
+}
@@ -10,6 +10,9 @@
 #include <iostream>
 
 //own
+#include "core/model/AssetManager.h"
+#include "core/rendering/TextureCache.h"
+
 #include "core/utility/Assert.h"
 #include "core/utility/CommonUtility.h"
 
@@ -17,26 +20,60 @@ namespace CoreEngine
 {
     PathModel::PathModel(const std::string& path, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& natural_scale) noexcept 
     : m_file_path(path), m_natural_scale_factor(natural_scale)
+    {
+        //Imported & centered once per file, every further PathModel of it shares the meshes
+        const std::shared_ptr<const AssetManager::ModelAsset> asset = AssetManager::Get().GetModel(path, natural_scale, [&]() {
+            ImportMeshes(path, natural_scale);
+            CalculateAABBExtentsAndLocalCenter();
+            CenterModelLocally();
+            //After centering, which drops packed vertices. Meshes failing the precision check keep only full vertices
+            for (Mesh& mesh : m_mesh_vector)
+            {
+                mesh.PackVertices();
+            }
+            return AssetManager::ModelAsset{ m_mesh_vector, m_aabb_half_extents };
+        });
+
+        m_mesh_vector       = asset->m_meshes;
+        m_aabb_half_extents = asset->m_aabb_half_extents;
+        m_local_center      = glm::vec3(0.0f);
+
+        m_position = position;
+        m_rotation = rotation;
+    }
+
+    void PathModel::ImportMeshes(const std::string& path, const glm::vec3& natural_scale) noexcept
     {
         Assimp::Importer importer;
         const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_SortByPType | aiProcess_FlipUVs | aiProcess_GenNormals | aiProcess_JoinIdenticalVertices | aiProcess_PreTransformVertices);
         
         ENGINE_ASSERT (scene && !(scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) && scene->mRootNode 
-            && (std::string("At PathModel::PathModel(): Assimp error: ") + importer.GetErrorString()).c_str() );
+            && (std::string("At PathModel::ImportMeshes(): Assimp error: ") + importer.GetErrorString()).c_str() );
 
+        m_mesh_vector.clear();
         m_mesh_vector.reserve(scene->mNumMeshes);
 
+        //Triangle weighted ACMR over all meshes
+        double acmr_before_sum  = 0.0;
+        double acmr_after_sum   = 0.0;
+        size_t amount_triangles = 0;
+
         for (unsigned int i = 0; i < scene->mNumMeshes; i++) 
         {
             if (scene->mMeshes[i]->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) continue;
-            m_mesh_vector.emplace_back( GetMeshFromAi(path, scene->mMeshes[i], scene, natural_scale) );
+            MeshOptimizer::Statistics optimization {};
+            m_mesh_vector.emplace_back( GetMeshFromAi(path, scene->mMeshes[i], scene, natural_scale, optimization) );
+
+            acmr_before_sum  += double(optimization.m_acmr_before) * optimization.m_amount_triangles;
+            acmr_after_sum   += double(optimization.m_acmr_after)  * optimization.m_amount_triangles;
+            amount_triangles += optimization.m_amount_triangles;
         }
 
-        m_position = position;
-        m_rotation = rotation;
-        
-        CalculateAABBExtentsAndLocalCenter();
-        CenterModelLocally();
+        if (amount_triangles > 0)
+        {
+            ENGINE_DEBUG_PRINT("Optimized " << m_mesh_vector.size() << " mesh(es), " << amount_triangles << " triangles of " << path 
+                << ": ACMR " << acmr_before_sum / amount_triangles << " -> " << acmr_after_sum / amount_triangles);
+        }
     }
 
     std::unique_ptr<Basic_Model> PathModel::Copy() const noexcept
@@ -59,7 +96,7 @@ namespace CoreEngine
         return m_natural_scale_factor;
     }
 
-    Mesh PathModel::GetMeshFromAi(const std::string& model_file_path, const aiMesh* mesh, const aiScene* scene, const glm::vec3& natural_scale) noexcept
+    Mesh PathModel::GetMeshFromAi(const std::string& model_file_path, const aiMesh* mesh, const aiScene* scene, const glm::vec3& natural_scale, MeshOptimizer::Statistics& out_optimization) noexcept
     {
         ENGINE_ASSERT(mesh && scene && "At PathModel::GetMeshFromAi(): Mesh and Scene must not be nullptr");
         //////////////////////////////////////////////// 
@@ -92,6 +129,9 @@ namespace CoreEngine
                 indices.push_back(face.mIndices[j]);
         }
 
+        //Vertex cache, overdraw & vertex fetch order. Assimp's JoinIdenticalVertices already removed the duplicates
+        out_optimization = MeshOptimizer::Optimize(vertices, indices);
+
         /////////////////////////////////////////////// 
         //--------- Load Material
         //////////////////////////////////////////////// 
@@ -161,19 +201,14 @@ namespace CoreEngine
                 if (texIndex >= 0 && texIndex < static_cast<int>(scene->mNumTextures))
                 {
                     const aiTexture* embedded_tex = scene->mTextures[texIndex];
-                    return std::make_shared<Texture>(embedded_tex);
+                    return TextureCache::Get().GetEmbedded(embedded_tex);
                 }
                 return nullptr;
             }
 
             const std::filesystem::path directory = std::filesystem::path(model_file_path).parent_path();
             const std::filesystem::path fullPath  = directory / local_path;
-            if (std::filesystem::exists(fullPath))
-            {
-                return std::make_shared<Texture>(fullPath.string().c_str());
-            }
-
-            return nullptr;
+            return TextureCache::Get().GetFromFile(fullPath.string());
         };
 
         material->m_base_texture               = LoadTexture(aiTextureType_BASE_COLOR);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/model/Model.h"
+#include "core/model/MeshOptimizer.h"
 
 namespace CoreEngine
 {
@@ -25,7 +26,11 @@ namespace CoreEngine
         std::string m_file_path;
         glm::vec3   m_natural_scale_factor;
 
-        [[nodiscard]] static Mesh GetMeshFromAi(const std::string& model_file_path, const aiMesh* mesh, const aiScene* scene, const glm::vec3& natural_scale) noexcept;
+        //Assimp import into m_mesh_vector, only on AssetManager cache misses
+        void ImportMeshes(const std::string& path, const glm::vec3& natural_scale) noexcept;
+
+        //Geometry is run through MeshOptimizer::Optimize(), its statistics go to out_optimization
+        [[nodiscard]] static Mesh GetMeshFromAi(const std::string& model_file_path, const aiMesh* mesh, const aiScene* scene, const glm::vec3& natural_scale, MeshOptimizer::Statistics& out_optimization) noexcept;
         [[nodiscard]] static std::shared_ptr<MaterialPBR> ExtractMaterial(const std::string& model_file_path, const aiMaterial* mesh, const aiScene* scene) noexcept;
     };
 
@@ -6,15 +6,23 @@ namespace CoreEngine
 {
     enum SSBO_BINDING : GLuint 
     {
-        IndirectDraw3D_TRANSFORM     = 0,
-        IndirectDraw3D_MATERIAL      = 1,
-        IndirectDraw3D_LIGHTS        = 2,
-        IndirectDraw3D_DRAW_INDICES  = 3
+        IndirectDraw3D_TRANSFORM       = 0,
+        IndirectDraw3D_MATERIAL        = 1,
+        IndirectDraw3D_LIGHTS          = 2,
+        IndirectDraw3D_DRAW_INDICES    = 3,
+        IndirectDraw3D_MESH_BOUNDS     = 4,
+        IndirectDraw3D_DRAW_TEMPLATES  = 5,
+        IndirectDraw3D_CULLED_COMMANDS = 6,
+        IndirectDraw3D_MESH_GEOMETRY   = 7,
+        IndirectDraw3D_VERTICES        = 8,
+        IndirectDraw3D_PACKED_VERTICES = 9,
+        IndirectDraw3D_GEOMETRY_DECODE = 10
     };
 
     enum UBO_BINDING : GLuint 
     {
         IndirectDraw3D_SSBO_SIZES = 1,
-        IndirectDraw3D_CAMERA     = 2
+        IndirectDraw3D_CAMERA     = 2,
+        IndirectDraw3D_CULL       = 3
     };
 }
\ No newline at end of file
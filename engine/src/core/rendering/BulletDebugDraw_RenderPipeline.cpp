@@ -1,4 +1,5 @@
 #include "core/rendering/BulletDebugDraw_RenderPipeline.h"
+#include "core/rendering/GpuProfiler.h"
 
 #include "core/utility/PhysicsUtility.h"
 
@@ -41,6 +42,9 @@ namespace CoreEngine
 
     void BulletDebugDraw_RenderPipeline::RenderAndClearData() noexcept
     {
+        // Includes the lines & points pipelines, their own GPU scopes are nested and skipped
+        ENGINE_PERFORMANCE_MEASURE_GPU_SCOPE_TIME("BulletDebugDraw Render()");
+
         glDisable(GL_DEPTH_TEST);
         //////////////////////////////////////////////// 
         //--------- Draw lines
@@ -1,14 +1,18 @@
 #include "core/rendering/DrawLines3D_RenderPipeline.h"
 
+#include "core/rendering/GpuProfiler.h"
+
+#include "core/utility/FrustumCulling.h"
 #include "core/utility/Performance.h"
 
+#include <algorithm>
+#include <array>
+
 namespace CoreEngine
 {
     DrawLines3D_RenderPipeline::DrawLines3D_RenderPipeline() noexcept
     : m_shader_program(s_VERTEX_SHADER_CODE, s_FRAGMENT_SHADER_CODE, Shader::ProvidedPointers::ARE_SOURCE_CODE) 
     {
-        m_vao.LinkAttribute(m_vbo, 0, 3, GL_FLOAT, sizeof(LineVertex), (void*)0);
-        m_vao.LinkAttribute(m_vbo, 1, 3, GL_FLOAT, sizeof(LineVertex), (void*)sizeof(glm::vec3));
         m_uniform_cam_matrix = glGetUniformLocation(m_shader_program.GetID(), "camera_matrix_uniform");
     }
 
@@ -17,15 +21,15 @@ namespace CoreEngine
         glProgramUniformMatrix4fv(m_shader_program.GetID(), m_uniform_cam_matrix, 1, GL_FALSE, &matrix[0][0]);
     }
 
-    void DrawLines3D_RenderPipeline::SetLineData(const std::vector<glm::vec3>& line_vertex_positions, const glm::vec3& line_color) noexcept
+    void DrawLines3D_RenderPipeline::SetLineData(std::span<const glm::vec3> line_vertex_positions, const glm::vec3& line_color) noexcept
     {
-        std::vector<LineVertex> lines;
-        lines.reserve(line_vertex_positions.size());
+        // Written in place, the capacity of the last frame is reused
+        m_line_vertices.clear();
+        m_line_vertices.reserve(line_vertex_positions.size());
         for (const glm::vec3& pos : line_vertex_positions)
         {
-            lines.emplace_back(pos, line_color);
+            m_line_vertices.emplace_back(pos, line_color);
         }
-        SetLineData(std::move(lines));
     }
 
     void DrawLines3D_RenderPipeline::SetLineData(std::vector<LineVertex>&& line_vertices) noexcept
@@ -36,21 +40,39 @@ namespace CoreEngine
     void DrawLines3D_RenderPipeline::SetCameraMatrixAndFrustumCull(const glm::mat4& view_projection) noexcept
     {
         SetCameraMatrix(view_projection);
-        size_t lines_culled_count {0};
 
-        //Backwards iteration required
-        for (size_t i = m_line_vertices.size(); i >= 2; i -= 2)
-        {
-            size_t idx = i - 2;
-            const MathUtility::Line line{ m_line_vertices[idx].m_position, m_line_vertices[idx+1].m_position };
-            if (! MathUtility::LineIsInFrustum(MathUtility::ExtractProjectionPlanesFromVP(view_projection), line))
+        const FrustumCulling::NormalizedPlanes planes = FrustumCulling::ExtractNormalizedPlanes(view_projection);
+        const size_t amount_lines = m_line_vertices.size() / 2;
+
+        //Every batch compacts its own range in place, the ranges are joined afterwards - the line order is kept
+        std::array<size_t, FrustumCulling::MAX_WORKERS + 1> batch_begin {};
+        std::array<size_t, FrustumCulling::MAX_WORKERS + 1> batch_kept  {};
+        auto cull_batch = [&](size_t begin_line, size_t end_line, size_t batch_index) {
+            size_t write_idx = begin_line * 2;
+            for (size_t line = begin_line; line < end_line; line++)
             {
-                m_line_vertices.erase(m_line_vertices.begin() + idx, m_line_vertices.begin() + idx + 2);
-                lines_culled_count++;
+                const size_t idx = line * 2;
+                if (FrustumCulling::LineIsInFrustum(planes, m_line_vertices[idx].m_position, m_line_vertices[idx + 1].m_position))
+                {
+                    m_line_vertices[write_idx]     = m_line_vertices[idx];
+                    m_line_vertices[write_idx + 1] = m_line_vertices[idx + 1];
+                    write_idx += 2;
+                }
             }
+            batch_begin[batch_index] = begin_line * 2;
+            batch_kept[batch_index]  = write_idx - begin_line * 2;
+        };
+        const size_t amount_batches = FrustumCulling::RunBatches(amount_lines, cull_batch);
+
+        size_t amount_kept = batch_kept[0];
+        for (size_t b = 1; b < amount_batches; b++)
+        {
+            std::copy_n(m_line_vertices.begin() + batch_begin[b], batch_kept[b], m_line_vertices.begin() + amount_kept);
+            amount_kept += batch_kept[b];
         }
+        m_line_vertices.resize(amount_kept);
 
-        ENGINE_PERFORMANCE_LOG_OCCURENCE("Line Frustum Culled: ", lines_culled_count);
+        ENGINE_PERFORMANCE_LOG_OCCURENCE("Line Frustum Culled: ", amount_lines - amount_kept / 2);
     }
 
     void DrawLines3D_RenderPipeline::ClearAllLines() noexcept
@@ -60,12 +82,26 @@ namespace CoreEngine
 
     void DrawLines3D_RenderPipeline::Render() noexcept
     {
-        m_vbo.SetNewData(m_line_vertices.data(), static_cast<GLuint>(m_line_vertices.size() * sizeof(LineVertex)));
+        ENGINE_PERFORMANCE_MEASURE_GPU_SCOPE_TIME("DrawLines3D Render()");
+
+        if (m_line_vertices.empty())
+            return;
+
+        m_vertex_stream.Write(m_line_vertices.data(), m_line_vertices.size() * sizeof(LineVertex));
+        if (m_vertex_stream.GetID() != m_linked_stream_id)
+        {
+            m_vao.LinkAttribute(m_vertex_stream, 0, 3, GL_FLOAT, sizeof(LineVertex), (void*)0);
+            m_vao.LinkAttribute(m_vertex_stream, 1, 3, GL_FLOAT, sizeof(LineVertex), (void*)sizeof(glm::vec3));
+            m_linked_stream_id = m_vertex_stream.GetID();
+        }
 
         m_vao.Bind();
         m_shader_program.Activate();
 
-        glDrawArrays(GL_LINES, 0, m_line_vertices.size());
+        //Regions start at multiples of the vertex size
+        const GLint first_vertex = static_cast<GLint>(m_vertex_stream.GetCurrentOffset() / static_cast<GLintptr>(sizeof(LineVertex)));
+        glDrawArrays(GL_LINES, first_vertex, m_line_vertices.size());
+        m_vertex_stream.FenceCurrentRegion();
 
         m_vao.Unbind();
         m_shader_program.Deactivate();
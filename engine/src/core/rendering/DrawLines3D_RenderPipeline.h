@@ -6,6 +6,8 @@
 #include "core/rendering/RenderBuffers.h"
 #include "core/rendering/Shader.h"
 
+#include <span>
+
 namespace CoreEngine
 {
     class DrawLines3D_RenderPipeline
@@ -30,7 +32,7 @@ namespace CoreEngine
         }
 
         void SetCameraMatrix(const glm::mat4& matrix) noexcept;
-        void SetLineData(const std::vector<glm::vec3>& line_vertex_positions, const glm::vec3& line_color) noexcept;
+        void SetLineData(std::span<const glm::vec3> line_vertex_positions, const glm::vec3& line_color) noexcept;
         void SetLineData(std::vector<LineVertex>&& line_vertices) noexcept;
         void SetCameraMatrixAndFrustumCull(const glm::mat4& view_projection) noexcept;
         void ClearAllLines() noexcept;
@@ -44,10 +46,11 @@ namespace CoreEngine
         ~DrawLines3D_RenderPipeline() noexcept = default;
 
     //////////////////////////////////////////////// 
-    //---------  Move is allowed
+    //---------  Move policy
     ////////////////////////////////////////////////
-        explicit DrawLines3D_RenderPipeline(DrawLines3D_RenderPipeline&&)  noexcept  = default;
-        DrawLines3D_RenderPipeline& operator=(DrawLines3D_RenderPipeline&&) noexcept = default;
+        // Not movable, the GL objects (VAO, stream) aren't
+        DrawLines3D_RenderPipeline(DrawLines3D_RenderPipeline&&)            = delete;
+        DrawLines3D_RenderPipeline& operator=(DrawLines3D_RenderPipeline&&) = delete;
 
     protected:
         #ifdef __INTELLISENSE__
@@ -65,8 +68,9 @@ namespace CoreEngine
 
         Shader  m_shader_program;
 
-        VBO     m_vbo;
-        VAO     m_vao;
+        StreamingBuffer m_vertex_stream {sizeof(LineVertex)};
+        GLuint          m_linked_stream_id {0}; // Attributes are relinked whenever the stream grew
+        VAO             m_vao;
 
         GLint m_uniform_cam_matrix  = -1;
 
@@ -1,25 +1,25 @@
 #include "core/rendering/DrawPoints3D_RenderPipeline.h"
 
+#include "core/rendering/GpuProfiler.h"
+
 namespace CoreEngine
 {
     DrawPoints3D_RenderPipeline::DrawPoints3D_RenderPipeline() noexcept
     : m_shader_program(s_VERTEX_SHADER_CODE, s_FRAGMENT_SHADER_CODE, Shader::ProvidedPointers::ARE_SOURCE_CODE) 
     {
-        m_vao.LinkAttribute(m_vbo, 0, 3, GL_FLOAT, sizeof(PointVertex), (void*)0);
-        m_vao.LinkAttribute(m_vbo, 1, 3, GL_FLOAT, sizeof(PointVertex), (void*)sizeof(glm::vec3));
         m_uniform_cam_matrix  = glGetUniformLocation(m_shader_program.GetID(), "camera_matrix_uniform");
         glEnable(GL_PROGRAM_POINT_SIZE);
     }
 
-    void DrawPoints3D_RenderPipeline::SetPoints(const std::vector<glm::vec3>& points, const glm::vec3& color) noexcept
+    void DrawPoints3D_RenderPipeline::SetPoints(std::span<const glm::vec3> points, const glm::vec3& color) noexcept
     { 
-        std::vector<PointVertex> point_vertices;
-        point_vertices.reserve(points.size());
+        // Written in place, the capacity of the last frame is reused
+        m_point_vertices.clear();
+        m_point_vertices.reserve(points.size());
         for (const glm::vec3& pos : points)
         {
-            point_vertices.emplace_back(pos, color);
+            m_point_vertices.emplace_back(pos, color);
         }
-        SetPoints(std::move(point_vertices));
     }
 
     void DrawPoints3D_RenderPipeline::SetPoints(std::vector<PointVertex>&& points) noexcept
@@ -39,12 +39,26 @@ namespace CoreEngine
 
     void DrawPoints3D_RenderPipeline::Render() noexcept
     {
-        m_vbo.SetNewData(m_point_vertices.data(), static_cast<GLuint>(m_point_vertices.size() * sizeof(PointVertex)));
+        ENGINE_PERFORMANCE_MEASURE_GPU_SCOPE_TIME("DrawPoints3D Render()");
+
+        if (m_point_vertices.empty())
+            return;
+
+        m_vertex_stream.Write(m_point_vertices.data(), m_point_vertices.size() * sizeof(PointVertex));
+        if (m_vertex_stream.GetID() != m_linked_stream_id)
+        {
+            m_vao.LinkAttribute(m_vertex_stream, 0, 3, GL_FLOAT, sizeof(PointVertex), (void*)0);
+            m_vao.LinkAttribute(m_vertex_stream, 1, 3, GL_FLOAT, sizeof(PointVertex), (void*)sizeof(glm::vec3));
+            m_linked_stream_id = m_vertex_stream.GetID();
+        }
 
         m_vao.Bind();
         m_shader_program.Activate();
 
-        glDrawArrays(GL_POINTS, 0, m_point_vertices.size());
+        //Regions start at multiples of the vertex size
+        const GLint first_vertex = static_cast<GLint>(m_vertex_stream.GetCurrentOffset() / static_cast<GLintptr>(sizeof(PointVertex)));
+        glDrawArrays(GL_POINTS, first_vertex, m_point_vertices.size());
+        m_vertex_stream.FenceCurrentRegion();
 
         m_vao.Unbind();
         m_shader_program.Deactivate();
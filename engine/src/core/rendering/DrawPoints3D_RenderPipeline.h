@@ -5,6 +5,8 @@
 #include "core/rendering/RenderBuffers.h"
 #include "core/rendering/Shader.h"
 
+#include <span>
+
 namespace CoreEngine
 {
     class DrawPoints3D_RenderPipeline
@@ -27,13 +29,17 @@ namespace CoreEngine
             m_point_vertices.emplace_back(std::forward<Args>(args)...);
         }
         
-        void SetPoints(const std::vector<glm::vec3>& points, const glm::vec3& color) noexcept;
+        void SetPoints(std::span<const glm::vec3> points, const glm::vec3& color) noexcept;
         void SetPoints(std::vector<PointVertex>&& points) noexcept;
         void SetCameraMatrix(const glm::mat4& cam_matrix) noexcept;
         void ClearAllPoints() noexcept;
         
         void Render() noexcept;
 
+        // Not movable, the GL objects (VAO, stream) aren't
+        DrawPoints3D_RenderPipeline(DrawPoints3D_RenderPipeline&&)            = delete;
+        DrawPoints3D_RenderPipeline& operator=(DrawPoints3D_RenderPipeline&&) = delete;
+
     protected:
         #ifdef __INTELLISENSE__
             static constexpr char s_VERTEX_SHADER_CODE[]   = {};
@@ -50,8 +56,9 @@ namespace CoreEngine
 
         Shader  m_shader_program;
 
-        VBO     m_vbo;
-        VAO     m_vao;
+        StreamingBuffer m_vertex_stream {sizeof(PointVertex)};
+        GLuint          m_linked_stream_id {0}; // Attributes are relinked whenever the stream grew
+        VAO             m_vao;
 
         GLint m_uniform_cam_matrix  = -1;
 
@@ -1,5 +1,7 @@
 #include "core/rendering/FlatQuadImage_RenderPipeline.h"
 
+#include "core/rendering/GpuProfiler.h"
+
 namespace CoreEngine
 {
     FlatQuadImage_RenderPipeline::FlatQuadImage_RenderPipeline(const char* texture_path, const std::array<GLfloat, 24>& custom_quad) noexcept
@@ -27,6 +29,8 @@ namespace CoreEngine
         {   
             return;
         }
+        ENGINE_PERFORMANCE_MEASURE_GPU_SCOPE_TIME("FlatQuadImage Render()");
+
     //--------- For 2D no depth
         glDisable(GL_DEPTH_TEST);
 
@@ -0,0 +1,176 @@
+#include "core/rendering/GpuProfiler.h"
+
+#include "glad/gl.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace CoreEngine
+{
+namespace
+{
+    struct PendingQuery
+    {
+        GLuint                 m_query        = 0;
+        ScopeProfiler::ScopeId m_scope_id     = 0;
+        int64_t                m_cpu_begin_ns = 0;
+        uint64_t               m_frame        = 0;
+    };
+
+    // Main thread only, like everything touching GL
+    struct ContextState
+    {
+        uint32_t m_tag              = 0;
+        bool     m_is_available     = false;
+        bool     m_query_is_active  = false;
+        uint64_t m_frame            = 0;
+        size_t   m_amount_queries   = 0;
+        uint64_t m_skipped_scopes   = 0;
+        int64_t  m_last_readback_ns = 0;
+        std::vector<GLuint>       m_free_queries;
+        std::vector<PendingQuery> m_pending; // Submission order
+    };
+
+    std::vector<std::unique_ptr<ContextState>> g_contexts;
+    ContextState* g_current_context = nullptr; // Of the window being rendered
+
+    [[nodiscard]] ContextState& GetOrCreateContext(uint32_t tag) noexcept
+    {
+        for (std::unique_ptr<ContextState>& context : g_contexts)
+        {
+            if (context->m_tag == tag) return *context;
+        }
+
+        std::unique_ptr<ContextState> context = std::make_unique<ContextState>();
+        context->m_tag = tag;
+
+        GLint counter_bits = 0;
+        glGetQueryiv(GL_TIME_ELAPSED, GL_QUERY_COUNTER_BITS, &counter_bits);
+        context->m_is_available = counter_bits > 0;
+
+        context->m_free_queries.reserve(GpuProfiler::MAX_QUERIES_PER_CONTEXT);
+        context->m_pending.reserve(GpuProfiler::MAX_QUERIES_PER_CONTEXT);
+
+        g_contexts.push_back(std::move(context));
+        return *g_contexts.back();
+    }
+
+    void ReadBackFinishedQueries(ContextState& context) noexcept
+    {
+        size_t amount_done = 0;
+        int64_t readback_ns = 0;
+        for (const PendingQuery& pending : context.m_pending)
+        {
+            if (pending.m_frame + GpuProfiler::READBACK_DELAY_FRAMES > context.m_frame)
+                break;
+
+            GLint is_available = GL_FALSE;
+            glGetQueryObjectiv(pending.m_query, GL_QUERY_RESULT_AVAILABLE, &is_available);
+            // Results become available in submission order, nothing behind this one is ready either
+            if (is_available == GL_FALSE)
+                break;
+
+            GLuint64 elapsed_ns = 0;
+            glGetQueryObjectui64v(pending.m_query, GL_QUERY_RESULT, &elapsed_ns);
+
+            ScopeProfiler::Record(ScopeProfiler::ScopeEvent{ pending.m_cpu_begin_ns, pending.m_cpu_begin_ns + static_cast<int64_t>(elapsed_ns),
+                0.0, context.m_tag, pending.m_scope_id, ScopeProfiler::EventKind::GPU });
+
+            readback_ns += static_cast<int64_t>(elapsed_ns);
+            context.m_free_queries.push_back(pending.m_query);
+            amount_done++;
+        }
+
+        context.m_pending.erase(context.m_pending.begin(), context.m_pending.begin() + static_cast<std::ptrdiff_t>(amount_done));
+        if (amount_done > 0)
+            context.m_last_readback_ns = readback_ns;
+    }
+}
+    ////////////////////////////////////////////////
+    //--------- Scopes
+    ////////////////////////////////////////////////
+    GpuProfiler::ScopeGuard::ScopeGuard(ScopeProfiler::ScopeId scope_id) noexcept
+    {
+        ContextState* context = g_current_context;
+        if (! context || ! context->m_is_available || ! ScopeProfiler::GetIsEnabled())
+            return;
+
+        // Nested, the outer scope includes this work
+        if (context->m_query_is_active)
+            return;
+
+        GLuint query = 0;
+        if (! context->m_free_queries.empty())
+        {
+            query = context->m_free_queries.back();
+            context->m_free_queries.pop_back();
+        }
+        else if (context->m_amount_queries < MAX_QUERIES_PER_CONTEXT)
+        {
+            glGenQueries(1, &query);
+            context->m_amount_queries++;
+        }
+        else
+        {
+            context->m_skipped_scopes++;
+            return;
+        }
+
+        context->m_pending.push_back(PendingQuery{ query, scope_id, ScopeProfiler::NowNanoSeconds(), context->m_frame });
+        context->m_query_is_active = true;
+        m_is_recording = true;
+        glBeginQuery(GL_TIME_ELAPSED, query);
+    }
+
+    GpuProfiler::ScopeGuard::~ScopeGuard() noexcept
+    {
+        if (! m_is_recording)
+            return;
+
+        glEndQuery(GL_TIME_ELAPSED);
+        if (g_current_context)
+            g_current_context->m_query_is_active = false;
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Frames & contexts
+    ////////////////////////////////////////////////
+    void GpuProfiler::BeginFrame(uint32_t tag) noexcept
+    {
+        ContextState& context = GetOrCreateContext(tag);
+        context.m_frame++;
+        g_current_context = &context;
+
+        if (context.m_is_available)
+            ReadBackFinishedQueries(context);
+    }
+
+    void GpuProfiler::OnContextDestroyed(uint32_t tag) noexcept
+    {
+        const auto it = std::find_if(g_contexts.begin(), g_contexts.end(), [tag](const std::unique_ptr<ContextState>& context) { return context->m_tag == tag; });
+        if (it == g_contexts.end())
+            return;
+
+        ContextState& context = **it;
+        for (const PendingQuery& pending : context.m_pending)
+            context.m_free_queries.push_back(pending.m_query);
+        if (! context.m_free_queries.empty())
+            glDeleteQueries(static_cast<GLsizei>(context.m_free_queries.size()), context.m_free_queries.data());
+
+        if (g_current_context == &context)
+            g_current_context = nullptr;
+        g_contexts.erase(it);
+    }
+
+    std::vector<GpuProfiler::ContextStatistics> GpuProfiler::GetContextStatistics() noexcept
+    {
+        std::vector<ContextStatistics> statistics;
+        statistics.reserve(g_contexts.size());
+        for (const std::unique_ptr<ContextState>& context : g_contexts)
+        {
+            statistics.push_back(ContextStatistics{ context->m_tag, context->m_is_available, static_cast<float>(context->m_last_readback_ns) * 1e-3f,
+                context->m_amount_queries, context->m_pending.size(), context->m_skipped_scopes });
+        }
+        return statistics;
+    }
+}
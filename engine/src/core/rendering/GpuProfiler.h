@@ -0,0 +1,67 @@
+#pragma once
+
+#include "core/utility/Performance.h"
+
+#include <cstdint>
+#include <vector>
+
+////////////////////////////////////////////////
+//--------- GPU scope profiling
+////////////////////////////////////////////////
+// Like ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME, but measures the GPU time of the GL commands issued inside the scope.
+// Main thread only, between Window::BeginFrame() and the next window's BeginFrame(); tagged with that window's handle.
+// GL_TIME_ELAPSED queries can't nest: a GPU scope inside another one is skipped, the outer one includes its work.
+#ifndef ENGINE_DISABLE_PROFILER
+    #define ENGINE_PERFORMANCE_MEASURE_GPU_SCOPE_TIME(name) \
+        static const ::CoreEngine::ScopeProfiler::ScopeId ENGINE_PERFORMANCE_CONCAT(gpu_profiler_scope_id_, __LINE__) = ::CoreEngine::ScopeProfiler::RegisterScope(name); \
+        const ::CoreEngine::GpuProfiler::ScopeGuard ENGINE_PERFORMANCE_CONCAT(gpu_profiler_scope_guard_, __LINE__) (ENGINE_PERFORMANCE_CONCAT(gpu_profiler_scope_id_, __LINE__))
+#else
+    #define ENGINE_PERFORMANCE_MEASURE_GPU_SCOPE_TIME(name) static_cast<void>(0)
+#endif
+
+namespace CoreEngine
+{
+    ////////////////////////////////////////////////
+    //--------- GPU times
+    ////////////////////////////////////////////////
+    // Pooled GL_TIME_ELAPSED queries, one pool per GL context (= window). Results are polled READBACK_DELAY_FRAMES frames
+    // after submission and only if available, so reading them never stalls the pipeline; they are recorded into the
+    // ScopeProfiler as EventKind::GPU events and show up in its statistics & traces next to the CPU scopes, late by the delay.
+    // Works on any GL 3.3+ context including software ones (llvmpipe), which report CPU time spent rasterizing.
+    class GpuProfiler final
+    {
+    public:
+        static constexpr uint64_t READBACK_DELAY_FRAMES   = 3;
+        static constexpr size_t   MAX_QUERIES_PER_CONTEXT = 256; // Scopes beyond are skipped until queries come back
+
+        class ScopeGuard
+        {
+        public:
+            explicit ScopeGuard(ScopeProfiler::ScopeId scope_id) noexcept;
+            ~ScopeGuard() noexcept;
+
+            ScopeGuard(const ScopeGuard&)            = delete;
+            ScopeGuard& operator=(const ScopeGuard&) = delete;
+
+        private:
+            bool m_is_recording = false;
+        };
+
+        struct ContextStatistics
+        {
+            uint32_t m_tag              = 0;     // Window handle
+            bool     m_is_available     = false; // GL_QUERY_COUNTER_BITS of GL_TIME_ELAPSED > 0
+            float    m_last_readback_us = 0.0f;  // GPU time of all scopes read back at the last BeginFrame(), usually one frame
+            size_t   m_amount_queries   = 0;     // Created
+            size_t   m_amount_pending   = 0;     // Waiting for their result
+            uint64_t m_skipped_scopes   = 0;     // Pool exhausted, nested scopes don't count
+        };
+
+        // Main thread, with the window's context current. Called by Window::BeginFrame() and on context destruction.
+        static void BeginFrame(uint32_t tag) noexcept;
+        static void OnContextDestroyed(uint32_t tag) noexcept;
+
+        // Main thread only
+        [[nodiscard]] static std::vector<ContextStatistics> GetContextStatistics() noexcept;
+    };
+}
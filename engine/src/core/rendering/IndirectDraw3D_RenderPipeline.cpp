@@ -1,32 +1,67 @@
 #include "core/rendering/IndirectDraw3D_RenderPipeline.h"
 
 #include "core/rendering/BindingPoints.h"
+#include "core/rendering/GpuProfiler.h"
+#include "core/rendering/TextureCache.h"
 
 #include "core/utility/Assert.h"
+#include "core/utility/FrameArena.h"
 #include "core/utility/MathUtility.h"
 #include "core/utility/Performance.h"
 
+#include <algorithm>
+#include <string_view>
+
 namespace CoreEngine
 {
+namespace
+{
+    [[nodiscard]] std::string_view AsBytes(const auto& vec) noexcept
+    {
+        return std::string_view(reinterpret_cast<const char*>(vec.data()), vec.size() * sizeof(vec[0]));
+    }
+
+    //Packed meshes released their full vertices, the packed ones are what gets uploaded anyway
+    [[nodiscard]] std::string_view VertexBytes(const MeshData& data) noexcept
+    {
+        return data.m_packed_vertices.empty() ? AsBytes(data.m_vertices) : AsBytes(data.m_packed_vertices);
+    }
+
+    [[nodiscard]] size_t HashMeshContent(const MeshData& data) noexcept
+    {
+        const size_t vertices_hash = std::hash<std::string_view>{}(VertexBytes(data));
+        const size_t indices_hash  = std::hash<std::string_view>{}(AsBytes(data.m_indices));
+        return vertices_hash ^ (indices_hash + 0x9e3779b97f4a7c15ull + (vertices_hash << 6) + (vertices_hash >> 2));
+    }
+
+    //Packed positions are relative to the mesh bounds, so those have to match as well
+    [[nodiscard]] bool MeshContentEquals(const MeshData& a, const MeshData& b) noexcept
+    {
+        return a.m_packed_vertices.empty() == b.m_packed_vertices.empty()
+            && VertexBytes(a) == VertexBytes(b) && AsBytes(a.m_indices) == AsBytes(b.m_indices)
+            && a.m_packed_position_min == b.m_packed_position_min && a.m_packed_position_extent == b.m_packed_position_extent;
+    }
+}
     IndirectDraw3D_RenderPipeline::IndirectDraw3D_RenderPipeline() noexcept
-    :   m_shader_program(s_VERTEX_SHADER_CODE, s_FRAGMENT_SHADER_CODE, Shader::ProvidedPointers::ARE_SOURCE_CODE),
+    :   m_culling_mode(GpuCullingIsSupported() ? CullingMode::GPU : CullingMode::CPU),
+        m_shader_program(s_VERTEX_SHADER_CODE, s_FRAGMENT_SHADER_CODE, Shader::ProvidedPointers::ARE_SOURCE_CODE),
+        m_cull_shader_program(s_CULL_COMPUTE_SHADER_CODE, Shader::ProvidedPointers::ARE_SOURCE_CODE),
         m_ssbo_sizes_ubo(nullptr, sizeof(SSBO_SizesData), UBO_BINDING::IndirectDraw3D_SSBO_SIZES),
-        m_camera_ubo(nullptr, sizeof(CameraRenderData), UBO_BINDING::IndirectDraw3D_CAMERA)
+        m_camera_ubo(nullptr, sizeof(CameraRenderData), UBO_BINDING::IndirectDraw3D_CAMERA),
+        m_cull_ubo(nullptr, sizeof(CullData), UBO_BINDING::IndirectDraw3D_CULL)
     {   
-        m_vao.Bind();
-        m_ebo.Bind();
-
-        m_vao.LinkAttribute(m_vbo, 0, 3, GL_FLOAT, sizeof(Vertex), (void*)0);
-        m_vao.LinkAttribute(m_vbo, 1, 3, GL_FLOAT, sizeof(Vertex), (void*)(3 * sizeof(float)));
-        m_vao.LinkAttribute(m_vbo, 2, 2, GL_FLOAT, sizeof(Vertex), (void*)(6 * sizeof(float)));
-
-        m_ebo.Unbind();
+        LinkGeometryBuffers();
+        //Sets the binding points of the per-slot & per-geometry SSBOs
+        ReallocateSlotBuffers();
+        RebuildInstanceRegions();
 
         SetSceneData({}, {});
     }
 
     void IndirectDraw3D_RenderPipeline::Render() noexcept
     {
+        ENGINE_PERFORMANCE_MEASURE_GPU_SCOPE_TIME("IndirectDraw3D Render()");
+
     //------------------- Depth Testing for 3D
         glDepthMask(GL_TRUE); 
         glEnable(GL_DEPTH_TEST);
@@ -42,213 +77,739 @@ namespace CoreEngine
         glCullFace(GL_BACK);
         glEnable(GL_CULL_FACE);
 
+        //Nothing visible, or nothing written yet: a stream has no buffer to bind before its first write
+        if (m_draw_command_count == 0 || m_mesh_transform_stream.GetID() == 0)
+            return;
+        if (m_culling_mode == CullingMode::CPU && (m_draw_command_stream.GetID() == 0 || m_instance_stream.GetID() == 0))
+            return;
+
     //-------------------  Bind buffers
-        m_indirect_command_buffer.Bind();
-        m_vao.Bind();  //VAO binds VBO and EBO implicitly already
+        m_vao.Bind();  //VAO binds the EBO, the vertices are pulled from the VBOs in the vertex shader
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SSBO_BINDING::IndirectDraw3D_VERTICES, m_vbo.GetID());
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SSBO_BINDING::IndirectDraw3D_PACKED_VERTICES, m_packed_vbo.GetID());
+        m_geometry_decode_ssbo.BindBase();
+        m_mesh_geometries_ssbo.BindBase();
         m_camera_ubo.BindBase();
 
-        m_active_draw_indices_ssbo.BindBase();
-        m_mesh_transform_ssbo.BindBase();
+        if (m_culling_mode == CullingMode::GPU) { m_active_draw_indices_ssbo.BindBase(); }
+        else                                    { m_instance_stream.BindRange(GL_SHADER_STORAGE_BUFFER, SSBO_BINDING::IndirectDraw3D_DRAW_INDICES); }
+        m_mesh_transform_stream.BindRange(GL_SHADER_STORAGE_BUFFER, SSBO_BINDING::IndirectDraw3D_TRANSFORM);
         m_texture_indices_ssbo.BindBase();
         m_light_ssbo.BindBase();
 
         m_shader_program.Activate();
 
-        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, m_draw_command_count, 0);
+        if (m_culling_mode == CullingMode::GPU)
+        {
+            //Instance counts written by the cull in UpdateModelTransforms(), never read back to the CPU
+            m_indirect_command_buffer.Bind();
+            glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, m_draw_command_count, 0);
+        }
+        else
+        {
+            m_draw_command_stream.Bind(GL_DRAW_INDIRECT_BUFFER);
+            glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<const void*>(m_draw_command_stream.GetCurrentOffset()), m_draw_command_count, 0);
+            m_draw_command_stream.FenceCurrentRegion();
+            m_instance_stream.FenceCurrentRegion();
+        }
+        m_mesh_transform_stream.FenceCurrentRegion();
 
     //------------------- Unbind buffers to avoid other pipelines modifying them
         m_shader_program.Deactivate();
         
-        m_indirect_command_buffer.Unbind();
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
         m_vao.Unbind();
         m_camera_ubo.Unbind();
 
     }
 
-    void IndirectDraw3D_RenderPipeline::SetSceneData(const std::vector<Basic_Model*>& model_vec, const std::vector<Light>& lights_vec) noexcept
+    void IndirectDraw3D_RenderPipeline::SetSceneData(std::span<Basic_Model* const> model_vec, const std::vector<Light>& lights_vec) noexcept
     {
-    //------------------ Calcualting these up front to avoid resizing later
-        size_t amount_meshes   {};
-        size_t amount_vertices {};
-        size_t amount_indices  {};
+        ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("IndirectDraw3D SetSceneData()");
+        m_scene_counter++;
+
+    //------------------ Keep unchanged models, collect the new & re-meshed ones
+        std::pmr::vector<Basic_Model*> models_to_add (&FrameArena::GetThreadLocal());
+        for (Basic_Model* model_ptr : model_vec)
+        {
+            const auto record_it = m_model_record_indices.find(model_ptr);
+            if (record_it != m_model_record_indices.end() && ! m_model_records[record_it->second].IsStale())
+            {
+                m_model_records[record_it->second].m_last_seen_scene = m_scene_counter;
+            }
+            else
+            {
+                models_to_add.push_back(model_ptr);
+            }
+        }
+
+    //------------------ Remove what wasn't seen, backwards as removing moves the last record into the gap
+        for (size_t i = m_model_records.size(); i-- > 0;)
+        {
+            if (m_model_records[i].m_last_seen_scene != m_scene_counter)
+            {
+                RemoveModelMeshes(i);
+            }
+        }
+
+    //------------------ Calcualting this up front, so the slot buffers grow at most once. Not the geometry, repeated meshes share it
+        size_t amount_meshes {};
+        for (const Basic_Model* model_ptr : models_to_add)
+        {
+            amount_meshes += model_ptr->GetMeshVectorConstReference().size();
+        }
+        if (amount_meshes > m_free_mesh_slots.size())
+        {
+            EnsureMeshSlotCapacity(m_mesh_transforms.size() + amount_meshes - m_free_mesh_slots.size());
+        }
+
+        for (Basic_Model* model_ptr : models_to_add)
+        {
+            if (! m_model_record_indices.contains(model_ptr))
+            {
+                AddModelMeshes(model_ptr);
+            }
+        }
+
+        UpdateMovedMeshes();
+        FinishSceneChange();
+        SetLightData(lights_vec);
+    }
+
+    bool IndirectDraw3D_RenderPipeline::AddModel(Basic_Model* model_ptr) noexcept
+    {
+        if (m_model_record_indices.contains(model_ptr))
+            return false;
+
+        AddModelMeshes(model_ptr);
+        FinishSceneChange();
+        return true;
+    }
+
+    bool IndirectDraw3D_RenderPipeline::RemoveModel(const Basic_Model* model_ptr) noexcept
+    {
+        const auto record_it = m_model_record_indices.find(model_ptr);
+        if (record_it == m_model_record_indices.end())
+            return false;
+
+        RemoveModelMeshes(record_it->second);
+        FinishSceneChange();
+        return true;
+    }
+
+    void IndirectDraw3D_RenderPipeline::UpdateModelTransforms(std::span<Basic_Model* const> model_vec, const glm::mat4& view_projection) noexcept
+    {
+        size_t amount_meshes {0};
         for (const Basic_Model* model_ptr : model_vec)
         {
-            const std::vector<Mesh>& meshes = model_ptr->GetMeshVectorConstReference();
-            amount_meshes += meshes.size();
-            for (const Mesh& mesh : meshes)
+            amount_meshes += model_ptr->GetMeshVectorConstReference().size();
+        }
+
+        ENGINE_ASSERT (GetAmountInstances() == amount_meshes && 
+        "At IndirectDraw3D::UpdateModelTransforms(): May only be called if no models where added / removed since last call to SetSceneData().");
+
+        //Textures that finished loading replace the 0 handles in the material data
+        const uint64_t texture_generation = TextureCache::Get().GetGeneration();
+        if (texture_generation != m_seen_texture_generation && ! m_material_ptrs.empty())
+        {
+            m_seen_texture_generation = texture_generation;
+            MarkSlotDirty(0);
+            MarkSlotDirty(static_cast<GLuint>(m_material_ptrs.size() - 1));
+            FlushDirtySlots();
+        }
+
+        if (m_culling_mode == CullingMode::GPU) { UpdateModelTransformsGPU(view_projection); }
+        else                                    { UpdateModelTransformsCPU(view_projection); }
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Scene changes
+    ////////////////////////////////////////////////
+    bool IndirectDraw3D_RenderPipeline::ModelRecord::IsStale() const noexcept
+    {
+        const std::vector<Mesh>& meshes = m_model_ptr->GetMeshVectorConstReference();
+        return meshes.data() != m_meshes_data || meshes.size() != m_mesh_slots.size();
+    }
+
+    void IndirectDraw3D_RenderPipeline::AddModelMeshes(Basic_Model* model_ptr) noexcept
+    {
+        std::vector<Mesh>& meshes = model_ptr->GetMeshVectorReference();
+        const glm::mat4 model_matrix = model_ptr->GetModelMatrix();
+
+        ModelRecord record;
+        record.m_model_ptr       = model_ptr;
+        record.m_meshes_data     = meshes.data();
+        record.m_last_seen_scene = m_scene_counter;
+        record.m_mesh_slots.reserve(meshes.size());
+
+        for (Mesh& mesh : meshes)
+        {
+            ENGINE_ASSERT(mesh.GetMaterialSharedPtr() && "At IndirectDraw3D::AddModelMeshes(): Mesh should have a non null material ptr.");
+
+            const GLuint slot     = AllocateMeshSlot();
+            const GLuint geometry = AcquireGeometry(mesh);
+
+            std::vector<GLuint>& instance_slots = m_geometries[geometry].m_instance_slots;
+            m_slot_geometries[slot]       = geometry;
+            m_slot_instance_indices[slot] = static_cast<GLuint>(instance_slots.size());
+            instance_slots.push_back(slot);
+
+            m_mesh_transforms[slot]  = model_matrix;
+            m_material_ptrs[slot]    = mesh.GetMaterialSharedPtr();
+            m_mesh_local_aabbs[slot] = MathUtility::AABB(mesh.GetLocalAABBHalfExtents(), mesh.GetLocalCenter());
+            m_mesh_world_aabbs.Set(slot, MathUtility::AABB::CreateWorldSpaceAABB(model_matrix, mesh.GetLocalAABBHalfExtents(), mesh.GetLocalCenter()));
+
+            MarkSlotDirty(slot);
+            record.m_mesh_slots.push_back(slot);
+        }
+        m_instances_changed = true;
+
+        m_model_record_indices.emplace(model_ptr, m_model_records.size());
+        m_model_records.push_back(std::move(record));
+    }
+
+    void IndirectDraw3D_RenderPipeline::RemoveModelMeshes(size_t record_index) noexcept
+    {
+        ModelRecord& record = m_model_records[record_index];
+        for (const GLuint slot : record.m_mesh_slots)
+        {
+            //Swap & pop out of the geometry's instances
+            const GLuint geometry = m_slot_geometries[slot];
+            std::vector<GLuint>& instance_slots = m_geometries[geometry].m_instance_slots;
+            const GLuint moved_slot = instance_slots.back();
+            instance_slots[m_slot_instance_indices[slot]] = moved_slot;
+            m_slot_instance_indices[moved_slot] = m_slot_instance_indices[slot];
+            instance_slots.pop_back();
+
+            if (instance_slots.empty())
             {
-                amount_vertices += mesh.GetVerticesConstReference().size();
-                amount_indices  += mesh.GetIndicesConstReference().size();
+                ReleaseGeometry(geometry);
             }
-        } 
 
-    //------------------ Persistent member data
-        m_active_draw_indices.clear();
-        m_mesh_transforms.clear();
-        m_material_ptrs.clear();
+            m_slot_geometries[slot] = s_FREE_SLOT;
+            m_material_ptrs[slot].reset();
+
+            m_free_mesh_slots.push_back(slot);
+            MarkSlotDirty(slot);
+        }
+        m_instances_changed = true;
+
+        m_model_record_indices.erase(record.m_model_ptr);
+        if (record_index != m_model_records.size() - 1)
+        {
+            record = std::move(m_model_records.back());
+            m_model_record_indices[record.m_model_ptr] = record_index;
+        }
+        m_model_records.pop_back();
+    }
+
+    GLuint IndirectDraw3D_RenderPipeline::AcquireGeometry(const Mesh& mesh) noexcept
+    {
+        std::shared_ptr<const MeshData> data = mesh.GetSharedData();
+        const auto same_data_it = m_geometries_by_data.find(data.get());
+        if (same_data_it != m_geometries_by_data.end())
+            return same_data_it->second;
+
+        //Separately created meshes with equal content, e.g. primitives of the same size
+        const size_t content_hash = HashMeshContent(*data);
+        const auto [same_hash_begin, same_hash_end] = m_geometries_by_hash.equal_range(content_hash);
+        for (auto it = same_hash_begin; it != same_hash_end; ++it)
+        {
+            if (MeshContentEquals(*m_geometries[it->second].m_data, *data))
+                return it->second;
+        }
 
-        m_active_draw_indices.reserve(amount_meshes);
-        m_mesh_transforms.reserve(amount_meshes);
-        m_material_ptrs.reserve(amount_meshes);
+        const std::vector<Vertex>&       verts        = data->m_vertices;
+        const std::vector<PackedVertex>& packed_verts = data->m_packed_vertices;
+        const std::vector<GLuint>&       indices      = data->m_indices;
+        const bool                       is_packed    = ! packed_verts.empty();
+
+        //Only this mesh's ranges are uploaded
+        const size_t offset_vertices = is_packed ? AllocatePackedVertices(packed_verts.size()) : AllocateVertices(verts.size());
+        const size_t offset_indices  = AllocateIndices(indices.size());
+        if (is_packed) { m_packed_vbo.SetSubData(packed_verts.data(), packed_verts.size() * sizeof(PackedVertex), offset_vertices * sizeof(PackedVertex)); }
+        else           { m_vbo.SetSubData(verts.data(), verts.size() * sizeof(Vertex), offset_vertices * sizeof(Vertex)); }
+        m_ebo.SetSubData(indices.data(), indices.size() * sizeof(GLuint), offset_indices * sizeof(GLuint));
+
+        const GLuint geometry = AllocateGeometry();
+        GeometryEntry& entry = m_geometries[geometry];
+        entry.m_is_packed    = is_packed;
+        entry.m_first_vertex = offset_vertices;
+        entry.m_vertex_count = is_packed ? packed_verts.size() : verts.size();
+        entry.m_first_index  = offset_indices;
+        entry.m_index_count  = indices.size();
+        entry.m_content_hash = content_hash;
+        m_geometries_by_hash.emplace(content_hash, geometry);
+        m_geometries_by_data.emplace(data.get(), geometry);
+        //Keeps the address in m_geometries_by_data from being reused by other data
+        entry.m_data = std::move(data);
+
+        //Create draw command, instanceCount & baseInstance are set by RebuildInstanceRegions()
+        DrawElementsIndirectCommand cmd;
+        cmd.count = indices.size();                      // Number of indices to draw
+        cmd.instanceCount = 0;                           // Meshes sharing this geometry
+        cmd.firstIndex = offset_indices;                 // Offset in index buffer
+        cmd.baseVertex = offset_vertices;                // Offset in m_vbo or m_packed_vbo
+        cmd.baseInstance = 0;                            // Start of the geometry's region in the instance table
+        m_draw_templates[geometry] = cmd;
+
+        return geometry;
+    }
 
-    //------------------ Temporary data to be passed into GPU buffers
-        std::vector<DrawElementsIndirectCommand> temp_draw_commands;
-        std::vector<Vertex>   temp_mesh_vertices;
-        std::vector<GLuint>   temp_mesh_indices;
-        std::vector<MaterialPBR::GPU_std430_Aligned_Data> temp_material;
+    void IndirectDraw3D_RenderPipeline::ReleaseGeometry(GLuint geometry) noexcept
+    {
+        GeometryEntry& entry = m_geometries[geometry];
+        (entry.m_is_packed ? m_packed_vertex_ranges : m_vertex_ranges).Free(entry.m_first_vertex, entry.m_vertex_count);
+        m_index_ranges.Free(entry.m_first_index, entry.m_index_count);
 
-        temp_draw_commands.reserve(amount_meshes);
-        temp_mesh_vertices.reserve(amount_vertices);
-        temp_mesh_indices.reserve(amount_indices);
-        temp_material.reserve(amount_meshes);
+        m_geometries_by_data.erase(entry.m_data.get());
+        const auto [same_hash_begin, same_hash_end] = m_geometries_by_hash.equal_range(entry.m_content_hash);
+        for (auto it = same_hash_begin; it != same_hash_end; ++it)
+        {
+            if (it->second == geometry)
+            {
+                m_geometries_by_hash.erase(it);
+                break;
+            }
+        }
 
-        GLuint offset_indices  = 0;
-        GLint  offset_vertices = 0;
-        GLuint offset_mesh     = 0;
-    //------------------
+        entry = GeometryEntry{};
+        m_draw_templates[geometry] = DrawElementsIndirectCommand{};
+        m_free_geometries.push_back(geometry);
+    }
 
-        for(Basic_Model* model_ptr : model_vec)
+    GLuint IndirectDraw3D_RenderPipeline::AllocateGeometry() noexcept
+    {
+        if (m_free_geometries.empty())
         {
-            const glm::mat4 model_matrix = model_ptr->GetModelMatrix();
+            const size_t old_capacity = m_geometries.size();
+            const size_t new_capacity = std::max(old_capacity * 2, s_MIN_GEOMETRIES);
+            m_geometries.resize(new_capacity);
+            m_draw_templates.resize(new_capacity, DrawElementsIndirectCommand{});
 
-            for (Mesh& mesh : model_ptr->GetMeshVectorReference()) 
+            //Lowest new geometry on top, handed out first. The GPU buffers follow in RebuildInstanceRegions()
+            for (size_t geometry = new_capacity; geometry-- > old_capacity;)
             {
-                m_active_draw_indices.push_back(offset_mesh);
-                m_mesh_transforms.push_back(model_matrix);
-                ENGINE_ASSERT(mesh.GetMaterialSharedPtr() && "At IndirectDraw3D::SetSceneData(): Mesh should have a non null material ptr.");
-                m_material_ptrs.push_back(mesh.GetMaterialSharedPtr());
-
-                const std::vector<Vertex>& verts   = mesh.GetVerticesConstReference();
-                const std::vector<GLuint>& indices = mesh.GetIndicesConstReference();
-
-                //Update vectors to pass to GPU later
-                temp_mesh_vertices.insert(temp_mesh_vertices.end(), verts.begin(), verts.end());
-                temp_mesh_indices.insert(temp_mesh_indices.end(), indices.begin(), indices.end());
-
-                temp_material.push_back(mesh.GetMaterialConstSharedPtr()->GetGPUAlignedData());
-
-                //Create draw command
-                DrawElementsIndirectCommand cmd;
-                cmd.count = mesh.GetIndicesConstReference().size();  // Number of indices to draw
-                cmd.instanceCount = 1;                               // One instance per model (can be >1 for instancing)
-                cmd.firstIndex = offset_indices;                     // Offset in index buffer
-                cmd.baseVertex = offset_vertices;                    // Offset in vertex buffer
-                cmd.baseInstance = offset_mesh;                      // Model index for SSBO lookup
-
-                temp_draw_commands.push_back(cmd);
-
-                //Update offsets for next cmd
-                offset_indices  += indices.size();
-                offset_vertices += verts.size();
-                offset_mesh     += 1;
+                m_free_geometries.push_back(static_cast<GLuint>(geometry));
             }
         }
+        const GLuint geometry = m_free_geometries.back();
+        m_free_geometries.pop_back();
+        return geometry;
+    }
 
-        //Set indirect cmd data and save amount of commands
-        m_indirect_command_buffer.SetNewData(temp_draw_commands.data(), temp_draw_commands.size() * sizeof(DrawElementsIndirectCommand));
-        m_draw_command_count = temp_draw_commands.size();
+    GLuint IndirectDraw3D_RenderPipeline::AllocateMeshSlot() noexcept
+    {
+        if (m_free_mesh_slots.empty())
+        {
+            EnsureMeshSlotCapacity(std::max(m_mesh_transforms.size() * 2, s_MIN_MESH_SLOTS));
+        }
+        const GLuint slot = m_free_mesh_slots.back();
+        m_free_mesh_slots.pop_back();
+        return slot;
+    }
 
-        //Set SSBO model specific data
-        m_texture_indices_ssbo.SetNewData(temp_material.data(), sizeof(MaterialPBR::GPU_std430_Aligned_Data) * temp_material.size(), SSBO_BINDING::IndirectDraw3D_MATERIAL);
-        m_mesh_transform_ssbo.SetNewData(m_mesh_transforms.data(), sizeof(glm::mat4) * m_mesh_transforms.size(), SSBO_BINDING::IndirectDraw3D_TRANSFORM);
-        m_active_draw_indices_ssbo.SetNewData(m_active_draw_indices.data(), sizeof(GLuint) * m_active_draw_indices.size(), SSBO_BINDING::IndirectDraw3D_DRAW_INDICES);
+    size_t IndirectDraw3D_RenderPipeline::AllocateVertices(size_t amount) noexcept
+    {
+        size_t offset = m_vertex_ranges.Allocate(amount);
+        if (offset == RangeAllocator::INVALID_OFFSET)
+        {
+            //The appended space merges with a free range at the end, so it fits afterwards
+            GrowGeometryBuffers(std::max(m_vertex_ranges.GetCapacity() * 2, m_vertex_ranges.GetCapacity() + amount), m_packed_vertex_ranges.GetCapacity(), m_index_ranges.GetCapacity());
+            offset = m_vertex_ranges.Allocate(amount);
+        }
+        return offset;
+    }
 
-        //Store Lights
-        m_light_ssbo.SetNewData(lights_vec.data(), lights_vec.size() * sizeof(Light), SSBO_BINDING::IndirectDraw3D_LIGHTS);
+    size_t IndirectDraw3D_RenderPipeline::AllocatePackedVertices(size_t amount) noexcept
+    {
+        size_t offset = m_packed_vertex_ranges.Allocate(amount);
+        if (offset == RangeAllocator::INVALID_OFFSET)
+        {
+            GrowGeometryBuffers(m_vertex_ranges.GetCapacity(), std::max(m_packed_vertex_ranges.GetCapacity() * 2, m_packed_vertex_ranges.GetCapacity() + amount), m_index_ranges.GetCapacity());
+            offset = m_packed_vertex_ranges.Allocate(amount);
+        }
+        return offset;
+    }
 
-        //Store lengths of SSBO
-        SSBO_SizesData ssbo_sizes {};
-        ssbo_sizes.m_active_draw_indices_size = m_active_draw_indices.size();
-        ssbo_sizes.m_mesh_transform_size      = m_mesh_transforms.size();
-        ssbo_sizes.m_materials_size           = m_material_ptrs.size();
-        ssbo_sizes.m_light_size               = lights_vec.size();
-        m_ssbo_sizes_ubo.SetSubData(&ssbo_sizes, sizeof(SSBO_SizesData), 0);
-        
-        //Store mesh data
-        m_vbo.SetNewData(temp_mesh_vertices);
-        m_ebo.SetNewData(temp_mesh_indices);
+    size_t IndirectDraw3D_RenderPipeline::AllocateIndices(size_t amount) noexcept
+    {
+        size_t offset = m_index_ranges.Allocate(amount);
+        if (offset == RangeAllocator::INVALID_OFFSET)
+        {
+            GrowGeometryBuffers(m_vertex_ranges.GetCapacity(), m_packed_vertex_ranges.GetCapacity(), std::max(m_index_ranges.GetCapacity() * 2, m_index_ranges.GetCapacity() + amount));
+            offset = m_index_ranges.Allocate(amount);
+        }
+        return offset;
     }
 
-    void IndirectDraw3D_RenderPipeline::UpdateModelTransforms(const std::vector<Basic_Model*>& model_vec, const glm::mat4& view_projection) noexcept
+    void IndirectDraw3D_RenderPipeline::GrowGeometryBuffers(size_t vertex_capacity, size_t packed_vertex_capacity, size_t index_capacity) noexcept
     {
-        size_t amount_meshes {0};
-        for (const Basic_Model* model_ptr : model_vec)
+        //The VBOs are bound by ID in Render(), only a new EBO needs relinking
+        if (vertex_capacity > m_vertex_ranges.GetCapacity())
         {
-            amount_meshes += model_ptr->GetMeshVectorConstReference().size();
+            m_vbo.Grow(m_vertex_ranges.GetCapacity() * sizeof(Vertex), vertex_capacity * sizeof(Vertex));
+            m_vertex_ranges.Grow(vertex_capacity);
         }
+        if (packed_vertex_capacity > m_packed_vertex_ranges.GetCapacity())
+        {
+            m_packed_vbo.Grow(m_packed_vertex_ranges.GetCapacity() * sizeof(PackedVertex), packed_vertex_capacity * sizeof(PackedVertex));
+            m_packed_vertex_ranges.Grow(packed_vertex_capacity);
+        }
+        if (index_capacity > m_index_ranges.GetCapacity())
+        {
+            m_ebo.Grow(m_index_ranges.GetCapacity() * sizeof(GLuint), index_capacity * sizeof(GLuint));
+            m_index_ranges.Grow(index_capacity);
+            LinkGeometryBuffers();
+        }
+    }
 
-        ENGINE_ASSERT (m_mesh_transforms.size() == amount_meshes && 
-        "At IndirectDraw3D::UpdateModelTransforms(): May only be called if no models where added / removed since last call to SetSceneData().");
+    void IndirectDraw3D_RenderPipeline::LinkGeometryBuffers() noexcept
+    {
+        m_vao.Bind();
+        m_ebo.Bind();
+        m_vao.Unbind();
+        m_ebo.Unbind();
+    }
 
-        m_mesh_transforms.clear();
-        m_mesh_transforms.reserve(amount_meshes);
+    void IndirectDraw3D_RenderPipeline::EnsureMeshSlotCapacity(size_t slot_capacity) noexcept
+    {
+        const size_t old_capacity = m_mesh_transforms.size();
+        if (slot_capacity <= old_capacity)
+            return;
+
+        m_mesh_transforms.resize(slot_capacity, glm::mat4(1.0f));
+        m_material_ptrs.resize(slot_capacity);
+        m_mesh_local_aabbs.resize(slot_capacity);
+        m_slot_geometries.resize(slot_capacity, s_FREE_SLOT);
+        m_slot_instance_indices.resize(slot_capacity, 0);
+        m_mesh_world_aabbs.Resize(slot_capacity);
+
+        //Lowest new slot on top, handed out first
+        for (size_t slot = slot_capacity; slot-- > old_capacity;)
+        {
+            m_free_mesh_slots.push_back(static_cast<GLuint>(slot));
+        }
 
-        std::vector<DrawElementsIndirectCommand> temp_draw_commands;
-        temp_draw_commands.reserve(amount_meshes);
-        //Offsets for draw command
-        GLuint offset_indices  {0};
-        GLint  offset_vertices {0};
-        GLuint offset_mesh     {0};
+        ReallocateSlotBuffers();
+    }
 
-        int culled_mesh_counter {0};
+    void IndirectDraw3D_RenderPipeline::ReallocateSlotBuffers() noexcept
+    {
+        const size_t slot_capacity = m_mesh_transforms.size();
 
-        for (const Basic_Model* model_ptr : model_vec)
+        std::pmr::vector<MaterialPBR::GPU_std430_Aligned_Data> materials (&FrameArena::GetThreadLocal());
+        std::pmr::vector<MeshBoundsData> mesh_bounds (&FrameArena::GetThreadLocal());
+        GatherSlotData(0, slot_capacity, materials, mesh_bounds);
+
+        //Instance table, written by the GPU cull or DrawAllMeshesUntilNextCull(). At most one instance per slot
+        m_active_draw_indices_ssbo.SetNewData(nullptr, sizeof(GLuint) * slot_capacity, SSBO_BINDING::IndirectDraw3D_DRAW_INDICES);
+        m_texture_indices_ssbo.SetNewData(materials.data(), sizeof(MaterialPBR::GPU_std430_Aligned_Data) * slot_capacity, SSBO_BINDING::IndirectDraw3D_MATERIAL);
+        m_mesh_bounds_ssbo.SetNewData(mesh_bounds.data(), sizeof(MeshBoundsData) * slot_capacity, SSBO_BINDING::IndirectDraw3D_MESH_BOUNDS);
+        m_mesh_geometries_ssbo.SetNewData(m_slot_geometries.data(), sizeof(GLuint) * slot_capacity, SSBO_BINDING::IndirectDraw3D_MESH_GEOMETRY);
+
+        //Everything is uploaded
+        m_dirty_slots_begin = 0;
+        m_dirty_slots_end   = 0;
+    }
+
+    void IndirectDraw3D_RenderPipeline::MarkSlotDirty(GLuint slot) noexcept
+    {
+        if (m_dirty_slots_begin >= m_dirty_slots_end)
+        {
+            m_dirty_slots_begin = slot;
+            m_dirty_slots_end   = slot + 1;
+            return;
+        }
+        m_dirty_slots_begin = std::min(m_dirty_slots_begin, slot);
+        m_dirty_slots_end   = std::max(m_dirty_slots_end, slot + 1);
+    }
+
+    void IndirectDraw3D_RenderPipeline::FlushDirtySlots() noexcept
+    {
+        if (m_dirty_slots_begin >= m_dirty_slots_end)
+            return;
+
+        const GLuint begin  = m_dirty_slots_begin;
+        const GLuint amount = m_dirty_slots_end - m_dirty_slots_begin;
+
+        std::pmr::vector<MaterialPBR::GPU_std430_Aligned_Data> materials (&FrameArena::GetThreadLocal());
+        std::pmr::vector<MeshBoundsData> mesh_bounds (&FrameArena::GetThreadLocal());
+        GatherSlotData(begin, begin + amount, materials, mesh_bounds);
+
+        m_texture_indices_ssbo.SetSubData(materials.data(), sizeof(MaterialPBR::GPU_std430_Aligned_Data) * amount, sizeof(MaterialPBR::GPU_std430_Aligned_Data) * begin);
+        m_mesh_bounds_ssbo.SetSubData(mesh_bounds.data(), sizeof(MeshBoundsData) * amount, sizeof(MeshBoundsData) * begin);
+        m_mesh_geometries_ssbo.SetSubData(m_slot_geometries.data() + begin, sizeof(GLuint) * amount, sizeof(GLuint) * begin);
+
+        m_dirty_slots_begin = 0;
+        m_dirty_slots_end   = 0;
+    }
+
+    void IndirectDraw3D_RenderPipeline::GatherSlotData(size_t begin, size_t end, std::pmr::vector<MaterialPBR::GPU_std430_Aligned_Data>& out_materials, std::pmr::vector<MeshBoundsData>& out_bounds) const noexcept
+    {
+        out_materials.clear();
+        out_bounds.clear();
+        out_materials.reserve(end - begin);
+        out_bounds.reserve(end - begin);
+
+        for (size_t slot = begin; slot < end; slot++)
         {
-            const glm::mat4 model_mat   = model_ptr->GetModelMatrix();
+            out_materials.push_back(m_material_ptrs[slot] ? m_material_ptrs[slot]->GetGPUAlignedData() : MaterialPBR::GPU_std430_Aligned_Data{});
+            out_bounds.push_back(MeshBoundsData{ glm::vec4(m_mesh_local_aabbs[slot].m_center, 0.0f), glm::vec4(m_mesh_local_aabbs[slot].m_half_extents, 0.0f) });
+        }
+    }
+
+    void IndirectDraw3D_RenderPipeline::RebuildInstanceRegions() noexcept
+    {
+        GLuint region_begin {0};
+        for (size_t geometry = 0; geometry < m_geometries.size(); geometry++)
+        {
+            const GLuint amount_instances = static_cast<GLuint>(m_geometries[geometry].m_instance_slots.size());
+            m_draw_templates[geometry].instanceCount = amount_instances;
+            m_draw_templates[geometry].baseInstance  = region_begin;
+            region_begin += amount_instances;
+        }
 
-            for (const Mesh& mesh : model_ptr->GetMeshVectorConstReference())
+        //The GPU cull starts every frame from these & counts the visible instances
+        std::pmr::vector<DrawElementsIndirectCommand> cull_templates (m_draw_templates.begin(), m_draw_templates.end(), &FrameArena::GetThreadLocal());
+        for (DrawElementsIndirectCommand& cmd : cull_templates)
+        {
+            cmd.instanceCount = 0;
+        }
+        m_draw_templates_ssbo.SetNewData(cull_templates.data(), sizeof(DrawElementsIndirectCommand) * cull_templates.size(), SSBO_BINDING::IndirectDraw3D_DRAW_TEMPLATES);
+        //Overwritten by the GPU cull or DrawAllMeshesUntilNextCull(), only the size matters
+        m_indirect_command_buffer.SetNewData(m_draw_templates.data(), sizeof(DrawElementsIndirectCommand) * m_draw_templates.size());
+
+        std::pmr::vector<GeometryDecodeData> decode_data (m_geometries.size(), GeometryDecodeData{}, &FrameArena::GetThreadLocal());
+        for (size_t geometry = 0; geometry < m_geometries.size(); geometry++)
+        {
+            const GeometryEntry& entry = m_geometries[geometry];
+            if (entry.m_is_packed)
             {
-                m_mesh_transforms.push_back(model_mat);
+                decode_data[geometry].m_position_min    = glm::vec4(entry.m_data->m_packed_position_min, 1.0f);
+                decode_data[geometry].m_position_extent = glm::vec4(entry.m_data->m_packed_position_extent, 0.0f);
+            }
+        }
+        m_geometry_decode_ssbo.SetNewData(decode_data.data(), sizeof(GeometryDecodeData) * decode_data.size(), SSBO_BINDING::IndirectDraw3D_GEOMETRY_DECODE);
 
-                const MathUtility::AABB world_space_aabb = MathUtility::AABB::CreateWorldSpaceAABB(model_mat, mesh.GetLocalAABBHalfExtents(), mesh.GetLocalCenter());
+        m_instances_changed = false;
+    }
 
-                const GLuint mesh_indices_count  = mesh.GetIndicesConstReference().size();
-                const GLuint mesh_vertices_count = mesh.GetVerticesConstReference().size();
+    void IndirectDraw3D_RenderPipeline::WriteAllInstances(GLuint* out_instance_table) const noexcept
+    {
+        for (size_t geometry = 0; geometry < m_geometries.size(); geometry++)
+        {
+            const std::vector<GLuint>& instance_slots = m_geometries[geometry].m_instance_slots;
+            std::copy(instance_slots.begin(), instance_slots.end(), out_instance_table + m_draw_templates[geometry].baseInstance);
+        }
+    }
 
-                if (MathUtility::AABBIsInFrustum(MathUtility::ExtractProjectionPlanesFromVP(view_projection), world_space_aabb))
-                {
-                    //Create draw command
-                    DrawElementsIndirectCommand cmd;
-                    cmd.count = mesh.GetIndicesConstReference().size();  // Number of indices to draw
-                    cmd.instanceCount = 1;                               // One instance per model (can be >1 for instancing)
-                    cmd.firstIndex    = offset_indices;                  // Offset in index buffer
-                    cmd.baseVertex    = offset_vertices;                 // Offset in vertex buffer
-                    cmd.baseInstance  = offset_mesh;                     // Model index for SSBO lookup
-
-                    temp_draw_commands.push_back(cmd);
-                }
-                else 
+    size_t IndirectDraw3D_RenderPipeline::GetAmountInstances() const noexcept
+    {
+        return m_mesh_transforms.size() - m_free_mesh_slots.size();
+    }
+
+    void IndirectDraw3D_RenderPipeline::FinishSceneChange() noexcept
+    {
+        FlushDirtySlots();
+        if (m_instances_changed)
+        {
+            RebuildInstanceRegions();
+        }
+        m_mesh_transform_stream.Write(m_mesh_transforms.data(), sizeof(glm::mat4) * m_mesh_transforms.size());
+        UpdateSSBOSizes();
+        DrawAllMeshesUntilNextCull();
+    }
+
+    void IndirectDraw3D_RenderPipeline::UpdateSSBOSizes() noexcept
+    {
+        SSBO_SizesData ssbo_sizes {};
+        ssbo_sizes.m_active_draw_indices_size = m_mesh_transforms.size();
+        ssbo_sizes.m_mesh_transform_size      = m_mesh_transforms.size();
+        ssbo_sizes.m_materials_size           = m_material_ptrs.size();
+        ssbo_sizes.m_light_size               = m_light_count;
+        m_ssbo_sizes_ubo.SetSubData(&ssbo_sizes, sizeof(SSBO_SizesData), 0);
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Per frame
+    ////////////////////////////////////////////////
+    size_t IndirectDraw3D_RenderPipeline::UpdateMovedMeshes() noexcept
+    {
+        size_t moved_meshes {0};
+        for (const ModelRecord& record : m_model_records)
+        {
+            if (record.m_mesh_slots.empty())
+                continue;
+
+            //All meshes of a model share its matrix, comparing the first one is enough
+            const glm::mat4 model_mat = record.m_model_ptr->GetModelMatrix();
+            if (m_mesh_transforms[record.m_mesh_slots.front()] != model_mat)
+            {
+                for (const GLuint slot : record.m_mesh_slots)
                 {
-                    culled_mesh_counter++;
+                    m_mesh_transforms[slot] = model_mat;
+                    m_mesh_world_aabbs.Set(slot, MathUtility::AABB::CreateWorldSpaceAABB(model_mat, m_mesh_local_aabbs[slot].m_half_extents, m_mesh_local_aabbs[slot].m_center));
                 }
+                moved_meshes += record.m_mesh_slots.size();
+            }
+        }
+        return moved_meshes;
+    }
+
+    void IndirectDraw3D_RenderPipeline::UpdateModelTransformsCPU(const glm::mat4& view_projection) noexcept
+    {
+        const size_t moved_meshes = UpdateMovedMeshes();
 
-                //Update offsets for next cmd
-                offset_indices  += mesh_indices_count;
-                offset_vertices += mesh_vertices_count;
-                offset_mesh     += 1;
+        std::pmr::vector<uint32_t> visible_meshes (&FrameArena::GetThreadLocal());
+        FrustumCulling::CullAABBs(FrustumCulling::ExtractNormalizedPlanes(view_projection), m_mesh_world_aabbs, visible_meshes);
+
+        //Visible instances per geometry, free slots have nothing to draw
+        std::pmr::vector<GLuint> instance_offsets (m_draw_templates.size(), 0, &FrameArena::GetThreadLocal());
+        size_t amount_draws {0};
+        for (const uint32_t mesh_index : visible_meshes)
+        {
+            const GLuint geometry = m_slot_geometries[mesh_index];
+            if (geometry != s_FREE_SLOT && instance_offsets[geometry]++ == 0)
+            {
+                amount_draws++;
             }
         }
 
-        ENGINE_PERFORMANCE_LOG_OCCURENCE("Frustum Culled Mesh: ", culled_mesh_counter);
+        //One command per geometry with visible instances, written straight into the mapped command region. The counts
+        //become the start of each command's region in the instance table
+        DrawElementsIndirectCommand* draw_commands = static_cast<DrawElementsIndirectCommand*>(m_draw_command_stream.BeginWrite(amount_draws * sizeof(DrawElementsIndirectCommand)));
+        GLuint amount_visible_instances {0};
+        size_t draw_index {0};
+        for (size_t geometry = 0; geometry < instance_offsets.size(); geometry++)
+        {
+            const GLuint amount_geometry_instances = instance_offsets[geometry];
+            if (amount_geometry_instances == 0)
+                continue;
 
-        //Set indirect cmd data and save amount of commands
-        m_indirect_command_buffer.SetSubData(temp_draw_commands.data(), temp_draw_commands.size() * sizeof(DrawElementsIndirectCommand), 0);
-        m_draw_command_count = temp_draw_commands.size();
+            DrawElementsIndirectCommand& cmd = draw_commands[draw_index++];
+            cmd = m_draw_templates[geometry];
+            cmd.instanceCount = amount_geometry_instances;
+            cmd.baseInstance  = amount_visible_instances;
+
+            instance_offsets[geometry] = amount_visible_instances;
+            amount_visible_instances  += amount_geometry_instances;
+        }
+        m_draw_command_count = amount_draws;
+
+        GLuint* instance_table = static_cast<GLuint*>(m_instance_stream.BeginWrite(amount_visible_instances * sizeof(GLuint)));
+        for (const uint32_t mesh_index : visible_meshes)
+        {
+            const GLuint geometry = m_slot_geometries[mesh_index];
+            if (geometry != s_FREE_SLOT)
+            {
+                instance_table[instance_offsets[geometry]++] = mesh_index;
+            }
+        }
+
+        ENGINE_PERFORMANCE_LOG_OCCURENCE("Frustum Culled Mesh: ", GetAmountInstances() - amount_visible_instances);
 
         //Set transform data
-        m_mesh_transform_ssbo.SetSubData(m_mesh_transforms.data(), m_mesh_transforms.size() * sizeof(glm::mat4), 0);
+        if (moved_meshes > 0)
+        {
+            m_mesh_transform_stream.Write(m_mesh_transforms.data(), m_mesh_transforms.size() * sizeof(glm::mat4));
+        }
+    }
+
+    void IndirectDraw3D_RenderPipeline::UpdateModelTransformsGPU(const glm::mat4& view_projection) noexcept
+    {
+        ENGINE_PERFORMANCE_MEASURE_GPU_SCOPE_TIME("IndirectDraw3D Cull");
+
+        if (UpdateMovedMeshes() > 0)
+        {
+            m_mesh_transform_stream.Write(m_mesh_transforms.data(), m_mesh_transforms.size() * sizeof(glm::mat4));
+        }
+        m_draw_command_count = m_draw_templates.size();
+
+        //Planes once per frame & normalized here, not per mesh in the shader
+        CullData cull_data {};
+        cull_data.m_frustum_planes = FrustumCulling::ExtractNormalizedPlanes(view_projection);
+        cull_data.m_mesh_count = static_cast<GLuint>(m_mesh_transforms.size());
+        m_cull_ubo.SetSubData(&cull_data, sizeof(CullData), 0);
+
+        //Commands with instanceCount 0, the cull counts the visible instances into them
+        m_draw_templates_ssbo.Bind();
+        m_indirect_command_buffer.Bind();
+        glCopyBufferSubData(GL_SHADER_STORAGE_BUFFER, GL_DRAW_INDIRECT_BUFFER, 0, 0, m_draw_templates.size() * sizeof(DrawElementsIndirectCommand));
+        m_indirect_command_buffer.Unbind();
+        m_draw_templates_ssbo.Unbind();
+
+        if (cull_data.m_mesh_count == 0)
+            return;
+
+    //------------------- Bind buffers, the command buffer is written to as SSBO
+        m_cull_ubo.BindBase();
+        m_mesh_transform_stream.BindRange(GL_SHADER_STORAGE_BUFFER, SSBO_BINDING::IndirectDraw3D_TRANSFORM);
+        m_mesh_bounds_ssbo.BindBase();
+        m_mesh_geometries_ssbo.BindBase();
+        m_active_draw_indices_ssbo.BindBase();
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SSBO_BINDING::IndirectDraw3D_CULLED_COMMANDS, m_indirect_command_buffer.GetID());
+
+        m_cull_shader_program.Activate();
+        glDispatchCompute((cull_data.m_mesh_count + s_CULL_WORKGROUP_SIZE - 1) / s_CULL_WORKGROUP_SIZE, 1, 1);
+        m_cull_shader_program.Deactivate();
+
+        //Commands are consumed as GL_DRAW_INDIRECT_BUFFER, the instance table by the vertex shader in Render()
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+        //Fenced again by Render(), in case it doesn't run this frame
+        m_mesh_transform_stream.FenceCurrentRegion();
+    }
+
+    void IndirectDraw3D_RenderPipeline::DrawAllMeshesUntilNextCull() noexcept
+    {
+        //Every geometry with all of its instances, in the regions of the templates
+        m_draw_command_count = m_draw_templates.size();
+        const size_t amount_instances = GetAmountInstances();
+
+        if (m_culling_mode == CullingMode::GPU)
+        {
+            std::pmr::vector<GLuint> instance_table (amount_instances, &FrameArena::GetThreadLocal());
+            WriteAllInstances(instance_table.data());
+            m_active_draw_indices_ssbo.SetSubData(instance_table.data(), sizeof(GLuint) * amount_instances, 0);
+            m_indirect_command_buffer.SetSubData(m_draw_templates.data(), sizeof(DrawElementsIndirectCommand) * m_draw_templates.size(), 0);
+        }
+        else
+        {
+            WriteAllInstances(static_cast<GLuint*>(m_instance_stream.BeginWrite(sizeof(GLuint) * amount_instances)));
+            m_draw_command_stream.Write(m_draw_templates.data(), m_draw_templates.size() * sizeof(DrawElementsIndirectCommand));
+        }
     }
 
     void IndirectDraw3D_RenderPipeline::SetLightData(const std::vector<Light>& lights_vec) noexcept
     {
         m_light_ssbo.SetNewData(lights_vec.data(), lights_vec.size() * sizeof(Light), SSBO_BINDING::IndirectDraw3D_LIGHTS);
+        m_light_count = static_cast<GLuint>(lights_vec.size());
+        UpdateSSBOSizes();
+    }
 
-        SSBO_SizesData ssbo_sizes {};
-        ssbo_sizes.m_active_draw_indices_size = m_active_draw_indices.size();
-        ssbo_sizes.m_mesh_transform_size      = m_mesh_transforms.size();
-        ssbo_sizes.m_materials_size           = m_material_ptrs.size();
-        ssbo_sizes.m_light_size               = lights_vec.size();
-        m_ssbo_sizes_ubo.SetSubData(&ssbo_sizes, sizeof(SSBO_SizesData), 0);
+    void IndirectDraw3D_RenderPipeline::SetCullingMode(CullingMode mode) noexcept
+    {
+        if (mode == CullingMode::GPU && ! GpuCullingIsSupported())
+        {
+            mode = CullingMode::CPU;
+        }
+        if (mode == m_culling_mode)
+            return;
+
+        m_culling_mode = mode;
+
+        //Until the next UpdateModelTransforms(), as after SetSceneData()
+        DrawAllMeshesUntilNextCull();
+    }
+
+    IndirectDraw3D_RenderPipeline::CullingMode IndirectDraw3D_RenderPipeline::GetCullingMode() const noexcept
+    {
+        return m_culling_mode;
+    }
+
+    bool IndirectDraw3D_RenderPipeline::GpuCullingIsSupported() noexcept
+    {
+        return GLAD_GL_VERSION_4_3 != 0;
     }
 
     void IndirectDraw3D_RenderPipeline::SetCameraData(const glm::mat4& cam_matrix, const glm::vec3& cam_pos) noexcept
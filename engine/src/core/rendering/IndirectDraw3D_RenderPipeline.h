@@ -10,11 +10,33 @@
 
 #include "core/rendering/Material.h"
 
+#include "core/utility/FrustumCulling.h"
+#include "core/utility/RangeAllocator.h"
+
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <unordered_map>
+
 namespace CoreEngine
 {
     class IndirectDraw3D_RenderPipeline
     {
     public:
+        // Meshes with identical vertices & indices share one geometry range & one draw command, drawn instanced. Both modes
+        // compact the visible instances of every command into an instance -> mesh slot table.
+        // GPU: a compute shader culls every mesh's world AABB and counts the visible instances into the commands - the CPU
+        // only uploads transforms. CPU: FrustumCulling over the world AABBs kept as structure of arrays, for software GL &
+        // contexts without GL 4.3.
+        // The vertex shader pulls the vertices from SSBOs: full Vertex from m_vbo, or PackedVertex from m_packed_vbo for
+        // meshes with packed vertices (Mesh::PackVertices()), half the memory & fetch bandwidth.
+        enum class CullingMode : uint8_t
+        {
+            CPU = 0,
+            GPU = 1
+        };
+
         //////////////////////////////////////////////// 
         //---------  Constructor
         //////////////////////////////////////////////// 
@@ -23,21 +45,33 @@ namespace CoreEngine
         //////////////////////////////////////////////// 
         //---------  Public methods
         //////////////////////////////////////////////// 
-        //Call this is models were added / deleted - Expensive and will rebuild entire data once
-        void SetSceneData(const std::vector<Basic_Model*>& model_vec, const std::vector<Light>& lights) noexcept;
+        //Call this is models were added / deleted. Diffs model_vec against the models already uploaded: only added, removed
+        //or re-meshed models touch their vertex, index & slot ranges, everything else just has its transform updated
+        void SetSceneData(std::span<Basic_Model* const> model_vec, const std::vector<Light>& lights) noexcept;
+        //Single model versions of SetSceneData(), false if the model is already added / not added. Added models have to
+        //stay alive until removed
+        bool AddModel(Basic_Model* model_ptr) noexcept;
+        bool RemoveModel(const Basic_Model* model_ptr) noexcept;
         //Call if no models added / deleted, but positions may have changed. Will apply frustum culling
-        void UpdateModelTransforms(const std::vector<Basic_Model*>& model_vec, const glm::mat4& camera_matrix) noexcept;
+        void UpdateModelTransforms(std::span<Basic_Model* const> model_vec, const glm::mat4& camera_matrix) noexcept;
         //Call if just new light sources were added
         void SetLightData(const std::vector<Light>& lights) noexcept;
         //Call if camera state changed
         void SetCameraData(const glm::mat4& cam_matrix, const glm::vec3& cam_pos) noexcept;
         void Render() noexcept;
 
+        //Falls back to CullingMode::CPU if the context can't do GPU culling
+        void SetCullingMode(CullingMode mode) noexcept;
+        [[nodiscard]] CullingMode GetCullingMode() const noexcept;
+        //Needs compute shaders & glMultiDrawElementsIndirect, i.e. GL 4.3
+        [[nodiscard]] static bool GpuCullingIsSupported() noexcept;
+
         //////////////////////////////////////////////// 
         //---------  Copy / Move policy
         //////////////////////////////////////////////// 
-        explicit IndirectDraw3D_RenderPipeline(IndirectDraw3D_RenderPipeline&&)        = default;
-        IndirectDraw3D_RenderPipeline& operator=(IndirectDraw3D_RenderPipeline&&)      = default;
+        // Not movable, the GL objects (VAO, VBOs, streams) aren't
+        IndirectDraw3D_RenderPipeline(IndirectDraw3D_RenderPipeline&&)                 = delete;
+        IndirectDraw3D_RenderPipeline& operator=(IndirectDraw3D_RenderPipeline&&)      = delete;
         IndirectDraw3D_RenderPipeline(const IndirectDraw3D_RenderPipeline&)            = delete;
         IndirectDraw3D_RenderPipeline& operator=(const IndirectDraw3D_RenderPipeline&) = delete;
 
@@ -61,40 +95,168 @@ namespace CoreEngine
             glm::vec3 camPos; GLfloat padding;
         };
 
+        //Maintain valid std430 alignment
+        struct MeshBoundsData
+        {
+            glm::vec4 m_local_center;       // w unused
+            glm::vec4 m_local_half_extents; // w unused
+        };
+
+        //Maintain valid std140 alignment
+        struct CullData
+        {
+            std::array<glm::vec4, 5> m_frustum_planes; // Normalized
+            GLuint m_mesh_count = 0;
+            GLuint padding[3];
+        };
+
+        //Maintain valid std430 alignment
+        struct GeometryDecodeData
+        {
+            glm::vec4 m_position_min;    // w: 1 if the vertices are in m_packed_vbo
+            glm::vec4 m_position_extent; // w unused
+        };
+
+        //Vertex & index range shared by every mesh slot with the same content, one draw command each
+        struct GeometryEntry
+        {
+            bool                m_is_packed    = false; // m_first_vertex is in m_packed_vbo
+            size_t              m_first_vertex = 0;
+            size_t              m_vertex_count = 0;
+            size_t              m_first_index  = 0;
+            size_t              m_index_count  = 0;
+            size_t              m_content_hash = 0;
+            std::vector<GLuint> m_instance_slots;
+            std::shared_ptr<const MeshData> m_data; // Of the first instance, new meshes are compared against it
+        };
+
+        //Slots of one added model. A model whose mesh vector was replaced since is removed & added again
+        struct ModelRecord
+        {
+            Basic_Model*        m_model_ptr   = nullptr;
+            const Mesh*         m_meshes_data = nullptr;
+            std::vector<GLuint> m_mesh_slots;
+            uint64_t            m_last_seen_scene = 0;
+
+            [[nodiscard]] bool IsStale() const noexcept;
+        };
+
+    //------------------- Scene changes
+        void AddModelMeshes(Basic_Model* model_ptr) noexcept;
+        void RemoveModelMeshes(size_t record_index) noexcept;
+        [[nodiscard]] GLuint AllocateMeshSlot() noexcept;
+        //Existing geometry with the same vertices & indices, or a new one with its data uploaded
+        [[nodiscard]] GLuint AcquireGeometry(const Mesh& mesh) noexcept;
+        //Once its last instance is gone
+        void ReleaseGeometry(GLuint geometry) noexcept;
+        [[nodiscard]] GLuint AllocateGeometry() noexcept;
+        //Grow the VBOs / EBO if no free range is large enough
+        [[nodiscard]] size_t AllocateVertices(size_t amount) noexcept;
+        [[nodiscard]] size_t AllocatePackedVertices(size_t amount) noexcept;
+        [[nodiscard]] size_t AllocateIndices(size_t amount) noexcept;
+        void GrowGeometryBuffers(size_t vertex_capacity, size_t packed_vertex_capacity, size_t index_capacity) noexcept;
+        void EnsureMeshSlotCapacity(size_t slot_capacity) noexcept;
+        void LinkGeometryBuffers() noexcept;
+        //Whole per-slot buffers, after the slot capacity changed
+        void ReallocateSlotBuffers() noexcept;
+        //Only the slots changed since the last flush
+        void FlushDirtySlots() noexcept;
+        void MarkSlotDirty(GLuint slot) noexcept;
+        void GatherSlotData(size_t begin, size_t end, std::pmr::vector<MaterialPBR::GPU_std430_Aligned_Data>& out_materials, std::pmr::vector<MeshBoundsData>& out_bounds) const noexcept;
+        //Instance table regions of the geometries, in geometry order, the draw templates using them & the geometry decode data
+        void RebuildInstanceRegions() noexcept;
+        //Every instance into the regions of RebuildInstanceRegions(), amount of instances entries
+        void WriteAllInstances(GLuint* out_instance_table) const noexcept;
+        [[nodiscard]] size_t GetAmountInstances() const noexcept;
+        //Transforms, SSBO sizes & draw commands after any scene change
+        void FinishSceneChange() noexcept;
+        void UpdateSSBOSizes() noexcept;
+
+        //Refreshes transforms & world AABBs of the meshes whose model matrix changed, returns how many
+        size_t UpdateMovedMeshes() noexcept;
+        void UpdateModelTransformsCPU(const glm::mat4& view_projection) noexcept;
+        void UpdateModelTransformsGPU(const glm::mat4& view_projection) noexcept;
+        //Draws every mesh, until the next cull. For frames in which SetSceneData() replaced the commands
+        void DrawAllMeshesUntilNextCull() noexcept;
+
         //////////////////////////////////////////////// 
         //---------  CPU Side Data
         //////////////////////////////////////////////// 
         CameraRenderData                             m_camera_render_data;
-        std::vector<GLuint>                          m_active_draw_indices;
+        CullingMode                                  m_culling_mode;
+        GLuint                                       m_light_count = 0;
+
+        //Per mesh slot, sized to the slot capacity. Free slots have geometry s_FREE_SLOT, which neither cull draws
         std::vector<glm::mat4>                       m_mesh_transforms;
         std::vector<std::shared_ptr<MaterialPBR>>    m_material_ptrs;
+        std::vector<MathUtility::AABB>               m_mesh_local_aabbs;
+        std::vector<GLuint>                          m_slot_geometries;
+        std::vector<GLuint>                          m_slot_instance_indices; // Index in the geometry's m_instance_slots
+        FrustumCulling::AABB_SoA                     m_mesh_world_aabbs;
+        std::vector<GLuint>                          m_free_mesh_slots;
+        GLuint                                       m_dirty_slots_begin = 0;
+        GLuint                                       m_dirty_slots_end   = 0;
+        uint64_t                                     m_seen_texture_generation = 0; // TextureCache generation of the uploaded materials
+
+        //Per geometry, sized to the geometry capacity. Free geometries keep a count 0 draw template
+        std::vector<GeometryEntry>                   m_geometries;
+        std::vector<DrawElementsIndirectCommand>     m_draw_templates;   // instanceCount = all instances, the culls count the visible ones
+        std::vector<GLuint>                          m_free_geometries;
+        std::unordered_map<const MeshData*, GLuint>  m_geometries_by_data; // Copies of a mesh share their MeshData, no hashing needed
+        std::unordered_multimap<size_t, GLuint>      m_geometries_by_hash;
+        bool                                         m_instances_changed = false;
+
+        std::vector<ModelRecord>                          m_model_records;
+        std::unordered_map<const Basic_Model*, size_t>    m_model_record_indices;
+        uint64_t                                          m_scene_counter = 0;
+
+        //Vertices & indices of every mesh share m_vbo / m_packed_vbo / m_ebo, in units of Vertex / PackedVertex / GLuint
+        RangeAllocator                               m_vertex_ranges;
+        RangeAllocator                               m_packed_vertex_ranges;
+        RangeAllocator                               m_index_ranges;
 
         //////////////////////////////////////////////// 
         //--------- GPU Side Data
         //////////////////////////////////////////////// 
         Shader  m_shader_program;
+        Shader  m_cull_shader_program;
         
         UBO     m_ssbo_sizes_ubo;
         UBO     m_camera_ubo;
+        UBO     m_cull_ubo;
 
-        SSBO    m_active_draw_indices_ssbo;
-        SSBO    m_mesh_transform_ssbo;
+        SSBO    m_active_draw_indices_ssbo; // Instance -> mesh slot, written by the GPU cull
         SSBO    m_texture_indices_ssbo;
         SSBO    m_light_ssbo;
+        SSBO    m_mesh_bounds_ssbo;
+        SSBO    m_mesh_geometries_ssbo;
+        SSBO    m_draw_templates_ssbo;      // All commands with instanceCount 0, copied into the command buffer before the cull
+        SSBO    m_geometry_decode_ssbo;
         
-        VBO     m_vbo;
+        VBO     m_vbo;                      // Bound as SSBOs, the VAO only holds the EBO
+        VBO     m_packed_vbo;
         EBO     m_ebo;
         VAO     m_vao;
 
-        GLsizei        m_draw_command_count = 0;
-        IndirectBuffer m_indirect_command_buffer;
+        StreamingBuffer m_mesh_transform_stream {sizeof(glm::mat4)};
+
+        GLsizei         m_draw_command_count = 0; // CPU culling: commands in the stream, GPU culling: one per geometry
+        IndirectBuffer  m_indirect_command_buffer; // Written by the GPU cull
+        StreamingBuffer m_draw_command_stream {sizeof(DrawElementsIndirectCommand)}; // Written by the CPU cull
+        StreamingBuffer m_instance_stream {sizeof(GLuint)};                          // Instance -> mesh slot of the CPU cull
 
         //////////////////////////////////////////////// 
         //--------- Shaders
         //////////////////////////////////////////////// 
+        static constexpr GLuint s_CULL_WORKGROUP_SIZE = 64; // local_size_x of the compute shader
+        static constexpr size_t s_MIN_MESH_SLOTS      = 64;
+        static constexpr size_t s_MIN_GEOMETRIES      = 16;
+        static constexpr GLuint s_FREE_SLOT           = UINT32_MAX; // Geometry of a free slot, same value in the compute shader
+
         #ifdef __INTELLISENSE__
-            static constexpr char s_VERTEX_SHADER_CODE[]   = {};
-            static constexpr char s_FRAGMENT_SHADER_CODE[] = {};
+            static constexpr char s_VERTEX_SHADER_CODE[]       = {};
+            static constexpr char s_FRAGMENT_SHADER_CODE[]     = {};
+            static constexpr char s_CULL_COMPUTE_SHADER_CODE[] = {};
         #else 
             static constexpr char s_VERTEX_SHADER_CODE[]   = { 
                 #embed "shaders/shader_IndirectDraw3D.vert" suffix(, '\0') 
@@ -103,6 +265,10 @@ namespace CoreEngine
             static constexpr char s_FRAGMENT_SHADER_CODE[] = { 
                 #embed "shaders/shader_IndirectDraw3D.frag" suffix(, '\0') 
             };
+
+            static constexpr char s_CULL_COMPUTE_SHADER_CODE[] = { 
+                #embed "shaders/shader_IndirectDraw3D.comp" suffix(, '\0') 
+            };
         #endif
     };
 }
\ No newline at end of file
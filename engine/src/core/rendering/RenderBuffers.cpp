@@ -1,7 +1,39 @@
 #include "core/rendering/RenderBuffers.h"
 
+#include "core/utility/Assert.h"
+#include "core/utility/Performance.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
 namespace CoreEngine
 {
+namespace
+{
+    //Returns the new buffer, the old one is deleted
+    [[nodiscard]] GLuint GrowBufferKeepingData(const GLuint old_buffer, const GLsizeiptr old_size, const GLsizeiptr new_size)
+    {
+        GLuint new_buffer {0};
+        glGenBuffers(1, &new_buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, new_buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, new_size, nullptr, GL_DYNAMIC_DRAW);
+
+        if (old_size > 0)
+        {
+            glBindBuffer(GL_COPY_READ_BUFFER, old_buffer);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, old_size);
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        }
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        if (old_buffer)
+        {
+            glDeleteBuffers(1, &old_buffer);
+        }
+        return new_buffer;
+    }
+}
     //------------------------------- VBO
     VBO::VBO(const std::vector<Vertex>& vertices)
     {
@@ -52,6 +84,18 @@ namespace CoreEngine
         Unbind();
     }
 
+    void VBO::SetSubData(const void* data, const GLsizeiptr size, const GLintptr offset)
+    {
+        Bind();
+        glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+        Unbind();
+    }
+
+    void VBO::Grow(const GLsizeiptr old_size, const GLsizeiptr new_size)
+    {
+        m_ID = GrowBufferKeepingData(m_ID, old_size, new_size);
+    }
+
     void VBO::Bind()
     {
         glBindBuffer(GL_ARRAY_BUFFER, m_ID);
@@ -97,6 +141,16 @@ namespace CoreEngine
         Unbind();
     }
 
+    void VAO::LinkAttribute(StreamingBuffer& buffer, GLuint layout, GLuint numComponents, GLenum type, GLsizeiptr stride, void* offset)
+    {
+        Bind();
+        buffer.Bind(GL_ARRAY_BUFFER);
+        glVertexAttribPointer(layout, numComponents, type, GL_FALSE,  stride, offset);
+        glEnableVertexAttribArray(layout);
+        buffer.Unbind(GL_ARRAY_BUFFER);
+        Unbind();
+    }
+
     void VAO::Bind()
     {
         glBindVertexArray(m_ID);
@@ -145,6 +199,19 @@ namespace CoreEngine
         Unbind();
     }
 
+    void EBO::SetSubData(const void* data, const GLsizeiptr size, const GLintptr offset)
+    {
+        //Through GL_COPY_WRITE_BUFFER, binding GL_ELEMENT_ARRAY_BUFFER would change the bound VAO
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_ID);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+
+    void EBO::Grow(const GLsizeiptr old_size, const GLsizeiptr new_size)
+    {
+        m_ID = GrowBufferKeepingData(m_ID, old_size, new_size);
+    }
+
     void EBO::Bind()
     {
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ID);
@@ -351,4 +418,136 @@ namespace CoreEngine
     {
         return m_ID;
     }
+
+    //------------------------------- Streaming Buffer
+    StreamingBuffer::StreamingBuffer(const GLsizeiptr element_size)
+    :   m_element_size(element_size)
+    {
+    }
+
+    StreamingBuffer::~StreamingBuffer()
+    {
+        Delete();
+    }
+
+    void* StreamingBuffer::BeginWrite(const GLsizeiptr size)
+    {
+        if (size > m_region_size)
+        {
+            Reallocate(size);
+        }
+
+        m_current_region = (m_current_region + 1) % REGION_COUNT;
+        WaitForRegion(m_current_region);
+        return m_mapped_memory + GetCurrentOffset();
+    }
+
+    void StreamingBuffer::Write(const void* data, const GLsizeiptr size)
+    {
+        void* region_memory = BeginWrite(size);
+        if (size > 0)
+        {
+            std::memcpy(region_memory, data, static_cast<size_t>(size));
+        }
+    }
+
+    void StreamingBuffer::FenceCurrentRegion()
+    {
+        if (! m_ID)
+            return;
+
+        GLsync& fence = m_region_fences[m_current_region];
+        if (fence)
+        {
+            glDeleteSync(fence);
+        }
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    void StreamingBuffer::WaitForRegion(const GLuint region)
+    {
+        GLsync& fence = m_region_fences[region];
+        if (! fence)
+            return;
+
+        //Normally signaled long ago, REGION_COUNT - 1 frames passed since
+        if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+        {
+            ENGINE_PERFORMANCE_LOG_OCCURENCE("StreamingBuffer waited for GPU: ", 1);
+            constexpr GLuint64 ONE_SECOND_NS = 1'000'000'000;
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, ONE_SECOND_NS) == GL_TIMEOUT_EXPIRED) {}
+        }
+
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    void StreamingBuffer::Reallocate(const GLsizeiptr min_region_size)
+    {
+        //Regions start at multiples of both the offset alignment & the element size
+        const GLsizeiptr unit = std::lcm(REGION_ALIGNMENT, m_element_size);
+        const GLsizeiptr grown_size = std::max(min_region_size, m_region_size + m_region_size / 2);
+        const GLsizeiptr new_region_size = std::max<GLsizeiptr>((grown_size + unit - 1) / unit, 1) * unit;
+
+        //The driver keeps the old storage alive until the GPU is done with it
+        Delete();
+        m_region_size = new_region_size;
+
+        constexpr GLbitfield FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glGenBuffers(1, &m_ID);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_ID);
+        glBufferStorage(GL_COPY_WRITE_BUFFER, m_region_size * REGION_COUNT, nullptr, FLAGS);
+        m_mapped_memory = static_cast<std::byte*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, m_region_size * REGION_COUNT, FLAGS));
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        ENGINE_ASSERT(m_mapped_memory && "At StreamingBuffer::Reallocate(): Persistent mapping failed.");
+    }
+
+    void StreamingBuffer::Bind(const GLenum target)
+    {
+        glBindBuffer(target, m_ID);
+    }
+
+    void StreamingBuffer::Unbind(const GLenum target)
+    {
+        glBindBuffer(target, 0);
+    }
+
+    void StreamingBuffer::BindRange(const GLenum target, const GLuint binding)
+    {
+        if (! m_ID)
+            return;
+
+        glBindBufferRange(target, binding, m_ID, GetCurrentOffset(), m_region_size);
+    }
+
+    GLintptr StreamingBuffer::GetCurrentOffset() const
+    {
+        return static_cast<GLintptr>(m_current_region) * m_region_size;
+    }
+
+    GLuint StreamingBuffer::GetID() const
+    {
+        return m_ID;
+    }
+
+    void StreamingBuffer::Delete()
+    {
+        for (GLsync& fence : m_region_fences)
+        {
+            if (fence)
+            {
+                glDeleteSync(fence);
+                fence = nullptr;
+            }
+        }
+
+        if(m_ID)
+        {
+            //Deleting unmaps as well
+            glDeleteBuffers(1, &m_ID);
+            m_ID = 0;
+            m_mapped_memory = nullptr;
+        }
+    }
 }
\ No newline at end of file
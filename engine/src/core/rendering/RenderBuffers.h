@@ -4,6 +4,7 @@
 #include <iostream>
 #include <vector>
 #include <array>
+#include <cstddef>
 
 //Own includes
 #include "core/model/Model.h"
@@ -19,6 +20,8 @@ namespace CoreEngine
         GLuint baseInstance;  // Mesh index (for SSBO lookup)     
     };
 
+    class StreamingBuffer;
+
     class VBO
     {
         private:
@@ -61,6 +64,11 @@ namespace CoreEngine
 
             void SetNewData(const void* data, const GLuint size_of_data);
 
+            void SetSubData(const void* data, const GLsizeiptr size, const GLintptr offset);
+
+            /// @brief New storage of new_size bytes, the first old_size bytes are copied over on the GPU. Changes the ID, relink VAOs
+            void Grow(const GLsizeiptr old_size, const GLsizeiptr new_size);
+
             void Bind();
             void Unbind();
 
@@ -94,6 +102,9 @@ namespace CoreEngine
             /// @param offset The numComponents of attributes that are before this one
             void LinkAttribute(VBO& VBO, GLuint layout, GLuint numComponents, GLenum type, GLsizeiptr stride, void* offset);
 
+            /// @brief Same as above for a StreamingBuffer. Relink after it grew, its ID changes
+            void LinkAttribute(StreamingBuffer& buffer, GLuint layout, GLuint numComponents, GLenum type, GLsizeiptr stride, void* offset);
+
             /// @brief Binds this VAO
             void Bind();
 
@@ -128,6 +139,11 @@ namespace CoreEngine
             /// @param indices New indices data to be stored
             void SetNewData(const std::vector<GLuint>& indices);
 
+            void SetSubData(const void* data, const GLsizeiptr size, const GLintptr offset);
+
+            /// @brief New storage of new_size bytes, the first old_size bytes are copied over on the GPU. Changes the ID, rebind to VAOs
+            void Grow(const GLsizeiptr old_size, const GLsizeiptr new_size);
+
             /// @brief Bind this EBO
             void Bind();
 
@@ -235,4 +251,58 @@ namespace CoreEngine
 
             [[nodiscard]] GLuint GetID() const;
     };
+
+    /// @brief Persistently & coherently mapped buffer for data that is rewritten every frame.
+    /// Split into REGION_COUNT regions, every write goes to the next one once the fence of its last use signaled - writing is
+    /// a memcpy, without the implicit syncs of glBufferSubData or the reallocations of glBufferData. Only growing reallocates.
+    class StreamingBuffer
+    {
+        public:
+            static constexpr GLuint     REGION_COUNT     = 3;
+            static constexpr GLsizeiptr REGION_ALIGNMENT = 256; // Largest GL_*_BUFFER_OFFSET_ALIGNMENT allowed by the spec
+
+        private:
+            GLuint     m_ID {0};
+            std::byte* m_mapped_memory {nullptr};
+            GLsizeiptr m_element_size;
+            GLsizeiptr m_region_size {0};
+            GLuint     m_current_region {0};
+            std::array<GLsync, REGION_COUNT> m_region_fences {};
+
+            void Reallocate(const GLsizeiptr min_region_size);
+            void WaitForRegion(const GLuint region);
+            void Delete();
+
+        public:
+            /// @param element_size Regions also start at multiples of it, so offsets can be passed as first vertex / element
+            explicit StreamingBuffer(const GLsizeiptr element_size = 1);
+            ~StreamingBuffer();
+
+//------------------------- Copy/Move behaviour
+            StreamingBuffer(const StreamingBuffer&)            = delete;
+            StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+            StreamingBuffer(StreamingBuffer&&)                 = delete;
+            StreamingBuffer& operator=(StreamingBuffer&&)      = delete;
+//-------------------------
+
+            /// @brief Moves on to the next region & returns its mapped memory, at least size bytes. Its previous content is undefined
+            [[nodiscard]] void* BeginWrite(const GLsizeiptr size);
+
+            /// @brief BeginWrite() & memcpy
+            void Write(const void* data, const GLsizeiptr size);
+
+            /// @brief Call after the last GL command reading the current region was issued
+            void FenceCurrentRegion();
+
+            void Bind(const GLenum target);
+            void Unbind(const GLenum target);
+
+            /// @brief glBindBufferRange() of the current region, does nothing before the first write
+            void BindRange(const GLenum target, const GLuint binding);
+
+            [[nodiscard]] GLintptr GetCurrentOffset() const;
+
+            [[nodiscard]] GLuint GetID() const;
+    };
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 //std
 #include <iostream>
+#include <string>
 
 //Own includes
 #include "core/utility/CommonUtility.h"
@@ -51,6 +52,35 @@ namespace CoreEngine
         glDeleteShader(fragment_shader);
     }
 
+    Shader::Shader(const char* compute, const ProvidedPointers meaning)
+    {
+        std::string compute_file_content;
+        const char* compute_source_code = compute;
+        if (meaning == Shader::ProvidedPointers::ARE_FILE_PATHS)
+        {
+            compute_file_content = CommonUtility::ReadFileToString(compute);
+            compute_source_code  = compute_file_content.c_str();
+        }
+        else if (meaning != Shader::ProvidedPointers::ARE_SOURCE_CODE)
+        {
+            ENGINE_ASSERT(false && ("At Shader::Shader() \"PointerMeaning\" is not recognizable: " + std::to_string(static_cast<int>(meaning))).c_str());
+        }
+
+        constexpr const bool IS_PROGRAM_LINK_ERR = true;
+
+        GLuint compute_shader = glCreateShader(GL_COMPUTE_SHADER);
+        glShaderSource(compute_shader, 1, &compute_source_code, NULL);
+        glCompileShader(compute_shader);
+        PrintCompilationErrors(compute_shader, !IS_PROGRAM_LINK_ERR);
+
+        this->ID = glCreateProgram();
+        glAttachShader(this->ID, compute_shader);
+        glLinkProgram(this->ID);
+        PrintCompilationErrors(ID, IS_PROGRAM_LINK_ERR);
+
+        glDeleteShader(compute_shader);
+    }
+
     Shader::~Shader()
     {
         Delete();
@@ -21,6 +21,8 @@ namespace CoreEngine
             };
 
             explicit Shader(const char* vertex, const char* fragment, const ProvidedPointers meaning);
+            //Compute shader program
+            explicit Shader(const char* compute, const ProvidedPointers meaning);
             ~Shader();
 
 //--------------- Copy/Move behaviour
@@ -6,9 +6,24 @@
 
 //Std
 #include <iostream>
+#include <utility>
 
 namespace CoreEngine
 {
+namespace
+{
+    //Pixel format & internal format
+    [[nodiscard]] std::pair<GLenum, GLenum> GetFormatsFromAmountChannels(int amount_channels) noexcept
+    {
+        switch (amount_channels)
+        {
+            case 1:  return { GL_RED, GL_R8 };
+            case 2:  return { GL_RG,  GL_RG8 };
+            case 3:  return { GL_RGB, GL_RGB8 };
+            default: return { GL_RGBA, GL_RGBA8 };
+        }
+    }
+}
     Texture::Texture(const char* file_path)
     {
         stbi_set_flip_vertically_on_load(false);
@@ -81,6 +96,13 @@ namespace CoreEngine
         glMakeTextureHandleResidentARB(m_bindless_handle);
     }
 
+    Texture::Texture(DeferredUpload)
+    :   m_width_img(0),
+        m_height_img(0),
+        m_amount_channels_img(0)
+    {
+    }
+
     Texture::Texture(Texture&& _tex) 
     :  m_ID(_tex.m_ID), 
         m_bindless_handle(_tex.m_bindless_handle), 
@@ -111,20 +133,8 @@ namespace CoreEngine
             glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, maxAniso);
         }
 
-        GLenum format         = GL_RGBA;
-        GLenum internalFormat = GL_RGBA8;
-        GLenum pixelType      = GL_UNSIGNED_BYTE;
-
-        if (m_amount_channels_img == 1) 
-        {
-            format = GL_RED;
-            internalFormat = GL_R8;
-        } 
-        else if (m_amount_channels_img == 3) 
-        {
-            format = GL_RGB;
-            internalFormat = GL_RGB8;
-        }
+        const auto [format, internalFormat] = GetFormatsFromAmountChannels(m_amount_channels_img);
+        const GLenum pixelType              = GL_UNSIGNED_BYTE;
 
         glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_width_img, m_height_img, 0, format, pixelType, m_data_img);
 
@@ -160,6 +170,49 @@ namespace CoreEngine
         glBindTexture(GL_TEXTURE_2D, 0);
     }
 
+    void Texture::Upload(const unsigned char* pixels, std::span<const MipLevel> mip_levels, int amount_channels)
+    {
+        if (m_ID != 0 || ! pixels || mip_levels.empty()) 
+        {
+            std::cout << "At Texture::Upload(): Texture is already uploaded or has no pixels." << std::endl;
+            return;
+        }
+
+        m_width_img           = mip_levels[0].m_width;
+        m_height_img          = mip_levels[0].m_height;
+        m_amount_channels_img = amount_channels;
+
+        const auto [format, internalFormat] = GetFormatsFromAmountChannels(amount_channels);
+
+        //Immutable storage for exactly the given levels, no mipmap generation on the driver
+        glCreateTextures(GL_TEXTURE_2D, 1, &m_ID);
+        glTextureStorage2D(m_ID, static_cast<GLsizei>(mip_levels.size()), internalFormat, m_width_img, m_height_img);
+
+        GLint previous_alignment = 4;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &previous_alignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (size_t level = 0; level < mip_levels.size(); level++)
+        {
+            const MipLevel& mip = mip_levels[level];
+            glTextureSubImage2D(m_ID, static_cast<GLint>(level), 0, 0, mip.m_width, mip.m_height, format, GL_UNSIGNED_BYTE, pixels + mip.m_offset);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, previous_alignment);
+
+        glTextureParameteri(m_ID, GL_TEXTURE_MIN_FILTER, mip_levels.size() > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTextureParameteri(m_ID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTextureParameteri(m_ID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTextureParameteri(m_ID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+        GLfloat maxAniso = 0.0f;
+        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &maxAniso);
+        if (maxAniso > 1.0f) {
+            glTextureParameterf(m_ID, GL_TEXTURE_MAX_ANISOTROPY, maxAniso);
+        }
+
+        m_bindless_handle = glGetTextureHandleARB(m_ID);
+        glMakeTextureHandleResidentARB(m_bindless_handle);
+    }
+
     GLuint Texture::GetID() const
     {
         return m_ID;
@@ -169,4 +222,9 @@ namespace CoreEngine
     {
         return m_bindless_handle;
     }
+
+    bool Texture::IsUploaded() const
+    {
+        return m_ID != 0;
+    }
 }
\ No newline at end of file
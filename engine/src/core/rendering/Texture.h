@@ -9,6 +9,9 @@
 #include <assimp/scene.h>
 //Glm
 #include <glm/glm.hpp>
+//Std
+#include <cstddef>
+#include <span>
 
 namespace CoreEngine
 {
@@ -24,10 +27,19 @@ namespace CoreEngine
             void GenerateGpuTexture();
 
         public:
+            struct DeferredUpload {};
+
+            struct MipLevel
+            {
+                size_t m_offset = 0; // Bytes into the pixel data, rows tightly packed
+                int    m_width  = 0;
+                int    m_height = 0;
+            };
 
             explicit Texture(const char* file_path);
             explicit Texture(const aiTexture* embeddedTexture);
             explicit Texture(const glm::vec3& rgb_color_tex); //Solid color
+            explicit Texture(DeferredUpload); //No GPU texture & bindless handle 0 until Upload()
             explicit Texture(Texture&& _tex);
             ~Texture();
 
@@ -39,7 +51,11 @@ namespace CoreEngine
             void Bind();
             void Unbind();
 
+            //Mip chain decoded elsewhere, e.g. by the TextureCache's workers, level 0 first. Only once, on the GL thread
+            void Upload(const unsigned char* pixels, std::span<const MipLevel> mip_levels, int amount_channels);
+
             [[nodiscard]] GLuint GetID() const;
             [[nodiscard]] GLuint64 GetBindlessHandle() const;
+            [[nodiscard]] bool IsUploaded() const;
     };
 }
\ No newline at end of file
@@ -0,0 +1,434 @@
+#include "core/rendering/TextureCache.h"
+
+#include "core/utility/Performance.h"
+
+//STB, implemented in Texture.cpp
+#include "stb_image.h"
+
+//Std
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+#include <system_error>
+
+namespace CoreEngine
+{
+namespace
+{
+    ////////////////////////////////////////////////
+    //--------- Disk cache format
+    ////////////////////////////////////////////////
+    // Header, then every mip level from largest to 1x1, rows tightly packed (unpack alignment 1)
+    struct DiskCacheHeader
+    {
+        uint32_t m_magic            = 0;
+        uint32_t m_version          = 0;
+        uint64_t m_source_hash      = 0;
+        uint32_t m_width            = 0;
+        uint32_t m_height           = 0;
+        uint32_t m_amount_channels  = 0;
+        uint32_t m_amount_mip_levels = 0;
+    };
+    static_assert(sizeof(DiskCacheHeader) == 32, "Expected sizeof(DiskCacheHeader) to be 32 Bytes long");
+
+    constexpr uint32_t s_DISK_CACHE_MAGIC   = 0x43584554; // "TEXC"
+    constexpr uint32_t s_DISK_CACHE_VERSION = 1;
+
+    [[nodiscard]] std::filesystem::path GetDiskCacheFilePath(const std::filesystem::path& directory, size_t source_hash) noexcept
+    {
+        std::ostringstream name;
+        name << std::hex << source_hash << ".texc";
+        return directory / name.str();
+    }
+
+    [[nodiscard]] bool ReadFileBytes(const std::string& path, std::vector<unsigned char>& out_bytes) noexcept
+    {
+        std::ifstream file (std::filesystem::path(path), std::ios::binary | std::ios::ate);
+        if (! file)
+            return false;
+
+        const std::streamsize size = file.tellg();
+        if (size <= 0)
+            return false;
+
+        out_bytes.resize(static_cast<size_t>(size));
+        file.seekg(0);
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(out_bytes.data()), size));
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Mip chains
+    ////////////////////////////////////////////////
+    [[nodiscard]] std::vector<Texture::MipLevel> BuildMipLevels(int width, int height, int amount_channels) noexcept
+    {
+        std::vector<Texture::MipLevel> levels;
+        size_t offset = 0;
+        while (true)
+        {
+            levels.push_back(Texture::MipLevel{ offset, width, height });
+            offset += size_t(width) * height * amount_channels;
+            if (width == 1 && height == 1)
+                break;
+            width  = std::max(width / 2, 1);
+            height = std::max(height / 2, 1);
+        }
+        return levels;
+    }
+
+    [[nodiscard]] size_t GetMipChainSize(const std::vector<Texture::MipLevel>& levels, int amount_channels) noexcept
+    {
+        return levels.empty() ? 0 : levels.back().m_offset + size_t(levels.back().m_width) * levels.back().m_height * amount_channels;
+    }
+
+    // Fills every level after the first with a 2x2 box filter of the previous one, odd edges clamp
+    void GenerateMipChain(unsigned char* pixels, const std::vector<Texture::MipLevel>& levels, int amount_channels) noexcept
+    {
+        for (size_t level = 1; level < levels.size(); level++)
+        {
+            const Texture::MipLevel& source = levels[level - 1];
+            const Texture::MipLevel& target = levels[level];
+            const unsigned char* source_pixels = pixels + source.m_offset;
+            unsigned char*       target_pixels = pixels + target.m_offset;
+
+            for (int y = 0; y < target.m_height; y++)
+            {
+                const size_t row_0 = size_t(std::min(y * 2,     source.m_height - 1)) * source.m_width;
+                const size_t row_1 = size_t(std::min(y * 2 + 1, source.m_height - 1)) * source.m_width;
+                for (int x = 0; x < target.m_width; x++)
+                {
+                    const size_t column_0 = size_t(std::min(x * 2,     source.m_width - 1));
+                    const size_t column_1 = size_t(std::min(x * 2 + 1, source.m_width - 1));
+                    for (int c = 0; c < amount_channels; c++)
+                    {
+                        const unsigned sum = source_pixels[(row_0 + column_0) * amount_channels + c] + source_pixels[(row_0 + column_1) * amount_channels + c]
+                                           + source_pixels[(row_1 + column_0) * amount_channels + c] + source_pixels[(row_1 + column_1) * amount_channels + c];
+                        target_pixels[(size_t(y) * target.m_width + x) * amount_channels + c] = static_cast<unsigned char>((sum + 2) / 4);
+                    }
+                }
+            }
+        }
+    }
+}
+    TextureCache& TextureCache::Get() noexcept
+    {
+        static TextureCache s_texture_cache;
+        return s_texture_cache;
+    }
+
+    TextureCache::TextureCache() noexcept
+    {
+        const size_t hardware_threads = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+        const size_t amount_workers   = std::min(hardware_threads - 1, s_MAX_WORKERS);
+        m_workers.reserve(amount_workers);
+        for (size_t i = 0; i < amount_workers; i++)
+        {
+            m_workers.emplace_back([this](std::stop_token stop_token) { WorkerLoop(stop_token); });
+        }
+    }
+
+    std::shared_ptr<Texture> TextureCache::GetFromFile(const std::string& path) noexcept
+    {
+        std::error_code error;
+        const std::filesystem::path canonical_path = std::filesystem::weakly_canonical(path, error);
+        if (error || ! std::filesystem::exists(canonical_path, error))
+        {
+            return nullptr;
+        }
+
+        DecodeJob job {};
+        job.m_path = canonical_path.string();
+        return Enqueue(TextureKey{ glfwGetCurrentContext(), job.m_path }, std::move(job));
+    }
+
+    std::shared_ptr<Texture> TextureCache::GetEmbedded(const aiTexture* embedded_texture) noexcept
+    {
+        //mHeight 0: mWidth bytes of a compressed file, otherwise mWidth * mHeight raw texels
+        const bool   is_compressed = embedded_texture->mHeight == 0;
+        const size_t amount_bytes  = is_compressed ? embedded_texture->mWidth : size_t(embedded_texture->mWidth) * embedded_texture->mHeight * sizeof(aiTexel);
+        const auto*  bytes         = reinterpret_cast<const unsigned char*>(embedded_texture->pcData);
+
+        const size_t content_hash = std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(bytes), amount_bytes));
+        TextureKey key { glfwGetCurrentContext(), "*" + std::to_string(content_hash) + ":" + std::to_string(amount_bytes) };
+
+        if (const auto it = m_textures.find(key); it != m_textures.end())
+        {
+            if (std::shared_ptr<Texture> texture = it->second.lock())
+            {
+                return texture;
+            }
+        }
+
+        DecodeJob job {};
+        job.m_encoded.assign(bytes, bytes + amount_bytes);
+        if (! is_compressed)
+        {
+            job.m_raw_width  = static_cast<int>(embedded_texture->mWidth);
+            job.m_raw_height = static_cast<int>(embedded_texture->mHeight);
+        }
+        return Enqueue(std::move(key), std::move(job));
+    }
+
+    std::shared_ptr<Texture> TextureCache::Enqueue(TextureKey&& key, DecodeJob&& job) noexcept
+    {
+        std::weak_ptr<Texture>& cached = m_textures[std::move(key)];
+        if (std::shared_ptr<Texture> texture = cached.lock())
+        {
+            return texture;
+        }
+
+        auto texture  = std::make_shared<Texture>(Texture::DeferredUpload{});
+        cached        = texture;
+        job.m_texture = texture;
+        job.m_context         = glfwGetCurrentContext();
+        job.m_cache_directory = m_disk_cache_directory;
+        m_amount_pending++;
+        {
+            std::scoped_lock lock (m_mutex);
+            m_jobs.push_back(std::move(job));
+        }
+        m_wake.notify_one();
+        return texture;
+    }
+
+    size_t TextureCache::ProcessCompletedUploads(size_t max_bytes) noexcept
+    {
+        if (m_amount_pending == 0)
+            return 0;
+
+        ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("TextureCache::ProcessCompletedUploads()");
+        const GLFWwindow* context = glfwGetCurrentContext();
+
+        //Taken out of the queue under the lock, uploaded without it
+        std::vector<DecodedTexture> to_upload;
+        {
+            std::scoped_lock lock (m_mutex);
+            size_t budget_used = 0;
+            for (auto it = m_completed.begin(); it != m_completed.end() && (to_upload.empty() || budget_used < max_bytes); )
+            {
+                if (it->m_context != context)
+                {
+                    ++it;
+                    continue;
+                }
+                budget_used += it->GetSize();
+                to_upload.push_back(std::move(*it));
+                it = m_completed.erase(it);
+            }
+        }
+
+        size_t amount_uploaded = 0;
+        for (DecodedTexture& decoded : to_upload)
+        {
+            m_amount_pending--;
+            const std::shared_ptr<Texture> texture = decoded.m_texture.lock();
+            if (! texture || decoded.m_mip_levels.empty())
+                continue;
+
+            texture->Upload(decoded.GetPixels(), decoded.m_mip_levels, decoded.m_amount_channels);
+            amount_uploaded++;
+        }
+
+        if (amount_uploaded > 0)
+        {
+            m_generation++;
+        }
+        return amount_uploaded;
+    }
+
+    uint64_t TextureCache::GetGeneration() const noexcept
+    {
+        return m_generation;
+    }
+
+    size_t TextureCache::GetAmountPendingTextures() const noexcept
+    {
+        return m_amount_pending;
+    }
+
+    void TextureCache::SetDiskCacheDirectory(const std::filesystem::path& directory) noexcept
+    {
+        m_disk_cache_directory = directory;
+    }
+
+    const std::filesystem::path& TextureCache::GetDiskCacheDirectory() const noexcept
+    {
+        return m_disk_cache_directory;
+    }
+
+    void TextureCache::WorkerLoop(std::stop_token stop_token) noexcept
+    {
+        while (true)
+        {
+            DecodeJob job;
+            {
+                std::unique_lock lock (m_mutex);
+                if (! m_wake.wait(lock, stop_token, [&] { return ! m_jobs.empty(); }))
+                    return;
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+
+            //Released meanwhile, nothing to load
+            DecodedTexture decoded = job.m_texture.expired() ? DecodedTexture{ job.m_texture, job.m_context } : Load(job);
+
+            std::scoped_lock lock (m_mutex);
+            m_completed.push_back(std::move(decoded));
+        }
+    }
+
+    TextureCache::DecodedTexture TextureCache::Load(DecodeJob& job) noexcept
+    {
+        DecodedTexture decoded { job.m_texture, job.m_context };
+
+        if (! job.m_path.empty() && ! ReadFileBytes(job.m_path, job.m_encoded))
+        {
+            std::cout << "At TextureCache::Load(): Texture failed to load: " << job.m_path << std::endl;
+            return decoded;
+        }
+
+        size_t source_hash = std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(job.m_encoded.data()), job.m_encoded.size()));
+        source_hash ^= (size_t(job.m_raw_width) << 32 | size_t(job.m_raw_height)) + 0x9e3779b97f4a7c15ull + (source_hash << 6) + (source_hash >> 2);
+
+        const std::filesystem::path cache_file_path = job.m_cache_directory.empty() ? std::filesystem::path{} : GetDiskCacheFilePath(job.m_cache_directory, source_hash);
+        if (! cache_file_path.empty() && TryLoadFromDiskCache(cache_file_path, source_hash, decoded))
+        {
+            return decoded;
+        }
+
+        if (! Decode(job, decoded))
+        {
+            std::cout << "At TextureCache::Load(): Texture failed to decode: " << (job.m_path.empty() ? "embedded texture" : job.m_path) << std::endl;
+            return decoded;
+        }
+
+        if (! cache_file_path.empty())
+        {
+            WriteDiskCache(cache_file_path, source_hash, decoded);
+        }
+        return decoded;
+    }
+
+    bool TextureCache::Decode(DecodeJob& job, DecodedTexture& out_decoded) noexcept
+    {
+        int width = 0, height = 0, amount_channels = 0;
+        std::unique_ptr<unsigned char, void(*)(void*)> level_0 {nullptr, &stbi_image_free};
+
+        if (job.m_raw_width <= 0)
+        {
+            level_0.reset(stbi_load_from_memory(job.m_encoded.data(), static_cast<int>(job.m_encoded.size()), &width, &height, &amount_channels, 0));
+            if (! level_0)
+                return false;
+        }
+        else
+        {
+            width           = job.m_raw_width;
+            height          = job.m_raw_height;
+            amount_channels = 4;
+        }
+
+        out_decoded.m_amount_channels = amount_channels;
+        out_decoded.m_mip_levels      = BuildMipLevels(width, height, amount_channels);
+        out_decoded.m_pixels.resize(GetMipChainSize(out_decoded.m_mip_levels, amount_channels));
+
+        if (level_0)
+        {
+            std::memcpy(out_decoded.m_pixels.data(), level_0.get(), size_t(width) * height * amount_channels);
+        }
+        else
+        {
+            //aiTexel is BGRA
+            const size_t amount_texels = size_t(width) * height;
+            for (size_t i = 0; i < amount_texels; i++)
+            {
+                out_decoded.m_pixels[i * 4 + 0] = job.m_encoded[i * 4 + 2];
+                out_decoded.m_pixels[i * 4 + 1] = job.m_encoded[i * 4 + 1];
+                out_decoded.m_pixels[i * 4 + 2] = job.m_encoded[i * 4 + 0];
+                out_decoded.m_pixels[i * 4 + 3] = job.m_encoded[i * 4 + 3];
+            }
+        }
+
+        GenerateMipChain(out_decoded.m_pixels.data(), out_decoded.m_mip_levels, amount_channels);
+        return true;
+    }
+
+    bool TextureCache::TryLoadFromDiskCache(const std::filesystem::path& cache_file_path, size_t source_hash, DecodedTexture& out_decoded) noexcept
+    {
+        MappedFile file;
+        if (! file.Open(cache_file_path) || file.GetSize() < sizeof(DiskCacheHeader))
+            return false;
+
+        DiskCacheHeader header {};
+        std::memcpy(&header, file.GetData(), sizeof(DiskCacheHeader));
+        if (header.m_magic != s_DISK_CACHE_MAGIC || header.m_version != s_DISK_CACHE_VERSION || header.m_source_hash != source_hash
+            || header.m_width == 0 || header.m_height == 0 || header.m_amount_channels == 0 || header.m_amount_channels > 4)
+            return false;
+
+        std::vector<Texture::MipLevel> levels = BuildMipLevels(static_cast<int>(header.m_width), static_cast<int>(header.m_height), static_cast<int>(header.m_amount_channels));
+        if (levels.size() != header.m_amount_mip_levels || file.GetSize() != sizeof(DiskCacheHeader) + GetMipChainSize(levels, static_cast<int>(header.m_amount_channels)))
+            return false;
+
+        out_decoded.m_cache_file        = std::move(file);
+        out_decoded.m_cache_file_offset = sizeof(DiskCacheHeader);
+        out_decoded.m_mip_levels        = std::move(levels);
+        out_decoded.m_amount_channels   = static_cast<int>(header.m_amount_channels);
+        return true;
+    }
+
+    void TextureCache::WriteDiskCache(const std::filesystem::path& cache_file_path, size_t source_hash, const DecodedTexture& decoded) noexcept
+    {
+        const DiskCacheHeader header 
+        {
+            .m_magic             = s_DISK_CACHE_MAGIC,
+            .m_version           = s_DISK_CACHE_VERSION,
+            .m_source_hash       = source_hash,
+            .m_width             = static_cast<uint32_t>(decoded.m_mip_levels.front().m_width),
+            .m_height            = static_cast<uint32_t>(decoded.m_mip_levels.front().m_height),
+            .m_amount_channels   = static_cast<uint32_t>(decoded.m_amount_channels),
+            .m_amount_mip_levels = static_cast<uint32_t>(decoded.m_mip_levels.size())
+        };
+
+        std::error_code error;
+        std::filesystem::create_directories(cache_file_path.parent_path(), error);
+        if (error)
+            return;
+
+        //Written under a temporary name first, a half written file is never mistaken for a cache entry
+        std::filesystem::path temporary_path = cache_file_path;
+        temporary_path += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+        {
+            std::ofstream file (temporary_path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(DiskCacheHeader));
+            file.write(reinterpret_cast<const char*>(decoded.GetPixels()), static_cast<std::streamsize>(decoded.GetSize()));
+            if (! file)
+            {
+                file.close();
+                std::filesystem::remove(temporary_path, error);
+                return;
+            }
+        }
+        std::filesystem::rename(temporary_path, cache_file_path, error);
+        if (error)
+        {
+            std::filesystem::remove(temporary_path, error);
+        }
+    }
+
+    const unsigned char* TextureCache::DecodedTexture::GetPixels() const noexcept
+    {
+        return m_cache_file.IsOpen() ? m_cache_file.GetData() + m_cache_file_offset : m_pixels.data();
+    }
+
+    size_t TextureCache::DecodedTexture::GetSize() const noexcept
+    {
+        return GetMipChainSize(m_mip_levels, m_amount_channels);
+    }
+
+    size_t TextureCache::TextureKeyHash::operator()(const TextureKey& key) const noexcept
+    {
+        const size_t source_hash = std::hash<std::string>{}(key.m_source);
+        return source_hash ^ (std::hash<const void*>{}(key.m_context) + 0x9e3779b97f4a7c15ull + (source_hash << 6) + (source_hash >> 2));
+    }
+}
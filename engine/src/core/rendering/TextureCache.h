@@ -0,0 +1,119 @@
+#pragma once
+
+#include "core/rendering/Texture.h"
+#include "core/utility/MappedFile.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace CoreEngine
+{
+    ////////////////////////////////////////////////
+    //--------- Texture cache
+    ////////////////////////////////////////////////
+    // Loads textures without blocking the GL thread. Decoding runs on worker threads, the decoded pixels wait in a
+    // completion queue until ProcessCompletedUploads() uploads them on the GL thread. Until then the texture has bindless
+    // handle 0, which the shaders treat as "no texture" & fall back to the material factors. Textures are shared while
+    // in use: by canonical path, embedded ones by a hash of their bytes. Windows don't share GL contexts, so every
+    // texture belongs to the context current when it was requested. Request & upload from the main thread only.
+    // Decoded textures & their mip chains are written to a disk cache, keyed by a hash of the source bytes. Later loads
+    // of the same source map the cached file & upload from it directly, without decoding or generating mipmaps.
+    class TextureCache final
+    {
+    public:
+        [[nodiscard]] static TextureCache& Get() noexcept;
+
+        // nullptr if the file doesn't exist
+        [[nodiscard]] std::shared_ptr<Texture> GetFromFile(const std::string& path) noexcept;
+        // The texture's bytes are copied, the aiScene may be freed right after
+        [[nodiscard]] std::shared_ptr<Texture> GetEmbedded(const aiTexture* embedded_texture) noexcept;
+
+        // Uploads the decoded textures of the current context, stops after max_bytes (at least one texture) to keep
+        // frames short. Returns how many were uploaded
+        size_t ProcessCompletedUploads(size_t max_bytes = s_DEFAULT_UPLOAD_BUDGET_BYTES) noexcept;
+
+        // Incremented whenever textures got uploaded, users caching bindless handles fetch them again on change
+        [[nodiscard]] uint64_t GetGeneration() const noexcept;
+        [[nodiscard]] size_t GetAmountPendingTextures() const noexcept;
+
+        // Empty path disables the disk cache. Affects textures requested afterwards
+        void SetDiskCacheDirectory(const std::filesystem::path& directory) noexcept;
+        [[nodiscard]] const std::filesystem::path& GetDiskCacheDirectory() const noexcept;
+
+        TextureCache(const TextureCache&)            = delete;
+        TextureCache& operator=(const TextureCache&) = delete;
+
+    private:
+        static constexpr size_t s_DEFAULT_UPLOAD_BUDGET_BYTES = 32ull * 1024 * 1024;
+        static constexpr size_t s_MAX_WORKERS                 = 4;
+
+        TextureCache() noexcept;
+
+        struct TextureKey
+        {
+            const GLFWwindow* m_context = nullptr;
+            std::string       m_source;         // Canonical path, or "*<hash>:<size>" for embedded data
+
+            [[nodiscard]] bool operator==(const TextureKey&) const noexcept = default;
+        };
+
+        struct TextureKeyHash
+        {
+            [[nodiscard]] size_t operator()(const TextureKey& key) const noexcept;
+        };
+
+        struct DecodeJob
+        {
+            std::weak_ptr<Texture>     m_texture;
+            const GLFWwindow*          m_context = nullptr;
+            std::filesystem::path      m_cache_directory;
+            std::string                m_path;        // Empty for embedded data, read by the worker
+            std::vector<unsigned char> m_encoded;     // Compressed file bytes, or raw BGRA8 texels if m_raw_width > 0
+            int                        m_raw_width  = 0;
+            int                        m_raw_height = 0;
+        };
+
+        struct DecodedTexture
+        {
+            std::weak_ptr<Texture>         m_texture;
+            const GLFWwindow*              m_context = nullptr;
+            std::vector<unsigned char>     m_pixels            {}; // Every mip level, unless loaded from the disk cache
+            MappedFile                     m_cache_file        {};
+            size_t                         m_cache_file_offset = 0;
+            std::vector<Texture::MipLevel> m_mip_levels        {}; // Empty if loading failed
+            int                            m_amount_channels   = 0;
+
+            [[nodiscard]] const unsigned char* GetPixels() const noexcept;
+            [[nodiscard]] size_t GetSize() const noexcept;
+        };
+
+        [[nodiscard]] std::shared_ptr<Texture> Enqueue(TextureKey&& key, DecodeJob&& job) noexcept;
+        void WorkerLoop(std::stop_token stop_token) noexcept;
+        [[nodiscard]] static DecodedTexture Load(DecodeJob& job) noexcept;
+        [[nodiscard]] static bool Decode(DecodeJob& job, DecodedTexture& out_decoded) noexcept;
+        [[nodiscard]] static bool TryLoadFromDiskCache(const std::filesystem::path& cache_file_path, size_t source_hash, DecodedTexture& out_decoded) noexcept;
+        static void WriteDiskCache(const std::filesystem::path& cache_file_path, size_t source_hash, const DecodedTexture& decoded) noexcept;
+
+        //Main thread only
+        std::unordered_map<TextureKey, std::weak_ptr<Texture>, TextureKeyHash> m_textures;
+        uint64_t                                                              m_generation = 0;
+        size_t                                                                m_amount_pending = 0;
+        std::filesystem::path                                                 m_disk_cache_directory {"resources/texture_cache"};
+
+        //Shared with the workers
+        mutable std::mutex          m_mutex;
+        std::condition_variable_any m_wake;
+        std::deque<DecodeJob>       m_jobs;
+        std::vector<DecodedTexture> m_completed;
+        std::vector<std::jthread>   m_workers; // Last, joined before the rest is destroyed
+    };
+}
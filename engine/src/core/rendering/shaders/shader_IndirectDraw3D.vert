@@ -1,12 +1,5 @@
 #version 460 core
 
-/////////////////////////////////////////////// 
-//--------- Layout in variables
-//////////////////////////////////////////////// 
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
-layout (location = 2) in vec2 aTexUV;
-
 /////////////////////////////////////////////// 
 //--------- SSBOs
 //////////////////////////////////////////////// 
@@ -20,6 +13,35 @@ layout(std430, binding = 3) buffer ActiveIndicesBuffer
     uint active_draw_indices[];
 };
 
+layout(std430, binding = 7) readonly buffer MeshGeometryBuffer 
+{
+    uint mesh_geometries[];
+};
+
+//Vertices are pulled, gl_VertexID already includes the command's baseVertex
+//Vertex: position xyz, normal xyz, uv xy
+layout(std430, binding = 8) readonly buffer VertexBuffer 
+{
+    float vertices[];
+};
+
+//PackedVertex: unorm16 position xy, unorm16 position z, snorm16 octahedral normal, half uv
+layout(std430, binding = 9) readonly buffer PackedVertexBuffer 
+{
+    uvec4 packed_vertices[];
+};
+
+struct GeometryDecodeData
+{
+    vec4 position_min;    // w: 1 if packed
+    vec4 position_extent;
+};
+
+layout(std430, binding = 10) readonly buffer GeometryDecodeBuffer 
+{
+    GeometryDecodeData geometry_decode_data[];
+};
+
 /////////////////////////////////////////////// 
 //--------- UBOs
 //////////////////////////////////////////////// 
@@ -35,13 +57,42 @@ out vec3 normal;
 out vec2 tex_uv;
 out uint calculated_model_index;
 
+vec3 DecodeOctahedral(vec2 encoded)
+{
+    vec3 n  = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float t = max(-n.z, 0.0);
+    n.x    += n.x >= 0.0 ? -t : t;
+    n.y    += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
 void main()
 {
     calculated_model_index = active_draw_indices[gl_BaseInstance + gl_InstanceID];
+    GeometryDecodeData decode = geometry_decode_data[mesh_geometries[calculated_model_index]];
+
+    vec3 local_position;
+    vec3 local_normal;
+    vec2 vertex_uv;
+    if (decode.position_min.w != 0.0)
+    {
+        uvec4 packed_vertex = packed_vertices[gl_VertexID];
+        local_position = decode.position_min.xyz + decode.position_extent.xyz * vec3(unpackUnorm2x16(packed_vertex.x), unpackUnorm2x16(packed_vertex.y).x);
+        local_normal   = DecodeOctahedral(unpackSnorm2x16(packed_vertex.z));
+        vertex_uv      = unpackHalf2x16(packed_vertex.w);
+    }
+    else
+    {
+        int base = gl_VertexID * 8;
+        local_position = vec3(vertices[base + 0], vertices[base + 1], vertices[base + 2]);
+        local_normal   = vec3(vertices[base + 3], vertices[base + 4], vertices[base + 5]);
+        vertex_uv      = vec2(vertices[base + 6], vertices[base + 7]);
+    }
+
     mat4 model             = model_matrices[calculated_model_index];
-    vertex_world_pos       = vec3(model * vec4(aPos, 1.0f));
+    vertex_world_pos       = vec3(model * vec4(local_position, 1.0f));
     view_direction         = normalize(cam_pos - vertex_world_pos);
-    normal                 = normalize(mat3(transpose(inverse(model))) * aNormal);
-    tex_uv                 = aTexUV;
+    normal                 = normalize(mat3(transpose(inverse(model))) * local_normal);
+    tex_uv                 = vertex_uv;
     gl_Position            = cam_matrix * vec4(vertex_world_pos, 1.0);
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "core/scene/Scene3D_SceneObject.h"
 #include "core/scene/Scene3D_ObjectBuilder.h"
 
+#include "core/utility/FrameArena.h"
 #include "core/utility/MathUtility.h"
 #include "core/utility/Units.h"
 
@@ -26,7 +27,8 @@ namespace CoreEngine
         void OnDrawBtDebug() noexcept;
         void SetDebugDrawer(btIDebugDraw* drawer) noexcept;
 
-        [[nodiscard]] const std::vector<Basic_Model*> GetRenderModelVector() const noexcept;
+        // Frame temporary by default, pass another resource to keep it past the end of the frame
+        [[nodiscard]] std::pmr::vector<Basic_Model*> GetRenderModelVector(std::pmr::memory_resource* resource = &FrameArena::GetThreadLocal()) const noexcept;
         [[nodiscard]] const std::vector<Light>& GetLightVectorConstRef() const noexcept;
         [[nodiscard]] std::vector<glm::vec3> GetDebugLinesAllObjects() const noexcept;
         [[nodiscard]] std::vector<std::unique_ptr<Scene3D_SceneObject>>& GetSceneObjectsRef() noexcept;
@@ -0,0 +1,262 @@
+#include "core/utility/AllocationTracker.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <new>
+
+namespace CoreEngine
+{
+namespace
+{
+    // One writer per set (its thread) except for the shared overflow set, hence atomics everywhere.
+    // All of these are constant initialized, so counting works before main() and during static destruction.
+    struct alignas(64) ThreadCounters
+    {
+        std::atomic<uint64_t> m_allocations   {0};
+        std::atomic<uint64_t> m_deallocations {0};
+        std::atomic<uint64_t> m_bytes         {0};
+        std::array<std::atomic<uint64_t>, AllocationTracker::AMOUNT_SIZE_CLASSES> m_size_classes {};
+    };
+
+    struct ScopeCounters
+    {
+        std::atomic<uint64_t> m_allocations {0};
+        std::atomic<uint64_t> m_bytes       {0};
+    };
+
+    constexpr size_t NO_SCOPE_INDEX = ScopeProfiler::MAX_SCOPES;
+
+    std::array<ThreadCounters, AllocationTracker::MAX_THREADS + 1> g_thread_counters;  // Last = overflow
+    std::atomic<size_t>                                            g_amount_threads {0};
+    std::array<ScopeCounters, ScopeProfiler::MAX_SCOPES + 1>       g_scope_counters;   // Last = outside of any scope
+
+    thread_local ThreadCounters* t_counters = nullptr;
+
+    // Totals at the last EndFrame(), main thread only
+    struct Totals
+    {
+        uint64_t m_allocations   = 0;
+        uint64_t m_deallocations = 0;
+        uint64_t m_bytes         = 0;
+        std::array<uint64_t, AllocationTracker::AMOUNT_SIZE_CLASSES> m_size_classes {};
+    };
+
+    Totals g_previous_totals;
+    std::array<uint64_t, ScopeProfiler::MAX_SCOPES + 1> g_previous_scope_allocations {};
+    std::array<uint64_t, ScopeProfiler::MAX_SCOPES + 1> g_previous_scope_bytes {};
+
+    AllocationTracker::FrameStatistics g_last_frame;
+    std::atomic<uint64_t>              g_frame_budget {0};
+
+    [[nodiscard]] inline ThreadCounters& GetThreadCounters() noexcept
+    {
+        if (t_counters == nullptr) [[unlikely]]
+        {
+            const size_t index = g_amount_threads.fetch_add(1, std::memory_order::relaxed);
+            t_counters = &g_thread_counters[std::min(index, AllocationTracker::MAX_THREADS)];
+        }
+        return *t_counters;
+    }
+
+    [[nodiscard]] constexpr size_t GetSizeClass(size_t size) noexcept
+    {
+        if (size <= 16) return 0;
+        return std::min<size_t>(std::bit_width(size - 1) - 4, AllocationTracker::AMOUNT_SIZE_CLASSES - 1);
+    }
+}
+    ////////////////////////////////////////////////
+    //--------- Counting
+    ////////////////////////////////////////////////
+    void AllocationTracker::OnAllocate(size_t size) noexcept
+    {
+        if (! s_is_enabled.load(std::memory_order::relaxed)) return;
+
+        ThreadCounters& counters = GetThreadCounters();
+        counters.m_allocations.fetch_add(1, std::memory_order::relaxed);
+        counters.m_bytes.fetch_add(size, std::memory_order::relaxed);
+        counters.m_size_classes[GetSizeClass(size)].fetch_add(1, std::memory_order::relaxed);
+
+        const ScopeProfiler::ScopeId scope_id = ScopeProfiler::GetCurrentScopeId();
+        ScopeCounters& scope = g_scope_counters[scope_id < ScopeProfiler::MAX_SCOPES ? scope_id : NO_SCOPE_INDEX];
+        scope.m_allocations.fetch_add(1, std::memory_order::relaxed);
+        scope.m_bytes.fetch_add(size, std::memory_order::relaxed);
+    }
+
+    void AllocationTracker::OnDeallocate() noexcept
+    {
+        if (! s_is_enabled.load(std::memory_order::relaxed)) return;
+        GetThreadCounters().m_deallocations.fetch_add(1, std::memory_order::relaxed);
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Aggregation
+    ////////////////////////////////////////////////
+    void AllocationTracker::EndFrame() noexcept
+    {
+        if (g_last_frame.m_scopes.capacity() == 0)
+            g_last_frame.m_scopes.reserve(ScopeProfiler::MAX_SCOPES + 1); // Once, so aggregating doesn't allocate afterwards
+
+        Totals totals {};
+        const size_t amount_sets = std::min(g_amount_threads.load(std::memory_order::relaxed), MAX_THREADS) + 1;
+        for (size_t i = 0; i < amount_sets; i++)
+        {
+            // Unused sets (incl. the overflow one) are zero
+            const ThreadCounters& counters = g_thread_counters[i < amount_sets - 1 ? i : MAX_THREADS];
+            totals.m_allocations   += counters.m_allocations.load(std::memory_order::relaxed);
+            totals.m_deallocations += counters.m_deallocations.load(std::memory_order::relaxed);
+            totals.m_bytes         += counters.m_bytes.load(std::memory_order::relaxed);
+            for (size_t size_class = 0; size_class < AMOUNT_SIZE_CLASSES; size_class++)
+                totals.m_size_classes[size_class] += counters.m_size_classes[size_class].load(std::memory_order::relaxed);
+        }
+
+        FrameStatistics& frame = g_last_frame;
+        frame.m_allocations   = totals.m_allocations   - g_previous_totals.m_allocations;
+        frame.m_deallocations = totals.m_deallocations - g_previous_totals.m_deallocations;
+        frame.m_bytes         = totals.m_bytes         - g_previous_totals.m_bytes;
+        for (size_t size_class = 0; size_class < AMOUNT_SIZE_CLASSES; size_class++)
+            frame.m_size_classes[size_class] = totals.m_size_classes[size_class] - g_previous_totals.m_size_classes[size_class];
+        g_previous_totals = totals;
+
+        frame.m_scopes.clear();
+        for (size_t i = 0; i < g_scope_counters.size(); i++)
+        {
+            const uint64_t allocations = g_scope_counters[i].m_allocations.load(std::memory_order::relaxed);
+            const uint64_t bytes       = g_scope_counters[i].m_bytes.load(std::memory_order::relaxed);
+            if (allocations != g_previous_scope_allocations[i])
+            {
+                const ScopeProfiler::ScopeId scope_id = i == NO_SCOPE_INDEX ? ScopeProfiler::NO_SCOPE : static_cast<ScopeProfiler::ScopeId>(i);
+                frame.m_scopes.push_back(ScopeAllocations{ scope_id, allocations - g_previous_scope_allocations[i], bytes - g_previous_scope_bytes[i] });
+            }
+            g_previous_scope_allocations[i] = allocations;
+            g_previous_scope_bytes[i]       = bytes;
+        }
+        std::sort(frame.m_scopes.begin(), frame.m_scopes.end(),
+            [](const ScopeAllocations& a, const ScopeAllocations& b) -> bool { return a.m_allocations > b.m_allocations; });
+
+        frame.m_history_allocations[frame.m_history_head] = static_cast<float>(frame.m_allocations);
+        frame.m_history_head = (frame.m_history_head + 1) % HISTORY_FRAMES;
+
+        const float budget = static_cast<float>(GetFrameBudget());
+        frame.m_history_max        = 0.0f;
+        frame.m_frames_over_budget = 0;
+        for (const float allocations : frame.m_history_allocations)
+        {
+            frame.m_history_max = std::max(frame.m_history_max, allocations);
+            if (allocations > budget) frame.m_frames_over_budget++;
+        }
+
+        ENGINE_PERFORMANCE_TRACE_COUNTER("Allocations / Frame", frame.m_allocations);
+    }
+
+    const AllocationTracker::FrameStatistics& AllocationTracker::GetLastFrameConstRef() noexcept
+    {
+        return g_last_frame;
+    }
+
+    void AllocationTracker::SetFrameBudget(uint64_t allocations) noexcept
+    {
+        g_frame_budget.store(allocations, std::memory_order::relaxed);
+    }
+
+    uint64_t AllocationTracker::GetFrameBudget() noexcept
+    {
+        return g_frame_budget.load(std::memory_order::relaxed);
+    }
+
+    bool AllocationTracker::GetLastFrameIsOverBudget() noexcept
+    {
+        return g_last_frame.m_allocations > GetFrameBudget();
+    }
+
+    void AllocationTracker::SetEnabled(bool enabled) noexcept
+    {
+        s_is_enabled.store(enabled, std::memory_order::relaxed);
+    }
+
+    bool AllocationTracker::GetIsEnabled() noexcept
+    {
+        return s_is_enabled.load(std::memory_order::relaxed);
+    }
+}
+
+////////////////////////////////////////////////
+//--------- Global operator new / delete
+////////////////////////////////////////////////
+#ifdef ENGINE_ENABLE_ALLOCATION_TRACKING
+namespace
+{
+    [[nodiscard]] void* TrackedAllocate(size_t size, size_t alignment) noexcept
+    {
+        size = std::max<size_t>(size, 1);
+        void* memory = nullptr;
+        while (true)
+        {
+            if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            {
+                memory = std::malloc(size);
+            }
+            else
+            {
+            #ifdef _WIN32
+                memory = _aligned_malloc(size, alignment);
+            #else
+                memory = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+            #endif
+            }
+            if (memory != nullptr) break;
+
+            std::new_handler handler = std::get_new_handler();
+            if (handler == nullptr) return nullptr;
+            try { handler(); } catch (...) { return nullptr; }
+        }
+        CoreEngine::AllocationTracker::OnAllocate(size);
+        return memory;
+    }
+
+    void TrackedFree(void* memory, size_t alignment) noexcept
+    {
+        if (memory == nullptr) return;
+        CoreEngine::AllocationTracker::OnDeallocate();
+    #ifdef _WIN32
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+            _aligned_free(memory);
+            return;
+        }
+    #else
+        static_cast<void>(alignment);
+    #endif
+        std::free(memory);
+    }
+
+    [[nodiscard]] void* TrackedAllocateOrThrow(size_t size, size_t alignment)
+    {
+        void* memory = TrackedAllocate(size, alignment);
+        if (memory == nullptr) throw std::bad_alloc();
+        return memory;
+    }
+}
+
+void* operator new(size_t size) { return TrackedAllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](size_t size) { return TrackedAllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(size_t size, std::align_val_t alignment) { return TrackedAllocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return TrackedAllocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(size, static_cast<size_t>(alignment)); }
+
+void operator delete(void* memory) noexcept { TrackedFree(memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void operator delete[](void* memory) noexcept { TrackedFree(memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void operator delete(void* memory, size_t) noexcept { TrackedFree(memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void operator delete[](void* memory, size_t) noexcept { TrackedFree(memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { TrackedFree(memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { TrackedFree(memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void operator delete(void* memory, std::align_val_t alignment) noexcept { TrackedFree(memory, static_cast<size_t>(alignment)); }
+void operator delete[](void* memory, std::align_val_t alignment) noexcept { TrackedFree(memory, static_cast<size_t>(alignment)); }
+void operator delete(void* memory, size_t, std::align_val_t alignment) noexcept { TrackedFree(memory, static_cast<size_t>(alignment)); }
+void operator delete[](void* memory, size_t, std::align_val_t alignment) noexcept { TrackedFree(memory, static_cast<size_t>(alignment)); }
+void operator delete(void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept { TrackedFree(memory, static_cast<size_t>(alignment)); }
+void operator delete[](void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept { TrackedFree(memory, static_cast<size_t>(alignment)); }
+#endif
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "core/utility/Performance.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace CoreEngine
+{
+    ////////////////////////////////////////////////
+    //--------- Allocation tracking
+    ////////////////////////////////////////////////
+    // Opt in: defining ENGINE_ENABLE_ALLOCATION_TRACKING replaces the global operator new/delete (AllocationTracker.cpp)
+    // with versions that count into per thread counters. Every allocation is attributed to the innermost
+    // ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME scope of the allocating thread. Counting itself never allocates.
+    // Without the define all of this compiles to nothing but the (then empty) statistics.
+    class AllocationTracker final
+    {
+    public:
+        static constexpr size_t MAX_THREADS         = 64; // Threads beyond share one set of counters
+        static constexpr size_t AMOUNT_SIZE_CLASSES = 12; // <= 16 B, <= 32 B, ..., <= 16 KiB, larger
+        static constexpr size_t HISTORY_FRAMES      = ScopeProfiler::HISTORY_FRAMES;
+
+        struct ScopeAllocations
+        {
+            ScopeProfiler::ScopeId m_scope_id    = ScopeProfiler::NO_SCOPE; // NO_SCOPE = outside of any scope
+            uint64_t               m_allocations = 0;
+            uint64_t               m_bytes       = 0;
+        };
+
+        // Deltas over the last frame, all threads
+        struct FrameStatistics
+        {
+            uint64_t m_allocations   = 0;
+            uint64_t m_deallocations = 0;
+            uint64_t m_bytes         = 0;
+            std::array<uint64_t, AMOUNT_SIZE_CLASSES> m_size_classes {};
+            std::vector<ScopeAllocations> m_scopes; // Only scopes that allocated, most allocations first
+
+            // Allocations per frame of the last HISTORY_FRAMES frames (ring, m_history_head = oldest)
+            std::array<float, HISTORY_FRAMES> m_history_allocations {};
+            size_t   m_history_head   = 0;
+            float    m_history_max    = 0.0f;
+            uint32_t m_frames_over_budget = 0; // Within the history
+        };
+
+        [[nodiscard]] static constexpr bool GetIsAvailable() noexcept
+        {
+        #ifdef ENGINE_ENABLE_ALLOCATION_TRACKING
+            return true;
+        #else
+            return false;
+        #endif
+        }
+
+        // Called by the replaced operators
+        static void OnAllocate(size_t size) noexcept;
+        static void OnDeallocate() noexcept;
+
+        // Main thread only, next to ScopeProfiler::EndFrame()
+        static void EndFrame() noexcept;
+        [[nodiscard]] static const FrameStatistics& GetLastFrameConstRef() noexcept;
+
+        // Allocations per frame; frames above show up as warnings. 0 is the goal for the steady state loop.
+        static void SetFrameBudget(uint64_t allocations) noexcept;
+        [[nodiscard]] static uint64_t GetFrameBudget() noexcept;
+        [[nodiscard]] static bool GetLastFrameIsOverBudget() noexcept;
+
+        static void SetEnabled(bool enabled) noexcept;
+        [[nodiscard]] static bool GetIsEnabled() noexcept;
+
+        // Upper bound in bytes of the given size class, the last class is unbounded
+        [[nodiscard]] static constexpr size_t GetSizeClassLimit(size_t size_class) noexcept
+        {
+            return size_t{16} << size_class;
+        }
+
+    private:
+        static inline std::atomic<bool> s_is_enabled = true;
+    };
+}
@@ -0,0 +1,271 @@
+#include "core/utility/Benchmark.h"
+
+#include "core/utility/Performance.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+
+namespace CoreEngine::Benchmark
+{
+    struct StateAccess
+    {
+        [[nodiscard]] static double GetRealTimeNanoSeconds(const State& state) noexcept
+        {
+            return static_cast<double>(state.m_end_ns - state.m_begin_ns);
+        }
+
+        [[nodiscard]] static double GetCpuTimeNanoSeconds(const State& state) noexcept
+        {
+            return static_cast<double>(state.m_end_cpu_clocks - state.m_begin_cpu_clocks) * (1e9 / CLOCKS_PER_SEC);
+        }
+
+        [[nodiscard]] static int64_t GetItemsProcessed(const State& state) noexcept
+        {
+            return state.m_items_processed;
+        }
+
+        [[nodiscard]] static const std::string& GetErrorMessage(const State& state) noexcept
+        {
+            return state.m_error_message;
+        }
+    };
+
+namespace
+{
+    struct Definition
+    {
+        std::string          m_name;
+        Function             m_function;
+        std::vector<int64_t> m_arguments;
+    };
+
+    std::vector<Definition> g_definitions;
+
+    constexpr uint64_t MAX_ITERATIONS = 1'000'000'000;
+
+    [[nodiscard]] State RunOnce(const Function& function, uint64_t iterations, int64_t argument)
+    {
+        State state (iterations, argument);
+        function(state);
+        return state;
+    }
+
+    [[nodiscard]] Result MakeResult(const std::string& name, const State& state, size_t repetition_index, size_t repetitions) noexcept
+    {
+        const double iterations = static_cast<double>(state.GetIterations());
+        const double real_time  = StateAccess::GetRealTimeNanoSeconds(state);
+
+        Result result {};
+        result.m_name             = name;
+        result.m_run_name         = name;
+        result.m_repetition_index = repetition_index;
+        result.m_repetitions      = repetitions;
+        result.m_iterations       = state.GetIterations();
+        result.m_real_time_ns     = real_time / iterations;
+        result.m_cpu_time_ns      = StateAccess::GetCpuTimeNanoSeconds(state) / iterations;
+        result.m_items_per_second = real_time > 0.0 ? static_cast<double>(StateAccess::GetItemsProcessed(state)) * 1e9 / real_time : 0.0;
+        return result;
+    }
+
+    [[nodiscard]] double Median(std::vector<double> values) noexcept
+    {
+        std::sort(values.begin(), values.end());
+        const size_t middle = values.size() / 2;
+        return values.size() % 2 == 1 ? values[middle] : 0.5 * (values[middle - 1] + values[middle]);
+    }
+
+    [[nodiscard]] std::string EscapeJson(const std::string& text)
+    {
+        std::string escaped;
+        for (const char c : text)
+        {
+            if (c == '"' || c == '\\') escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+}
+    ////////////////////////////////////////////////
+    //--------- State
+    ////////////////////////////////////////////////
+    bool State::KeepRunning() noexcept
+    {
+        if (m_iterations_done == 0)
+        {
+            m_begin_cpu_clocks = static_cast<int64_t>(std::clock());
+            m_begin_ns         = ScopeProfiler::NowNanoSeconds();
+        }
+
+        if (m_iterations_done < m_max_iterations)
+        {
+            m_iterations_done++;
+            return true;
+        }
+
+        m_end_ns         = ScopeProfiler::NowNanoSeconds();
+        m_end_cpu_clocks = static_cast<int64_t>(std::clock());
+        return false;
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Registration
+    ////////////////////////////////////////////////
+    void Register(std::string name, Function function, std::vector<int64_t> arguments)
+    {
+        g_definitions.emplace_back(std::move(name), std::move(function), std::move(arguments));
+    }
+
+    void ClearRegistered() noexcept
+    {
+        g_definitions.clear();
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Running
+    ////////////////////////////////////////////////
+    std::vector<Result> RunAll(const RunConfig& config)
+    {
+        std::vector<Result> results;
+        const double min_time_ns = config.m_min_time.Get() * 1e9;
+        const size_t repetitions = std::max<size_t>(config.m_repetitions, 1);
+
+        for (const Definition& definition : g_definitions)
+        {
+            const std::vector<int64_t> arguments = definition.m_arguments.empty() ? std::vector<int64_t>{0} : definition.m_arguments;
+            for (const int64_t argument : arguments)
+            {
+                const std::string name = definition.m_arguments.empty() ? definition.m_name : definition.m_name + "/" + std::to_string(argument);
+                if (! config.m_filter.empty() && name.find(config.m_filter) == std::string::npos)
+                    continue;
+
+                // Grow the iteration count until one run takes at least the min time, that run is the first repetition
+                uint64_t iterations = 1;
+                State state = RunOnce(definition.m_function, iterations, argument);
+                if (! StateAccess::GetErrorMessage(state).empty())
+                {
+                    Result skipped {};
+                    skipped.m_name          = name;
+                    skipped.m_run_name      = name;
+                    skipped.m_error_message = StateAccess::GetErrorMessage(state);
+                    results.push_back(std::move(skipped));
+                    continue;
+                }
+
+                while (StateAccess::GetRealTimeNanoSeconds(state) < min_time_ns && iterations < MAX_ITERATIONS)
+                {
+                    const double elapsed    = std::max(StateAccess::GetRealTimeNanoSeconds(state), 1.0);
+                    const double multiplier = elapsed / min_time_ns > 0.1 ? 1.4 * min_time_ns / elapsed : 10.0;
+                    iterations = std::min<uint64_t>(MAX_ITERATIONS, std::max<uint64_t>(iterations + 1, static_cast<uint64_t>(static_cast<double>(iterations) * multiplier)));
+                    state = RunOnce(definition.m_function, iterations, argument);
+                }
+
+                const size_t first_result = results.size();
+                results.push_back(MakeResult(name, state, 0, repetitions));
+                for (size_t repetition = 1; repetition < repetitions; repetition++)
+                {
+                    results.push_back(MakeResult(name, RunOnce(definition.m_function, iterations, argument), repetition, repetitions));
+                }
+
+                if (repetitions > 1)
+                {
+                    std::vector<double> real_times, cpu_times, items_per_second;
+                    for (size_t i = first_result; i < results.size(); i++)
+                    {
+                        real_times.push_back(results[i].m_real_time_ns);
+                        cpu_times.push_back(results[i].m_cpu_time_ns);
+                        items_per_second.push_back(results[i].m_items_per_second);
+                    }
+
+                    Result median = results[first_result];
+                    median.m_name             = name + "_median";
+                    median.m_is_aggregate     = true;
+                    median.m_real_time_ns     = Median(std::move(real_times));
+                    median.m_cpu_time_ns      = Median(std::move(cpu_times));
+                    median.m_items_per_second = Median(std::move(items_per_second));
+                    results.push_back(std::move(median));
+                }
+            }
+        }
+        return results;
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Output
+    ////////////////////////////////////////////////
+    void PrintResults(const std::vector<Result>& results, std::ostream& out)
+    {
+        size_t name_width = 9;
+        for (const Result& result : results) name_width = std::max(name_width, result.m_name.size());
+
+        out << std::left << std::setw(static_cast<int>(name_width) + 2) << "Benchmark"
+            << std::right << std::setw(14) << "Time (ns)" << std::setw(14) << "CPU (ns)" << std::setw(14) << "Iterations" << std::setw(16) << "Items/s" << '\n';
+
+        for (const Result& result : results)
+        {
+            if (! result.m_error_message.empty())
+            {
+                out << std::left << std::setw(static_cast<int>(name_width) + 2) << result.m_name << "Skipped: " << result.m_error_message << '\n';
+                continue;
+            }
+            out << std::left << std::setw(static_cast<int>(name_width) + 2) << result.m_name << std::right << std::fixed << std::setprecision(1)
+                << std::setw(14) << result.m_real_time_ns << std::setw(14) << result.m_cpu_time_ns << std::setw(14) << result.m_iterations;
+            if (result.m_items_per_second > 0.0)
+                out << std::setw(16) << std::scientific << std::setprecision(3) << result.m_items_per_second;
+            out << std::defaultfloat << '\n';
+        }
+        out.flush();
+    }
+
+    bool WriteResultsToJsonFile(const std::string& file_path, const std::vector<Result>& results) noexcept
+    {
+        std::ofstream file (file_path, std::ios::out | std::ios::trunc);
+        if (! file.is_open())
+            return false;
+
+        const std::time_t now = std::time(nullptr);
+        char date[64] {};
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    #ifdef NDEBUG
+        constexpr const char* BUILD_TYPE = "release";
+    #else
+        constexpr const char* BUILD_TYPE = "debug";
+    #endif
+
+        file << std::setprecision(17);
+        file << "{\n  \"context\": {\n"
+             << "    \"date\": \"" << date << "\",\n"
+             << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+             << "    \"library_build_type\": \"" << BUILD_TYPE << "\"\n"
+             << "  },\n  \"benchmarks\": [";
+
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const Result& result = results[i];
+            file << (i == 0 ? "\n" : ",\n")
+                 << "    {\"name\": \"" << EscapeJson(result.m_name) << "\", \"run_name\": \"" << EscapeJson(result.m_run_name) << "\""
+                 << ", \"run_type\": \"" << (result.m_is_aggregate ? "aggregate" : "iteration") << "\"";
+            if (! result.m_error_message.empty())
+            {
+                file << ", \"error_occurred\": true, \"error_message\": \"" << EscapeJson(result.m_error_message) << "\"}";
+                continue;
+            }
+            if (result.m_is_aggregate)
+                file << ", \"aggregate_name\": \"median\"";
+            file << ", \"repetitions\": " << result.m_repetitions << ", \"repetition_index\": " << result.m_repetition_index
+                 << ", \"iterations\": " << result.m_iterations
+                 << ", \"real_time\": " << result.m_real_time_ns << ", \"cpu_time\": " << result.m_cpu_time_ns << ", \"time_unit\": \"ns\"";
+            if (result.m_items_per_second > 0.0)
+                file << ", \"items_per_second\": " << result.m_items_per_second;
+            file << '}';
+        }
+        file << "\n  ]\n}\n";
+
+        return file.good();
+    }
+}
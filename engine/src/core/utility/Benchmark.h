@@ -0,0 +1,103 @@
+#pragma once
+
+#include "core/utility/Units.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace CoreEngine
+{
+    // Self contained microbenchmarks in the style of Google Benchmark, including its JSON output so the usual
+    // comparison tooling (e.g. compare.py) works on two result files:
+    //
+    //  Benchmark::Register("Math/RaySphereIntersect", [](Benchmark::State& state) {
+    //      ...setup, not timed...
+    //      while (state.KeepRunning()) { Benchmark::DoNotOptimize(...); }
+    //  }, {64, 4096});
+    namespace Benchmark
+    {
+        namespace Detail
+        {
+            inline const volatile void* volatile g_do_not_optimize_sink = nullptr;
+        }
+
+        // Forces the value to be computed & kept in memory
+        template <typename T>
+        inline void DoNotOptimize(const T& value) noexcept
+        {
+        #if defined(__GNUC__) || defined(__clang__)
+            asm volatile("" : : "r,m"(value) : "memory");
+        #else
+            Detail::g_do_not_optimize_sink = &value;
+            std::atomic_signal_fence(std::memory_order::seq_cst);
+        #endif
+        }
+
+        class State
+        {
+        public:
+            explicit State(uint64_t iterations, int64_t argument) noexcept : m_max_iterations(iterations), m_argument(argument) {}
+
+            // Timing starts with the first call and ends once it returns false
+            [[nodiscard]] bool KeepRunning() noexcept;
+
+            [[nodiscard]] int64_t GetArgument() const noexcept { return m_argument; }
+            [[nodiscard]] uint64_t GetIterations() const noexcept { return m_max_iterations; }
+
+            // Items per iteration * iterations, reported as items per second
+            void SetItemsProcessed(int64_t items) noexcept { m_items_processed = items; }
+
+            // Call instead of running, e.g. if a required resource is missing; the message ends up in the results
+            void SkipWithError(std::string message) noexcept { m_error_message = std::move(message); }
+
+        private:
+            friend struct StateAccess;
+
+            uint64_t m_max_iterations;
+            uint64_t m_iterations_done  = 0;
+            int64_t  m_argument;
+            int64_t  m_items_processed  = 0;
+            int64_t  m_begin_ns         = 0;
+            int64_t  m_end_ns           = 0;
+            int64_t  m_begin_cpu_clocks = 0;
+            int64_t  m_end_cpu_clocks   = 0;
+            std::string m_error_message;
+        };
+
+        using Function = std::function<void(State&)>;
+
+        // Without arguments the benchmark runs once with argument 0, otherwise once per argument as "name/argument"
+        void Register(std::string name, Function function, std::vector<int64_t> arguments = {});
+        void ClearRegistered() noexcept;
+
+        struct RunConfig
+        {
+            std::string   m_filter;              // Substring of the name, empty = all
+            Units::Second m_min_time    {0.5};   // Per repetition
+            size_t        m_repetitions {3};
+        };
+
+        struct Result
+        {
+            std::string m_name;
+            std::string m_run_name;           // m_name without the aggregate suffix
+            bool        m_is_aggregate       = false; // Median over the repetitions
+            size_t      m_repetition_index   = 0;
+            size_t      m_repetitions        = 0;
+            uint64_t    m_iterations         = 0;
+            double      m_real_time_ns       = 0.0; // Per iteration
+            double      m_cpu_time_ns        = 0.0;
+            double      m_items_per_second   = 0.0;
+            std::string m_error_message;      // Non empty = skipped, no timings
+        };
+
+        [[nodiscard]] std::vector<Result> RunAll(const RunConfig& config);
+
+        void PrintResults(const std::vector<Result>& results, std::ostream& out);
+        [[nodiscard]] bool WriteResultsToJsonFile(const std::string& file_path, const std::vector<Result>& results) noexcept;
+    }
+}
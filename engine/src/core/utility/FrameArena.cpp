@@ -0,0 +1,187 @@
+#include "core/utility/FrameArena.h"
+
+#include "core/utility/Assert.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace CoreEngine
+{
+namespace
+{
+    [[nodiscard]] inline uintptr_t AlignUp(uintptr_t address, size_t alignment) noexcept
+    {
+        return (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    }
+
+#ifdef ENGINE_FRAME_ARENA_DEBUG
+    constexpr uint64_t     HEADER_MAGIC    = 0xF4A3EA4E4A11C8EDull;
+    constexpr size_t       GUARD_SIZE      = 16;
+    constexpr std::uint8_t GUARD_BYTE      = 0xFD;
+    constexpr std::uint8_t ALLOCATED_BYTE  = 0xCD; // Handed out, not yet written by the user
+    constexpr std::uint8_t FREED_BYTE      = 0xDD; // Deallocated or reset, reading this is a bug
+#endif
+}
+
+#ifdef ENGINE_FRAME_ARENA_DEBUG
+    // Right in front of every allocation; the headers form a list back to the first allocation since the last reset
+    struct FrameArena::DebugHeader
+    {
+        uint64_t     m_magic;
+        size_t       m_size;
+        DebugHeader* m_previous;
+    };
+#endif
+
+    FrameArena::FrameArena(size_t block_size) noexcept : m_block_size(block_size)
+    {
+        ENGINE_ASSERT(block_size > 0 && "At FrameArena::FrameArena(): Block size must not be 0.");
+    }
+
+    FrameArena& FrameArena::GetThreadLocal() noexcept
+    {
+        thread_local FrameArena arena;
+        return arena;
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Allocating
+    ////////////////////////////////////////////////
+    void* FrameArena::do_allocate(size_t bytes, size_t alignment)
+    {
+    #ifdef ENGINE_FRAME_ARENA_DEBUG
+        alignment = std::max(alignment, alignof(DebugHeader));
+        const size_t front_overhead = sizeof(DebugHeader);
+        const size_t back_overhead  = GUARD_SIZE;
+    #else
+        constexpr size_t front_overhead = 0;
+        constexpr size_t back_overhead  = 0;
+    #endif
+
+        while (true)
+        {
+            if (m_current_block == m_blocks.size())
+            {
+                AddBlock(front_overhead + bytes + back_overhead + alignment);
+            }
+
+            Block& block = m_blocks[m_current_block];
+            const uintptr_t begin  = reinterpret_cast<uintptr_t>(block.m_memory.get());
+            const uintptr_t cursor = begin + block.m_used;
+            const uintptr_t user   = AlignUp(cursor + front_overhead, alignment);
+            const uintptr_t end    = user + bytes + back_overhead;
+
+            if (end > begin + block.m_size)
+            {
+                m_current_block++;
+                continue;
+            }
+
+            m_bytes_used     += end - cursor;
+            m_peak_bytes_used = std::max(m_peak_bytes_used, m_bytes_used);
+            block.m_used      = end - begin;
+
+            std::byte* memory = reinterpret_cast<std::byte*>(user);
+        #ifdef ENGINE_FRAME_ARENA_DEBUG
+            DebugHeader* header = reinterpret_cast<DebugHeader*>(memory) - 1;
+            *header = DebugHeader{ HEADER_MAGIC, bytes, m_last_header };
+            m_last_header = header;
+            std::memset(memory, ALLOCATED_BYTE, bytes);
+            std::memset(memory + bytes, GUARD_BYTE, GUARD_SIZE);
+        #endif
+            return memory;
+        }
+    }
+
+    void FrameArena::do_deallocate([[maybe_unused]] void* memory, [[maybe_unused]] size_t bytes, [[maybe_unused]] size_t alignment)
+    {
+        // Everything is freed at once by Reset()
+    #ifdef ENGINE_FRAME_ARENA_DEBUG
+        const DebugHeader* header = reinterpret_cast<const DebugHeader*>(memory) - 1;
+        ENGINE_ASSERT(header->m_magic == HEADER_MAGIC && header->m_size == bytes &&
+            "At FrameArena::do_deallocate(): Memory was not allocated by this arena in the current frame (or its header got overwritten).");
+        std::memset(memory, FREED_BYTE, bytes);
+    #endif
+    }
+
+    void FrameArena::AddBlock(size_t min_size)
+    {
+        const size_t size = std::max(m_block_size, min_size);
+        m_blocks.push_back(Block{ std::make_unique_for_overwrite<std::byte[]>(size), size, 0 });
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Reset
+    ////////////////////////////////////////////////
+    void FrameArena::Reset() noexcept
+    {
+    #ifdef ENGINE_FRAME_ARENA_DEBUG
+        ENGINE_ASSERT(ValidateAllocations() && "At FrameArena::Reset(): Guard bytes were overwritten, something wrote past its frame allocation.");
+        for (Block& block : m_blocks)
+        {
+            std::memset(block.m_memory.get(), FREED_BYTE, block.m_used);
+        }
+        m_last_header = nullptr;
+    #endif
+
+        if (m_blocks.size() > 1)
+        {
+            size_t total_size = 0;
+            for (const Block& block : m_blocks) total_size += block.m_size;
+            m_blocks.clear();
+            AddBlock(total_size);
+        }
+
+        for (Block& block : m_blocks) block.m_used = 0;
+        m_current_block = 0;
+        m_bytes_used    = 0;
+    }
+
+#ifdef ENGINE_FRAME_ARENA_DEBUG
+    bool FrameArena::ValidateAllocations() const noexcept
+    {
+        bool is_valid = true;
+        for (const DebugHeader* header = m_last_header; header != nullptr; header = header->m_previous)
+        {
+            if (header->m_magic != HEADER_MAGIC)
+            {
+                ENGINE_DEBUG_PRINT("FrameArena: Allocation header at " << header << " was overwritten.");
+                return false; // The list can't be followed any further
+            }
+
+            const std::byte* guard = reinterpret_cast<const std::byte*>(header + 1) + header->m_size;
+            for (size_t i = 0; i < GUARD_SIZE; i++)
+            {
+                if (guard[i] != std::byte{GUARD_BYTE})
+                {
+                    ENGINE_DEBUG_PRINT("FrameArena: Write past the end of a " << header->m_size << " byte allocation at " << (header + 1) << '.');
+                    is_valid = false;
+                    break;
+                }
+            }
+        }
+        return is_valid;
+    }
+#endif
+
+    ////////////////////////////////////////////////
+    //--------- Statistics
+    ////////////////////////////////////////////////
+    size_t FrameArena::GetBytesUsed() const noexcept
+    {
+        return m_bytes_used;
+    }
+
+    size_t FrameArena::GetPeakBytesUsed() const noexcept
+    {
+        return m_peak_bytes_used;
+    }
+
+    size_t FrameArena::GetCapacity() const noexcept
+    {
+        size_t capacity = 0;
+        for (const Block& block : m_blocks) capacity += block.m_size;
+        return capacity;
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// Poisons freed & reset memory and validates guard bytes around every allocation on Reset(); on by default in debug builds
+#if ! defined(ENGINE_FRAME_ARENA_DEBUG) && ! defined(NDEBUG)
+    #define ENGINE_FRAME_ARENA_DEBUG
+#endif
+
+namespace CoreEngine
+{
+    ////////////////////////////////////////////////
+    //--------- Frame arena
+    ////////////////////////////////////////////////
+    // Bump allocator for data that lives at most until the end of the current frame, used through std::pmr:
+    //
+    //  std::pmr::vector<glm::vec3> points (&FrameArena::GetThreadLocal());
+    //
+    // Deallocation is a no-op, Reset() frees everything at once. The application resets the main thread's arena at the
+    // end of every main loop iteration; any other thread using its arena has to reset it itself.
+    class FrameArena final : public std::pmr::memory_resource
+    {
+    public:
+        static constexpr size_t DEFAULT_BLOCK_SIZE = 1 << 20;
+
+        explicit FrameArena(size_t block_size = DEFAULT_BLOCK_SIZE) noexcept;
+        ~FrameArena() noexcept override = default;
+
+        // Arena of the calling thread, memory is only reserved on the first allocation
+        [[nodiscard]] static FrameArena& GetThreadLocal() noexcept;
+
+        // Invalidates everything allocated since the last reset. Keeps the memory; if the frame needed several blocks,
+        // they are merged into one, so the steady state never allocates.
+        void Reset() noexcept;
+
+        [[nodiscard]] size_t GetBytesUsed() const noexcept;
+        [[nodiscard]] size_t GetPeakBytesUsed() const noexcept;
+        [[nodiscard]] size_t GetCapacity() const noexcept;
+
+        FrameArena(const FrameArena&)            = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<std::byte[]> m_memory;
+            size_t                       m_size = 0;
+            size_t                       m_used = 0;
+        };
+
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void  do_deallocate(void* memory, size_t bytes, size_t alignment) override;
+        bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+        void AddBlock(size_t min_size);
+
+        std::vector<Block> m_blocks;
+        size_t             m_block_size;
+        size_t             m_current_block   = 0;
+        size_t             m_bytes_used      = 0; // Including alignment padding & debug overhead
+        size_t             m_peak_bytes_used = 0;
+
+    #ifdef ENGINE_FRAME_ARENA_DEBUG
+        struct DebugHeader;
+        [[nodiscard]] bool ValidateAllocations() const noexcept;
+
+        DebugHeader* m_last_header = nullptr;
+    #endif
+    };
+}
@@ -0,0 +1,247 @@
+#include "core/utility/FrustumCulling.h"
+#include "core/utility/FrustumCulling_AVX2.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <latch>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+namespace CoreEngine
+{
+namespace
+{
+    ////////////////////////////////////////////////
+    //--------- Workers
+    ////////////////////////////////////////////////
+    // Created on first use, sleep between runs. Only one run at a time, from the main thread.
+    class WorkerPool
+    {
+    public:
+        [[nodiscard]] static WorkerPool& Get() noexcept
+        {
+            static WorkerPool s_pool;
+            return s_pool;
+        }
+
+        [[nodiscard]] size_t GetAmountWorkers() const noexcept { return m_workers.size(); }
+
+        // Batch 0 runs on the calling thread, batch i on worker i - 1
+        void Run(size_t amount_batches, size_t amount, FrustumCulling::BatchFunction function, void* context) noexcept
+        {
+            std::latch workers_done (static_cast<std::ptrdiff_t>(amount_batches - 1));
+            {
+                std::scoped_lock lock (m_mutex);
+                m_job = Job{ function, context, amount, amount_batches, &workers_done };
+                m_generation++;
+            }
+            m_wake.notify_all();
+
+            RunBatch(m_job, 0);
+            workers_done.wait();
+        }
+
+        WorkerPool(const WorkerPool&)            = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+    private:
+        struct Job
+        {
+            FrustumCulling::BatchFunction m_function       = nullptr;
+            void*                         m_context        = nullptr;
+            size_t                        m_amount         = 0;
+            size_t                        m_amount_batches = 0;
+            std::latch*                   m_done           = nullptr;
+        };
+
+        WorkerPool() noexcept
+        {
+            const size_t hardware_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+            const size_t amount_workers   = std::min(hardware_threads - 1, FrustumCulling::MAX_WORKERS);
+            m_workers.reserve(amount_workers);
+            for (size_t i = 0; i < amount_workers; i++)
+            {
+                m_workers.emplace_back([this, i](std::stop_token stop_token) { WorkerLoop(stop_token, i + 1); });
+            }
+        }
+
+        static void RunBatch(const Job& job, size_t batch_index) noexcept
+        {
+            const size_t begin = job.m_amount * batch_index / job.m_amount_batches;
+            const size_t end   = job.m_amount * (batch_index + 1) / job.m_amount_batches;
+            job.m_function(job.m_context, begin, end, batch_index);
+        }
+
+        void WorkerLoop(std::stop_token stop_token, size_t batch_index) noexcept
+        {
+            uint64_t seen_generation = 0;
+            while (true)
+            {
+                Job job;
+                {
+                    std::unique_lock lock (m_mutex);
+                    if (! m_wake.wait(lock, stop_token, [&] { return m_generation != seen_generation; }))
+                        return;
+                    seen_generation = m_generation;
+                    job = m_job;
+                }
+
+                if (batch_index < job.m_amount_batches)
+                {
+                    RunBatch(job, batch_index);
+                    job.m_done->count_down();
+                }
+            }
+        }
+
+        std::mutex                  m_mutex;
+        std::condition_variable_any m_wake;
+        uint64_t                    m_generation = 0;
+        Job                         m_job;
+        std::vector<std::jthread>   m_workers; // Last, joined before the rest is destroyed
+    };
+
+    ////////////////////////////////////////////////
+    //--------- Box tests
+    ////////////////////////////////////////////////
+    // Writes the indices of the visible boxes in [begin, end) to out_indices, returns how many.
+    // 8 boxes at a time if the CPU has AVX2 (checked at runtime, the build doesn't have to target it), otherwise scalar
+    size_t CullRange(const FrustumCulling::NormalizedPlanes& planes, const FrustumCulling::AABB_SoA& boxes, size_t begin, size_t end, uint32_t* out_indices) noexcept
+    {
+    #ifdef ENGINE_FRUSTUM_CULLING_HAS_AVX2_KERNEL
+        if (FrustumCulling::AVX2::CpuSupportsAVX2())
+            return FrustumCulling::AVX2::CullRange(planes, boxes, begin, end, out_indices);
+    #endif
+
+        size_t amount_visible = 0;
+        for (size_t i = begin; i < end; i++)
+        {
+            const glm::vec3 center       { boxes.m_center_x[i], boxes.m_center_y[i], boxes.m_center_z[i] };
+            const glm::vec3 half_extents { boxes.m_half_extents_x[i], boxes.m_half_extents_y[i], boxes.m_half_extents_z[i] };
+            if (FrustumCulling::AABBIsInFrustum(planes, center, half_extents))
+            {
+                out_indices[amount_visible++] = static_cast<uint32_t>(i);
+            }
+        }
+
+        return amount_visible;
+    }
+}
+    ////////////////////////////////////////////////
+    //--------- Planes & single tests
+    ////////////////////////////////////////////////
+    FrustumCulling::NormalizedPlanes FrustumCulling::ExtractNormalizedPlanes(const glm::mat4& view_projection) noexcept
+    {
+        NormalizedPlanes planes = MathUtility::ExtractProjectionPlanesFromVP(view_projection);
+        for (glm::vec4& plane : planes)
+        {
+            plane /= glm::length(glm::vec3(plane));
+        }
+        return planes;
+    }
+
+    bool FrustumCulling::AABBIsInFrustum(const NormalizedPlanes& planes, const glm::vec3& center, const glm::vec3& half_extents) noexcept
+    {
+        for (const glm::vec4& p : planes)
+        {
+            const glm::vec3 normal = glm::vec3(p);
+            if (glm::dot(normal, center) + p.w < -glm::dot(glm::abs(normal), half_extents))
+                return false;
+        }
+        return true;
+    }
+
+    bool FrustumCulling::LineIsInFrustum(const NormalizedPlanes& planes, const glm::vec3& point_a, const glm::vec3& point_b) noexcept
+    {
+        for (const glm::vec4& p : planes)
+        {
+            const glm::vec3 normal = glm::vec3(p);
+            if (glm::dot(normal, point_a) + p.w < 0.0f && glm::dot(normal, point_b) + p.w < 0.0f)
+                return false;
+        }
+        return true;
+    }
+
+    ////////////////////////////////////////////////
+    //--------- AABB_SoA
+    ////////////////////////////////////////////////
+    void FrustumCulling::AABB_SoA::Clear() noexcept
+    {
+        Resize(0);
+    }
+
+    void FrustumCulling::AABB_SoA::Resize(size_t amount) noexcept
+    {
+        m_center_x.resize(amount);
+        m_center_y.resize(amount);
+        m_center_z.resize(amount);
+        m_half_extents_x.resize(amount);
+        m_half_extents_y.resize(amount);
+        m_half_extents_z.resize(amount);
+    }
+
+    void FrustumCulling::AABB_SoA::Set(size_t index, const MathUtility::AABB& world_aabb) noexcept
+    {
+        m_center_x[index]       = world_aabb.m_center.x;
+        m_center_y[index]       = world_aabb.m_center.y;
+        m_center_z[index]       = world_aabb.m_center.z;
+        m_half_extents_x[index] = world_aabb.m_half_extents.x;
+        m_half_extents_y[index] = world_aabb.m_half_extents.y;
+        m_half_extents_z[index] = world_aabb.m_half_extents.z;
+    }
+
+    size_t FrustumCulling::AABB_SoA::GetSize() const noexcept
+    {
+        return m_center_x.size();
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Batches
+    ////////////////////////////////////////////////
+    size_t FrustumCulling::RunBatches(size_t amount, BatchFunction function, void* context) noexcept
+    {
+        if (amount < PARALLEL_THRESHOLD)
+        {
+            function(context, 0, amount, 0);
+            return 1;
+        }
+
+        WorkerPool& pool = WorkerPool::Get();
+        const size_t amount_batches = std::min(pool.GetAmountWorkers() + 1, amount / MIN_BATCH_SIZE);
+        if (amount_batches <= 1)
+        {
+            function(context, 0, amount, 0);
+            return 1;
+        }
+
+        pool.Run(amount_batches, amount, function, context);
+        return amount_batches;
+    }
+
+    void FrustumCulling::CullAABBs(const NormalizedPlanes& planes, const AABB_SoA& boxes, std::pmr::vector<uint32_t>& out_visible_indices) noexcept
+    {
+        const size_t amount = boxes.GetSize();
+        out_visible_indices.resize(amount);
+
+        // Every batch compacts into its own range of the output, the ranges are joined afterwards
+        std::array<size_t, MAX_WORKERS + 1> batch_begin   {};
+        std::array<size_t, MAX_WORKERS + 1> batch_visible {};
+        auto cull_batch = [&](size_t begin, size_t end, size_t batch_index) {
+            batch_begin[batch_index]   = begin;
+            batch_visible[batch_index] = CullRange(planes, boxes, begin, end, out_visible_indices.data() + begin);
+        };
+        const size_t amount_batches = RunBatches(amount, cull_batch);
+
+        size_t amount_visible = batch_visible[0];
+        for (size_t b = 1; b < amount_batches; b++)
+        {
+            std::memmove(out_visible_indices.data() + amount_visible, out_visible_indices.data() + batch_begin[b], batch_visible[b] * sizeof(uint32_t));
+            amount_visible += batch_visible[b];
+        }
+        out_visible_indices.resize(amount_visible);
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "core/utility/MathUtility.h"
+
+#include "glm/glm.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+namespace CoreEngine
+{
+    ////////////////////////////////////////////////
+    //--------- Batched frustum culling
+    ////////////////////////////////////////////////
+    // CPU culling for many objects at once. Planes are extracted & normalized once per frame instead of once per test,
+    // boxes are stored as structure of arrays and tested 8 at a time with AVX2 (picked at runtime from CPUID, so the build
+    // doesn't need /arch:AVX2; otherwise a scalar loop over the same arrays), large counts are split across worker threads.
+    namespace FrustumCulling
+    {
+        static constexpr size_t MAX_WORKERS        = 7;     // Plus the calling thread
+        static constexpr size_t PARALLEL_THRESHOLD = 16384; // Below, everything runs on the calling thread
+        static constexpr size_t MIN_BATCH_SIZE     = 4096;
+
+        using NormalizedPlanes = MathUtility::ViewProjectionPlanes_ReverseZ;
+
+        [[nodiscard]] NormalizedPlanes ExtractNormalizedPlanes(const glm::mat4& view_projection) noexcept;
+
+        // Same results as MathUtility::AABBIsInFrustum() / LineIsInFrustum(), without normalizing per call
+        [[nodiscard]] bool AABBIsInFrustum(const NormalizedPlanes& planes, const glm::vec3& center, const glm::vec3& half_extents) noexcept;
+        [[nodiscard]] bool LineIsInFrustum(const NormalizedPlanes& planes, const glm::vec3& point_a, const glm::vec3& point_b) noexcept;
+
+        // World space boxes, one entry per index
+        struct AABB_SoA
+        {
+            std::vector<float> m_center_x;
+            std::vector<float> m_center_y;
+            std::vector<float> m_center_z;
+            std::vector<float> m_half_extents_x;
+            std::vector<float> m_half_extents_y;
+            std::vector<float> m_half_extents_z;
+
+            void Clear() noexcept;
+            void Resize(size_t amount) noexcept;
+            void Set(size_t index, const MathUtility::AABB& world_aabb) noexcept;
+            [[nodiscard]] size_t GetSize() const noexcept;
+        };
+
+        // Indices of the boxes inside the frustum, ascending. Main thread only, like everything using the workers.
+        void CullAABBs(const NormalizedPlanes& planes, const AABB_SoA& boxes, std::pmr::vector<uint32_t>& out_visible_indices) noexcept;
+
+        // Splits [0, amount) into contiguous batches, runs function(begin, end, batch_index) for each on the workers & the
+        // calling thread and returns the amount of batches once all are done. Batch indices are in range order.
+        using BatchFunction = void (*)(void* context, size_t begin, size_t end, size_t batch_index);
+        size_t RunBatches(size_t amount, BatchFunction function, void* context) noexcept;
+
+        template <typename Function>
+        requires std::is_invocable_v<Function&, size_t, size_t, size_t>
+        size_t RunBatches(size_t amount, Function& function) noexcept
+        {
+            return RunBatches(amount, [](void* context, size_t begin, size_t end, size_t batch_index) {
+                (*static_cast<Function*>(context))(begin, end, batch_index);
+            }, &function);
+        }
+    }
+}
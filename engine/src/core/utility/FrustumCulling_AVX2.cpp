@@ -0,0 +1,118 @@
+#include "core/utility/FrustumCulling_AVX2.h"
+
+#ifdef ENGINE_FRUSTUM_CULLING_HAS_AVX2_KERNEL
+
+#include <array>
+#include <bit>
+#include <cmath>
+
+#include <immintrin.h>
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+// MSVC emits AVX2 intrinsics without /arch:AVX2, GCC & Clang need the function to be marked
+#if defined(__GNUC__) && ! defined(__AVX2__)
+    #define ENGINE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define ENGINE_TARGET_AVX2
+#endif
+
+namespace CoreEngine
+{
+    bool FrustumCulling::AVX2::CpuSupportsAVX2() noexcept
+    {
+        static const bool s_is_supported = []() noexcept
+        {
+        #ifdef _MSC_VER
+            int info[4] {};
+            __cpuid(info, 0);
+            if (info[0] < 7) return false;
+
+            __cpuid(info, 1);
+            const bool has_os_xsave = (info[2] & (1 << 27)) != 0;
+            const bool has_avx      = (info[2] & (1 << 28)) != 0;
+            if (! has_os_xsave || ! has_avx) return false;
+
+            // The OS has to save the XMM & YMM registers on context switches
+            if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+        #else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") != 0;
+        #endif
+        }();
+        return s_is_supported;
+    }
+
+    ENGINE_TARGET_AVX2 size_t FrustumCulling::AVX2::CullRange(const NormalizedPlanes& planes, const AABB_SoA& boxes, size_t begin, size_t end, uint32_t* out_indices) noexcept
+    {
+        const float* center_x       = boxes.m_center_x.data();
+        const float* center_y       = boxes.m_center_y.data();
+        const float* center_z       = boxes.m_center_z.data();
+        const float* half_extents_x = boxes.m_half_extents_x.data();
+        const float* half_extents_y = boxes.m_half_extents_y.data();
+        const float* half_extents_z = boxes.m_half_extents_z.data();
+
+        constexpr size_t AMOUNT_PLANES = std::tuple_size_v<NormalizedPlanes>;
+        __m256 normal_x[AMOUNT_PLANES], normal_y[AMOUNT_PLANES], normal_z[AMOUNT_PLANES], plane_w[AMOUNT_PLANES];
+        __m256 abs_normal_x[AMOUNT_PLANES], abs_normal_y[AMOUNT_PLANES], abs_normal_z[AMOUNT_PLANES];
+        for (size_t p = 0; p < planes.size(); p++)
+        {
+            normal_x[p]     = _mm256_set1_ps(planes[p].x);
+            normal_y[p]     = _mm256_set1_ps(planes[p].y);
+            normal_z[p]     = _mm256_set1_ps(planes[p].z);
+            abs_normal_x[p] = _mm256_set1_ps(std::abs(planes[p].x));
+            abs_normal_y[p] = _mm256_set1_ps(std::abs(planes[p].y));
+            abs_normal_z[p] = _mm256_set1_ps(std::abs(planes[p].z));
+            plane_w[p]      = _mm256_set1_ps(planes[p].w);
+        }
+        const __m256 sign_bit = _mm256_set1_ps(-0.0f);
+
+        size_t amount_visible = 0;
+        size_t i = begin;
+        for (; i + 8 <= end; i += 8)
+        {
+            const __m256 cx = _mm256_loadu_ps(center_x + i);
+            const __m256 cy = _mm256_loadu_ps(center_y + i);
+            const __m256 cz = _mm256_loadu_ps(center_z + i);
+            const __m256 hx = _mm256_loadu_ps(half_extents_x + i);
+            const __m256 hy = _mm256_loadu_ps(half_extents_y + i);
+            const __m256 hz = _mm256_loadu_ps(half_extents_z + i);
+
+            __m256 is_inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (size_t p = 0; p < planes.size(); p++)
+            {
+                const __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(normal_x[p], cx), _mm256_mul_ps(normal_y[p], cy)),
+                                                      _mm256_add_ps(_mm256_mul_ps(normal_z[p], cz), plane_w[p]));
+                const __m256 radius   = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(abs_normal_x[p], hx), _mm256_mul_ps(abs_normal_y[p], hy)),
+                                                      _mm256_mul_ps(abs_normal_z[p], hz));
+                // ! (distance < -radius), like the scalar test
+                is_inside = _mm256_and_ps(is_inside, _mm256_cmp_ps(distance, _mm256_xor_ps(radius, sign_bit), _CMP_NLT_UQ));
+            }
+
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(is_inside));
+            while (mask != 0)
+            {
+                out_indices[amount_visible++] = static_cast<uint32_t>(i) + static_cast<uint32_t>(std::countr_zero(mask));
+                mask &= mask - 1;
+            }
+        }
+
+        for (; i < end; i++)
+        {
+            const glm::vec3 center       { center_x[i], center_y[i], center_z[i] };
+            const glm::vec3 half_extents { half_extents_x[i], half_extents_y[i], half_extents_z[i] };
+            if (AABBIsInFrustum(planes, center, half_extents))
+            {
+                out_indices[amount_visible++] = static_cast<uint32_t>(i);
+            }
+        }
+
+        return amount_visible;
+    }
+}
+
+#endif
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "core/utility/FrustumCulling.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Internal to FrustumCulling.cpp. The kernel lives in its own translation unit so it may be built with /arch:AVX2
+// (or -mavx2) without the rest of the engine requiring an AVX2 CPU; it is only called after CpuSupportsAVX2().
+#if defined(_M_X64) || defined(__x86_64__)
+    #define ENGINE_FRUSTUM_CULLING_HAS_AVX2_KERNEL
+#endif
+
+#ifdef ENGINE_FRUSTUM_CULLING_HAS_AVX2_KERNEL
+namespace CoreEngine::FrustumCulling::AVX2
+{
+    // CPUID & the OS saving the YMM registers, checked once
+    [[nodiscard]] bool CpuSupportsAVX2() noexcept;
+
+    // Same contract as the scalar loop: writes the indices of the visible boxes in [begin, end) to out_indices, returns how many
+    [[nodiscard]] size_t CullRange(const NormalizedPlanes& planes, const AABB_SoA& boxes, size_t begin, size_t end, uint32_t* out_indices) noexcept;
+}
+#endif
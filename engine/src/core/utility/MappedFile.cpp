@@ -0,0 +1,120 @@
+#include "core/utility/MappedFile.h"
+
+#include <utility>
+
+//Win
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace CoreEngine
+{
+    MappedFile::~MappedFile() noexcept
+    {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    :   m_data(std::exchange(other.m_data, nullptr)),
+        m_size(std::exchange(other.m_size, 0))
+    {
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+
+    bool MappedFile::Open(const std::filesystem::path& path) noexcept
+    {
+        Close();
+
+    #ifdef _WIN32
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER file_size {};
+        if (! GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        //The view keeps the mapping & file alive, both handles can be closed right away
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr)
+            return false;
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (view == nullptr)
+            return false;
+
+        m_data = static_cast<const unsigned char*>(view);
+        m_size = static_cast<size_t>(file_size.QuadPart);
+    #else
+        const int file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+            return false;
+
+        struct stat file_stat {};
+        if (fstat(file, &file_stat) != 0 || file_stat.st_size <= 0)
+        {
+            close(file);
+            return false;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if (view == MAP_FAILED)
+            return false;
+
+        m_data = static_cast<const unsigned char*>(view);
+        m_size = static_cast<size_t>(file_stat.st_size);
+    #endif
+        return true;
+    }
+
+    void MappedFile::Close() noexcept
+    {
+        if (m_data == nullptr)
+            return;
+
+    #ifdef _WIN32
+        UnmapViewOfFile(m_data);
+    #else
+        munmap(const_cast<unsigned char*>(m_data), m_size);
+    #endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    bool MappedFile::IsOpen() const noexcept
+    {
+        return m_data != nullptr;
+    }
+
+    const unsigned char* MappedFile::GetData() const noexcept
+    {
+        return m_data;
+    }
+
+    size_t MappedFile::GetSize() const noexcept
+    {
+        return m_size;
+    }
+}
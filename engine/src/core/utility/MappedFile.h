@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace CoreEngine
+{
+    ////////////////////////////////////////////////
+    //--------- Mapped file
+    ////////////////////////////////////////////////
+    // Read only memory mapping of a whole file, unmapped on destruction. The mapped address stays the same across moves.
+    class MappedFile final
+    {
+    public:
+        MappedFile() noexcept = default;
+        ~MappedFile() noexcept;
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // Closes the current mapping first. False if the file can't be opened, is empty or can't be mapped
+        [[nodiscard]] bool Open(const std::filesystem::path& path) noexcept;
+        void Close() noexcept;
+
+        [[nodiscard]] bool IsOpen() const noexcept;
+        [[nodiscard]] const unsigned char* GetData() const noexcept;
+        [[nodiscard]] size_t GetSize() const noexcept;
+
+    private:
+        const unsigned char* m_data = nullptr;
+        size_t               m_size = 0;
+    };
+}
@@ -195,4 +195,35 @@ namespace CoreEngine
             // no far plane
         };
     }
+
+    glm::quat MathUtility::QuatLog(const glm::quat& q) noexcept
+    {
+        const glm::vec3 v (q.x, q.y, q.z);
+        const float length = glm::length(v);
+        if (length < 1e-7f) return glm::quat(0.0f, v.x, v.y, v.z);
+
+        const glm::vec3 scaled = v * (std::atan2(length, q.w) / length);
+        return glm::quat(0.0f, scaled.x, scaled.y, scaled.z);
+    }
+
+    glm::quat MathUtility::QuatExp(const glm::quat& q) noexcept
+    {
+        const glm::vec3 v (q.x, q.y, q.z);
+        const float angle = glm::length(v);
+        if (angle < 1e-7f) return glm::normalize(glm::quat(1.0f, v.x, v.y, v.z));
+
+        const glm::vec3 scaled = v * (std::sin(angle) / angle);
+        return glm::quat(std::cos(angle), scaled.x, scaled.y, scaled.z);
+    }
+
+    glm::vec3 MathUtility::RotationVectorFromQuat(const glm::quat& q) noexcept
+    {
+        const glm::quat log = QuatLog(q.w < 0.0f ? -q : q);
+        return glm::vec3(log.x, log.y, log.z) * 2.0f;
+    }
+
+    glm::quat MathUtility::QuatFromRotationVector(const glm::vec3& v) noexcept
+    {
+        return QuatExp(glm::quat(0.0f, v.x * 0.5f, v.y * 0.5f, v.z * 0.5f));
+    }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
 
 #include <array>
 
@@ -90,6 +91,17 @@ namespace CoreEngine
         [[nodiscard]] bool LineIsInFrustum(const ViewProjectionPlanes_ReverseZ& planes, const Line& line) noexcept;
 
          [[nodiscard]] ViewProjectionPlanes_ReverseZ ExtractProjectionPlanesFromVP(const glm::mat4& vp) noexcept;
+
+    //////////////////////////////////////////////// 
+    //---------  Quaternions
+    //////////////////////////////////////////////// 
+        // Log & exp of unit quaternions, first order around identity where glm's generic versions lose precision
+        [[nodiscard]] glm::quat QuatLog(const glm::quat& q) noexcept;
+        [[nodiscard]] glm::quat QuatExp(const glm::quat& q) noexcept;
+
+        // Axis * angle, the shortest way (q and -q give the same vector)
+        [[nodiscard]] glm::vec3 RotationVectorFromQuat(const glm::quat& q) noexcept;
+        [[nodiscard]] glm::quat QuatFromRotationVector(const glm::vec3& v) noexcept;
     }
 
 }
\ No newline at end of file
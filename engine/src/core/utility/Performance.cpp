@@ -0,0 +1,451 @@
+#include "core/utility/Performance.h"
+
+#include <cstring>
+#include <deque>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace CoreEngine
+{
+namespace
+{
+    // Single producer (the owning thread), single consumer (EndFrame). Indices only grow, the slot is index % capacity.
+    struct ThreadBuffer
+    {
+        std::array<ScopeProfiler::ScopeEvent, ScopeProfiler::THREAD_CAPACITY> m_events {};
+        alignas(64) std::atomic<uint64_t> m_write_index {0};
+        alignas(64) std::atomic<uint64_t> m_read_index  {0};
+        std::atomic<uint64_t> m_dropped_events {0};
+        std::atomic<bool>     m_is_owned       {false};
+        uint32_t              m_thread_id      = 0; // Changes with every new owner, guarded by g_registry_mutex
+    };
+
+    // Gives the buffer back once its thread exits, so short lived threads don't pile up buffers
+    struct ThreadBufferOwnership
+    {
+        ThreadBuffer* m_buffer = nullptr;
+        ~ThreadBufferOwnership() noexcept
+        {
+            if (m_buffer) m_buffer->m_is_owned.store(false, std::memory_order::release);
+        }
+    };
+
+    std::mutex g_registry_mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> g_thread_buffers;
+    std::array<const char*, ScopeProfiler::MAX_SCOPES> g_scope_names {};
+    std::deque<std::string> g_owned_scope_names; // Deque, so the names' pointers stay valid
+    size_t g_amount_scopes = 0;
+    std::unordered_map<uint32_t, std::string> g_tag_names;
+    std::unordered_map<uint32_t, std::string> g_thread_names;
+    uint32_t g_next_thread_id = 1;
+
+    thread_local ThreadBufferOwnership t_thread_buffer;
+
+    // Aggregation, main thread only
+    struct FrameAccumulator
+    {
+        uint32_t m_calls    = 0;
+        int64_t  m_total_ns = 0;
+        int64_t  m_min_ns   = std::numeric_limits<int64_t>::max();
+        int64_t  m_max_ns   = 0;
+    };
+
+    std::vector<ScopeProfiler::ScopeStatistics> g_statistics;
+    std::vector<FrameAccumulator>               g_frame_accumulators;
+    std::unordered_map<uint64_t, size_t>        g_statistics_index;
+    uint64_t                                    g_dropped_events = 0;
+
+    // Tracing, main thread only
+    struct TraceEvent
+    {
+        ScopeProfiler::ScopeEvent m_event;
+        uint32_t                  m_thread_id = 0;
+    };
+
+    std::vector<TraceEvent> g_trace_events;
+    bool                    g_is_tracing        = false;
+    bool                    g_has_unsaved_trace = false; // From StartTrace() until written, also once the trace is full
+    int64_t                 g_trace_begin_ns    = 0;
+
+    [[nodiscard]] ThreadBuffer& AcquireThreadBuffer() noexcept
+    {
+        std::scoped_lock lock (g_registry_mutex);
+        for (std::unique_ptr<ThreadBuffer>& buffer : g_thread_buffers)
+        {
+            // Events of the previous owner have to be drained first, they still carry its thread id
+            if (buffer->m_read_index.load(std::memory_order::acquire) != buffer->m_write_index.load(std::memory_order::relaxed))
+                continue;
+
+            bool expected = false;
+            if (buffer->m_is_owned.compare_exchange_strong(expected, true, std::memory_order::acq_rel))
+            {
+                buffer->m_thread_id = g_next_thread_id++;
+                return *buffer;
+            }
+        }
+        g_thread_buffers.push_back(std::make_unique<ThreadBuffer>());
+        g_thread_buffers.back()->m_is_owned.store(true, std::memory_order::relaxed);
+        g_thread_buffers.back()->m_thread_id = g_next_thread_id++;
+        return *g_thread_buffers.back();
+    }
+
+    [[nodiscard]] ThreadBuffer& GetThreadBuffer() noexcept
+    {
+        if (! t_thread_buffer.m_buffer)
+            t_thread_buffer.m_buffer = &AcquireThreadBuffer();
+        return *t_thread_buffer.m_buffer;
+    }
+
+    [[nodiscard]] inline float NanoToMicro(int64_t ns) noexcept
+    {
+        return static_cast<float>(ns) * 1e-3f;
+    }
+
+    void Accumulate(const ScopeProfiler::ScopeEvent& event)
+    {
+        if (event.m_kind == ScopeProfiler::EventKind::COUNTER)
+            return;
+
+        // The same name may be measured on the CPU and the GPU
+        const uint64_t key = (static_cast<uint64_t>(event.m_kind) << 48) | (static_cast<uint64_t>(event.m_scope_id) << 32) | event.m_tag;
+
+        auto it = g_statistics_index.find(key);
+        if (it == g_statistics_index.end())
+        {
+            ScopeProfiler::ScopeStatistics statistics {};
+            statistics.m_scope_id = event.m_scope_id;
+            statistics.m_tag      = event.m_tag;
+            statistics.m_kind     = event.m_kind;
+            g_statistics.push_back(statistics);
+            g_frame_accumulators.emplace_back();
+            it = g_statistics_index.emplace(key, g_statistics.size() - 1).first;
+        }
+
+        FrameAccumulator& accumulator = g_frame_accumulators[it->second];
+        const int64_t duration = event.m_end_ns - event.m_begin_ns;
+        accumulator.m_calls++;
+        accumulator.m_total_ns += duration;
+        accumulator.m_min_ns    = std::min(accumulator.m_min_ns, duration);
+        accumulator.m_max_ns    = std::max(accumulator.m_max_ns, duration);
+    }
+
+    void AppendToTrace(const ScopeProfiler::ScopeEvent& event, uint32_t thread_id)
+    {
+        // Recorded before the trace started, but drained after
+        if (event.m_begin_ns < g_trace_begin_ns)
+            return;
+
+        if (g_trace_events.size() >= ScopeProfiler::MAX_TRACE_EVENTS)
+        {
+            g_is_tracing = false;
+            return;
+        }
+        g_trace_events.push_back(TraceEvent{ event, thread_id });
+    }
+
+    // Into the accumulators of the current frame & the trace
+    void DrainThreadBuffers() noexcept
+    {
+        std::scoped_lock lock (g_registry_mutex);
+        for (std::unique_ptr<ThreadBuffer>& buffer : g_thread_buffers)
+        {
+            const uint64_t read_index  = buffer->m_read_index.load(std::memory_order::relaxed);
+            const uint64_t write_index = buffer->m_write_index.load(std::memory_order::acquire);
+            for (uint64_t i = read_index; i < write_index; i++)
+            {
+                const ScopeProfiler::ScopeEvent& event = buffer->m_events[i % ScopeProfiler::THREAD_CAPACITY];
+                Accumulate(event);
+                if (g_is_tracing) AppendToTrace(event, event.m_kind == ScopeProfiler::EventKind::GPU ? ScopeProfiler::GPU_TRACE_THREAD_ID : buffer->m_thread_id);
+            }
+            buffer->m_read_index.store(write_index, std::memory_order::release);
+            g_dropped_events += buffer->m_dropped_events.exchange(0, std::memory_order::relaxed);
+        }
+    }
+
+    [[nodiscard]] std::string EscapeJson(std::string_view text)
+    {
+        std::string escaped;
+        escaped.reserve(text.size());
+        for (const char c : text)
+        {
+            switch (c)
+            {
+                case '"':  escaped += "\\\""; break;
+                case '\\': escaped += "\\\\"; break;
+                case '\n': escaped += "\\n"; break;
+                case '\t': escaped += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                        escaped += std::format("\\u{:04x}", static_cast<int>(c));
+                    else
+                        escaped += c;
+            }
+        }
+        return escaped;
+    }
+}
+    ////////////////////////////////////////////////
+    //--------- Registration
+    ////////////////////////////////////////////////
+    ScopeProfiler::ScopeId ScopeProfiler::RegisterScope(const char* name) noexcept
+    {
+        std::scoped_lock lock (g_registry_mutex);
+
+        // Same name from several call sites ends up in one scope
+        for (size_t i = 0; i < g_amount_scopes; i++)
+        {
+            if (std::strcmp(g_scope_names[i], name) == 0)
+                return static_cast<ScopeId>(i);
+        }
+
+        if (g_amount_scopes == MAX_SCOPES)
+            return static_cast<ScopeId>(MAX_SCOPES - 1);
+
+        g_scope_names[g_amount_scopes] = name;
+        return static_cast<ScopeId>(g_amount_scopes++);
+    }
+
+    ScopeProfiler::ScopeId ScopeProfiler::RegisterScope(std::string_view name) noexcept
+    {
+        std::scoped_lock lock (g_registry_mutex);
+
+        for (size_t i = 0; i < g_amount_scopes; i++)
+        {
+            if (std::string_view(g_scope_names[i]) == name)
+                return static_cast<ScopeId>(i);
+        }
+
+        if (g_amount_scopes == MAX_SCOPES)
+            return static_cast<ScopeId>(MAX_SCOPES - 1);
+
+        g_scope_names[g_amount_scopes] = g_owned_scope_names.emplace_back(name).c_str();
+        return static_cast<ScopeId>(g_amount_scopes++);
+    }
+
+    const char* ScopeProfiler::GetScopeName(ScopeId scope_id) noexcept
+    {
+        std::scoped_lock lock (g_registry_mutex);
+        return scope_id < g_amount_scopes ? g_scope_names[scope_id] : "Unknown";
+    }
+
+    void ScopeProfiler::SetTagName(uint32_t tag, std::string name) noexcept
+    {
+        std::scoped_lock lock (g_registry_mutex);
+        g_tag_names[tag] = std::move(name);
+    }
+
+    std::string ScopeProfiler::GetTagName(uint32_t tag) noexcept
+    {
+        std::scoped_lock lock (g_registry_mutex);
+        const auto it = g_tag_names.find(tag);
+        if (it != g_tag_names.end()) return it->second;
+        return tag == 0 ? std::string() : std::to_string(tag);
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Recording
+    ////////////////////////////////////////////////
+    void ScopeProfiler::Record(const ScopeEvent& event) noexcept
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        const uint64_t write_index = buffer.m_write_index.load(std::memory_order::relaxed);
+        if (write_index - buffer.m_read_index.load(std::memory_order::acquire) >= THREAD_CAPACITY)
+        {
+            buffer.m_dropped_events.fetch_add(1, std::memory_order::relaxed);
+            return;
+        }
+
+        buffer.m_events[write_index % THREAD_CAPACITY] = event;
+        buffer.m_write_index.store(write_index + 1, std::memory_order::release);
+    }
+
+    void ScopeProfiler::SetThreadName(std::string name) noexcept
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        std::scoped_lock lock (g_registry_mutex);
+        g_thread_names[buffer.m_thread_id] = std::move(name);
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Aggregation
+    ////////////////////////////////////////////////
+    void ScopeProfiler::FlushThreadBuffers() noexcept
+    {
+        DrainThreadBuffers();
+    }
+
+    void ScopeProfiler::EndFrame() noexcept
+    {
+        DrainThreadBuffers();
+
+        for (size_t i = 0; i < g_statistics.size(); i++)
+        {
+            ScopeStatistics&        statistics  = g_statistics[i];
+            const FrameAccumulator& accumulator = g_frame_accumulators[i];
+
+            statistics.m_calls           = accumulator.m_calls;
+            statistics.m_total_us        = NanoToMicro(accumulator.m_total_ns);
+            statistics.m_min_call_us     = accumulator.m_calls > 0 ? NanoToMicro(accumulator.m_min_ns) : 0.0f;
+            statistics.m_max_call_us     = NanoToMicro(accumulator.m_max_ns);
+            statistics.m_average_call_us = accumulator.m_calls > 0 ? statistics.m_total_us / static_cast<float>(accumulator.m_calls) : 0.0f;
+
+            statistics.m_history_total_us[statistics.m_history_head] = statistics.m_total_us;
+            statistics.m_history_head = (statistics.m_history_head + 1) % HISTORY_FRAMES;
+
+            float history_min = std::numeric_limits<float>::max();
+            float history_max = 0.0f;
+            float history_sum = 0.0f;
+            for (const float total : statistics.m_history_total_us)
+            {
+                history_min  = std::min(history_min, total);
+                history_max  = std::max(history_max, total);
+                history_sum += total;
+            }
+            statistics.m_history_min_us = history_min;
+            statistics.m_history_max_us = history_max;
+            statistics.m_history_avg_us = history_sum / static_cast<float>(HISTORY_FRAMES);
+        }
+
+        //After the statistics, FlushThreadBuffers() may have accumulated into this frame already
+        for (FrameAccumulator& accumulator : g_frame_accumulators)
+            accumulator = FrameAccumulator{};
+    }
+
+    const std::vector<ScopeProfiler::ScopeStatistics>& ScopeProfiler::GetStatisticsConstRef() noexcept
+    {
+        return g_statistics;
+    }
+
+    void ScopeProfiler::ResetStatistics() noexcept
+    {
+        g_statistics.clear();
+        g_frame_accumulators.clear();
+        g_statistics_index.clear();
+        g_dropped_events = 0;
+    }
+
+    uint64_t ScopeProfiler::GetAmountDroppedEvents() noexcept
+    {
+        return g_dropped_events;
+    }
+
+    void ScopeProfiler::SetEnabled(bool enabled) noexcept
+    {
+        s_is_enabled.store(enabled, std::memory_order::relaxed);
+    }
+
+    bool ScopeProfiler::GetIsEnabled() noexcept
+    {
+        return s_is_enabled.load(std::memory_order::relaxed);
+    }
+
+    ////////////////////////////////////////////////
+    //--------- Tracing
+    ////////////////////////////////////////////////
+    void ScopeProfiler::StartTrace() noexcept
+    {
+        g_trace_events.clear();
+        g_trace_begin_ns    = NowNanoSeconds();
+        g_is_tracing        = true;
+        g_has_unsaved_trace = true;
+        SetEnabled(true);
+    }
+
+    void ScopeProfiler::StopTrace() noexcept
+    {
+        g_is_tracing = false;
+    }
+
+    bool ScopeProfiler::GetIsTracing() noexcept
+    {
+        return g_is_tracing;
+    }
+
+    bool ScopeProfiler::GetHasUnsavedTrace() noexcept
+    {
+        return g_has_unsaved_trace;
+    }
+
+    size_t ScopeProfiler::GetAmountTraceEvents() noexcept
+    {
+        return g_trace_events.size();
+    }
+
+    bool ScopeProfiler::WriteTraceToFile(const std::string& file_path) noexcept
+    {
+        std::ofstream file (file_path, std::ios::out | std::ios::trunc);
+        if (! file.is_open())
+            return false;
+
+        std::vector<std::string> scope_names;
+        std::unordered_map<uint32_t, std::string> tag_names;
+        std::unordered_map<uint32_t, std::string> thread_names;
+        {
+            std::scoped_lock lock (g_registry_mutex);
+            scope_names.reserve(g_amount_scopes);
+            for (size_t i = 0; i < g_amount_scopes; i++)
+                scope_names.push_back(EscapeJson(g_scope_names[i]));
+            for (const auto& [tag, name] : g_tag_names)
+                tag_names.emplace(tag, EscapeJson(name));
+            for (const auto& [thread_id, name] : g_thread_names)
+                thread_names.emplace(thread_id, EscapeJson(name));
+        }
+
+        // Chrome Trace Event format, timestamps in microseconds since StartTrace()
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"CoreEngine\"}}";
+        file << std::format(",\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"GPU\"}}}}", GPU_TRACE_THREAD_ID);
+        for (const auto& [thread_id, name] : thread_names)
+        {
+            file << std::format(",\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}", thread_id, name);
+        }
+
+        for (const TraceEvent& trace_event : g_trace_events)
+        {
+            const ScopeEvent& event = trace_event.m_event;
+            const std::string& name = event.m_scope_id < scope_names.size() ? scope_names[event.m_scope_id] : scope_names.back();
+            const double begin_us   = static_cast<double>(event.m_begin_ns - g_trace_begin_ns) * 1e-3;
+
+            if (event.m_kind == EventKind::COUNTER)
+            {
+                file << std::format(",\n{{\"name\":\"{}\",\"ph\":\"C\",\"ts\":{:.3f},\"pid\":1,\"tid\":{},\"args\":{{\"value\":{}}}}}",
+                    name, begin_us, trace_event.m_thread_id, event.m_value);
+                continue;
+            }
+
+            const double duration_us = static_cast<double>(event.m_end_ns - event.m_begin_ns) * 1e-3;
+            file << std::format(",\n{{\"name\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{}",
+                name, begin_us, duration_us, trace_event.m_thread_id);
+
+            if (event.m_tag != 0)
+            {
+                const auto it = tag_names.find(event.m_tag);
+                if (it != tag_names.end())
+                    file << std::format(",\"args\":{{\"tag\":\"{}\"}}", it->second);
+                else
+                    file << std::format(",\"args\":{{\"tag\":{}}}", event.m_tag);
+            }
+            file << '}';
+        }
+        file << "\n]}\n";
+
+        file.close();
+        if (! file.good())
+            return false;
+        g_has_unsaved_trace = false;
+        return true;
+    }
+
+    std::string ScopeProfiler::ScopeStatistics::ToString() const
+    {
+        const std::string tag_name = GetTagName(m_tag);
+        return std::format("{}{}{}{} : {:.1f} µs ({} calls, {:.1f}/{:.1f}/{:.1f}) | {} frames {:.1f}/{:.1f}/{:.1f}",
+            m_kind == EventKind::GPU ? "[GPU] " : "", GetScopeName(m_scope_id), tag_name.empty() ? "" : " @ ", tag_name,
+            m_total_us, m_calls, m_min_call_us, m_average_call_us, m_max_call_us,
+            HISTORY_FRAMES, m_history_min_us, m_history_avg_us, m_history_max_us);
+    }
+}
@@ -1,68 +1,196 @@
 #pragma once
 
-#include <vector>
-#include <string>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "core/utility/Units.h"
-#include "core/utility/ScopedTimer.h"
 
-#define ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME(msg) const ::CoreEngine::ScopedCallbackTimer timer_##__LINE__( \
-    [](std::string&& message, ::CoreEngine::Units::MicroSecond ms) -> void { ::CoreEngine::PerFrameScopeTimes::CallScopeTime(std::move(message), ms); }, std::string(msg) ) 
+////////////////////////////////////////////////
+//--------- Scope profiling
+////////////////////////////////////////////////
+// The name must be a string literal (or otherwise outlive the program); it is registered once per call site and
+// afterwards only the static id is recorded. The tag separates runs of the same scope, e.g. per window.
+// Defining ENGINE_DISABLE_PROFILER compiles all scopes out; at runtime a disabled profiler costs one relaxed load per scope.
+#ifndef ENGINE_DISABLE_PROFILER
+    #define ENGINE_PERFORMANCE_CONCAT_IMPL(a, b) a##b
+    #define ENGINE_PERFORMANCE_CONCAT(a, b) ENGINE_PERFORMANCE_CONCAT_IMPL(a, b)
+
+    #define ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME_TAGGED(name, tag) \
+        static const ::CoreEngine::ScopeProfiler::ScopeId ENGINE_PERFORMANCE_CONCAT(profiler_scope_id_, __LINE__) = ::CoreEngine::ScopeProfiler::RegisterScope(name); \
+        const ::CoreEngine::ScopeProfiler::ScopeGuard ENGINE_PERFORMANCE_CONCAT(profiler_scope_guard_, __LINE__) (ENGINE_PERFORMANCE_CONCAT(profiler_scope_id_, __LINE__), static_cast<uint32_t>(tag))
+
+    #define ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME(name) ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME_TAGGED(name, 0)
+
+    // Value over time, only shows up in traces
+    #define ENGINE_PERFORMANCE_TRACE_COUNTER(name, value) do { \
+        static const ::CoreEngine::ScopeProfiler::ScopeId profiler_counter_id = ::CoreEngine::ScopeProfiler::RegisterScope(name); \
+        ::CoreEngine::ScopeProfiler::RecordCounter(profiler_counter_id, static_cast<double>(value)); } while (false)
+#else
+    #define ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME_TAGGED(name, tag) static_cast<void>(0)
+    #define ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME(name) static_cast<void>(0)
+    #define ENGINE_PERFORMANCE_TRACE_COUNTER(name, value) static_cast<void>(0)
+#endif
 
-#define ENGINE_PERFORMANCE_LOG_OCCURENCE(msg, count) ::CoreEngine::PerFrameOccurrenceCounter::CallOccurenceCounter(std::move(msg), count)
+// msg is only evaluated on the first call of the call site, which registers it (the only allocation); count on every call
+#define ENGINE_PERFORMANCE_LOG_OCCURENCE(msg, count) do { \
+    static const ::CoreEngine::PerFrameOccurrenceCounter::CounterId profiler_occurrence_id = ::CoreEngine::PerFrameOccurrenceCounter::RegisterCounter(msg); \
+    const size_t profiler_occurrence_count = static_cast<size_t>(count); \
+    ::CoreEngine::PerFrameOccurrenceCounter::CallOccurenceCounter(profiler_occurrence_id, profiler_occurrence_count); \
+    ENGINE_PERFORMANCE_TRACE_COUNTER(::CoreEngine::PerFrameOccurrenceCounter::GetCounterMessage(profiler_occurrence_id), profiler_occurrence_count); } while (false)
 
 namespace CoreEngine
-{  
-    //////////////////////////////////////////////// 
+{
+    ////////////////////////////////////////////////
     //--------- Scope times
-    //////////////////////////////////////////////// 
-    class PerFrameScopeTimes final
+    ////////////////////////////////////////////////
+    // Every thread records into its own lock free ring buffer; EndFrame() (main loop, once per iteration) drains all of
+    // them and aggregates per scope & tag. Recording never allocates, only the first event of a new thread does.
+    class ScopeProfiler final
     {
     public:
-        struct ScopeTimeData
+        using ScopeId = uint16_t;
+        static constexpr ScopeId NO_SCOPE       = std::numeric_limits<ScopeId>::max();
+        static constexpr size_t MAX_SCOPES      = 1024;
+        static constexpr size_t HISTORY_FRAMES  = 120;
+        static constexpr size_t THREAD_CAPACITY = 8192; // Events per thread between two EndFrame() calls
+
+        enum class EventKind : uint8_t
         {
-            std::string        m_message;
-            Units::MicroSecond m_time {0};
-            
-            [[nodiscard]] constexpr inline std::string ToString() const
-            {
-                return m_message + " µs : " + std::to_string(m_time.Get());
-            }
+            SCOPE, COUNTER,
+            GPU // Recorded by the GpuProfiler: begin = CPU time of submission, end - begin = GPU time
+        };
+
+        struct ScopeEvent
+        {
+            int64_t   m_begin_ns  = 0; // steady_clock
+            int64_t   m_end_ns    = 0;
+            double    m_value     = 0.0; // Counters only
+            uint32_t  m_tag       = 0;
+            ScopeId   m_scope_id  = 0;
+            EventKind m_kind      = EventKind::SCOPE;
         };
 
-        constexpr static inline void CallScopeTime(std::string&& message, Units::MicroSecond elapsed_millis) noexcept
+        struct ScopeStatistics
         {
-            auto it = std::find_if(s_scope_times.begin(), s_scope_times.end(), [&message](const ScopeTimeData& data) { return data.m_message == message; });
+            ScopeId   m_scope_id = 0;
+            uint32_t  m_tag      = 0;
+            EventKind m_kind     = EventKind::SCOPE; // SCOPE or GPU
+
+            // Last frame, over the single calls
+            uint32_t m_calls           = 0;
+            float    m_total_us        = 0.0f;
+            float    m_min_call_us     = 0.0f;
+            float    m_average_call_us = 0.0f;
+            float    m_max_call_us     = 0.0f;
+
+            // Per frame totals of the last HISTORY_FRAMES frames (ring, m_history_head = oldest)
+            std::array<float, HISTORY_FRAMES> m_history_total_us {};
+            size_t   m_history_head   = 0;
+            float    m_history_min_us = 0.0f;
+            float    m_history_avg_us = 0.0f;
+            float    m_history_max_us = 0.0f;
+
+            [[nodiscard]] std::string ToString() const;
+        };
 
-            if (it != s_scope_times.end())
+        class ScopeGuard
+        {
+        public:
+            explicit ScopeGuard(ScopeId scope_id, uint32_t tag) noexcept : m_scope_id(scope_id), m_tag(tag)
             {
-                it->m_time = elapsed_millis;
+            #ifdef ENGINE_ENABLE_ALLOCATION_TRACKING
+                m_parent_scope_id  = s_current_scope_id;
+                s_current_scope_id = scope_id;
+            #endif
+                if (s_is_enabled.load(std::memory_order::relaxed))
+                    m_begin_ns = NowNanoSeconds();
             }
-            else
+
+            ~ScopeGuard() noexcept
             {
-                s_scope_times.emplace_back(std::move(message), elapsed_millis);
+                if (m_begin_ns != NOT_RECORDING)
+                    Record(ScopeEvent{ m_begin_ns, NowNanoSeconds(), 0.0, m_tag, m_scope_id, EventKind::SCOPE });
+            #ifdef ENGINE_ENABLE_ALLOCATION_TRACKING
+                s_current_scope_id = m_parent_scope_id;
+            #endif
             }
-        }
 
-        constexpr static inline void ResetFrameScopeTimes() noexcept 
-        { 
-            s_scope_times.clear(); 
-        }
+            ScopeGuard(const ScopeGuard&)            = delete;
+            ScopeGuard& operator=(const ScopeGuard&) = delete;
 
-        constexpr static inline void SortData() noexcept
+        private:
+            static constexpr int64_t NOT_RECORDING = -1;
+
+            int64_t  m_begin_ns = NOT_RECORDING;
+            ScopeId  m_scope_id;
+            uint32_t m_tag;
+        #ifdef ENGINE_ENABLE_ALLOCATION_TRACKING
+            ScopeId  m_parent_scope_id = NO_SCOPE;
+        #endif
+        };
+
+        [[nodiscard]] static ScopeId RegisterScope(const char* name) noexcept;
+        // Copies the name, for names that don't outlive the program
+        [[nodiscard]] static ScopeId RegisterScope(std::string_view name) noexcept;
+        [[nodiscard]] static const char* GetScopeName(ScopeId scope_id) noexcept;
+
+        // Optional readable names for tags, e.g. window titles
+        static void SetTagName(uint32_t tag, std::string name) noexcept;
+        [[nodiscard]] static std::string GetTagName(uint32_t tag) noexcept;
+
+        static void Record(const ScopeEvent& event) noexcept;
+
+        static inline void RecordCounter(ScopeId counter_id, double value) noexcept
         {
-            std::sort(s_scope_times.begin(), s_scope_times.end(), [](const ScopeTimeData& a, const ScopeTimeData& b) -> bool { return a.m_time < b.m_time; } );
+            if (! s_is_enabled.load(std::memory_order::relaxed)) return;
+            const int64_t now = NowNanoSeconds();
+            Record(ScopeEvent{ now, now, value, 0, counter_id, EventKind::COUNTER });
         }
 
-        [[nodiscard]] constexpr static inline const std::vector<ScopeTimeData>& GetScopeTimeDataConstRef() noexcept 
-        { 
-            return s_scope_times; 
+        // Shows up as the thread name in traces; applies to the calling thread until it exits
+        static void SetThreadName(std::string name) noexcept;
+
+        // Innermost open scope of the calling thread, only tracked with ENGINE_ENABLE_ALLOCATION_TRACKING (see AllocationTracker)
+        [[nodiscard]] static inline ScopeId GetCurrentScopeId() noexcept { return s_current_scope_id; }
+
+        // Main thread only
+        static void EndFrame() noexcept;
+        // Drains the threads' events into the current frame (& trace) without ending it, e.g. right before writing a trace
+        static void FlushThreadBuffers() noexcept;
+        [[nodiscard]] static const std::vector<ScopeStatistics>& GetStatisticsConstRef() noexcept;
+        static void ResetStatistics() noexcept;
+        [[nodiscard]] static uint64_t GetAmountDroppedEvents() noexcept;
+
+        static void SetEnabled(bool enabled) noexcept;
+        [[nodiscard]] static bool GetIsEnabled() noexcept;
+
+        // Tracing keeps every drained event (up to MAX_TRACE_EVENTS) for export in the Chrome Trace Event format,
+        // which chrome://tracing, Perfetto (ui.perfetto.dev) and Speedscope open directly. A full trace stops by itself,
+        // its events stay until the next StartTrace(), GetHasUnsavedTrace() is true until it is written
+        static constexpr size_t MAX_TRACE_EVENTS = 1'000'000;
+        static constexpr uint32_t GPU_TRACE_THREAD_ID = std::numeric_limits<uint32_t>::max(); // Own track for EventKind::GPU
+        static void StartTrace() noexcept;
+        static void StopTrace() noexcept;
+        [[nodiscard]] static bool GetIsTracing() noexcept;
+        [[nodiscard]] static bool GetHasUnsavedTrace() noexcept;
+        [[nodiscard]] static size_t GetAmountTraceEvents() noexcept;
+        [[nodiscard]] static bool WriteTraceToFile(const std::string& file_path) noexcept;
+
+        [[nodiscard]] static inline int64_t NowNanoSeconds() noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
         }
 
     private:
-        static inline std::vector<ScopeTimeData> s_scope_times;
-        
+        static inline std::atomic<bool> s_is_enabled = true;
+        static inline thread_local ScopeId s_current_scope_id = NO_SCOPE;
     };
 
 
@@ -72,10 +200,13 @@ namespace CoreEngine
     class PerFrameOccurrenceCounter final
     {
     public:
+        using CounterId = uint32_t;
+
         struct OccurrenceCounterData
         {
             std::string        m_message;
             size_t             m_count {0};
+            CounterId          m_id    {0};
             
             [[nodiscard]] constexpr inline std::string ToString() const
             {
@@ -83,29 +214,43 @@ namespace CoreEngine
             }
         };
 
-        constexpr static inline void CallOccurenceCounter(std::string&& message, const size_t count) noexcept
+        // Once per call site (see ENGINE_PERFORMANCE_LOG_OCCURENCE), copies the message
+        [[nodiscard]] static inline CounterId RegisterCounter(std::string_view message) noexcept
         {
-            auto it = std::find_if(s_occurence_data.begin(), s_occurence_data.end(), [&message](const OccurrenceCounterData& data) { return data.m_message == message; });
+            const CounterId id = static_cast<CounterId>(s_index_of_id.size());
+            s_index_of_id.push_back(s_occurence_data.size());
+            s_occurence_data.push_back(OccurrenceCounterData{ std::string(message), 0, id });
+            return id;
+        }
 
-            if (it != s_occurence_data.end())
-            {
-                it->m_count = count;
-            }
-            else
-            {
-                s_occurence_data.emplace_back(std::move(message), count);
-            }
+        constexpr static inline void CallOccurenceCounter(CounterId id, const size_t count) noexcept
+        {
+            s_occurence_data[s_index_of_id[id]].m_count = count;
+        }
+
+        [[nodiscard]] constexpr static inline const std::string& GetCounterMessage(CounterId id) noexcept
+        {
+            return s_occurence_data[s_index_of_id[id]].m_message;
         }
 
+        // Registered call sites stay, only their counts are zeroed
         constexpr static inline void ResetFrameOccurenceCounts() noexcept 
         { 
-            s_occurence_data.clear(); 
+            for (OccurrenceCounterData& data : s_occurence_data)
+            {
+                data.m_count = 0;
+            }
         }
 
         constexpr static inline void SortData() noexcept
         {
             std::sort(s_occurence_data.begin(), s_occurence_data.end(),
             [](const OccurrenceCounterData& a, const OccurrenceCounterData& b) -> bool { return a.m_count < b.m_count; } );
+
+            for (size_t i = 0; i < s_occurence_data.size(); i++)
+            {
+                s_index_of_id[s_occurence_data[i].m_id] = i;
+            }
         }
 
         [[nodiscard]] constexpr static inline const std::vector<OccurrenceCounterData>& GetOccurrenceCounterDataConstRef() noexcept 
@@ -115,6 +260,7 @@ namespace CoreEngine
 
     private:
         static inline std::vector<OccurrenceCounterData> s_occurence_data;
+        static inline std::vector<size_t>                s_index_of_id; // CounterId -> index into s_occurence_data, which SortData() reorders
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "core/utility/RangeAllocator.h"
+
+#include "core/utility/Assert.h"
+
+#include <iterator>
+
+namespace CoreEngine
+{
+    RangeAllocator::RangeAllocator(size_t capacity) noexcept
+    {
+        Reset(capacity);
+    }
+
+    size_t RangeAllocator::Allocate(size_t size) noexcept
+    {
+        if (size == 0)
+            return 0;
+
+        for (auto it = m_free_ranges.begin(); it != m_free_ranges.end(); ++it)
+        {
+            if (it->second < size)
+                continue;
+
+            const size_t offset    = it->first;
+            const size_t remaining = it->second - size;
+            m_free_ranges.erase(it);
+            if (remaining > 0)
+            {
+                m_free_ranges.emplace(offset + size, remaining);
+            }
+            m_amount_free -= size;
+            return offset;
+        }
+        return INVALID_OFFSET;
+    }
+
+    void RangeAllocator::Free(size_t offset, size_t size) noexcept
+    {
+        if (size == 0)
+            return;
+
+        ENGINE_ASSERT(offset + size <= m_capacity && "At RangeAllocator::Free(): Range is out of bounds.");
+        m_amount_free += size;
+
+        auto next = m_free_ranges.lower_bound(offset);
+        ENGINE_ASSERT((next == m_free_ranges.end() || offset + size <= next->first) && "At RangeAllocator::Free(): Range overlaps a free range.");
+
+        //Merge with the free range before
+        if (next != m_free_ranges.begin())
+        {
+            auto previous = std::prev(next);
+            ENGINE_ASSERT(previous->first + previous->second <= offset && "At RangeAllocator::Free(): Range overlaps a free range.");
+            if (previous->first + previous->second == offset)
+            {
+                offset = previous->first;
+                size  += previous->second;
+                m_free_ranges.erase(previous);
+            }
+        }
+
+        //Merge with the free range after
+        if (next != m_free_ranges.end() && offset + size == next->first)
+        {
+            size += next->second;
+            m_free_ranges.erase(next);
+        }
+
+        m_free_ranges.emplace(offset, size);
+    }
+
+    void RangeAllocator::Grow(size_t new_capacity) noexcept
+    {
+        if (new_capacity <= m_capacity)
+            return;
+
+        const size_t old_capacity = m_capacity;
+        m_capacity = new_capacity;
+        Free(old_capacity, new_capacity - old_capacity);
+    }
+
+    void RangeAllocator::Reset(size_t capacity) noexcept
+    {
+        m_free_ranges.clear();
+        m_capacity    = capacity;
+        m_amount_free = capacity;
+        if (capacity > 0)
+        {
+            m_free_ranges.emplace(0, capacity);
+        }
+    }
+
+    size_t RangeAllocator::GetCapacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+    size_t RangeAllocator::GetAmountFree() const noexcept
+    {
+        return m_amount_free;
+    }
+
+    size_t RangeAllocator::GetAmountFreeRanges() const noexcept
+    {
+        return m_free_ranges.size();
+    }
+}
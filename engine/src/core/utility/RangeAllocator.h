@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace CoreEngine
+{
+    ////////////////////////////////////////////////
+    //--------- Range allocator
+    ////////////////////////////////////////////////
+    // Hands out [offset, offset + size) ranges of a linear space of GetCapacity() units, e.g. vertices in a shared vertex
+    // buffer. First fit over a free list ordered by offset, freed ranges merge with their free neighbours. Only does the
+    // bookkeeping, the owner of the actual memory grows it & calls Grow() when Allocate() fails.
+    class RangeAllocator final
+    {
+    public:
+        static constexpr size_t INVALID_OFFSET = SIZE_MAX;
+
+        explicit RangeAllocator(size_t capacity = 0) noexcept;
+
+        // INVALID_OFFSET if no free range is large enough. Size 0 always succeeds with offset 0 and needs no Free()
+        [[nodiscard]] size_t Allocate(size_t size) noexcept;
+        void Free(size_t offset, size_t size) noexcept;
+
+        // Appends [old capacity, new_capacity) as free, merged with a free range at the end
+        void Grow(size_t new_capacity) noexcept;
+        void Reset(size_t capacity) noexcept;
+
+        [[nodiscard]] size_t GetCapacity() const noexcept;
+        [[nodiscard]] size_t GetAmountFree() const noexcept;
+        [[nodiscard]] size_t GetAmountFreeRanges() const noexcept;
+
+    private:
+        std::map<size_t, size_t> m_free_ranges; // Offset -> size
+        size_t m_capacity    = 0;
+        size_t m_amount_free = 0;
+    };
+}
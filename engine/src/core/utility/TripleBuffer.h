@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace CoreEngine
+{
+    /// @brief Wait-free single producer / single consumer handoff of the latest value.
+    /// The producer always owns one slot, the consumer owns one slot and the third slot is exchanged atomically.
+    /// Neither side ever blocks or retries, older values that were never read are simply overwritten.
+    template <typename T>
+    requires (std::is_copy_assignable_v<T>)
+    class TripleBuffer
+    {
+    public:
+        constexpr TripleBuffer() noexcept = default;
+
+        TripleBuffer(const TripleBuffer&)            = delete;
+        TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+        /// @brief Only ever call from the producing thread.
+        void Publish(const T& value) noexcept
+        {
+            m_slots[m_producer_index] = value;
+            const std::uint8_t previous = m_middle_state.exchange(static_cast<std::uint8_t>(m_producer_index | DIRTY_BIT), std::memory_order::acq_rel);
+            m_producer_index = previous & INDEX_MASK;
+        }
+
+        /// @brief Only ever call from the consuming thread. Returns false if nothing new was published since the last call.
+        /// @param out Receives the latest published value, untouched if nothing was ever published.
+        [[nodiscard]] bool ConsumeLatest(T& out) noexcept
+        {
+            if ((m_middle_state.load(std::memory_order::relaxed) & DIRTY_BIT) == 0)
+            {
+                if (m_has_consumed_once) out = m_slots[m_consumer_index];
+                return false;
+            }
+
+            const std::uint8_t previous = m_middle_state.exchange(m_consumer_index, std::memory_order::acq_rel);
+            m_consumer_index    = previous & INDEX_MASK;
+            m_has_consumed_once = true;
+            out = m_slots[m_consumer_index];
+            return true;
+        }
+
+    private:
+        static constexpr const std::uint8_t DIRTY_BIT  = 0b100;
+        static constexpr const std::uint8_t INDEX_MASK = 0b011;
+
+        std::array<T, 3> m_slots {};
+
+        alignas(64) std::atomic<std::uint8_t> m_middle_state {1};
+        alignas(64) std::uint8_t m_producer_index = 0;
+        alignas(64) std::uint8_t m_consumer_index = 2;
+        bool m_has_consumed_once = false;
+    };
+}
@@ -1,15 +1,51 @@
 #include "core/application/Application.h"
 
 #include "tas/layers/TasLayer.h"
+#include "tas/layers/HeadlessLayer.h"
+#include "tas/globalstate/GameState.h"
 
-int main()
+#include <cstring>
+#include <span>
+
+int main(int argc, char** argv)
 {
+    const std::span<char* const> arguments (argv, static_cast<size_t>(argc));
+
+    if (AsphaltTas::HeadlessLayer::CommandLineRequestsHeadless(arguments))
+    {
+        const std::optional<AsphaltTas::HeadlessLayer::Job> job = AsphaltTas::HeadlessLayer::ParseCommandLine(arguments);
+        if (! job)
+        {
+            return 2;
+        }
+
+        constexpr CoreEngine::Application::ApplicationConfig headless_config 
+        {
+            .m_debug_launch_with_console        = true,
+            .m_headless                         = true
+        };
+
+        CoreEngine::Application app = CoreEngine::Application::Create(headless_config);
+        app.PushHeadlessLayer<AsphaltTas::HeadlessLayer>(*job);
+        app.Run();
+        return AsphaltTas::HeadlessLayer::GetExitCode();
+    }
+
+    // --target <exe> also works with the window, e.g. to attach to the stand-in
+    for (size_t i = 1; i + 1 < arguments.size(); i++)
+    {
+        if (std::strcmp(arguments[i], "--target") == 0)
+        {
+            AsphaltTas::GameState::SetExeNameOverride(arguments[i + 1]);
+        }
+    }
 
     constexpr CoreEngine::Application::ApplicationConfig application_config 
     {
         .m_enable_vsync                     = true,
         .m_debug_launch_with_console        = true,
-        .m_use_glfw_await_events            = false
+        .m_use_glfw_await_events            = false,
+        .m_enable_idle_frame_pacing         = true
     };
 
     using Cdis = CoreEngine::Window::WindowCreationConfig::CallbackDisableFlags;
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "tas/globalstate/MemoryAddressState.h"
+
+#include <cstdint>
+
+// Shared between the stand-in target and the tool, see StandInTarget.h
+namespace AsphaltTas::StandIn
+{
+    // Short enough for the 15 characters Linux keeps of a process name
+#ifdef _WIN32
+    constexpr const char* const EXE_NAME = "AsphaltStandIn.exe";
+#else
+    constexpr const char* const EXE_NAME = "AsphaltStandIn";
+#endif
+
+    // Relative to the racer base, behind everything RacerStateAddresses covers. Incremented once per simulated tick,
+    // the tool reads it to see game ticks exactly (see LatencyProbe::SetTickCounterReader()).
+    constexpr uintptr_t OFFSET_TICK_COUNTER = 0x170;
+    static_assert(OFFSET_TICK_COUNTER >= RacerStateAddresses::GetByteSizeBaseToLastElementInclusive());
+    static_assert(OFFSET_TICK_COUNTER % alignof(uint64_t) == 0);
+}
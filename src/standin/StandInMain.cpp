@@ -0,0 +1,140 @@
+// Stand-in for the game, see StandInTarget.h. Own executable, run it and start the tool with --target AsphaltStandIn(.exe)
+//
+// Usage: AsphaltStandIn [--tick-rate <hz>] [--duration <seconds>] [--load-threads <count>]
+
+#include "standin/StandInTarget.h"
+#include "standin/StandInLayout.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Options
+    {
+        double   m_tick_rate           = 60.0; // Hz
+        double   m_duration            = 0.0;  // Seconds, 0 = until killed
+        uint32_t m_amount_load_threads = 0;    // Busy threads competing with the tool for the CPU, like the game's would
+    };
+
+    [[nodiscard]] bool ParseDouble(const char* text, double& out) noexcept
+    {
+        char* end = nullptr;
+        out = std::strtod(text, &end);
+        return end != text && *end == '\0';
+    }
+
+    [[nodiscard]] bool ParseCommandLine(std::span<char* const> arguments, Options& options) noexcept
+    {
+        bool is_valid = true;
+
+        for (size_t i = 1; i < arguments.size() && is_valid; i++)
+        {
+            const char* argument = arguments[i];
+            const bool has_value = i + 1 < arguments.size();
+
+            if (std::strcmp(argument, "--tick-rate") == 0 && has_value)
+            {
+                is_valid = ParseDouble(arguments[++i], options.m_tick_rate) && options.m_tick_rate > 0.0;
+            }
+            else if (std::strcmp(argument, "--duration") == 0 && has_value)
+            {
+                is_valid = ParseDouble(arguments[++i], options.m_duration) && options.m_duration >= 0.0;
+            }
+            else if (std::strcmp(argument, "--load-threads") == 0 && has_value)
+            {
+                double amount = 0.0;
+                is_valid = ParseDouble(arguments[++i], amount) && amount >= 0.0 && amount <= 256.0;
+                options.m_amount_load_threads = static_cast<uint32_t>(amount);
+            }
+            else
+            {
+                is_valid = false;
+            }
+        }
+
+        if (! is_valid)
+        {
+            std::cerr << "Usage: " << (arguments.empty() ? AsphaltTas::StandIn::EXE_NAME : arguments[0])
+                      << " [--tick-rate <hz>] [--duration <seconds>] [--load-threads <count>]\n";
+        }
+        return is_valid;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::span<char* const> arguments (argv, static_cast<size_t>(argc));
+
+    Options options {};
+    if (! ParseCommandLine(arguments, options))
+    {
+        return 2;
+    }
+
+    try
+    {
+        AsphaltTas::StandIn::Target target;
+
+        std::cout << std::hex
+                  << "Racer base:  0x" << target.GetRacerBaseAddress()  << "\n"
+                  << "Camera base: 0x" << target.GetCameraBaseAddress() << "\n"
+                  << std::dec
+                  << "Ticking at " << options.m_tick_rate << " Hz, " << options.m_amount_load_threads << " load thread(s)" << std::endl;
+
+        std::atomic<bool> is_running = true;
+        std::vector<std::thread> load_threads;
+        for (uint32_t i = 0; i < options.m_amount_load_threads; i++)
+        {
+            load_threads.emplace_back([&is_running]()
+            {
+                volatile uint64_t sink = 0;
+                while (is_running.load(std::memory_order::relaxed))
+                    sink = sink + 1;
+            });
+        }
+
+        using Clock = std::chrono::steady_clock;
+        const double dt_seconds = 1.0 / options.m_tick_rate;
+        const auto   tick_period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(dt_seconds));
+        const uint64_t ticks_per_status = std::max<uint64_t>(static_cast<uint64_t>(options.m_tick_rate * 5.0), 1); // Every 5 s
+        const uint64_t max_ticks        = static_cast<uint64_t>(options.m_duration * options.m_tick_rate);
+
+        auto next_tick = Clock::now();
+        while (max_ticks == 0 || target.GetTickCount() < max_ticks)
+        {
+            target.Tick(dt_seconds);
+
+            if (target.GetTickCount() % ticks_per_status == 0)
+            {
+                std::cout << "Ticks: " << target.GetTickCount()
+                          << " | Camera update patched: " << (target.GetCameraUpdateIsPatched()  ? "yes" : "no")
+                          << " | Capture hook installed: " << (target.GetCaptureHookIsInstalled() ? "yes" : "no") << std::endl;
+            }
+
+            // Fixed timestep, a late tick doesn't shift the ones after it
+            next_tick += tick_period;
+            std::this_thread::sleep_until(next_tick);
+        }
+
+        is_running.store(false, std::memory_order::relaxed);
+        for (std::thread& thread : load_threads)
+            thread.join();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
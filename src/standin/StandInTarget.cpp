@@ -0,0 +1,274 @@
+#include "standin/StandInTarget.h"
+#include "standin/StandInLayout.h"
+
+#include "tas/common/RacerState.h"
+#include "tas/globalstate/MemoryAddressState.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+#if ! (defined(__x86_64__) || defined(_M_X64))
+    #error "The stand-in target executes x86-64 code like the game does."
+#endif
+
+namespace AsphaltTas::StandIn
+{
+namespace
+{
+//////////////////////////////////////////////////////////
+// Code
+//////////////////////////////////////////////////////////
+    // The sequences the tool scans for must exist exactly once in the module: here, in the data section, where they can be
+    // made executable. No copy or template of these bytes may exist anywhere else, hence the immediates are patched in place.
+    // Every function takes no arguments & saves what it uses of the callee saved registers, so the ABI doesn't matter.
+    struct alignas(4096) CodePage
+    {
+        uint8_t m_racer_capture_site[67];
+        uint8_t m_camera_capture_site[37];
+        uint8_t m_camera_update[125];
+    };
+
+    CodePage g_code_page
+    {
+        // Racer capture site: MemoryAddressFinder::FindRacerStateBaseAddress() hooks +33 to capture rax (the world) and
+        // reads the disp32 at +49 as the offset of the racer pointer in the world
+        {
+            0x53,                                                   // +0  push rbx
+            0x41, 0x56,                                             // +1  push r14
+            0x48, 0xB8, 0, 0, 0, 0, 0, 0, 0, 0,                     // +3  mov rax, world
+            0x48, 0xBB, 0, 0, 0, 0, 0, 0, 0, 0,                     // +13 mov rbx, scratch
+            0x49, 0xBE, 0, 0, 0, 0, 0, 0, 0, 0,                     // +23 mov r14, scratch
+            0x48, 0x89, 0x43, 0x08,                                 // +33 mov [rbx+08], rax
+            0xF3, 0x41, 0x0F, 0x10, 0x8E, 0x30, 0x01, 0x00, 0x00,   // +37 movss xmm1, [r14+130]
+            0x48, 0x8B, 0x80, 0x48, 0x00, 0x00, 0x00,               // +46 mov rax, [rax+WORLD_OFFSET_RACER_POINTER]
+            0x83, 0xB8, 0x04, 0x01, 0x00, 0x00, 0x00,               // +53 cmp dword ptr [rax+104], 0
+            0x0F, 0x95, 0xC0,                                       // +60 setne al
+            0x41, 0x5E,                                             // +63 pop r14
+            0x5B,                                                   // +65 pop rbx
+            0xC3                                                    // +66 ret
+        },
+        // Camera capture site: MemoryAddressFinder::FindCameraStateAddresses() hooks +21 to capture rax (the camera state)
+        {
+            0x57,                                                   // +0  push rdi
+            0x48, 0xB8, 0, 0, 0, 0, 0, 0, 0, 0,                     // +1  mov rax, camera state
+            0x48, 0xBF, 0, 0, 0, 0, 0, 0, 0, 0,                     // +11 mov rdi, scratch
+            0xF3, 0x0F, 0x10, 0x08,                                 // +21 movss xmm1, [rax]
+            0xF3, 0x0F, 0x10, 0x50, 0x04,                           // +25 movss xmm2, [rax+04]
+            0xF3, 0x0F, 0x5C, 0x57, 0x78,                           // +30 subss xmm2, [rdi+78]
+            0x5F,                                                   // +35 pop rdi
+            0xC3                                                    // +36 ret
+        },
+        // Camera update: MemoryRW::DestroyCameraUpdateCode() NOPs the stores to the camera object (rcx)
+        {
+            0x48, 0xB9, 0, 0, 0, 0, 0, 0, 0, 0,                     // +0   mov rcx, camera object
+            0x48, 0xBA, 0, 0, 0, 0, 0, 0, 0, 0,                     // +10  mov rdx, source position
+            0xF2, 0x0F, 0x10, 0x02,                                 // +20  movsd xmm0, [rdx]
+            0xF2, 0x0F, 0x11, 0x41, 0x38,                           // +24  movsd [rcx+38], xmm0
+            0x8B, 0x42, 0x08,                                       // +29  mov eax, [rdx+08]
+            0x89, 0x41, 0x40,                                       // +32  mov [rcx+40], eax
+            0xC6, 0x41, 0x58, 0x01,                                 // +35  mov byte ptr [rcx+58], 01
+            0x48, 0xBA, 0, 0, 0, 0, 0, 0, 0, 0,                     // +39  mov rdx, source rotation
+            0xF3, 0x0F, 0x10, 0x0A,                                 // +49  movss xmm1, [rdx]
+            0xF3, 0x0F, 0x11, 0x49, 0x44,                           // +53  movss [rcx+44], xmm1
+            0x8B, 0x42, 0x04,                                       // +58  mov eax, [rdx+04]
+            0x89, 0x41, 0x48,                                       // +61  mov [rcx+48], eax
+            0x8B, 0x42, 0x08,                                       // +64  mov eax, [rdx+08]
+            0x89, 0x41, 0x4C,                                       // +67  mov [rcx+4C], eax
+            0x8B, 0x42, 0x0C,                                       // +70  mov eax, [rdx+0C]
+            0x89, 0x41, 0x50,                                       // +73  mov [rcx+50], eax
+            0x48, 0xBA, 0, 0, 0, 0, 0, 0, 0, 0,                     // +76  mov rdx, source fov
+            0xF3, 0x0F, 0x10, 0x02,                                 // +86  movss xmm0, [rdx]
+            0x8B, 0x42, 0x04,                                       // +90  mov eax, [rdx+04]
+            0x0F, 0x2E, 0x81, 0x28, 0x01, 0x00, 0x00,               // +93  ucomiss xmm0, [rcx+128]
+            0x75, 0x08,                                             // +100 jne +110
+            0x39, 0x81, 0x2C, 0x01, 0x00, 0x00,                     // +102 cmp [rcx+12C], eax
+            0x74, 0x0E,                                             // +108 je +124
+            0xF3, 0x0F, 0x11, 0x81, 0x28, 0x01, 0x00, 0x00,         // +110 movss [rcx+128], xmm0
+            0x89, 0x81, 0x2C, 0x01, 0x00, 0x00,                     // +118 mov [rcx+12C], eax
+            0xC3                                                    // +124 ret
+        }
+    };
+    static_assert(sizeof(CodePage) == 4096);
+
+    // Immediates
+    constexpr size_t RACER_SITE_WORLD         = 5;
+    constexpr size_t RACER_SITE_SCRATCH_RBX   = 15;
+    constexpr size_t RACER_SITE_SCRATCH_R14   = 25;
+    constexpr size_t CAMERA_SITE_CAMERA       = 3;
+    constexpr size_t CAMERA_SITE_SCRATCH      = 13;
+    constexpr size_t CAMERA_UPDATE_OBJECT     = 2;
+    constexpr size_t CAMERA_UPDATE_POSITION   = 12;
+    constexpr size_t CAMERA_UPDATE_ROTATION   = 41;
+    constexpr size_t CAMERA_UPDATE_FOV        = 78;
+
+    // Where the tool patches
+    constexpr size_t RACER_SITE_HOOK          = 33;
+    constexpr size_t CAMERA_SITE_HOOK         = 21;
+    constexpr size_t CAMERA_UPDATE_POSITION_STORE = 24;
+
+    std::atomic<bool> g_target_exists = false;
+
+    template <size_t N>
+    void PatchImmediate(uint8_t (&code)[N], size_t offset, const void* pointer) noexcept
+    {
+        const uint64_t value = reinterpret_cast<uint64_t>(pointer);
+        std::memcpy(&code[offset], &value, sizeof(value));
+    }
+
+    void Execute(const uint8_t* code) noexcept
+    {
+        reinterpret_cast<void(*)()>(const_cast<uint8_t*>(code))();
+    }
+
+    [[nodiscard]] bool MakeCodePageExecutable() noexcept
+    {
+    #ifdef _WIN32
+        DWORD old_protection = 0;
+        return VirtualProtect(&g_code_page, sizeof(g_code_page), PAGE_EXECUTE_READWRITE, &old_protection) != 0;
+    #else
+        return mprotect(&g_code_page, sizeof(g_code_page), PROT_READ | PROT_WRITE | PROT_EXEC) == 0;
+    #endif
+    }
+
+    // The game's camera convention, like MemoryRW::WriteCameraState()
+    [[nodiscard]] glm::vec3 ToGameConvention(glm::vec3 v) noexcept
+    {
+        v.z *= -1.0f;
+        std::swap(v.y, v.z);
+        return v;
+    }
+}
+
+//////////////////////////////////////////////////////////
+// Target
+//////////////////////////////////////////////////////////
+    Target::Target()
+    {
+        if (g_target_exists.exchange(true))
+            throw std::runtime_error("StandIn::Target: Only one target may exist.");
+
+        if (! MakeCodePageExecutable())
+        {
+            g_target_exists.store(false);
+            throw std::runtime_error("StandIn::Target: Failed to make the code page executable.");
+        }
+
+        const std::byte* racer = m_racer.data();
+        std::memcpy(&m_world[WORLD_OFFSET_RACER_POINTER], &racer, sizeof(racer));
+
+        PatchImmediate(g_code_page.m_racer_capture_site,  RACER_SITE_WORLD,       m_world.data());
+        PatchImmediate(g_code_page.m_racer_capture_site,  RACER_SITE_SCRATCH_RBX, m_scratch.data());
+        PatchImmediate(g_code_page.m_racer_capture_site,  RACER_SITE_SCRATCH_R14, m_scratch.data());
+        PatchImmediate(g_code_page.m_camera_capture_site, CAMERA_SITE_CAMERA,     m_camera_object.data() + CAMERA_OBJECT_TO_STATE);
+        PatchImmediate(g_code_page.m_camera_capture_site, CAMERA_SITE_SCRATCH,    m_scratch.data());
+        PatchImmediate(g_code_page.m_camera_update,       CAMERA_UPDATE_OBJECT,   m_camera_object.data());
+        PatchImmediate(g_code_page.m_camera_update,       CAMERA_UPDATE_POSITION, m_camera_source_position.data());
+        PatchImmediate(g_code_page.m_camera_update,       CAMERA_UPDATE_ROTATION, m_camera_source_rotation.data());
+        PatchImmediate(g_code_page.m_camera_update,       CAMERA_UPDATE_FOV,      m_camera_source_fov.data());
+
+        // Written by code of the game the tool doesn't touch
+        const float near_plane   = 0.1f;
+        const float aspect_ratio = 16.0f / 9.0f;
+        std::byte* camera_state = m_camera_object.data() + CAMERA_OBJECT_TO_STATE;
+        std::memcpy(camera_state + CameraStateAddresses::OFFSET_NEAR_PLANE,   &near_plane,   sizeof(near_plane));
+        std::memcpy(camera_state + CameraStateAddresses::OFFSET_ASPECT_RATIO, &aspect_ratio, sizeof(aspect_ratio));
+
+        Tick(0.0);
+    }
+
+    Target::~Target() noexcept
+    {
+        g_target_exists.store(false);
+    }
+
+    void Target::Tick(double dt_seconds) noexcept
+    {
+        m_time += dt_seconds;
+
+    //////////////////////////////////////////////////////////
+    // Racer: figure eight, 400 x 200 m, ~35 s per lap
+    //////////////////////////////////////////////////////////
+        constexpr float RADIUS_X = 200.0f;
+        constexpr float RADIUS_Z = 100.0f;
+        constexpr float ANGULAR_SPEED = 0.18f;
+        const float t = static_cast<float>(m_time) * ANGULAR_SPEED;
+
+        const glm::vec3 position (RADIUS_X * std::sin(t), 0.0f, RADIUS_Z * std::sin(2.0f * t));
+        const glm::vec3 velocity (RADIUS_X * ANGULAR_SPEED * std::cos(t), 0.0f, 2.0f * RADIUS_Z * ANGULAR_SPEED * std::cos(2.0f * t));
+
+        // Same basis RacerState::GetExtractedRotation() builds, forward = +Z of the rotation
+        const glm::vec3 forward = glm::normalize(velocity);
+        const glm::vec3 up      (0.0f, 1.0f, 0.0f);
+        const glm::vec3 right   = glm::normalize(glm::cross(up, forward));
+        const glm::quat rotation = glm::normalize(glm::quat_cast(glm::mat3(right, glm::cross(forward, right), forward)));
+
+        RacerState racer_state;
+        racer_state.SetPosition(position);
+        racer_state.SetRotation(rotation);
+        const glm::mat4 transform     = racer_state.GetGameConventionTransformMatrix();
+        const glm::vec3 game_velocity = ToGameConvention(velocity);
+
+        std::memcpy(&m_racer[RacerStateAddresses::OFFSET_TRANS_MATRIX4x4], &transform,     sizeof(transform));
+        std::memcpy(&m_racer[RacerStateAddresses::OFFSET_VELOCITY_VEC3],   &game_velocity, sizeof(game_velocity));
+        std::atomic_ref<uint64_t>(*reinterpret_cast<uint64_t*>(&m_racer[OFFSET_TICK_COUNTER])).store(++m_tick_count, std::memory_order::release);
+
+        Execute(g_code_page.m_racer_capture_site);
+
+    //////////////////////////////////////////////////////////
+    // Camera: chasing the racer
+    //////////////////////////////////////////////////////////
+        const glm::vec3 camera_position = position - 8.0f * forward + 3.0f * up;
+        const glm::quat camera_rotation = glm::quatLookAt(glm::normalize(position - camera_position), up);
+
+        const glm::vec3 game_position = ToGameConvention(camera_position);
+        glm::quat game_rotation = camera_rotation;
+        game_rotation.z *= -1.0f;
+        std::swap(game_rotation.y, game_rotation.z);
+
+        m_camera_source_position = { game_position.x, game_position.y, game_position.z, 0.0f };
+        m_camera_source_rotation = { game_rotation.x, game_rotation.y, game_rotation.z, game_rotation.w };
+        m_camera_source_fov      = { 1.0f, 0.0f };
+
+        Execute(g_code_page.m_camera_update);
+        Execute(g_code_page.m_camera_capture_site);
+    }
+
+    uint64_t Target::GetTickCount() const noexcept
+    {
+        return m_tick_count;
+    }
+
+    uintptr_t Target::GetRacerBaseAddress() const noexcept
+    {
+        return reinterpret_cast<uintptr_t>(m_racer.data());
+    }
+
+    uintptr_t Target::GetCameraBaseAddress() const noexcept
+    {
+        return reinterpret_cast<uintptr_t>(m_camera_object.data() + CAMERA_OBJECT_TO_STATE);
+    }
+
+    bool Target::GetCameraUpdateIsPatched() const noexcept
+    {
+        return std::atomic_ref<uint8_t>(g_code_page.m_camera_update[CAMERA_UPDATE_POSITION_STORE]).load(std::memory_order::relaxed) == 0x90;
+    }
+
+    bool Target::GetCaptureHookIsInstalled() const noexcept
+    {
+        return std::atomic_ref<uint8_t>(g_code_page.m_racer_capture_site[RACER_SITE_HOOK]).load(std::memory_order::relaxed) != 0x48
+            || std::atomic_ref<uint8_t>(g_code_page.m_camera_capture_site[CAMERA_SITE_HOOK]).load(std::memory_order::relaxed) != 0xF3;
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace AsphaltTas::StandIn
+{
+    // Emulates the parts of the game the tool touches, so the whole pipeline runs without the game (and off Windows):
+    //  - a racer struct (transform & velocity at the RacerStateAddresses offsets) and a camera struct (CameraStateAddresses)
+    //  - x86-64 code containing the exact sequences MemoryAddressFinder and MemoryRW::DestroyCameraUpdateCode() scan for.
+    //    It is executed every tick, so the capture hooks fire and NOPing the camera update stops it like in the game.
+    //
+    // Only one instance may exist, the code lives in a single page of the executable's data section.
+    class Target
+    {
+    public:
+        // Throws std::runtime_error if the code page can't be made executable
+        Target();
+        ~Target() noexcept;
+
+        // Moves the racer along a figure eight, then runs the code the game would: racer capture site, camera update
+        // (whatever the tool NOPed stays as the tool wrote it) and camera capture site
+        void Tick(double dt_seconds) noexcept;
+
+        [[nodiscard]] uint64_t  GetTickCount() const noexcept;
+        [[nodiscard]] uintptr_t GetRacerBaseAddress() const noexcept;
+        [[nodiscard]] uintptr_t GetCameraBaseAddress() const noexcept;
+
+        // True while the tool has the camera update code destroyed (MemoryRW::DestroyCameraUpdateCode())
+        [[nodiscard]] bool GetCameraUpdateIsPatched() const noexcept;
+        // True while MemoryAddressFinder has one of its capture hooks installed
+        [[nodiscard]] bool GetCaptureHookIsInstalled() const noexcept;
+
+        Target(const Target&)            = delete;
+        Target& operator=(const Target&) = delete;
+
+    private:
+        // Offsets inside the game's structs the tool never sees directly, they only have to be consistent with the code
+        static constexpr size_t WORLD_OFFSET_RACER_POINTER = 0x48;  // disp32 of the racer offset pattern
+        static constexpr size_t CAMERA_OBJECT_TO_STATE     = 0x38;  // Camera update code writes [rcx+38] = position
+
+        alignas(16) std::array<std::byte, 0x200> m_racer   {};
+        alignas(16) std::array<std::byte, 0x100> m_world   {};
+        alignas(16) std::array<std::byte, 0x200> m_camera_object {};
+        alignas(16) std::array<std::byte, 0x200> m_scratch {};
+
+        // What the game would write into the camera if nobody stopped it
+        alignas(16) std::array<float, 4> m_camera_source_position {};
+        alignas(16) std::array<float, 4> m_camera_source_rotation {};
+        alignas(16) std::array<float, 2> m_camera_source_fov      {};
+
+        double   m_time       = 0.0;
+        uint64_t m_tick_count = 0;
+    };
+}
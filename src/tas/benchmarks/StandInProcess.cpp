@@ -0,0 +1,200 @@
+#include "tas/benchmarks/StandInProcess.h"
+
+#include "standin/StandInLayout.h"
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <csignal>
+    #include <spawn.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+
+    extern char** environ;
+#endif
+
+namespace AsphaltTas
+{
+namespace
+{
+    // "<label> 0x<hex>" as printed by the stand-in, 0 if the line isn't there (yet)
+    [[nodiscard]] libmem::Address ParseAddressLine(std::string_view output, std::string_view label) noexcept
+    {
+        const size_t label_position = output.find(label);
+        if (label_position == std::string_view::npos) return 0;
+
+        const size_t line_end = output.find('\n', label_position);
+        if (line_end == std::string_view::npos) return 0;
+
+        const std::string line (output.substr(label_position + label.size(), line_end - label_position - label.size()));
+        return static_cast<libmem::Address>(std::strtoull(line.c_str(), nullptr, 16));
+    }
+}
+    std::filesystem::path StandInProcess::GetDefaultExecutablePath() noexcept
+    {
+        std::error_code error;
+    #ifdef _WIN32
+        wchar_t own_path[MAX_PATH] {};
+        const DWORD length = GetModuleFileNameW(nullptr, own_path, MAX_PATH);
+        const std::filesystem::path own_executable = (length > 0 && length < MAX_PATH) ? std::filesystem::path(own_path) : std::filesystem::path();
+    #else
+        const std::filesystem::path own_executable = std::filesystem::read_symlink("/proc/self/exe", error);
+    #endif
+        if (error || own_executable.empty())
+            return StandIn::EXE_NAME;
+
+        return own_executable.parent_path() / StandIn::EXE_NAME;
+    }
+
+    StandInProcess::StandInProcess(const std::filesystem::path& executable)
+    {
+        libmem::Pid pid = 0;
+
+    #ifdef _WIN32
+        SECURITY_ATTRIBUTES inheritable {};
+        inheritable.nLength        = sizeof(SECURITY_ATTRIBUTES);
+        inheritable.bInheritHandle = TRUE;
+
+        HANDLE output_read  = nullptr;
+        HANDLE output_write = nullptr;
+        if (! CreatePipe(&output_read, &output_write, &inheritable, 0))
+            throw std::runtime_error("Failed to create the stand-in output pipe");
+        SetHandleInformation(output_read, HANDLE_FLAG_INHERIT, 0);
+
+        STARTUPINFOW startup_info {};
+        startup_info.cb         = sizeof(STARTUPINFOW);
+        startup_info.dwFlags    = STARTF_USESTDHANDLES;
+        startup_info.hStdInput  = GetStdHandle(STD_INPUT_HANDLE);
+        startup_info.hStdOutput = output_write;
+        startup_info.hStdError  = GetStdHandle(STD_ERROR_HANDLE);
+
+        std::wstring command_line = L"\"" + executable.wstring() + L"\"";
+        PROCESS_INFORMATION process_info {};
+        const BOOL is_created = CreateProcessW(executable.c_str(), command_line.data(), nullptr, nullptr, TRUE, CREATE_NO_WINDOW, nullptr, nullptr, &startup_info, &process_info);
+        CloseHandle(output_write);
+        if (! is_created)
+        {
+            CloseHandle(output_read);
+            throw std::runtime_error("Failed to start " + executable.string());
+        }
+
+        CloseHandle(process_info.hThread);
+        m_process_handle = process_info.hProcess;
+        m_output_pipe    = output_read;
+        pid              = static_cast<libmem::Pid>(process_info.dwProcessId);
+    #else
+        int output_pipe[2] {};
+        if (pipe(output_pipe) != 0)
+            throw std::runtime_error("Failed to create the stand-in output pipe");
+
+        posix_spawn_file_actions_t file_actions;
+        posix_spawn_file_actions_init(&file_actions);
+        posix_spawn_file_actions_adddup2(&file_actions, output_pipe[1], STDOUT_FILENO);
+        posix_spawn_file_actions_addclose(&file_actions, output_pipe[0]);
+        posix_spawn_file_actions_addclose(&file_actions, output_pipe[1]);
+
+        std::string executable_string = executable.string();
+        char* arguments[] = { executable_string.data(), nullptr };
+        pid_t child = -1;
+        const int spawn_error = posix_spawn(&child, executable_string.c_str(), &file_actions, nullptr, arguments, environ);
+        posix_spawn_file_actions_destroy(&file_actions);
+        close(output_pipe[1]);
+        if (spawn_error != 0)
+        {
+            close(output_pipe[0]);
+            throw std::runtime_error("Failed to start " + executable_string);
+        }
+
+        m_pid         = child;
+        m_output_pipe = output_pipe[0];
+        pid           = static_cast<libmem::Pid>(child);
+    #endif
+
+        //The addresses are printed right after start, the pipe closes early if the stand-in fails
+        std::string output;
+        while (m_racer_base_address == 0 || m_camera_base_address == 0)
+        {
+            char buffer[256];
+        #ifdef _WIN32
+            DWORD amount_read = 0;
+            const bool has_read = ReadFile(m_output_pipe, buffer, sizeof(buffer), &amount_read, nullptr) && amount_read > 0;
+        #else
+            const ssize_t amount_read = read(m_output_pipe, buffer, sizeof(buffer));
+            const bool has_read = amount_read > 0;
+        #endif
+            if (! has_read)
+            {
+                Terminate();
+                throw std::runtime_error(executable.string() + " exited without publishing its addresses");
+            }
+
+            output.append(buffer, static_cast<size_t>(amount_read));
+            m_racer_base_address  = ParseAddressLine(output, "Racer base:");
+            m_camera_base_address = ParseAddressLine(output, "Camera base:");
+        }
+
+        m_process = libmem::GetProcess(pid);
+        if (! m_process)
+        {
+            Terminate();
+            throw std::runtime_error("Failed to open the stand-in process " + std::to_string(pid));
+        }
+    }
+
+    StandInProcess::~StandInProcess() noexcept
+    {
+        Terminate();
+    }
+
+    const libmem::Process& StandInProcess::GetProcess() const noexcept
+    {
+        return m_process.value();
+    }
+
+    libmem::Address StandInProcess::GetRacerBaseAddress() const noexcept
+    {
+        return m_racer_base_address;
+    }
+
+    libmem::Address StandInProcess::GetCameraBaseAddress() const noexcept
+    {
+        return m_camera_base_address;
+    }
+
+    void StandInProcess::Terminate() noexcept
+    {
+    #ifdef _WIN32
+        if (m_process_handle)
+        {
+            TerminateProcess(m_process_handle, 0);
+            WaitForSingleObject(m_process_handle, INFINITE);
+            CloseHandle(m_process_handle);
+            m_process_handle = nullptr;
+        }
+        if (m_output_pipe)
+        {
+            CloseHandle(m_output_pipe);
+            m_output_pipe = nullptr;
+        }
+    #else
+        if (m_pid > 0)
+        {
+            kill(m_pid, SIGTERM);
+            waitpid(m_pid, nullptr, 0);
+            m_pid = -1;
+        }
+        if (m_output_pipe >= 0)
+        {
+            close(m_output_pipe);
+            m_output_pipe = -1;
+        }
+    #endif
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "libmem/libmem.hpp"
+
+#include <filesystem>
+#include <optional>
+
+namespace AsphaltTas
+{
+    // Runs the stand-in target (see standin/StandInTarget.h) as a child process while this object lives, so the
+    // cross-process memory paths can be measured without the game. The addresses are the ones the stand-in prints on start.
+    class StandInProcess
+    {
+    public:
+        // The stand-in next to the running executable
+        [[nodiscard]] static std::filesystem::path GetDefaultExecutablePath() noexcept;
+
+        // Starts the executable & waits for its addresses. Throws std::runtime_error if it can't be started or opened
+        explicit StandInProcess(const std::filesystem::path& executable = GetDefaultExecutablePath());
+        // Terminates the stand-in
+        ~StandInProcess() noexcept;
+
+        [[nodiscard]] const libmem::Process& GetProcess() const noexcept;
+        [[nodiscard]] libmem::Address GetRacerBaseAddress() const noexcept;
+        [[nodiscard]] libmem::Address GetCameraBaseAddress() const noexcept;
+
+        StandInProcess(const StandInProcess&)            = delete;
+        StandInProcess& operator=(const StandInProcess&) = delete;
+
+    private:
+        void Terminate() noexcept;
+
+        std::optional<libmem::Process> m_process = std::nullopt; // Set once constructed
+        libmem::Address                m_racer_base_address  = 0;
+        libmem::Address                m_camera_base_address = 0;
+
+        // Kept open until the end, the stand-in keeps printing its status to it
+    #ifdef _WIN32
+        void* m_process_handle = nullptr;
+        void* m_output_pipe    = nullptr;
+    #else
+        int   m_pid            = -1;
+        int   m_output_pipe    = -1;
+    #endif
+    };
+}
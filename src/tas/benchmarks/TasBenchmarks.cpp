@@ -0,0 +1,261 @@
+#include "tas/benchmarks/TasBenchmarks.h"
+#include "tas/benchmarks/StandInProcess.h"
+
+#include "core/utility/Benchmark.h"
+
+#include "tas/common/RacerState.h"
+#include "tas/common/Replay.h"
+#include "tas/globalstate/MemoryAddressState.h"
+#include "tas/memory/MemoryTrace.h"
+#include "tas/memory/MemoryUtility.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <random>
+#include <vector>
+
+namespace AsphaltTas
+{
+namespace
+{
+    constexpr uint32_t DATASET_SEED = 0x7A5u;
+    constexpr size_t   DATASET_SIZE = 4096; // Power of two, indexed with & (DATASET_SIZE - 1)
+
+    [[nodiscard]] std::vector<RacerState> CreateRacerStates() noexcept
+    {
+        std::mt19937 rng (DATASET_SEED);
+        std::uniform_real_distribution<float> distribution (-1.0f, 1.0f);
+
+        std::vector<RacerState> states (DATASET_SIZE);
+        for (RacerState& state : states)
+        {
+            const glm::vec3 position = 1000.0f * glm::vec3(distribution(rng), distribution(rng), distribution(rng));
+            const glm::quat rotation = glm::normalize(glm::quat(distribution(rng) + 1.5f, distribution(rng), distribution(rng), distribution(rng)));
+            state.SetPosition(position);
+            state.SetRotation(rotation);
+            state.SetVelocity(80.0f * glm::vec3(distribution(rng), distribution(rng), distribution(rng)));
+        }
+        return states;
+    }
+
+    // A 60 Hz recording with slightly jittering frame times, like the recorder produces
+    [[nodiscard]] Replay CreateReplay(size_t amount_frames) noexcept
+    {
+        std::mt19937 rng (DATASET_SEED + 1);
+        std::uniform_int_distribution<long> frame_time_jitter (-500, 500);
+
+        const std::vector<RacerState> states = CreateRacerStates();
+        Replay replay;
+        CoreEngine::Units::MicroSecond time (0L);
+        for (size_t i = 0; i < amount_frames; i++)
+        {
+            replay.EmplaceBackFrame(states[i & (DATASET_SIZE - 1)], time);
+            time += CoreEngine::Units::MicroSecond(16'667L + frame_time_jitter(rng));
+        }
+        return replay;
+    }
+
+    [[nodiscard]] std::vector<CoreEngine::Units::MicroSecond> CreateSeekTimes(const Replay& replay) noexcept
+    {
+        std::mt19937 rng (DATASET_SEED + 2);
+        std::uniform_int_distribution<long> distribution (0L, replay.GetLastFrame().m_time_since_begin.Get());
+
+        std::vector<CoreEngine::Units::MicroSecond> times (DATASET_SIZE);
+        for (CoreEngine::Units::MicroSecond& time : times) time = CoreEngine::Units::MicroSecond(distribution(rng));
+        return times;
+    }
+
+    //////////////////////////////////////////////////////////
+    // RacerState
+    //////////////////////////////////////////////////////////
+    void RegisterRacerStateBenchmarks()
+    {
+        CoreEngine::Benchmark::Register("RacerState/GetExtractedPosition", [](CoreEngine::Benchmark::State& state) {
+            const std::vector<RacerState> racer_states = CreateRacerStates();
+            size_t i = 0;
+            while (state.KeepRunning())
+            {
+                CoreEngine::Benchmark::DoNotOptimize(racer_states[i].GetExtractedPosition());
+                i = (i + 1) & (DATASET_SIZE - 1);
+            }
+        });
+
+        CoreEngine::Benchmark::Register("RacerState/GetExtractedRotation", [](CoreEngine::Benchmark::State& state) {
+            const std::vector<RacerState> racer_states = CreateRacerStates();
+            size_t i = 0;
+            while (state.KeepRunning())
+            {
+                CoreEngine::Benchmark::DoNotOptimize(racer_states[i].GetExtractedRotation());
+                i = (i + 1) & (DATASET_SIZE - 1);
+            }
+        });
+
+        CoreEngine::Benchmark::Register("RacerState/SetRotation", [](CoreEngine::Benchmark::State& state) {
+            std::vector<RacerState> racer_states = CreateRacerStates();
+            std::vector<glm::quat> rotations;
+            for (const RacerState& racer_state : racer_states) rotations.push_back(racer_state.GetExtractedRotation());
+
+            size_t i = 0;
+            while (state.KeepRunning())
+            {
+                racer_states[i].SetRotation(rotations[(i + 1) & (DATASET_SIZE - 1)]);
+                CoreEngine::Benchmark::DoNotOptimize(racer_states[i]);
+                i = (i + 1) & (DATASET_SIZE - 1);
+            }
+        });
+
+        CoreEngine::Benchmark::Register("RacerState/GetGameConventionTransformMatrix", [](CoreEngine::Benchmark::State& state) {
+            const std::vector<RacerState> racer_states = CreateRacerStates();
+            size_t i = 0;
+            while (state.KeepRunning())
+            {
+                CoreEngine::Benchmark::DoNotOptimize(racer_states[i].GetGameConventionTransformMatrix());
+                i = (i + 1) & (DATASET_SIZE - 1);
+            }
+        });
+    }
+
+    //////////////////////////////////////////////////////////
+    // Replay
+    //////////////////////////////////////////////////////////
+    void RegisterReplayBenchmarks()
+    {
+        // Argument = amount of frames; 216'000 frames = one hour
+        CoreEngine::Benchmark::Register("Replay/IncrementToFirstFrameAfterGivenTime", [](CoreEngine::Benchmark::State& state) {
+            Replay replay = CreateReplay(static_cast<size_t>(state.GetArgument()));
+            const std::vector<CoreEngine::Units::MicroSecond> seek_times = CreateSeekTimes(replay);
+
+            size_t i = 0;
+            while (state.KeepRunning())
+            {
+                replay.ResetFrameIndex();
+                replay.IncrementToFirstFrameAfterGivenTime(seek_times[i]);
+                CoreEngine::Benchmark::DoNotOptimize(replay.GetCurrentFrame());
+                i = (i + 1) & (DATASET_SIZE - 1);
+            }
+        }, {3'600, 216'000});
+
+        CoreEngine::Benchmark::Register("Replay/SampleRacerStateAtTime", [](CoreEngine::Benchmark::State& state) {
+            const Replay replay = CreateReplay(static_cast<size_t>(state.GetArgument()));
+            const std::vector<CoreEngine::Units::MicroSecond> seek_times = CreateSeekTimes(replay);
+
+            size_t i = 0;
+            while (state.KeepRunning())
+            {
+                CoreEngine::Benchmark::DoNotOptimize(replay.SampleRacerStateAtTime(seek_times[i]));
+                i = (i + 1) & (DATASET_SIZE - 1);
+            }
+        }, {3'600, 216'000});
+    }
+
+    //////////////////////////////////////////////////////////
+    // Memory reading
+    //////////////////////////////////////////////////////////
+    struct StandInLaunch
+    {
+        std::unique_ptr<StandInProcess> m_process;
+        std::string                     m_error;
+    };
+
+    // The stand-in target plays the game for the cross-process reads. Started by the first benchmark that needs it and
+    // terminated when the benchmarks exit
+    [[nodiscard]] const StandInLaunch& GetStandIn() noexcept
+    {
+        static const StandInLaunch s_stand_in = []() -> StandInLaunch
+        {
+            try
+            {
+                return StandInLaunch{ std::make_unique<StandInProcess>(), "" };
+            }
+            catch (const std::exception& e)
+            {
+                return StandInLaunch{ nullptr, e.what() };
+            }
+        }();
+        return s_stand_in;
+    }
+
+    void RegisterMemoryBenchmarks()
+    {
+        // Reads the stand-in's live racer block, the same cross-process libmem path the services use on the game
+        CoreEngine::Benchmark::Register("MemoryUtility/ReadMemoryOrThrow/RacerBlock", [](CoreEngine::Benchmark::State& state) {
+            const StandInLaunch& stand_in = GetStandIn();
+            if (! stand_in.m_process)
+            {
+                state.SkipWithError("Failed to start the stand-in target: " + stand_in.m_error);
+                return;
+            }
+
+            constexpr size_t RACER_BLOCK_SIZE = RacerStateAddresses::GetByteSizeBaseToLastElementInclusive();
+            std::array<std::byte, RACER_BLOCK_SIZE> destination {};
+            const libmem::Process& process = stand_in.m_process->GetProcess();
+            const libmem::Address  address = stand_in.m_process->GetRacerBaseAddress();
+
+            while (state.KeepRunning())
+            {
+                MemoryUtility::ReadMemoryOrThrow(&process, address, destination.data(), destination.size());
+                CoreEngine::Benchmark::DoNotOptimize(destination);
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.GetIterations()));
+        });
+
+        // Argument = time dilation, 0 = unpaced & 1 = real time. The log holds DATASET_SIZE reads of the stand-in's racer
+        // block, recorded through the same MemoryUtility path the services use.
+        CoreEngine::Benchmark::Register("MemoryTrace/ReplayRead/RacerBlock", [](CoreEngine::Benchmark::State& state) {
+            const StandInLaunch& stand_in = GetStandIn();
+            if (! stand_in.m_process)
+            {
+                state.SkipWithError("Failed to start the stand-in target: " + stand_in.m_error);
+                return;
+            }
+
+            constexpr size_t RACER_BLOCK_SIZE = RacerStateAddresses::GetByteSizeBaseToLastElementInclusive();
+            std::array<std::byte, RACER_BLOCK_SIZE> destination {};
+            const libmem::Process& process = stand_in.m_process->GetProcess();
+            const libmem::Address  address = stand_in.m_process->GetRacerBaseAddress();
+
+            const std::string file_path = (std::filesystem::temp_directory_path() / "AsphaltTas_Benchmark.memtrace").string();
+            if (! MemoryTrace::StartRecording(file_path))
+            {
+                state.SkipWithError("Failed to record a memory trace to " + file_path);
+                return;
+            }
+            for (size_t i = 0; i < DATASET_SIZE; i++)
+            {
+                MemoryUtility::ReadMemoryOrThrow(&process, address, destination.data(), destination.size());
+            }
+
+            MemoryTrace::ReplayConfig config {};
+            config.m_time_dilation = static_cast<double>(state.GetArgument());
+            if (! MemoryTrace::StartReplay(file_path, config))
+            {
+                MemoryTrace::Stop();
+                state.SkipWithError("Failed to replay the memory trace " + file_path);
+                return;
+            }
+
+            while (state.KeepRunning())
+            {
+                CoreEngine::Benchmark::DoNotOptimize(MemoryUtility::TryReadMemoryOrNothing(&process, address, destination.data(), destination.size()));
+                CoreEngine::Benchmark::DoNotOptimize(destination);
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.GetIterations()));
+
+            MemoryTrace::Stop();
+            std::error_code error;
+            std::filesystem::remove(file_path, error);
+        }, {0, 1});
+    }
+}
+    void RegisterTasBenchmarks()
+    {
+        RegisterRacerStateBenchmarks();
+        RegisterReplayBenchmarks();
+        RegisterMemoryBenchmarks();
+    }
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace AsphaltTas
+{
+    // Registers the tool side hot paths with CoreEngine::Benchmark::Register(), fixed seed datasets like the engine ones
+    void RegisterTasBenchmarks();
+}
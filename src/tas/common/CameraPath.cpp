@@ -0,0 +1,357 @@
+#include "tas/common/CameraPath.h"
+
+#include "core/utility/Assert.h"
+#include "core/utility/MathUtility.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace AsphaltTas
+{
+namespace
+{
+    using CoreEngine::MathUtility::QuatLog;
+    using CoreEngine::MathUtility::QuatExp;
+
+    [[nodiscard]] glm::quat SquadIntermediate(const glm::quat& prev, const glm::quat& curr, const glm::quat& next) noexcept
+    {
+        const glm::quat inv = glm::inverse(curr);
+        const glm::quat sum = QuatLog(inv * next) + QuatLog(inv * prev);
+        return curr * QuatExp(sum * -0.25f);
+    }
+
+    [[nodiscard]] glm::quat Squad(const glm::quat& q1, const glm::quat& q2, const glm::quat& s1, const glm::quat& s2, float t) noexcept
+    {
+        return glm::mix(glm::mix(q1, q2, t), glm::mix(s1, s2, t), 2.0f * t * (1.0f - t));
+    }
+}
+
+//////////////////////////////////////////////////////////
+// Keyframe management
+//////////////////////////////////////////////////////////
+    void CameraPath::AddKeyframe(const Keyframe& keyframe) noexcept
+    {
+        const auto it = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), keyframe.m_time,
+            [](CoreEngine::Units::Second time, const Keyframe& k) { return time < k.m_time; });
+        m_keyframes.insert(it, keyframe);
+        Rebuild();
+    }
+
+    void CameraPath::RemoveKeyframe(size_t index) noexcept
+    {
+        ENGINE_ASSERT(index < m_keyframes.size() && "At CameraPath::RemoveKeyframe(): Index out of range.");
+        m_keyframes.erase(m_keyframes.begin() + index);
+        Rebuild();
+    }
+
+    void CameraPath::SetKeyframeTime(size_t index, CoreEngine::Units::Second time) noexcept
+    {
+        ENGINE_ASSERT(index < m_keyframes.size() && "At CameraPath::SetKeyframeTime(): Index out of range.");
+        Keyframe keyframe = m_keyframes[index];
+        keyframe.m_time = time;
+        m_keyframes.erase(m_keyframes.begin() + index);
+        AddKeyframe(keyframe);
+    }
+
+    void CameraPath::ClearKeyframes() noexcept
+    {
+        m_keyframes.clear();
+        Rebuild();
+    }
+
+    const std::vector<CameraPath::Keyframe>& CameraPath::GetKeyframesConstRef() const noexcept
+    {
+        return m_keyframes;
+    }
+
+    size_t CameraPath::GetAmountKeyframes() const noexcept
+    {
+        return m_keyframes.size();
+    }
+
+    bool CameraPath::IsPlayable() const noexcept
+    {
+        return m_keyframes.size() >= 2;
+    }
+
+//////////////////////////////////////////////////////////
+// Settings
+//////////////////////////////////////////////////////////
+    void CameraPath::SetSplineType(SplineType type) noexcept
+    {
+        m_spline_type = type;
+        Rebuild();
+    }
+
+    CameraPath::SplineType CameraPath::GetSplineType() const noexcept
+    {
+        return m_spline_type;
+    }
+
+    void CameraPath::SetKochanekBartelsParams(KochanekBartelsParams params) noexcept
+    {
+        m_kb_params = params;
+        Rebuild();
+    }
+
+    CameraPath::KochanekBartelsParams CameraPath::GetKochanekBartelsParams() const noexcept
+    {
+        return m_kb_params;
+    }
+
+    void CameraPath::SetPlaybackMode(PlaybackMode mode) noexcept
+    {
+        m_playback_mode = mode;
+    }
+
+    CameraPath::PlaybackMode CameraPath::GetPlaybackMode() const noexcept
+    {
+        return m_playback_mode;
+    }
+
+    CoreEngine::Units::Second CameraPath::GetDuration() const noexcept
+    {
+        if (m_keyframes.empty()) return CoreEngine::Units::Second(0);
+        return m_keyframes.back().m_time - m_keyframes.front().m_time;
+    }
+
+    float CameraPath::GetArcLength() const noexcept
+    {
+        if (m_arc_length_lut.empty()) return 0.0f;
+        return m_arc_length_lut.back().m_arc_length;
+    }
+
+//////////////////////////////////////////////////////////
+// Evaluation
+//////////////////////////////////////////////////////////
+    CameraState CameraPath::Evaluate(CoreEngine::Units::Second time_since_begin) const noexcept
+    {
+        CameraState out;
+        if (m_keyframes.empty()) return out;
+
+        if (m_keyframes.size() == 1)
+        {
+            out.m_position    = m_keyframes.front().m_position;
+            out.m_rotation    = m_keyframes.front().m_rotation;
+            out.m_fov_radians = m_keyframes.front().m_fov_radians;
+            return out;
+        }
+
+        const double duration = GetDuration().Get();
+        const float  progress = duration > 0.0 ? static_cast<float>(std::clamp(time_since_begin.Get() / duration, 0.0, 1.0)) : 1.0f;
+
+        GlobalParameter parameter = 0.0f;
+        switch (m_playback_mode)
+        {
+            case PlaybackMode::KEYFRAME_TIMING:
+                parameter = FindParameterByTime(time_since_begin);
+                break;
+            case PlaybackMode::CONSTANT_SPEED:
+                parameter = FindParameterByArcLength(GetArcLength() * progress);
+                break;
+            case PlaybackMode::EASE_IN_OUT:
+                parameter = FindParameterByArcLength(GetArcLength() * glm::smoothstep(0.0f, 1.0f, progress));
+                break;
+        }
+
+        const size_t last_segment = m_keyframes.size() - 2;
+        const size_t segment      = std::min(static_cast<size_t>(parameter), last_segment);
+        const float  t            = std::clamp(parameter - static_cast<float>(segment), 0.0f, 1.0f);
+
+        const Keyframe& k1 = m_keyframes[segment];
+        const Keyframe& k2 = m_keyframes[segment + 1];
+
+        out.m_position = EvaluatePosition(segment, t);
+        out.m_rotation = glm::normalize(Squad(k1.m_rotation, k2.m_rotation, m_squad_intermediates[segment], m_squad_intermediates[segment + 1], t));
+
+        //Uniform Catmull-Rom for the fov, keeps zooms smooth across keyframes
+        const float f0 = m_keyframes[segment == 0 ? 0 : segment - 1].m_fov_radians;
+        const float f3 = m_keyframes[std::min(segment + 2, m_keyframes.size() - 1)].m_fov_radians;
+        const float f1 = k1.m_fov_radians;
+        const float f2 = k2.m_fov_radians;
+        out.m_fov_radians = 0.5f * ((2.0f * f1) + (-f0 + f2) * t + (2.0f * f0 - 5.0f * f1 + 4.0f * f2 - f3) * t * t + (-f0 + 3.0f * f1 - 3.0f * f2 + f3) * t * t * t);
+
+        return out;
+    }
+
+    std::vector<glm::vec3> CameraPath::CalculateDebugLines(size_t samples_per_segment) const noexcept
+    {
+        std::vector<glm::vec3> lines;
+        if (! IsPlayable() || samples_per_segment == 0) return lines;
+
+        const size_t amount_segments = m_keyframes.size() - 1;
+        lines.reserve(amount_segments * samples_per_segment * 2);
+
+        glm::vec3 previous = m_keyframes.front().m_position;
+        for (size_t segment = 0; segment < amount_segments; segment++)
+        {
+            for (size_t i = 1; i <= samples_per_segment; i++)
+            {
+                const glm::vec3 current = EvaluatePosition(segment, static_cast<float>(i) / static_cast<float>(samples_per_segment));
+                lines.push_back(previous);
+                lines.push_back(current);
+                previous = current;
+            }
+        }
+        return lines;
+    }
+
+//////////////////////////////////////////////////////////
+// Internal
+//////////////////////////////////////////////////////////
+    void CameraPath::Rebuild() noexcept
+    {
+        m_squad_intermediates.clear();
+        m_arc_length_lut.clear();
+
+        if (m_keyframes.empty()) return;
+
+        //Keep neighbouring rotations in the same hemisphere, otherwise squad takes the long way around
+        for (size_t i = 1; i < m_keyframes.size(); i++)
+        {
+            if (glm::dot(m_keyframes[i - 1].m_rotation, m_keyframes[i].m_rotation) < 0.0f)
+                m_keyframes[i].m_rotation = -m_keyframes[i].m_rotation;
+        }
+
+        m_squad_intermediates.reserve(m_keyframes.size());
+        for (size_t i = 0; i < m_keyframes.size(); i++)
+        {
+            const glm::quat& prev = m_keyframes[i == 0 ? 0 : i - 1].m_rotation;
+            const glm::quat& curr = m_keyframes[i].m_rotation;
+            const glm::quat& next = m_keyframes[std::min(i + 1, m_keyframes.size() - 1)].m_rotation;
+            m_squad_intermediates.push_back(glm::normalize(SquadIntermediate(prev, curr, next)));
+        }
+
+        if (! IsPlayable()) return;
+
+        const size_t amount_segments = m_keyframes.size() - 1;
+        m_arc_length_lut.reserve(amount_segments * ARC_LENGTH_SAMPLES_PER_SEGMENT + 1);
+        m_arc_length_lut.push_back({0.0f, 0.0f});
+
+        float     arc_length = 0.0f;
+        glm::vec3 previous   = m_keyframes.front().m_position;
+        for (size_t segment = 0; segment < amount_segments; segment++)
+        {
+            for (size_t i = 1; i <= ARC_LENGTH_SAMPLES_PER_SEGMENT; i++)
+            {
+                const float t = static_cast<float>(i) / static_cast<float>(ARC_LENGTH_SAMPLES_PER_SEGMENT);
+                const glm::vec3 current = EvaluatePosition(segment, t);
+                arc_length += glm::length(current - previous);
+                previous    = current;
+                m_arc_length_lut.push_back({arc_length, static_cast<float>(segment) + t});
+            }
+        }
+    }
+
+    CameraPath::GlobalParameter CameraPath::FindParameterByTime(CoreEngine::Units::Second time_since_begin) const noexcept
+    {
+        const CoreEngine::Units::Second time = m_keyframes.front().m_time + time_since_begin;
+
+        const auto it = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), time,
+            [](CoreEngine::Units::Second t, const Keyframe& k) { return t < k.m_time; });
+
+        if (it == m_keyframes.begin()) return 0.0f;
+        if (it == m_keyframes.end())   return static_cast<float>(m_keyframes.size() - 1);
+
+        const size_t segment = static_cast<size_t>(std::distance(m_keyframes.begin(), it)) - 1;
+        const double span    = (m_keyframes[segment + 1].m_time - m_keyframes[segment].m_time).Get();
+        const double t       = span > 0.0 ? (time - m_keyframes[segment].m_time).Get() / span : 1.0;
+
+        return static_cast<float>(segment) + static_cast<float>(t);
+    }
+
+    CameraPath::GlobalParameter CameraPath::FindParameterByArcLength(float arc_length) const noexcept
+    {
+        if (m_arc_length_lut.empty()) return 0.0f;
+
+        const auto it = std::lower_bound(m_arc_length_lut.begin(), m_arc_length_lut.end(), arc_length,
+            [](const ArcLengthSample& sample, float length) { return sample.m_arc_length < length; });
+
+        if (it == m_arc_length_lut.begin()) return it->m_parameter;
+        if (it == m_arc_length_lut.end())   return m_arc_length_lut.back().m_parameter;
+
+        const ArcLengthSample& lower = *(it - 1);
+        const ArcLengthSample& upper = *it;
+        const float span = upper.m_arc_length - lower.m_arc_length;
+        const float t    = span > 0.0f ? (arc_length - lower.m_arc_length) / span : 0.0f;
+
+        return glm::mix(lower.m_parameter, upper.m_parameter, t);
+    }
+
+    glm::vec3 CameraPath::EvaluatePosition(size_t segment, float t) const noexcept
+    {
+        if (m_spline_type == SplineType::KOCHANEK_BARTELS)
+            return EvaluateKochanekBartels(segment, t);
+        return EvaluateCentripetalCatmullRom(segment, t);
+    }
+
+    glm::vec3 CameraPath::EvaluateCentripetalCatmullRom(size_t segment, float t) const noexcept
+    {
+        const std::ptrdiff_t i = static_cast<std::ptrdiff_t>(segment);
+        const glm::vec3 p0 = GetControlPoint(i - 1);
+        const glm::vec3 p1 = GetControlPoint(i);
+        const glm::vec3 p2 = GetControlPoint(i + 1);
+        const glm::vec3 p3 = GetControlPoint(i + 2);
+
+        //Knot spacing of |d|^0.5, epsilon guards against coincident keyframes
+        auto Knot = [](const glm::vec3& a, const glm::vec3& b) -> float { return std::max(std::sqrt(glm::length(b - a)), 1e-4f); };
+
+        const float t0 = 0.0f;
+        const float t1 = t0 + Knot(p0, p1);
+        const float t2 = t1 + Knot(p1, p2);
+        const float t3 = t2 + Knot(p2, p3);
+
+        const float u = glm::mix(t1, t2, t);
+
+        //Barry-Goldman pyramidal formulation
+        const glm::vec3 a1 = ((t1 - u) / (t1 - t0)) * p0 + ((u - t0) / (t1 - t0)) * p1;
+        const glm::vec3 a2 = ((t2 - u) / (t2 - t1)) * p1 + ((u - t1) / (t2 - t1)) * p2;
+        const glm::vec3 a3 = ((t3 - u) / (t3 - t2)) * p2 + ((u - t2) / (t3 - t2)) * p3;
+
+        const glm::vec3 b1 = ((t2 - u) / (t2 - t0)) * a1 + ((u - t0) / (t2 - t0)) * a2;
+        const glm::vec3 b2 = ((t3 - u) / (t3 - t1)) * a2 + ((u - t1) / (t3 - t1)) * a3;
+
+        return ((t2 - u) / (t2 - t1)) * b1 + ((u - t1) / (t2 - t1)) * b2;
+    }
+
+    glm::vec3 CameraPath::EvaluateKochanekBartels(size_t segment, float t) const noexcept
+    {
+        const std::ptrdiff_t i = static_cast<std::ptrdiff_t>(segment);
+        const glm::vec3 p0 = GetControlPoint(i - 1);
+        const glm::vec3 p1 = GetControlPoint(i);
+        const glm::vec3 p2 = GetControlPoint(i + 1);
+        const glm::vec3 p3 = GetControlPoint(i + 2);
+
+        const float tension    = m_kb_params.m_tension;
+        const float bias       = m_kb_params.m_bias;
+        const float continuity = m_kb_params.m_continuity;
+
+        const glm::vec3 outgoing = ((1.0f - tension) * (1.0f + bias) * (1.0f + continuity) * 0.5f) * (p1 - p0)
+                                 + ((1.0f - tension) * (1.0f - bias) * (1.0f - continuity) * 0.5f) * (p2 - p1);
+
+        const glm::vec3 incoming = ((1.0f - tension) * (1.0f + bias) * (1.0f - continuity) * 0.5f) * (p2 - p1)
+                                 + ((1.0f - tension) * (1.0f - bias) * (1.0f + continuity) * 0.5f) * (p3 - p2);
+
+        const float t2 = t * t;
+        const float t3 = t2 * t;
+
+        const float h00 =  2.0f * t3 - 3.0f * t2 + 1.0f;
+        const float h10 =         t3 - 2.0f * t2 + t;
+        const float h01 = -2.0f * t3 + 3.0f * t2;
+        const float h11 =         t3 -        t2;
+
+        return h00 * p1 + h10 * outgoing + h01 * p2 + h11 * incoming;
+    }
+
+    glm::vec3 CameraPath::GetControlPoint(std::ptrdiff_t index) const noexcept
+    {
+        const std::ptrdiff_t count = static_cast<std::ptrdiff_t>(m_keyframes.size());
+
+        if (index < 0)
+            return 2.0f * m_keyframes[0].m_position - m_keyframes[1].m_position;
+        if (index >= count)
+            return 2.0f * m_keyframes[count - 1].m_position - m_keyframes[count - 2].m_position;
+
+        return m_keyframes[static_cast<size_t>(index)].m_position;
+    }
+}
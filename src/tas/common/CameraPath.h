@@ -0,0 +1,107 @@
+#pragma once
+
+#include "tas/common/CameraState.h"
+
+#include "core/utility/Units.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include <vector>
+
+namespace AsphaltTas
+{
+    // Camera flight path through user placed keyframes.
+    // Positions follow a centripetal Catmull-Rom or Kochanek-Bartels spline, rotations are squad interpolated.
+    // An arc length lookup table allows constant speed / eased playback independent of the keyframe spacing.
+    class CameraPath
+    {
+    public:
+        struct Keyframe
+        {
+            glm::vec3 m_position {0};
+            glm::quat m_rotation = glm::identity<glm::quat>();
+            float     m_fov_radians = 1.0f;
+            CoreEngine::Units::Second m_time {0};
+        };
+
+        enum class SplineType
+        {
+            CENTRIPETAL_CATMULL_ROM, KOCHANEK_BARTELS
+        };
+
+        enum class PlaybackMode
+        {
+            KEYFRAME_TIMING, CONSTANT_SPEED, EASE_IN_OUT
+        };
+
+        struct KochanekBartelsParams
+        {
+            float m_tension    = 0.0f;
+            float m_bias       = 0.0f;
+            float m_continuity = 0.0f;
+        };
+
+        explicit CameraPath() noexcept = default;
+
+        // Keyframes are kept sorted by time
+        void AddKeyframe(const Keyframe& keyframe) noexcept;
+        void RemoveKeyframe(size_t index) noexcept;
+        void SetKeyframeTime(size_t index, CoreEngine::Units::Second time) noexcept;
+        void ClearKeyframes() noexcept;
+
+        [[nodiscard]] const std::vector<Keyframe>& GetKeyframesConstRef() const noexcept;
+        [[nodiscard]] size_t GetAmountKeyframes() const noexcept;
+        [[nodiscard]] bool IsPlayable() const noexcept;
+
+        void SetSplineType(SplineType type) noexcept;
+        [[nodiscard]] SplineType GetSplineType() const noexcept;
+
+        void SetKochanekBartelsParams(KochanekBartelsParams params) noexcept;
+        [[nodiscard]] KochanekBartelsParams GetKochanekBartelsParams() const noexcept;
+
+        void SetPlaybackMode(PlaybackMode mode) noexcept;
+        [[nodiscard]] PlaybackMode GetPlaybackMode() const noexcept;
+
+        [[nodiscard]] CoreEngine::Units::Second GetDuration() const noexcept;
+        [[nodiscard]] float GetArcLength() const noexcept;
+
+        // Time is relative to the first keyframe, clamps to the ends of the path. O(log k)
+        [[nodiscard]] CameraState Evaluate(CoreEngine::Units::Second time_since_begin) const noexcept;
+
+        // Line segment pairs, ready to be passed to DrawLines3D_RenderPipeline::SetLineData
+        [[nodiscard]] std::vector<glm::vec3> CalculateDebugLines(size_t samples_per_segment) const noexcept;
+
+    private:
+        // Segment index + local parameter [0, 1] packed into one value (e.g. 2.5 = halfway through the 3rd segment)
+        using GlobalParameter = float;
+
+        struct ArcLengthSample
+        {
+            float           m_arc_length;
+            GlobalParameter m_parameter;
+        };
+
+        void Rebuild() noexcept;
+
+        [[nodiscard]] GlobalParameter FindParameterByTime(CoreEngine::Units::Second time_since_begin) const noexcept;
+        [[nodiscard]] GlobalParameter FindParameterByArcLength(float arc_length) const noexcept;
+
+        [[nodiscard]] glm::vec3 EvaluatePosition(size_t segment, float t) const noexcept;
+        [[nodiscard]] glm::vec3 EvaluateCentripetalCatmullRom(size_t segment, float t) const noexcept;
+        [[nodiscard]] glm::vec3 EvaluateKochanekBartels(size_t segment, float t) const noexcept;
+
+        // Clamped access, the ends of the path are extended by reflection
+        [[nodiscard]] glm::vec3 GetControlPoint(std::ptrdiff_t index) const noexcept;
+
+        std::vector<Keyframe>        m_keyframes;
+        std::vector<glm::quat>       m_squad_intermediates;
+        std::vector<ArcLengthSample> m_arc_length_lut;
+
+        SplineType            m_spline_type   = SplineType::CENTRIPETAL_CATMULL_ROM;
+        PlaybackMode          m_playback_mode = PlaybackMode::KEYFRAME_TIMING;
+        KochanekBartelsParams m_kb_params {};
+
+        static constexpr const size_t ARC_LENGTH_SAMPLES_PER_SEGMENT = 64;
+    };
+}
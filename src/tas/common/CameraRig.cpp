@@ -0,0 +1,641 @@
+#include "tas/common/CameraRig.h"
+
+#include "core/utility/Assert.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace AsphaltTas
+{
+namespace
+{
+    constexpr glm::vec3 WORLD_UP      {0.0f, 1.0f, 0.0f};
+    constexpr glm::vec3 LOCAL_FORWARD {0.0f, 0.0f, 1.0f};
+
+    [[nodiscard]] glm::vec3 FlattenedDirection(const glm::vec3& v, const glm::vec3& fallback) noexcept
+    {
+        const glm::vec3 flat (v.x, 0.0f, v.z);
+        const float length = glm::length(flat);
+        return length > 1e-4f ? flat / length : fallback;
+    }
+
+    // Camera positions & the points they look at, filled by the rigs column wise
+    struct LookColumns
+    {
+        std::array<float, RigSampleBlock::CAPACITY> m_from_x {}, m_from_y {}, m_from_z {};
+        std::array<float, RigSampleBlock::CAPACITY> m_to_x {},   m_to_y {},   m_to_z {};
+    };
+
+    //Camera looks along its local -z. The directions are normalized column wise, quatLookAt() branches & stays per sample
+    void WriteLookAt(const LookColumns& look, float fov_radians, std::span<CameraState> out) noexcept
+    {
+        std::array<float, RigSampleBlock::CAPACITY> forward_x, forward_y, forward_z, length;
+        for (size_t i = 0; i < out.size(); i++)
+        {
+            const float dx = look.m_to_x[i] - look.m_from_x[i];
+            const float dy = look.m_to_y[i] - look.m_from_y[i];
+            const float dz = look.m_to_z[i] - look.m_from_z[i];
+            length[i] = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+            const float inverse_length = 1.0f / std::max(length[i], 1e-5f);
+            forward_x[i] = dx * inverse_length;
+            forward_y[i] = dy * inverse_length;
+            forward_z[i] = dz * inverse_length;
+        }
+
+        for (size_t i = 0; i < out.size(); i++)
+        {
+            const glm::vec3 forward (forward_x[i], forward_y[i], forward_z[i]);
+            const glm::vec3 up = std::abs(forward.y) > 0.999f ? LOCAL_FORWARD : WORLD_UP;
+
+            out[i].m_position    = glm::vec3(look.m_from_x[i], look.m_from_y[i], look.m_from_z[i]);
+            out[i].m_rotation    = length[i] < 1e-5f ? glm::identity<glm::quat>() : glm::quatLookAt(forward, up);
+            out[i].m_fov_radians = fov_radians;
+        }
+    }
+}
+//////////////////////////////////////////////////////////
+// RigSampleBlock
+//////////////////////////////////////////////////////////
+    void RigSampleBlock::Assign(std::span<const RigSample> samples) noexcept
+    {
+        ENGINE_ASSERT(samples.size() <= CAPACITY && "At RigSampleBlock::Assign(): Too many samples.");
+
+        //The transpose, scalar: every sample needs its rotation extracted from the racer matrix
+        m_size = samples.size();
+        for (size_t i = 0; i < m_size; i++)
+        {
+            const RacerState& racer_state = samples[i].m_racer_state;
+            const glm::vec3 position = racer_state.GetExtractedPosition();
+            const glm::quat rotation = racer_state.GetExtractedRotation();
+            const glm::vec3 heading  = FlattenedDirection(rotation * LOCAL_FORWARD, LOCAL_FORWARD);
+            const glm::vec3 travel   = FlattenedDirection(racer_state.GetVelocity(), heading);
+
+            m_position_x[i] = position.x;
+            m_position_y[i] = position.y;
+            m_position_z[i] = position.z;
+            m_heading_x[i]  = heading.x;
+            m_heading_z[i]  = heading.z;
+            m_travel_x[i]   = travel.x;
+            m_travel_z[i]   = travel.z;
+            m_rotation[i]   = rotation;
+            m_time[i]       = samples[i].m_time.Get();
+        }
+    }
+
+
+//////////////////////////////////////////////////////////
+// Basic_CameraRig
+//////////////////////////////////////////////////////////
+    void Basic_CameraRig::EvaluateBatch(std::span<const RigSample> samples, std::span<CameraState> out) const noexcept
+    {
+        ENGINE_ASSERT(samples.size() == out.size() && "At Basic_CameraRig::EvaluateBatch(): Sizes must match.");
+
+        RigSampleBlock block;
+        for (size_t first = 0; first < samples.size(); first += RigSampleBlock::CAPACITY)
+        {
+            const size_t amount = std::min(RigSampleBlock::CAPACITY, samples.size() - first);
+            block.Assign(samples.subspan(first, amount));
+            EvaluateBlock(block, out.subspan(first, amount));
+        }
+    }
+
+    CameraState Basic_CameraRig::Evaluate(const RigSample& sample) const noexcept
+    {
+        CameraState out;
+        EvaluateBatch(std::span<const RigSample>(&sample, 1), std::span<CameraState>(&out, 1));
+        return out;
+    }
+
+    Basic_CameraRig::Type Basic_CameraRig::GetType() const noexcept
+    {
+        return m_type;
+    }
+
+    const char* Basic_CameraRig::TypeToString(Type type) noexcept
+    {
+        switch (type)
+        {
+            case Type::CHASE:       return "Chase";
+            case Type::HOOD:        return "Hood";
+            case Type::ORBIT:       return "Orbit";
+            case Type::DOLLY_TRACK: return "Dolly Track";
+            case Type::LOOK_AT:     return "Look At";
+        }
+        return "Unknown";
+    }
+
+    float Basic_CameraRig::GetFovRadians() const noexcept
+    {
+        return m_fov_radians;
+    }
+
+    void Basic_CameraRig::SetFovRadians(float fov) noexcept
+    {
+        m_fov_radians = fov;
+    }
+
+//////////////////////////////////////////////////////////
+// Chase_CameraRig
+//////////////////////////////////////////////////////////
+    Chase_CameraRig::Chase_CameraRig() noexcept : Basic_CameraRig(Type::CHASE)
+    {
+
+    }
+
+    void Chase_CameraRig::EvaluateBlock(const RigSampleBlock& block, std::span<CameraState> out) const noexcept
+    {
+        ENGINE_ASSERT(block.m_size == out.size() && "At Chase_CameraRig::EvaluateBlock(): Sizes must match.");
+
+        const float alignment = m_params.m_velocity_alignment;
+        LookColumns look;
+        for (size_t i = 0; i < block.m_size; i++)
+        {
+            //Blend of heading & travel, back to unit length; the heading if they cancel out
+            const float mixed_x = block.m_heading_x[i] + (block.m_travel_x[i] - block.m_heading_x[i]) * alignment;
+            const float mixed_z = block.m_heading_z[i] + (block.m_travel_z[i] - block.m_heading_z[i]) * alignment;
+            const float length  = std::sqrt(mixed_x * mixed_x + mixed_z * mixed_z);
+            const bool  is_flat = length > 1e-4f;
+            const float direction_x = is_flat ? mixed_x / std::max(length, 1e-4f) : block.m_heading_x[i];
+            const float direction_z = is_flat ? mixed_z / std::max(length, 1e-4f) : block.m_heading_z[i];
+
+            look.m_from_x[i] = block.m_position_x[i] - direction_x * m_params.m_distance;
+            look.m_from_y[i] = block.m_position_y[i] + m_params.m_height;
+            look.m_from_z[i] = block.m_position_z[i] - direction_z * m_params.m_distance;
+            look.m_to_x[i]   = block.m_position_x[i];
+            look.m_to_y[i]   = block.m_position_y[i] + m_params.m_look_at_height;
+            look.m_to_z[i]   = block.m_position_z[i];
+        }
+        WriteLookAt(look, m_fov_radians, out);
+    }
+
+    std::unique_ptr<Basic_CameraRig> Chase_CameraRig::Copy() const
+    {
+        return std::make_unique<Chase_CameraRig>(*this);
+    }
+
+    bool Chase_CameraRig::IsRacerRelative() const noexcept
+    {
+        return true;
+    }
+
+    Chase_CameraRig::Params Chase_CameraRig::GetParams() const noexcept
+    {
+        return m_params;
+    }
+
+    void Chase_CameraRig::SetParams(const Params& params) noexcept
+    {
+        m_params = params;
+    }
+
+//////////////////////////////////////////////////////////
+// Hood_CameraRig
+//////////////////////////////////////////////////////////
+    Hood_CameraRig::Hood_CameraRig() noexcept : Basic_CameraRig(Type::HOOD)
+    {
+
+    }
+
+    void Hood_CameraRig::EvaluateBlock(const RigSampleBlock& block, std::span<CameraState> out) const noexcept
+    {
+        ENGINE_ASSERT(block.m_size == out.size() && "At Hood_CameraRig::EvaluateBlock(): Sizes must match.");
+
+        const glm::quat look_direction = m_params.m_look_backwards ? glm::identity<glm::quat>() : glm::angleAxis(glm::radians(180.0f), WORLD_UP);
+
+        //Branch free quaternion math per sample
+        for (size_t i = 0; i < block.m_size; i++)
+        {
+            const glm::quat& car_rot = block.m_rotation[i];
+
+            out[i].m_position    = glm::vec3(block.m_position_x[i], block.m_position_y[i], block.m_position_z[i]) + car_rot * m_params.m_offset;
+            out[i].m_rotation    = car_rot * look_direction;
+            out[i].m_fov_radians = m_fov_radians;
+        }
+    }
+
+    std::unique_ptr<Basic_CameraRig> Hood_CameraRig::Copy() const
+    {
+        return std::make_unique<Hood_CameraRig>(*this);
+    }
+
+    bool Hood_CameraRig::IsRacerRelative() const noexcept
+    {
+        return true;
+    }
+
+    Hood_CameraRig::Params Hood_CameraRig::GetParams() const noexcept
+    {
+        return m_params;
+    }
+
+    void Hood_CameraRig::SetParams(const Params& params) noexcept
+    {
+        m_params = params;
+    }
+
+//////////////////////////////////////////////////////////
+// Orbit_CameraRig
+//////////////////////////////////////////////////////////
+    Orbit_CameraRig::Orbit_CameraRig() noexcept : Basic_CameraRig(Type::ORBIT)
+    {
+
+    }
+
+    void Orbit_CameraRig::EvaluateBlock(const RigSampleBlock& block, std::span<CameraState> out) const noexcept
+    {
+        ENGINE_ASSERT(block.m_size == out.size() && "At Orbit_CameraRig::EvaluateBlock(): Sizes must match.");
+
+        constexpr double TWO_PI = 2.0 * std::numbers::pi;
+
+        //Wrapped in double, live sample times are seconds since epoch
+        std::array<float, RigSampleBlock::CAPACITY> angle;
+        for (size_t i = 0; i < block.m_size; i++)
+        {
+            angle[i] = static_cast<float>(std::fmod(m_params.m_start_angle_radians + m_params.m_angular_speed_radians * block.m_time[i], TWO_PI));
+        }
+        if (m_params.m_relative_to_heading)
+        {
+            for (size_t i = 0; i < block.m_size; i++)
+            {
+                angle[i] += std::atan2(block.m_heading_x[i], block.m_heading_z[i]);
+            }
+        }
+
+        LookColumns look;
+        for (size_t i = 0; i < block.m_size; i++)
+        {
+            look.m_from_x[i] = block.m_position_x[i] + std::sin(angle[i]) * m_params.m_distance;
+            look.m_from_y[i] = block.m_position_y[i] + m_params.m_height;
+            look.m_from_z[i] = block.m_position_z[i] + std::cos(angle[i]) * m_params.m_distance;
+            look.m_to_x[i]   = block.m_position_x[i];
+            look.m_to_y[i]   = block.m_position_y[i];
+            look.m_to_z[i]   = block.m_position_z[i];
+        }
+        WriteLookAt(look, m_fov_radians, out);
+    }
+
+    std::unique_ptr<Basic_CameraRig> Orbit_CameraRig::Copy() const
+    {
+        return std::make_unique<Orbit_CameraRig>(*this);
+    }
+
+    bool Orbit_CameraRig::IsRacerRelative() const noexcept
+    {
+        return true;
+    }
+
+    Orbit_CameraRig::Params Orbit_CameraRig::GetParams() const noexcept
+    {
+        return m_params;
+    }
+
+    void Orbit_CameraRig::SetParams(const Params& params) noexcept
+    {
+        m_params = params;
+    }
+
+//////////////////////////////////////////////////////////
+// DollyTrack_CameraRig
+//////////////////////////////////////////////////////////
+    DollyTrack_CameraRig::DollyTrack_CameraRig() noexcept : Basic_CameraRig(Type::DOLLY_TRACK)
+    {
+
+    }
+
+    void DollyTrack_CameraRig::EvaluateBlock(const RigSampleBlock& block, std::span<CameraState> out) const noexcept
+    {
+        ENGINE_ASSERT(block.m_size == out.size() && "At DollyTrack_CameraRig::EvaluateBlock(): Sizes must match.");
+
+        //The rail search loops over the segments per sample
+        LookColumns look;
+        for (size_t i = 0; i < block.m_size; i++)
+        {
+            const glm::vec3 position = ClosestPointOnRail(glm::vec3(block.m_position_x[i], block.m_position_y[i], block.m_position_z[i]));
+
+            look.m_from_x[i] = position.x;
+            look.m_from_y[i] = position.y;
+            look.m_from_z[i] = position.z;
+            look.m_to_x[i]   = block.m_position_x[i];
+            look.m_to_y[i]   = block.m_position_y[i] + m_params.m_look_at_height;
+            look.m_to_z[i]   = block.m_position_z[i];
+        }
+        WriteLookAt(look, m_fov_radians, out);
+    }
+
+    glm::vec3 DollyTrack_CameraRig::ClosestPointOnRail(const glm::vec3& point) const noexcept
+    {
+        const std::vector<glm::vec3>& rail = m_params.m_rail_points;
+        if (rail.empty())     return point;
+        if (rail.size() == 1) return rail.front();
+
+        //Closest point over all rail segments, remembered as distance along the rail to apply the lead
+        float best_distance_sq   = std::numeric_limits<float>::max();
+        float best_rail_distance = 0.0f;
+        float rail_distance      = 0.0f;
+
+        for (size_t i = 0; i + 1 < rail.size(); i++)
+        {
+            const glm::vec3 segment = rail[i + 1] - rail[i];
+            const float segment_length_sq = glm::dot(segment, segment);
+            const float t = segment_length_sq > 0.0f ? std::clamp(glm::dot(point - rail[i], segment) / segment_length_sq, 0.0f, 1.0f) : 0.0f;
+
+            const glm::vec3 closest = rail[i] + segment * t;
+            const float distance_sq = glm::dot(point - closest, point - closest);
+            const float segment_length = std::sqrt(segment_length_sq);
+
+            if (distance_sq < best_distance_sq)
+            {
+                best_distance_sq   = distance_sq;
+                best_rail_distance = rail_distance + segment_length * t;
+            }
+            rail_distance += segment_length;
+        }
+
+        float target = std::clamp(best_rail_distance + m_params.m_lead_distance, 0.0f, rail_distance);
+        for (size_t i = 0; i + 1 < rail.size(); i++)
+        {
+            const float segment_length = glm::length(rail[i + 1] - rail[i]);
+            if (target <= segment_length || i + 2 == rail.size())
+            {
+                return segment_length > 0.0f ? glm::mix(rail[i], rail[i + 1], std::min(target / segment_length, 1.0f)) : rail[i];
+            }
+            target -= segment_length;
+        }
+        return rail.back();
+    }
+
+    std::unique_ptr<Basic_CameraRig> DollyTrack_CameraRig::Copy() const
+    {
+        return std::make_unique<DollyTrack_CameraRig>(*this);
+    }
+
+    bool DollyTrack_CameraRig::IsRacerRelative() const noexcept
+    {
+        return false;
+    }
+
+    const DollyTrack_CameraRig::Params& DollyTrack_CameraRig::GetParamsConstRef() const noexcept
+    {
+        return m_params;
+    }
+
+    void DollyTrack_CameraRig::SetParams(Params params) noexcept
+    {
+        m_params = std::move(params);
+    }
+
+//////////////////////////////////////////////////////////
+// LookAt_CameraRig
+//////////////////////////////////////////////////////////
+    LookAt_CameraRig::LookAt_CameraRig() noexcept : Basic_CameraRig(Type::LOOK_AT)
+    {
+
+    }
+
+    void LookAt_CameraRig::EvaluateBlock(const RigSampleBlock& block, std::span<CameraState> out) const noexcept
+    {
+        ENGINE_ASSERT(block.m_size == out.size() && "At LookAt_CameraRig::EvaluateBlock(): Sizes must match.");
+
+        LookColumns look;
+        for (size_t i = 0; i < block.m_size; i++)
+        {
+            look.m_from_x[i] = m_params.m_position.x;
+            look.m_from_y[i] = m_params.m_position.y;
+            look.m_from_z[i] = m_params.m_position.z;
+            look.m_to_x[i]   = block.m_position_x[i];
+            look.m_to_y[i]   = block.m_position_y[i] + m_params.m_look_at_height;
+            look.m_to_z[i]   = block.m_position_z[i];
+        }
+        WriteLookAt(look, m_fov_radians, out);
+    }
+
+    std::unique_ptr<Basic_CameraRig> LookAt_CameraRig::Copy() const
+    {
+        return std::make_unique<LookAt_CameraRig>(*this);
+    }
+
+    bool LookAt_CameraRig::IsRacerRelative() const noexcept
+    {
+        return false;
+    }
+
+    LookAt_CameraRig::Params LookAt_CameraRig::GetParams() const noexcept
+    {
+        return m_params;
+    }
+
+    void LookAt_CameraRig::SetParams(const Params& params) noexcept
+    {
+        m_params = params;
+    }
+
+//////////////////////////////////////////////////////////
+// CameraRigStack
+//////////////////////////////////////////////////////////
+    CameraRigStack::CameraRigStack(const CameraRigStack& other)
+    : m_smoothing_time(other.m_smoothing_time)
+    {
+        m_entries.reserve(other.m_entries.size());
+        for (const Entry& entry : other.m_entries)
+        {
+            m_entries.push_back({entry.m_rig->Copy(), entry.m_weight});
+        }
+    }
+
+    CameraRigStack& CameraRigStack::operator=(const CameraRigStack& other)
+    {
+        if (this != &other)
+        {
+            CameraRigStack copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    void CameraRigStack::PushRig(std::unique_ptr<Basic_CameraRig> rig, float weight) noexcept
+    {
+        ENGINE_ASSERT(rig && "At CameraRigStack::PushRig(): Rig must not be null.");
+        m_entries.push_back({std::move(rig), weight});
+    }
+
+    void CameraRigStack::RemoveRig(size_t index) noexcept
+    {
+        ENGINE_ASSERT(index < m_entries.size() && "At CameraRigStack::RemoveRig(): Index out of range.");
+        m_entries.erase(m_entries.begin() + index);
+    }
+
+    std::vector<CameraRigStack::Entry>& CameraRigStack::GetEntriesRef() noexcept
+    {
+        return m_entries;
+    }
+
+    const std::vector<CameraRigStack::Entry>& CameraRigStack::GetEntriesConstRef() const noexcept
+    {
+        return m_entries;
+    }
+
+    void CameraRigStack::SetSmoothingTime(CoreEngine::Units::Second time_constant) noexcept
+    {
+        m_smoothing_time = CoreEngine::Units::Second(std::max(0.0, time_constant.Get()));
+    }
+
+    CoreEngine::Units::Second CameraRigStack::GetSmoothingTime() const noexcept
+    {
+        return m_smoothing_time;
+    }
+
+    CameraState CameraRigStack::EvaluateLive(const RacerState& racer_state, CoreEngine::Units::Second time) noexcept
+    {
+        const RigSample sample {racer_state, time};
+        CameraState blended;
+        Blend(std::span<const RigSample>(&sample, 1), std::span<CameraState>(&blended, 1));
+
+        if (! m_live_smoothed_state.has_value())
+        {
+            m_live_smoothed_state = blended;
+        }
+        else
+        {
+            const float alpha = CalculateSmoothingFactor(time - m_live_last_time);
+            m_live_smoothed_state->m_position    = glm::mix(m_live_smoothed_state->m_position, blended.m_position, alpha);
+            m_live_smoothed_state->m_rotation    = glm::slerp(m_live_smoothed_state->m_rotation, blended.m_rotation, alpha);
+            m_live_smoothed_state->m_fov_radians = glm::mix(m_live_smoothed_state->m_fov_radians, blended.m_fov_radians, alpha);
+        }
+        m_live_last_time = time;
+
+        return m_live_smoothed_state.value();
+    }
+
+    void CameraRigStack::ResetLiveSmoothing() noexcept
+    {
+        m_live_smoothed_state = std::nullopt;
+    }
+
+    bool CameraRigStack::IsRacerRelative() const noexcept
+    {
+        if (m_entries.empty()) return false;
+
+        //Same selection as Blend(): the positive weights, or the first rig if there are none
+        const bool any_positive_weight = std::any_of(m_entries.begin(), m_entries.end(), [](const Entry& entry) { return entry.m_weight > 0.0f; });
+        if (! any_positive_weight)
+            return m_entries.front().m_rig->IsRacerRelative();
+
+        return std::all_of(m_entries.begin(), m_entries.end(), [](const Entry& entry) { return entry.m_weight <= 0.0f || entry.m_rig->IsRacerRelative(); });
+    }
+
+    void CameraRigStack::EvaluateBatch(std::span<const RigSample> samples, std::span<CameraState> out) const noexcept
+    {
+        ENGINE_ASSERT(samples.size() == out.size() && "At CameraRigStack::EvaluateBatch(): Sizes must match.");
+        if (samples.empty()) return;
+
+        Blend(samples, out);
+
+        for (size_t i = 1; i < out.size(); i++)
+        {
+            const float alpha = CalculateSmoothingFactor(samples[i].m_time - samples[i - 1].m_time);
+            out[i].m_position    = glm::mix(out[i - 1].m_position, out[i].m_position, alpha);
+            out[i].m_rotation    = glm::slerp(out[i - 1].m_rotation, out[i].m_rotation, alpha);
+            out[i].m_fov_radians = glm::mix(out[i - 1].m_fov_radians, out[i].m_fov_radians, alpha);
+        }
+    }
+
+    CameraTrack CameraRigStack::BakeFromReplay(const Replay& replay, CoreEngine::Units::Second sample_interval) const noexcept
+    {
+        CameraTrack track;
+        if (replay.GetAmountFrames() == 0 || sample_interval.Get() <= 0.0) return track;
+
+        const CoreEngine::Units::Second duration = CoreEngine::Units::Convert<CoreEngine::Units::Second>(replay.GetLastFrame().m_time_since_begin);
+        const size_t amount_samples = static_cast<size_t>(duration.Get() / sample_interval.Get()) + 1;
+
+        std::vector<RigSample> samples;
+        samples.reserve(amount_samples);
+        for (size_t i = 0; i < amount_samples; i++)
+        {
+            const CoreEngine::Units::Second time = sample_interval * static_cast<double>(i);
+            std::optional<RacerState> racer_state = replay.SampleRacerStateAtTime(CoreEngine::Units::Convert<CoreEngine::Units::MicroSecond>(time));
+            //Skipped instead of a default RacerState at the world origin, the track interpolates over the gap
+            if (! racer_state.has_value()) continue;
+            samples.push_back({racer_state.value(), time});
+        }
+
+        std::vector<CameraState> states (samples.size());
+        EvaluateBatch(samples, states);
+
+        track.Reserve(samples.size());
+        for (size_t i = 0; i < samples.size(); i++)
+        {
+            track.EmplaceBackSample(samples[i].m_time, states[i]);
+        }
+        return track;
+    }
+
+    void CameraRigStack::Blend(std::span<const RigSample> samples, std::span<CameraState> out) const noexcept
+    {
+        if (m_entries.empty()) return;
+
+        float total_weight = 0.0f;
+        for (const Entry& entry : m_entries)
+        {
+            total_weight += std::max(entry.m_weight, 0.0f);
+        }
+
+        //Every block is extracted once & evaluated by all rigs
+        RigSampleBlock block;
+        std::array<CameraState, RigSampleBlock::CAPACITY> scratch;
+        for (size_t first_sample = 0; first_sample < samples.size(); first_sample += RigSampleBlock::CAPACITY)
+        {
+            const size_t amount = std::min(RigSampleBlock::CAPACITY, samples.size() - first_sample);
+            const std::span<CameraState> block_out = out.subspan(first_sample, amount);
+            block.Assign(samples.subspan(first_sample, amount));
+
+            if (total_weight <= 0.0f)
+            {
+                m_entries.front().m_rig->EvaluateBlock(block, block_out);
+                continue;
+            }
+
+            bool first = true;
+            for (const Entry& entry : m_entries)
+            {
+                if (entry.m_weight <= 0.0f) continue;
+
+                const float weight = entry.m_weight / total_weight;
+                entry.m_rig->EvaluateBlock(block, std::span<CameraState>(scratch.data(), amount));
+
+                for (size_t i = 0; i < amount; i++)
+                {
+                    if (first)
+                    {
+                        block_out[i].m_position    = scratch[i].m_position * weight;
+                        block_out[i].m_rotation    = scratch[i].m_rotation * weight;
+                        block_out[i].m_fov_radians = scratch[i].m_fov_radians * weight;
+                        continue;
+                    }
+
+                    //Accumulated quaternions have to stay in one hemisphere, q and -q are the same rotation
+                    const glm::quat rotation = glm::dot(block_out[i].m_rotation, scratch[i].m_rotation) < 0.0f ? -scratch[i].m_rotation : scratch[i].m_rotation;
+
+                    block_out[i].m_position    += scratch[i].m_position * weight;
+                    block_out[i].m_rotation    += rotation * weight;
+                    block_out[i].m_fov_radians += scratch[i].m_fov_radians * weight;
+                }
+                first = false;
+            }
+
+            for (size_t i = 0; i < amount; i++)
+            {
+                block_out[i].m_rotation = glm::normalize(block_out[i].m_rotation);
+            }
+        }
+    }
+
+    float CameraRigStack::CalculateSmoothingFactor(CoreEngine::Units::Second delta_time) const noexcept
+    {
+        if (m_smoothing_time.Get() <= 0.0) return 1.0f;
+        return static_cast<float>(1.0 - std::exp(-std::max(0.0, delta_time.Get()) / m_smoothing_time.Get()));
+    }
+}
@@ -0,0 +1,259 @@
+#pragma once
+
+#include "tas/common/RacerState.h"
+#include "tas/common/CameraState.h"
+#include "tas/common/CameraTrack.h"
+#include "tas/common/Replay.h"
+
+#include "core/utility/Units.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace AsphaltTas
+{
+    // Racer state at a point in time, either live (time since epoch) or from a replay (time since begin)
+    struct RigSample
+    {
+        RacerState m_racer_state;
+        CoreEngine::Units::Second m_time {0};
+    };
+
+    // Up to CAPACITY samples as structure of arrays, so the rigs run their per sample math as plain float loops over the
+    // columns that the compiler vectorises. Extracted from the RacerStates once & shared by every rig of a CameraRigStack.
+    // Fixed size, lives on the stack: evaluating never allocates
+    struct RigSampleBlock
+    {
+        static constexpr size_t CAPACITY = 64;
+
+        size_t m_size = 0;
+        std::array<float, CAPACITY>     m_position_x {}, m_position_y {}, m_position_z {};
+        std::array<float, CAPACITY>     m_heading_x {},  m_heading_z {};  // Car forward flattened onto the ground, unit length
+        std::array<float, CAPACITY>     m_travel_x {},   m_travel_z {};   // Velocity flattened onto the ground, unit length, the heading when standing
+        std::array<glm::quat, CAPACITY> m_rotation {};
+        std::array<double, CAPACITY>    m_time {};
+
+        // At most CAPACITY samples
+        void Assign(std::span<const RigSample> samples) noexcept;
+    };
+
+//////////////////////////////////////////////////////////
+// Rigs
+//////////////////////////////////////////////////////////
+    class Basic_CameraRig
+    {
+    public:
+        enum class Type
+        {
+            CHASE, HOOD, ORBIT, DOLLY_TRACK, LOOK_AT
+        };
+
+        virtual ~Basic_CameraRig() noexcept = default;
+
+        // In RigSampleBlocks, one virtual call per block. Only the final look rotations (quatLookAt) & the dolly rail
+        // search stay scalar per sample
+        void EvaluateBatch(std::span<const RigSample> samples, std::span<CameraState> out) const noexcept;
+        // out.size() == block.m_size
+        virtual void EvaluateBlock(const RigSampleBlock& block, std::span<CameraState> out) const noexcept = 0;
+        [[nodiscard]] virtual std::unique_ptr<Basic_CameraRig> Copy() const = 0;
+        // True if the camera position moves rigidly with the car, i.e. it may be shifted along with the predicted racer position
+        [[nodiscard]] virtual bool IsRacerRelative() const noexcept = 0;
+
+        [[nodiscard]] CameraState Evaluate(const RigSample& sample) const noexcept;
+
+        [[nodiscard]] Type GetType() const noexcept;
+        [[nodiscard]] static const char* TypeToString(Type type) noexcept;
+
+        [[nodiscard]] float GetFovRadians() const noexcept;
+        void SetFovRadians(float fov) noexcept;
+
+    protected:
+        explicit Basic_CameraRig(Type type) noexcept : m_type(type) {}
+
+        Type  m_type;
+        float m_fov_radians = glm::radians(60.0f);
+    };
+
+    // Behind the car, optionally turning into the direction of travel instead of the car heading
+    class Chase_CameraRig : public Basic_CameraRig
+    {
+    public:
+        struct Params
+        {
+            float m_distance           = 6.0f;
+            float m_height             = 2.0f;
+            float m_look_at_height     = 1.0f;
+            float m_velocity_alignment = 0.5f; // 0 = car heading, 1 = direction of travel
+        };
+
+        explicit Chase_CameraRig() noexcept;
+        explicit Chase_CameraRig(Params params) noexcept : Basic_CameraRig(Type::CHASE), m_params(params) {}
+
+        virtual void EvaluateBlock(const RigSampleBlock& block, std::span<CameraState> out) const noexcept override;
+        [[nodiscard]] virtual std::unique_ptr<Basic_CameraRig> Copy() const override;
+        [[nodiscard]] virtual bool IsRacerRelative() const noexcept override;
+
+        [[nodiscard]] Params GetParams() const noexcept;
+        void SetParams(const Params& params) noexcept;
+
+    private:
+        Params m_params;
+    };
+
+    // Fixed in car space, looking along the car heading
+    class Hood_CameraRig : public Basic_CameraRig
+    {
+    public:
+        struct Params
+        {
+            glm::vec3 m_offset         {0.0f, 1.0f, 1.5f};
+            bool      m_look_backwards = false;
+        };
+
+        explicit Hood_CameraRig() noexcept;
+        explicit Hood_CameraRig(Params params) noexcept : Basic_CameraRig(Type::HOOD), m_params(params) {}
+
+        virtual void EvaluateBlock(const RigSampleBlock& block, std::span<CameraState> out) const noexcept override;
+        [[nodiscard]] virtual std::unique_ptr<Basic_CameraRig> Copy() const override;
+        [[nodiscard]] virtual bool IsRacerRelative() const noexcept override;
+
+        [[nodiscard]] Params GetParams() const noexcept;
+        void SetParams(const Params& params) noexcept;
+
+    private:
+        Params m_params;
+    };
+
+    // Circles the car over time
+    class Orbit_CameraRig : public Basic_CameraRig
+    {
+    public:
+        struct Params
+        {
+            float m_distance              = 8.0f;
+            float m_height                = 2.0f;
+            float m_start_angle_radians   = 0.0f;
+            float m_angular_speed_radians = 0.5f; // per second
+            bool  m_relative_to_heading   = true;
+        };
+
+        explicit Orbit_CameraRig() noexcept;
+        explicit Orbit_CameraRig(Params params) noexcept : Basic_CameraRig(Type::ORBIT), m_params(params) {}
+
+        virtual void EvaluateBlock(const RigSampleBlock& block, std::span<CameraState> out) const noexcept override;
+        [[nodiscard]] virtual std::unique_ptr<Basic_CameraRig> Copy() const override;
+        [[nodiscard]] virtual bool IsRacerRelative() const noexcept override;
+
+        [[nodiscard]] Params GetParams() const noexcept;
+        void SetParams(const Params& params) noexcept;
+
+    private:
+        Params m_params;
+    };
+
+    // Slides along a world space rail to the point closest to the car while looking at it
+    class DollyTrack_CameraRig : public Basic_CameraRig
+    {
+    public:
+        struct Params
+        {
+            std::vector<glm::vec3> m_rail_points;
+            float m_lead_distance  = 0.0f; // Along the rail, positive = ahead of the car
+            float m_look_at_height = 0.5f;
+        };
+
+        explicit DollyTrack_CameraRig() noexcept;
+        explicit DollyTrack_CameraRig(Params params) noexcept : Basic_CameraRig(Type::DOLLY_TRACK), m_params(std::move(params)) {}
+
+        virtual void EvaluateBlock(const RigSampleBlock& block, std::span<CameraState> out) const noexcept override;
+        [[nodiscard]] virtual std::unique_ptr<Basic_CameraRig> Copy() const override;
+        [[nodiscard]] virtual bool IsRacerRelative() const noexcept override;
+
+        [[nodiscard]] const Params& GetParamsConstRef() const noexcept;
+        void SetParams(Params params) noexcept;
+
+    private:
+        [[nodiscard]] glm::vec3 ClosestPointOnRail(const glm::vec3& point) const noexcept;
+
+        Params m_params;
+    };
+
+    // Fixed world position looking at the car
+    class LookAt_CameraRig : public Basic_CameraRig
+    {
+    public:
+        struct Params
+        {
+            glm::vec3 m_position       {0.0f};
+            float     m_look_at_height = 0.5f;
+        };
+
+        explicit LookAt_CameraRig() noexcept;
+        explicit LookAt_CameraRig(Params params) noexcept : Basic_CameraRig(Type::LOOK_AT), m_params(params) {}
+
+        virtual void EvaluateBlock(const RigSampleBlock& block, std::span<CameraState> out) const noexcept override;
+        [[nodiscard]] virtual std::unique_ptr<Basic_CameraRig> Copy() const override;
+        [[nodiscard]] virtual bool IsRacerRelative() const noexcept override;
+
+        [[nodiscard]] Params GetParams() const noexcept;
+        void SetParams(const Params& params) noexcept;
+
+    private:
+        Params m_params;
+    };
+
+//////////////////////////////////////////////////////////
+// Composition
+//////////////////////////////////////////////////////////
+    // Weighted blend of rigs followed by an exponential smoothing filter
+    class CameraRigStack
+    {
+    public:
+        struct Entry
+        {
+            std::unique_ptr<Basic_CameraRig> m_rig;
+            float m_weight = 1.0f;
+        };
+
+        explicit CameraRigStack() noexcept = default;
+        CameraRigStack(const CameraRigStack& other);
+        CameraRigStack& operator=(const CameraRigStack& other);
+        CameraRigStack(CameraRigStack&&) noexcept            = default;
+        CameraRigStack& operator=(CameraRigStack&&) noexcept = default;
+
+        void PushRig(std::unique_ptr<Basic_CameraRig> rig, float weight = 1.0f) noexcept;
+        void RemoveRig(size_t index) noexcept;
+        [[nodiscard]] std::vector<Entry>& GetEntriesRef() noexcept;
+        [[nodiscard]] const std::vector<Entry>& GetEntriesConstRef() const noexcept;
+
+        void SetSmoothingTime(CoreEngine::Units::Second time_constant) noexcept;
+        [[nodiscard]] CoreEngine::Units::Second GetSmoothingTime() const noexcept;
+
+        // Keeps the filter state between calls; time is expected to increase
+        [[nodiscard]] CameraState EvaluateLive(const RacerState& racer_state, CoreEngine::Units::Second time) noexcept;
+        void ResetLiveSmoothing() noexcept;
+        // True if every rig contributing to the blend is racer relative, false as soon as a world fixed one is mixed in
+        [[nodiscard]] bool IsRacerRelative() const noexcept;
+
+        // Evaluates all samples block by block, each block is extracted once for all rigs. The filter starts fresh at the first sample
+        void EvaluateBatch(std::span<const RigSample> samples, std::span<CameraState> out) const noexcept;
+
+        [[nodiscard]] CameraTrack BakeFromReplay(const Replay& replay, CoreEngine::Units::Second sample_interval) const noexcept;
+
+    private:
+        void Blend(std::span<const RigSample> samples, std::span<CameraState> out) const noexcept;
+        [[nodiscard]] float CalculateSmoothingFactor(CoreEngine::Units::Second delta_time) const noexcept;
+
+        std::vector<Entry> m_entries;
+        CoreEngine::Units::Second m_smoothing_time {0.0};
+
+        std::optional<CameraState> m_live_smoothed_state = std::nullopt;
+        CoreEngine::Units::Second  m_live_last_time {0.0};
+    };
+}
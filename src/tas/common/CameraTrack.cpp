@@ -0,0 +1,62 @@
+#include "tas/common/CameraTrack.h"
+
+#include <algorithm>
+
+namespace AsphaltTas
+{
+    void CameraTrack::Reserve(size_t amount_samples) noexcept
+    {
+        m_samples.reserve(amount_samples);
+    }
+
+    void CameraTrack::ClearAllSamples() noexcept
+    {
+        m_samples.clear();
+    }
+
+    CameraState CameraTrack::Evaluate(CoreEngine::Units::Second time_since_begin) const noexcept
+    {
+        if (m_samples.empty()) return CameraState{};
+
+        const CoreEngine::Units::Second time = m_samples.front().m_time + time_since_begin;
+
+        const auto it = std::upper_bound(m_samples.begin(), m_samples.end(), time,
+            [](CoreEngine::Units::Second t, const Sample& sample) { return t < sample.m_time; });
+
+        if (it == m_samples.begin()) return m_samples.front().m_state;
+        if (it == m_samples.end())   return m_samples.back().m_state;
+
+        const Sample& lower = *(it - 1);
+        const Sample& upper = *it;
+
+        const double span = (upper.m_time - lower.m_time).Get();
+        const float  t    = span > 0.0 ? static_cast<float>((time - lower.m_time).Get() / span) : 0.0f;
+
+        CameraState out = lower.m_state;
+        out.m_position    = glm::mix(lower.m_state.m_position, upper.m_state.m_position, t);
+        out.m_rotation    = glm::slerp(lower.m_state.m_rotation, upper.m_state.m_rotation, t);
+        out.m_fov_radians = glm::mix(lower.m_state.m_fov_radians, upper.m_state.m_fov_radians, t);
+        return out;
+    }
+
+    CoreEngine::Units::Second CameraTrack::GetDuration() const noexcept
+    {
+        if (m_samples.empty()) return CoreEngine::Units::Second(0);
+        return m_samples.back().m_time - m_samples.front().m_time;
+    }
+
+    size_t CameraTrack::GetAmountSamples() const noexcept
+    {
+        return m_samples.size();
+    }
+
+    bool CameraTrack::IsEmpty() const noexcept
+    {
+        return m_samples.empty();
+    }
+
+    const std::vector<CameraTrack::Sample>& CameraTrack::GetSamplesConstRef() const noexcept
+    {
+        return m_samples;
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "tas/common/CameraState.h"
+
+#include "core/utility/Units.h"
+
+#include <vector>
+
+namespace AsphaltTas
+{
+    // Pre-baked camera states over time, played back exactly the same on every run
+    class CameraTrack
+    {
+    public:
+        struct Sample
+        {
+            CoreEngine::Units::Second m_time;
+            CameraState               m_state;
+        };
+
+        template <typename... Args>
+        requires std::is_constructible_v<Sample, Args...>
+        void EmplaceBackSample(Args&&... args) noexcept
+        {
+            m_samples.emplace_back(std::forward<Args>(args)...);
+        }
+
+        void Reserve(size_t amount_samples) noexcept;
+        void ClearAllSamples() noexcept;
+
+        // Interpolates between the surrounding samples, clamps to the ends of the track
+        [[nodiscard]] CameraState Evaluate(CoreEngine::Units::Second time_since_begin) const noexcept;
+
+        [[nodiscard]] CoreEngine::Units::Second GetDuration() const noexcept;
+        [[nodiscard]] size_t GetAmountSamples() const noexcept;
+        [[nodiscard]] bool IsEmpty() const noexcept;
+        [[nodiscard]] const std::vector<Sample>& GetSamplesConstRef() const noexcept;
+
+    private:
+        std::vector<Sample> m_samples;
+    };
+}
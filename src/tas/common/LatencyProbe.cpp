@@ -0,0 +1,120 @@
+#include "tas/common/LatencyProbe.h"
+
+#include "core/utility/Performance.h"
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <vector>
+
+namespace AsphaltTas::LatencyProbe
+{
+namespace
+{
+    std::mutex g_probe_mutex;
+
+    // Ring of the latest writes, in milliseconds
+    std::array<double, WINDOW_SIZE> g_acquisition_to_write_ms {};
+    std::array<double, WINDOW_SIZE> g_tick_to_write_ms {};
+    size_t   g_amount_recorded = 0;
+    uint64_t g_writes          = 0;
+    uint64_t g_skipped_ticks   = 0;
+    std::optional<uint64_t> g_last_tick_index = std::nullopt;
+
+    std::mutex        g_tick_counter_mutex;
+    TickCounterReader g_tick_counter_reader = nullptr;
+
+    [[nodiscard]] Distribution CreateDistribution(std::vector<double>& values) noexcept
+    {
+        Distribution distribution;
+        distribution.m_amount_samples = values.size();
+        if (values.empty()) return distribution;
+
+        std::sort(values.begin(), values.end());
+        const auto Percentile = [&values](double p) -> double
+        {
+            return values[std::min(values.size() - 1, static_cast<size_t>(p * static_cast<double>(values.size())))];
+        };
+
+        double sum = 0.0;
+        for (const double value : values) sum += value;
+
+        distribution.m_min_ms  = values.front();
+        distribution.m_mean_ms = sum / static_cast<double>(values.size());
+        distribution.m_p50_ms  = Percentile(0.50);
+        distribution.m_p90_ms  = Percentile(0.90);
+        distribution.m_p99_ms  = Percentile(0.99);
+        distribution.m_max_ms  = values.back();
+        return distribution;
+    }
+}
+    void RecordWrite(const LatencyStamp& stamp, CoreEngine::Units::Second written_at) noexcept
+    {
+        const double acquisition_to_write_ms = (written_at - stamp.m_acquired_at).Get() * 1000.0;
+        const double tick_to_write_ms        = (written_at - stamp.m_tick_observed_at).Get() * 1000.0;
+
+        ENGINE_PERFORMANCE_TRACE_COUNTER("Latency: Acquisition -> Write ms", acquisition_to_write_ms);
+        ENGINE_PERFORMANCE_TRACE_COUNTER("Latency: Tick -> Write ms", tick_to_write_ms);
+
+        std::scoped_lock lock(g_probe_mutex);
+        const size_t slot = g_amount_recorded % WINDOW_SIZE;
+        g_acquisition_to_write_ms[slot] = acquisition_to_write_ms;
+        g_tick_to_write_ms[slot]        = tick_to_write_ms;
+        ++g_amount_recorded;
+        ++g_writes;
+
+        // Several writes per tick are expected, going backwards happens when the target restarts
+        if (g_last_tick_index.has_value() && stamp.m_tick_index > g_last_tick_index.value() + 1)
+            g_skipped_ticks += stamp.m_tick_index - g_last_tick_index.value() - 1;
+        g_last_tick_index = stamp.m_tick_index;
+    }
+
+    Report GetReport() noexcept
+    {
+        std::vector<double> acquisition_to_write;
+        std::vector<double> tick_to_write;
+        Report report;
+        {
+            std::scoped_lock lock(g_probe_mutex);
+            const size_t amount = std::min(g_amount_recorded, WINDOW_SIZE);
+            acquisition_to_write.assign(g_acquisition_to_write_ms.begin(), g_acquisition_to_write_ms.begin() + amount);
+            tick_to_write.assign(g_tick_to_write_ms.begin(), g_tick_to_write_ms.begin() + amount);
+            report.m_skipped_ticks = g_skipped_ticks;
+            report.m_writes        = g_writes;
+        }
+
+        report.m_acquisition_to_write = CreateDistribution(acquisition_to_write);
+        report.m_tick_to_write        = CreateDistribution(tick_to_write);
+        return report;
+    }
+
+    void Reset() noexcept
+    {
+        std::scoped_lock lock(g_probe_mutex);
+        g_amount_recorded = 0;
+        g_writes          = 0;
+        g_skipped_ticks   = 0;
+        g_last_tick_index = std::nullopt;
+    }
+
+    void SetTickCounterReader(TickCounterReader reader) noexcept
+    {
+        std::scoped_lock lock(g_tick_counter_mutex);
+        g_tick_counter_reader = std::move(reader);
+    }
+
+    std::optional<uint64_t> TryReadTickCounter() noexcept
+    {
+        std::scoped_lock lock(g_tick_counter_mutex);
+        if (! g_tick_counter_reader) return std::nullopt;
+
+        try
+        {
+            return g_tick_counter_reader();
+        }
+        catch (...)
+        {
+            return std::nullopt;
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "core/utility/Units.h"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+namespace AsphaltTas
+{
+    // Travels with a racer sample from the read out of game memory through interpolation and the camera controllers
+    // up to the camera write that used it. All times are Timer::GetTimeSinceEpoch.
+    struct LatencyStamp
+    {
+        CoreEngine::Units::Second m_acquired_at      {0}; // Start of the read that returned the sample
+        CoreEngine::Units::Second m_tick_observed_at {0}; // End of the first read that saw the game tick of the sample
+        uint64_t                  m_tick_index       = 0; // Tick counter of the target if available, else counts observed ticks
+    };
+
+    // Latency distributions over the last WINDOW_SIZE camera writes that depended on a racer sample
+    namespace LatencyProbe
+    {
+        constexpr size_t WINDOW_SIZE = 2048;
+
+        struct Distribution
+        {
+            size_t m_amount_samples = 0;
+            double m_min_ms  = 0.0;
+            double m_mean_ms = 0.0;
+            double m_p50_ms  = 0.0;
+            double m_p90_ms  = 0.0;
+            double m_p99_ms  = 0.0;
+            double m_max_ms  = 0.0;
+        };
+
+        struct Report
+        {
+            Distribution m_acquisition_to_write;
+            Distribution m_tick_to_write;
+
+            // Ticks no write was based on, from gaps in the tick indices. Only exact with a tick counter, state change
+            // detection can't see ticks in which the racer didn't move.
+            uint64_t m_skipped_ticks = 0;
+            uint64_t m_writes        = 0;
+        };
+
+        // Camera writer thread, right after a successful write
+        void RecordWrite(const LatencyStamp& stamp, CoreEngine::Units::Second written_at) noexcept;
+
+        [[nodiscard]] Report GetReport() noexcept;
+        void Reset() noexcept;
+
+        // Optional monotonic tick counter of the target, e.g. one a stand-in process increments every simulated tick.
+        // If set, a tick is observed whenever the counter changes instead of whenever the racer state changes.
+        using TickCounterReader = std::function<uint64_t()>;
+        void SetTickCounterReader(TickCounterReader reader) noexcept; // nullptr = back to state change detection
+        // nullopt if no reader is set or it threw
+        [[nodiscard]] std::optional<uint64_t> TryReadTickCounter() noexcept;
+    }
+}
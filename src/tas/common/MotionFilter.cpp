@@ -0,0 +1,309 @@
+#include "tas/common/MotionFilter.h"
+
+#include "core/utility/MathUtility.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace AsphaltTas
+{
+namespace
+{
+    using CoreEngine::MathUtility::RotationVectorFromQuat;
+    using CoreEngine::MathUtility::QuatFromRotationVector;
+
+    constexpr float MIN_DELTA_TIME = 1e-4f;
+
+    [[nodiscard]] float DeltaSeconds(CoreEngine::Units::Second from, CoreEngine::Units::Second to) noexcept
+    {
+        return std::max(static_cast<float>((to - from).Get()), MIN_DELTA_TIME);
+    }
+
+    [[nodiscard]] float SmoothingFactor(float cutoff_hz, float dt) noexcept
+    {
+        const float tau = 1.0f / (2.0f * std::numbers::pi_v<float> * std::max(cutoff_hz, 1e-3f));
+        return 1.0f / (1.0f + tau / dt);
+    }
+}
+
+//////////////////////////////////////////////////////////
+// Basic_MotionFilter
+//////////////////////////////////////////////////////////
+    Basic_MotionFilter::Type Basic_MotionFilter::GetType() const noexcept
+    {
+        return m_type;
+    }
+
+    const char* Basic_MotionFilter::TypeToString(Type type) noexcept
+    {
+        switch (type)
+        {
+            case Type::NONE:     return "None";
+            case Type::ONE_EURO: return "One Euro";
+            case Type::SPRING:   return "Critically Damped Spring";
+            case Type::KALMAN:   return "Kalman (Constant Acceleration)";
+        }
+        return "Unknown";
+    }
+
+    std::unique_ptr<Basic_MotionFilter> CreateMotionFilter(Basic_MotionFilter::Type type)
+    {
+        switch (type)
+        {
+            case Basic_MotionFilter::Type::NONE:     return std::make_unique<None_MotionFilter>();
+            case Basic_MotionFilter::Type::ONE_EURO: return std::make_unique<OneEuro_MotionFilter>();
+            case Basic_MotionFilter::Type::SPRING:   return std::make_unique<Spring_MotionFilter>();
+            case Basic_MotionFilter::Type::KALMAN:   return std::make_unique<Kalman_MotionFilter>();
+        }
+        return std::make_unique<None_MotionFilter>();
+    }
+
+//////////////////////////////////////////////////////////
+// None_MotionFilter
+//////////////////////////////////////////////////////////
+    MotionSample None_MotionFilter::Filter(const MotionSample& sample) noexcept
+    {
+        return sample;
+    }
+
+    void None_MotionFilter::Reset() noexcept
+    {
+
+    }
+
+    std::unique_ptr<Basic_MotionFilter> None_MotionFilter::Copy() const
+    {
+        return std::make_unique<None_MotionFilter>(*this);
+    }
+
+//////////////////////////////////////////////////////////
+// OneEuro_MotionFilter
+//////////////////////////////////////////////////////////
+    OneEuro_MotionFilter::OneEuro_MotionFilter() noexcept : Basic_MotionFilter(Type::ONE_EURO)
+    {
+
+    }
+
+    MotionSample OneEuro_MotionFilter::Filter(const MotionSample& sample) noexcept
+    {
+        if (! m_has_state)
+        {
+            m_has_state              = true;
+            m_state                  = sample;
+            m_linear_speed_estimate  = glm::vec3(0.0f);
+            m_angular_speed_estimate = 0.0f;
+            return m_state;
+        }
+
+        const float dt = DeltaSeconds(m_state.m_timestamp, sample.m_timestamp);
+        const float derivative_alpha = SmoothingFactor(m_params.m_derivative_cutoff_hz, dt);
+
+        //Position
+        const glm::vec3 raw_speed = (sample.m_position - m_state.m_position) / dt;
+        m_linear_speed_estimate   = glm::mix(m_linear_speed_estimate, raw_speed, derivative_alpha);
+
+        const float position_cutoff = m_params.m_min_cutoff_hz + m_params.m_beta * glm::length(m_linear_speed_estimate);
+        m_state.m_position = glm::mix(m_state.m_position, sample.m_position, SmoothingFactor(position_cutoff, dt));
+
+        //Orientation
+        const glm::quat target = glm::dot(m_state.m_rotation, sample.m_rotation) < 0.0f ? -sample.m_rotation : sample.m_rotation;
+        const float raw_angular_speed = glm::length(RotationVectorFromQuat(target * glm::inverse(m_state.m_rotation))) / dt;
+        m_angular_speed_estimate = glm::mix(m_angular_speed_estimate, raw_angular_speed, derivative_alpha);
+
+        const float rotation_cutoff = m_params.m_min_cutoff_hz + m_params.m_beta * m_angular_speed_estimate;
+        m_state.m_rotation  = glm::normalize(glm::slerp(m_state.m_rotation, target, SmoothingFactor(rotation_cutoff, dt)));
+        m_state.m_timestamp = sample.m_timestamp;
+
+        return m_state;
+    }
+
+    void OneEuro_MotionFilter::Reset() noexcept
+    {
+        m_has_state = false;
+    }
+
+    std::unique_ptr<Basic_MotionFilter> OneEuro_MotionFilter::Copy() const
+    {
+        return std::make_unique<OneEuro_MotionFilter>(*this);
+    }
+
+    OneEuro_MotionFilter::Params OneEuro_MotionFilter::GetParams() const noexcept
+    {
+        return m_params;
+    }
+
+    void OneEuro_MotionFilter::SetParams(const Params& params) noexcept
+    {
+        m_params = params;
+    }
+
+//////////////////////////////////////////////////////////
+// Spring_MotionFilter
+//////////////////////////////////////////////////////////
+    Spring_MotionFilter::Spring_MotionFilter() noexcept : Basic_MotionFilter(Type::SPRING)
+    {
+
+    }
+
+    MotionSample Spring_MotionFilter::Filter(const MotionSample& sample) noexcept
+    {
+        if (! m_has_state)
+        {
+            m_has_state        = true;
+            m_state            = sample;
+            m_linear_velocity  = glm::vec3(0.0f);
+            m_angular_velocity = glm::vec3(0.0f);
+            return m_state;
+        }
+
+        const float dt    = DeltaSeconds(m_state.m_timestamp, sample.m_timestamp);
+        const float omega = std::max(m_params.m_angular_frequency, 0.01f);
+        const float decay = std::exp(-omega * dt);
+
+        //Exact solution of x'' = -omega^2 x - 2 omega x' for the offset x to the (held) target
+        auto Step = [omega, dt, decay](glm::vec3& offset, glm::vec3& velocity) -> void
+        {
+            const glm::vec3 j = velocity + omega * offset;
+            offset   = (offset + j * dt) * decay;
+            velocity = (velocity - omega * j * dt) * decay;
+        };
+
+        glm::vec3 position_offset = m_state.m_position - sample.m_position;
+        Step(position_offset, m_linear_velocity);
+        m_state.m_position = sample.m_position + position_offset;
+
+        glm::vec3 rotation_offset = RotationVectorFromQuat(m_state.m_rotation * glm::inverse(sample.m_rotation));
+        Step(rotation_offset, m_angular_velocity);
+        m_state.m_rotation  = glm::normalize(QuatFromRotationVector(rotation_offset) * sample.m_rotation);
+        m_state.m_timestamp = sample.m_timestamp;
+
+        return m_state;
+    }
+
+    void Spring_MotionFilter::Reset() noexcept
+    {
+        m_has_state = false;
+    }
+
+    std::unique_ptr<Basic_MotionFilter> Spring_MotionFilter::Copy() const
+    {
+        return std::make_unique<Spring_MotionFilter>(*this);
+    }
+
+    Spring_MotionFilter::Params Spring_MotionFilter::GetParams() const noexcept
+    {
+        return m_params;
+    }
+
+    void Spring_MotionFilter::SetParams(const Params& params) noexcept
+    {
+        m_params = params;
+    }
+
+//////////////////////////////////////////////////////////
+// Kalman_MotionFilter
+//////////////////////////////////////////////////////////
+    Kalman_MotionFilter::Kalman_MotionFilter() noexcept : Basic_MotionFilter(Type::KALMAN)
+    {
+
+    }
+
+    MotionSample Kalman_MotionFilter::Filter(const MotionSample& sample) noexcept
+    {
+        //Large initial uncertainty on the derivatives, the first samples then define them
+        const glm::mat3 INITIAL_COVARIANCE = glm::mat3(glm::vec3(m_params.m_measurement_noise, 0.0f, 0.0f), glm::vec3(0.0f, 100.0f, 0.0f), glm::vec3(0.0f, 0.0f, 100.0f));
+
+        if (! m_has_state)
+        {
+            m_has_state      = true;
+            m_last_timestamp = sample.m_timestamp;
+
+            m_position_state = AxisState{ sample.m_position, glm::vec3(0.0f), glm::vec3(0.0f), INITIAL_COVARIANCE };
+            m_rotation_state = AxisState{ glm::vec3(0.0f),   glm::vec3(0.0f), glm::vec3(0.0f), INITIAL_COVARIANCE };
+            m_rotation_anchor = sample.m_rotation;
+            return sample;
+        }
+
+        const float dt = DeltaSeconds(m_last_timestamp, sample.m_timestamp);
+        m_last_timestamp = sample.m_timestamp;
+
+        PredictAndUpdate(m_position_state, sample.m_position, dt, m_params.m_measurement_noise);
+
+        //Orientation lives in the tangent space of the anchor; the anchor follows once the offset grows, keeping the mapping near linear
+        const glm::vec3 rotation_measurement = RotationVectorFromQuat(sample.m_rotation * glm::inverse(m_rotation_anchor));
+        PredictAndUpdate(m_rotation_state, rotation_measurement, dt, m_params.m_measurement_noise);
+
+        constexpr float REANCHOR_ANGLE = 0.5f;
+        if (glm::length(m_rotation_state.m_value) > REANCHOR_ANGLE)
+        {
+            m_rotation_anchor = glm::normalize(QuatFromRotationVector(m_rotation_state.m_value) * m_rotation_anchor);
+            m_rotation_state.m_value = glm::vec3(0.0f);
+        }
+
+        MotionSample out;
+        out.m_position  = m_position_state.m_value;
+        out.m_rotation  = glm::normalize(QuatFromRotationVector(m_rotation_state.m_value) * m_rotation_anchor);
+        out.m_timestamp = sample.m_timestamp;
+        return out;
+    }
+
+    void Kalman_MotionFilter::PredictAndUpdate(AxisState& state, const glm::vec3& measurement, float dt, float measurement_noise) const noexcept
+    {
+        const float dt2 = dt * dt;
+        const float dt3 = dt2 * dt;
+        const float dt4 = dt3 * dt;
+        const float dt5 = dt4 * dt;
+
+        //glm is column major: F[column][row]
+        glm::mat3 transition (1.0f);
+        transition[1][0] = dt;
+        transition[2][0] = 0.5f * dt2;
+        transition[2][1] = dt;
+
+        const float q = m_params.m_process_noise;
+        const glm::mat3 process_noise (
+            glm::vec3(dt5 / 20.0f, dt4 / 8.0f, dt3 / 6.0f) * q,
+            glm::vec3(dt4 / 8.0f,  dt3 / 3.0f, dt2 / 2.0f) * q,
+            glm::vec3(dt3 / 6.0f,  dt2 / 2.0f, dt)         * q
+        );
+
+        //Predict
+        state.m_value        = state.m_value + state.m_velocity * dt + state.m_acceleration * (0.5f * dt2);
+        state.m_velocity     = state.m_velocity + state.m_acceleration * dt;
+        state.m_covariance   = transition * state.m_covariance * glm::transpose(transition) + process_noise;
+
+        //Update, only the value is observed (H = [1 0 0])
+        const float innovation_variance = state.m_covariance[0][0] + measurement_noise;
+        const glm::vec3 gain = glm::vec3(state.m_covariance[0][0], state.m_covariance[0][1], state.m_covariance[0][2]) / innovation_variance;
+
+        const glm::vec3 innovation = measurement - state.m_value;
+        state.m_value        += gain.x * innovation;
+        state.m_velocity     += gain.y * innovation;
+        state.m_acceleration += gain.z * innovation;
+
+        glm::mat3 gain_times_observation (0.0f);
+        gain_times_observation[0] = gain;
+        state.m_covariance = (glm::mat3(1.0f) - gain_times_observation) * state.m_covariance;
+    }
+
+    void Kalman_MotionFilter::Reset() noexcept
+    {
+        m_has_state = false;
+    }
+
+    std::unique_ptr<Basic_MotionFilter> Kalman_MotionFilter::Copy() const
+    {
+        return std::make_unique<Kalman_MotionFilter>(*this);
+    }
+
+    Kalman_MotionFilter::Params Kalman_MotionFilter::GetParams() const noexcept
+    {
+        return m_params;
+    }
+
+    void Kalman_MotionFilter::SetParams(const Params& params) noexcept
+    {
+        m_params = params;
+    }
+}
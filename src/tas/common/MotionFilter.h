@@ -0,0 +1,157 @@
+#pragma once
+
+#include "core/utility/Units.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include <memory>
+
+namespace AsphaltTas
+{
+    struct MotionSample
+    {
+        glm::vec3 m_position {0};
+        glm::quat m_rotation = glm::identity<glm::quat>();
+        CoreEngine::Units::Second m_timestamp {0};
+    };
+
+//////////////////////////////////////////////////////////
+// Filters; all take timestamped samples and work on position and orientation
+//////////////////////////////////////////////////////////
+    class Basic_MotionFilter
+    {
+    public:
+        enum class Type
+        {
+            NONE, ONE_EURO, SPRING, KALMAN
+        };
+
+        virtual ~Basic_MotionFilter() noexcept = default;
+
+        [[nodiscard]] virtual MotionSample Filter(const MotionSample& sample) noexcept = 0;
+        virtual void Reset() noexcept = 0;
+        [[nodiscard]] virtual std::unique_ptr<Basic_MotionFilter> Copy() const = 0;
+
+        [[nodiscard]] Type GetType() const noexcept;
+        [[nodiscard]] static const char* TypeToString(Type type) noexcept;
+
+    protected:
+        explicit Basic_MotionFilter(Type type) noexcept : m_type(type) {}
+
+        Type m_type;
+    };
+
+    // Pass through, keeps the call sites free of special cases
+    class None_MotionFilter : public Basic_MotionFilter
+    {
+    public:
+        explicit None_MotionFilter() noexcept : Basic_MotionFilter(Type::NONE) {}
+
+        [[nodiscard]] virtual MotionSample Filter(const MotionSample& sample) noexcept override;
+        virtual void Reset() noexcept override;
+        [[nodiscard]] virtual std::unique_ptr<Basic_MotionFilter> Copy() const override;
+    };
+
+    // Low pass with a cutoff rising with speed: heavy smoothing while slow, little lag while fast (Casiez et al. 2012)
+    class OneEuro_MotionFilter : public Basic_MotionFilter
+    {
+    public:
+        struct Params
+        {
+            float m_min_cutoff_hz        = 1.0f;
+            float m_beta                 = 0.05f;
+            float m_derivative_cutoff_hz = 1.0f;
+        };
+
+        explicit OneEuro_MotionFilter() noexcept;
+        explicit OneEuro_MotionFilter(Params params) noexcept : Basic_MotionFilter(Type::ONE_EURO), m_params(params) {}
+
+        [[nodiscard]] virtual MotionSample Filter(const MotionSample& sample) noexcept override;
+        virtual void Reset() noexcept override;
+        [[nodiscard]] virtual std::unique_ptr<Basic_MotionFilter> Copy() const override;
+
+        [[nodiscard]] Params GetParams() const noexcept;
+        void SetParams(const Params& params) noexcept;
+
+    private:
+        Params m_params;
+
+        bool         m_has_state = false;
+        MotionSample m_state;
+        glm::vec3    m_linear_speed_estimate  {0};
+        float        m_angular_speed_estimate = 0.0f;
+    };
+
+    // Follows the target like a critically damped spring, stepped in closed form so it stays stable for any dt
+    class Spring_MotionFilter : public Basic_MotionFilter
+    {
+    public:
+        struct Params
+        {
+            float m_angular_frequency = 25.0f; // rad/s, higher = stiffer
+        };
+
+        explicit Spring_MotionFilter() noexcept;
+        explicit Spring_MotionFilter(Params params) noexcept : Basic_MotionFilter(Type::SPRING), m_params(params) {}
+
+        [[nodiscard]] virtual MotionSample Filter(const MotionSample& sample) noexcept override;
+        virtual void Reset() noexcept override;
+        [[nodiscard]] virtual std::unique_ptr<Basic_MotionFilter> Copy() const override;
+
+        [[nodiscard]] Params GetParams() const noexcept;
+        void SetParams(const Params& params) noexcept;
+
+    private:
+        Params m_params;
+
+        bool         m_has_state = false;
+        MotionSample m_state;
+        glm::vec3    m_linear_velocity  {0};
+        glm::vec3    m_angular_velocity {0};
+    };
+
+    // Constant acceleration model (position, velocity, acceleration) per axis.
+    // All axes share dt and noise, so they share one covariance matrix and one gain.
+    // Orientation runs through the same model on a rotation vector relative to a re-anchored reference.
+    class Kalman_MotionFilter : public Basic_MotionFilter
+    {
+    public:
+        struct Params
+        {
+            float m_process_noise     = 200.0f; // jerk spectral density
+            float m_measurement_noise = 0.01f;  // variance of a position sample
+        };
+
+        explicit Kalman_MotionFilter() noexcept;
+        explicit Kalman_MotionFilter(Params params) noexcept : Basic_MotionFilter(Type::KALMAN), m_params(params) {}
+
+        [[nodiscard]] virtual MotionSample Filter(const MotionSample& sample) noexcept override;
+        virtual void Reset() noexcept override;
+        [[nodiscard]] virtual std::unique_ptr<Basic_MotionFilter> Copy() const override;
+
+        [[nodiscard]] Params GetParams() const noexcept;
+        void SetParams(const Params& params) noexcept;
+
+    private:
+        struct AxisState
+        {
+            glm::vec3 m_value        {0};
+            glm::vec3 m_velocity     {0};
+            glm::vec3 m_acceleration {0};
+            glm::mat3 m_covariance   {1.0f};
+        };
+
+        void PredictAndUpdate(AxisState& state, const glm::vec3& measurement, float dt, float measurement_noise) const noexcept;
+
+        Params m_params;
+
+        bool      m_has_state = false;
+        CoreEngine::Units::Second m_last_timestamp {0};
+        AxisState m_position_state;
+        AxisState m_rotation_state;
+        glm::quat m_rotation_anchor = glm::identity<glm::quat>();
+    };
+
+    [[nodiscard]] std::unique_ptr<Basic_MotionFilter> CreateMotionFilter(Basic_MotionFilter::Type type);
+}
@@ -0,0 +1,171 @@
+#include "tas/common/MotionFilterHarness.h"
+
+#include "core/utility/MathUtility.h"
+
+#include "glm/gtc/quaternion.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace AsphaltTas::MotionFilterHarness
+{
+namespace
+{
+    using CoreEngine::MathUtility::RotationVectorFromQuat;
+    using CoreEngine::MathUtility::QuatFromRotationVector;
+
+    // Filters get this many samples to settle before they are measured
+    constexpr size_t WARMUP_SAMPLES = 30;
+
+    struct FitResult
+    {
+        float m_lag    = 0.0f;
+        float m_jitter = 0.0f;
+        float m_bias   = 0.0f;
+    };
+
+    // Least squares fit of error = velocity * lag. What is left splits into a slow part (bias, e.g. cutting corners)
+    // and the fast part around it (jitter), separated by the same centered window as the reference.
+    [[nodiscard]] FitResult FitLagAndJitter(std::span<const glm::vec3> errors, std::span<const glm::vec3> velocities, size_t half_window) noexcept
+    {
+        FitResult result;
+        if (errors.empty()) return result;
+
+        double numerator   = 0.0;
+        double denominator = 0.0;
+        for (size_t i = 0; i < errors.size(); i++)
+        {
+            numerator   += glm::dot(errors[i], velocities[i]);
+            denominator += glm::dot(velocities[i], velocities[i]);
+        }
+        result.m_lag = denominator > 1e-12 ? static_cast<float>(numerator / denominator) : 0.0f;
+
+        std::vector<glm::vec3> residuals (errors.size());
+        for (size_t i = 0; i < errors.size(); i++)
+            residuals[i] = errors[i] - velocities[i] * result.m_lag;
+
+        double jitter_squared_sum = 0.0;
+        double bias_squared_sum   = 0.0;
+        for (size_t i = 0; i < residuals.size(); i++)
+        {
+            const size_t begin = i > half_window ? i - half_window : 0;
+            const size_t end   = std::min(i + half_window + 1, residuals.size());
+
+            glm::vec3 sum (0.0f);
+            for (size_t j = begin; j < end; j++)
+                sum += residuals[j];
+            const glm::vec3 slow = sum / static_cast<float>(end - begin);
+            const glm::vec3 fast = residuals[i] - slow;
+
+            jitter_squared_sum += glm::dot(fast, fast);
+            bias_squared_sum   += glm::dot(slow, slow);
+        }
+        result.m_jitter = static_cast<float>(std::sqrt(jitter_squared_sum / static_cast<double>(residuals.size())));
+        result.m_bias   = static_cast<float>(std::sqrt(bias_squared_sum   / static_cast<double>(residuals.size())));
+        return result;
+    }
+}
+    bool SaveSamples(const std::string& file_path, std::span<const MotionSample> samples) noexcept
+    {
+        std::ofstream file (file_path, std::ios::out | std::ios::trunc);
+        if (! file.is_open()) return false;
+
+        //Steady clock seconds grow large with uptime, so times keep fixed nanosecond decimals instead of 9 significant digits.
+        //Positions & rotations are floats, 9 significant digits round-trip them
+        for (const MotionSample& sample : samples)
+        {
+            file << std::fixed << std::setprecision(9) << sample.m_timestamp.Get() << ' '
+                 << std::defaultfloat << sample.m_position.x << ' ' << sample.m_position.y << ' ' << sample.m_position.z << ' '
+                 << sample.m_rotation.w << ' ' << sample.m_rotation.x << ' ' << sample.m_rotation.y << ' ' << sample.m_rotation.z << '\n';
+        }
+        return file.good();
+    }
+
+    bool LoadSamples(const std::string& file_path, std::vector<MotionSample>& out) noexcept
+    {
+        std::ifstream file (file_path);
+        if (! file.is_open()) return false;
+
+        out.clear();
+        double time = 0.0;
+        MotionSample sample;
+        while (file >> time >> sample.m_position.x >> sample.m_position.y >> sample.m_position.z
+                    >> sample.m_rotation.w >> sample.m_rotation.x >> sample.m_rotation.y >> sample.m_rotation.z)
+        {
+            sample.m_timestamp = CoreEngine::Units::Second(time);
+            sample.m_rotation  = glm::normalize(sample.m_rotation);
+            out.push_back(sample);
+        }
+        return file.eof();
+    }
+
+    Report Evaluate(const Basic_MotionFilter& prototype, std::span<const MotionSample> samples, size_t reference_window) noexcept
+    {
+        Report report;
+        report.m_filter_type = prototype.GetType();
+
+        const size_t half_window = std::max<size_t>(reference_window / 2, 1);
+        const size_t first       = std::max(half_window, WARMUP_SAMPLES) + 1;
+        if (samples.size() < first + half_window + 3) return report;
+        const size_t last = samples.size() - half_window - 1; // exclusive, keeps one reference sample on each side for the derivative
+
+        //Filter
+        std::unique_ptr<Basic_MotionFilter> filter = prototype.Copy();
+        filter->Reset();
+
+        std::vector<MotionSample> filtered;
+        filtered.reserve(samples.size());
+        for (const MotionSample& sample : samples)
+            filtered.push_back(filter->Filter(sample));
+
+        //Reference
+        std::vector<MotionSample> reference (samples.size());
+        for (size_t i = half_window; i < samples.size() - half_window; i++)
+        {
+            glm::vec3 position_sum (0.0f);
+            glm::vec3 rotation_sum (0.0f);
+            for (size_t j = i - half_window; j <= i + half_window; j++)
+            {
+                position_sum += samples[j].m_position;
+                rotation_sum += RotationVectorFromQuat(samples[j].m_rotation * glm::inverse(samples[i].m_rotation));
+            }
+            const float count = static_cast<float>(2 * half_window + 1);
+            reference[i].m_position  = position_sum / count;
+            reference[i].m_rotation  = glm::normalize(QuatFromRotationVector(rotation_sum / count) * samples[i].m_rotation);
+            reference[i].m_timestamp = samples[i].m_timestamp;
+        }
+
+        //Errors against the reference and its velocity
+        std::vector<glm::vec3> position_errors, linear_velocities, rotation_errors, angular_velocities;
+        position_errors.reserve(last - first);
+        linear_velocities.reserve(last - first);
+        rotation_errors.reserve(last - first);
+        angular_velocities.reserve(last - first);
+
+        for (size_t i = first; i < last; i++)
+        {
+            const float dt = static_cast<float>((reference[i + 1].m_timestamp - reference[i - 1].m_timestamp).Get());
+            if (dt <= 0.0f) continue;
+
+            position_errors.push_back(reference[i].m_position - filtered[i].m_position);
+            linear_velocities.push_back((reference[i + 1].m_position - reference[i - 1].m_position) / dt);
+
+            rotation_errors.push_back(RotationVectorFromQuat(reference[i].m_rotation * glm::inverse(filtered[i].m_rotation)));
+            angular_velocities.push_back(RotationVectorFromQuat(reference[i + 1].m_rotation * glm::inverse(reference[i - 1].m_rotation)) / dt);
+        }
+
+        const FitResult position_fit = FitLagAndJitter(position_errors, linear_velocities, half_window);
+        const FitResult rotation_fit = FitLagAndJitter(rotation_errors, angular_velocities, half_window);
+
+        report.m_amount_samples          = position_errors.size();
+        report.m_position_lag_ms         = position_fit.m_lag    * 1000.0f;
+        report.m_position_jitter_mm      = position_fit.m_jitter * 1000.0f;
+        report.m_position_bias_mm        = position_fit.m_bias   * 1000.0f;
+        report.m_rotation_lag_ms         = rotation_fit.m_lag    * 1000.0f;
+        report.m_rotation_jitter_degrees = glm::degrees(rotation_fit.m_jitter);
+        report.m_rotation_bias_degrees   = glm::degrees(rotation_fit.m_bias);
+        return report;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "tas/common/MotionFilter.h"
+
+#include <span>
+#include <string>
+#include <vector>
+
+namespace AsphaltTas
+{
+    // Replays captured (noisy) sample streams through a filter and measures how much it lags versus how much jitter remains
+    namespace MotionFilterHarness
+    {
+        struct Report
+        {
+            Basic_MotionFilter::Type m_filter_type = Basic_MotionFilter::Type::NONE;
+            size_t m_amount_samples = 0;
+
+            // Lag is the time shift that best explains the error along the motion.
+            // Of what is left, jitter is the fast changing part (RMS) and bias the slow one (e.g. cutting corners).
+            float m_position_lag_ms         = 0.0f;
+            float m_position_jitter_mm      = 0.0f;
+            float m_position_bias_mm        = 0.0f;
+            float m_rotation_lag_ms         = 0.0f;
+            float m_rotation_jitter_degrees = 0.0f;
+            float m_rotation_bias_degrees   = 0.0f;
+        };
+
+        // Plain text, one sample per line: time px py pz qw qx qy qz
+        [[nodiscard]] bool SaveSamples(const std::string& file_path, std::span<const MotionSample> samples) noexcept;
+        [[nodiscard]] bool LoadSamples(const std::string& file_path, std::vector<MotionSample>& out) noexcept;
+
+        // The reference is a centered moving average over reference_window samples (non causal, so it has no lag itself).
+        // The filter is copied and reset, the prototype stays untouched.
+        [[nodiscard]] Report Evaluate(const Basic_MotionFilter& prototype, std::span<const MotionSample> samples, size_t reference_window = 9) noexcept;
+    }
+}
@@ -63,18 +63,25 @@ namespace AsphaltTas
     void RacerState::SetRotation(glm::quat rotation) noexcept
     {
         ///////////////////////////////////////////
-        // Convert to X, Z, Y convention & invert z for game +z convention
+        // Inverse of GetExtractedRotation: basis vectors go into the rows, in game (X, -Z, Y) convention
         //////////////////////////////////////////
-        auto ToGameConvetion = [](glm::vec3 v) -> glm::vec3
+        auto ToGameConvention = [](glm::vec3 v) -> glm::vec3
         {
-            return glm::vec3(v[0], v[2], -1.0f * v[1]);
+            return glm::vec3(v[0], -1.0f * v[2], v[1]);
         };
 
-        glm::mat3 basis = glm::mat3_cast(rotation);
+        const glm::mat3 basis = glm::mat3_cast(glm::normalize(rotation));
+
+        const glm::vec3 right   = ToGameConvention(basis[0]);
+        const glm::vec3 up      = ToGameConvention(basis[1]);
+        const glm::vec3 forward = ToGameConvention(basis[2]);
 
-        m_transform[0] = { ToGameConvetion(basis[0]), m_transform[0][3] };
-        m_transform[1] = { ToGameConvetion(basis[2]), m_transform[1][3] };
-        m_transform[2] = { ToGameConvetion(basis[1]), m_transform[2][3] };
+        for (int column = 0; column < 3; column++)
+        {
+            m_transform[column][0] = right[column];
+            m_transform[column][1] = forward[column];
+            m_transform[column][2] = up[column];
+        }
     }
 
     glm::mat4 RacerState::GetGameConventionTransformMatrix() const noexcept
@@ -2,6 +2,8 @@
 
 #include "core/utility/Assert.h"
 
+#include <algorithm>
+
 namespace AsphaltTas
 {
     void Replay::IncrementFrameIndex(size_t count) noexcept
@@ -39,6 +41,34 @@ namespace AsphaltTas
         return m_frames.size();
     }
 
+    const std::vector<Replay::Frame>& Replay::GetFramesConstRef() const noexcept
+    {
+        return m_frames;
+    }
+
+    std::optional<RacerState> Replay::SampleRacerStateAtTime(CoreEngine::Units::MicroSecond time_since_begin) const noexcept
+    {
+        if (m_frames.empty()) return std::nullopt;
+
+        const auto it = std::upper_bound(m_frames.begin(), m_frames.end(), time_since_begin,
+            [](CoreEngine::Units::MicroSecond time, const Frame& frame) { return time < frame.m_time_since_begin; });
+
+        if (it == m_frames.begin()) return m_frames.front().m_racer_state;
+        if (it == m_frames.end())   return m_frames.back().m_racer_state;
+
+        const Frame& lower = *(it - 1);
+        const Frame& upper = *it;
+
+        const auto  span = (upper.m_time_since_begin - lower.m_time_since_begin).Get();
+        const float t    = span > 0 ? static_cast<float>((time_since_begin - lower.m_time_since_begin).Get()) / static_cast<float>(span) : 0.0f;
+
+        RacerState out = lower.m_racer_state;
+        out.SetPosition(glm::mix(lower.m_racer_state.GetExtractedPosition(), upper.m_racer_state.GetExtractedPosition(), t));
+        out.SetRotation(glm::slerp(lower.m_racer_state.GetExtractedRotation(), upper.m_racer_state.GetExtractedRotation(), t));
+        out.SetVelocity(glm::mix(lower.m_racer_state.GetVelocity(), upper.m_racer_state.GetVelocity(), t));
+        return out;
+    }
+
     void Replay::ClearAllFrameData() noexcept
     {
         m_frames.clear();
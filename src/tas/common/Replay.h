@@ -5,6 +5,7 @@
 #include "core/utility/Units.h"
 
 #include <vector>
+#include <optional>
 
 namespace AsphaltTas
 {
@@ -30,6 +31,10 @@ namespace AsphaltTas
         [[nodiscard]] Frame GetCurrentFrame() const noexcept;
         [[nodiscard]] Frame GetLastFrame() const noexcept;
         [[nodiscard]] size_t GetAmountFrames() const noexcept;
+        [[nodiscard]] const std::vector<Frame>& GetFramesConstRef() const noexcept;
+
+        // Position, velocity and rotation are interpolated between the two surrounding frames; clamps to the recorded range
+        [[nodiscard]] std::optional<RacerState> SampleRacerStateAtTime(CoreEngine::Units::MicroSecond time_since_begin) const noexcept;
 
         void ClearAllFrameData() noexcept;
 
@@ -5,6 +5,10 @@
 #include "tas/memory/MemoryUtility.h"
 #include "tas/memory/MemoryRW.h"
 #include "tas/memory/MemoryAddressFinder.h"
+#include "tas/globalstate/MemoryAddressState.h"
+#include "tas/common/LatencyProbe.h"
+
+#include "standin/StandInLayout.h"
 
 #include <thread>
 
@@ -15,6 +19,22 @@ namespace
 {
     std::atomic<GamePlatform> g_platform  = GamePlatform::NONE;
     std::atomic<HWND>         g_game_hwnd = nullptr;
+
+    std::mutex  g_exe_name_override_mutex;
+    std::string g_exe_name_override;
+
+    // Only the stand-in exposes its ticks, throws like any read while the addresses aren't resolved
+    uint64_t ReadStandInTickCounter()
+    {
+        const uintptr_t racer_base = RacerStateAddresses::GetBaseAddress();
+        if (racer_base == INVALID_ADDRESS)
+            throw MemoryUtility::MemoryManipFailedException("GameState: Racer address not resolved yet.");
+
+        const libmem::Process process = MemoryUtility::GetAsphaltProcessOrThrow();
+        uint64_t tick_count = 0;
+        MemoryUtility::ReadMemoryOrThrow(&process, racer_base + StandIn::OFFSET_TICK_COUNTER, &tick_count, sizeof(tick_count));
+        return tick_count;
+    }
 }
 
     void SetCurrentPlatform(GamePlatform platform) noexcept
@@ -56,6 +76,30 @@ namespace
         return g_game_hwnd.load(std::memory_order::acquire);
     }
 
+    void SetExeNameOverride(std::string exe_name) noexcept
+    {
+        const bool is_stand_in = exe_name == StandIn::EXE_NAME;
+        {
+            std::scoped_lock lock(g_exe_name_override_mutex);
+            g_exe_name_override = std::move(exe_name);
+        }
+        LatencyProbe::SetTickCounterReader(is_stand_in ? LatencyProbe::TickCounterReader(&ReadStandInTickCounter) : nullptr);
+    }
+
+    std::string GetExeNameOverride() noexcept
+    {
+        std::scoped_lock lock(g_exe_name_override_mutex);
+        return g_exe_name_override;
+    }
+
+    std::string GetGameExeName(GamePlatform platform) noexcept
+    {
+        std::string exe_name = GetExeNameOverride();
+        if (exe_name.empty())
+            exe_name = GetGameExeNameFromPlatform(platform);
+        return exe_name;
+    }
+
     void OnInvalidateAllCaches() noexcept
     {
         MemoryUtility::InvalidateCache();
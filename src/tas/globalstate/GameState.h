@@ -5,6 +5,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
+#include <string>
 
 struct HWND__;
 using HWND   = HWND__*;
@@ -41,6 +42,14 @@ namespace AsphaltTas
             ENGINE_ASSERT(false && "Expected a valid platform to convert into EXE name.");
         }
 
+        // Makes the tool attach to another executable than the game, e.g. the stand-in target (StandIn::EXE_NAME).
+        // Any valid platform then resolves to this name. Empty = the game.
+        void SetExeNameOverride(std::string exe_name) noexcept;
+        [[nodiscard]] std::string GetExeNameOverride() noexcept;
+
+        // The override if set, else GetGameExeNameFromPlatform()
+        [[nodiscard]] std::string GetGameExeName(GamePlatform platform) noexcept;
+
         void OnInvalidateAllCaches() noexcept;
     };
 }
\ No newline at end of file
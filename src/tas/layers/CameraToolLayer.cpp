@@ -18,9 +18,12 @@
 
 #include "tas/common/RacerState.h"
 #include "tas/common/CameraState.h"
+#include "tas/common/LatencyProbe.h"
 
 #include "tas/servicethreads/MouseInputService.h"
 #include "tas/servicethreads/ReadCurrentStateService.h"
+#include "tas/servicethreads/CameraWriterService.h"
+#include "tas/servicethreads/ReplayRecorderService.h"
 
 #include "tas/layers/GuiStyle.h"
 
@@ -52,6 +55,8 @@ namespace AsphaltTas
         s_orbital_cam_controller.SetDistance(5.0f);
         s_orbital_cam_controller.SetSensitivity(0.2f);
 
+        m_camera_rig_stack.PushRig(std::make_unique<Chase_CameraRig>());
+
         try 
         {
             std::optional<CameraState> camera_state_now = ReadCurrentStateService::GetCurrentCameraState();
@@ -71,6 +76,7 @@ namespace AsphaltTas
 
             MemoryRW::DestroyCameraUpdateCode();
             MouseInputService::LaunchThread();
+            CameraWriterService::LaunchThread();
         } 
         catch (std::exception& e) 
         { 
@@ -82,6 +88,9 @@ namespace AsphaltTas
     CameraToolLayer::~CameraToolLayer() noexcept
     {
         s_instance = nullptr;
+        CameraWriterService::StopThread();
+        ReadCurrentStateService::StopSampleCapture();
+        ReadCurrentStateService::SetMotionFilter(std::make_unique<None_MotionFilter>());
         try 
         {
             MemoryRW::RestoreCameraUpdateCode();
@@ -117,8 +126,25 @@ namespace AsphaltTas
         input_state.m_mouse_move_delta = MouseInputService::GetMouseDeltaMovementAndReset();
 
         CameraState out;
+        CameraWriterService::CameraTarget target;
+
+        // The writer thread extrapolates the racer from this point in time onwards
+        const CoreEngine::Units::Second time_now = CoreEngine::Timer::GetTimeSinceEpoch<CoreEngine::Units::Second>();
 
-        if (s_current_controller_type == CameraControllerType::FREE_CAM)
+        const bool camera_path_is_playing = (s_current_controller_type == CameraControllerType::CAMERA_PATH) && m_playing_camera_path;
+
+        if (camera_path_is_playing)
+        {
+            // Actual playback happens on the writer thread, this only keeps the free cam in sync to continue from there
+            const CameraState path_state = m_playing_camera_path->Evaluate(time_now - m_camera_path_start_time);
+            m_free_cam_pseudo_camera.SetPosition(path_state.m_position);
+            m_free_cam_pseudo_camera.SetRotation(path_state.m_rotation);
+            out = path_state;
+
+            target.m_camera_path            = m_playing_camera_path;
+            target.m_playback_start_time = m_camera_path_start_time;
+        }
+        else if (s_current_controller_type == CameraControllerType::FREE_CAM || s_current_controller_type == CameraControllerType::CAMERA_PATH)
         {
             s_free_cam_controller.Update(m_free_cam_pseudo_camera, input_state, CoreEngine::Units::Convert<CoreEngine::Units::Second>(dt));
             out.m_position      = m_free_cam_pseudo_camera.GetPosition();
@@ -127,7 +153,7 @@ namespace AsphaltTas
         }
         else if (s_current_controller_type == CameraControllerType::ORBITAL_CAM)
         {
-            std::optional<RacerState> car_state = ReadCurrentStateService::GetInterpolatedRacerState();
+            std::optional<ReadCurrentStateService::StampedRacerState> car_state = ReadCurrentStateService::GetInterpolatedStampedRacerState(time_now);
 
             if (! car_state.has_value())
             {
@@ -136,8 +162,12 @@ namespace AsphaltTas
             }
             else 
             {
-                s_orbital_cam_controller.SetTarget(car_state->GetExtractedPosition());
+                s_orbital_cam_controller.SetTarget(car_state->m_state.GetExtractedPosition());
                 s_orbital_cam_controller.Update(m_orbital_cam_pseudo_camera, input_state, CoreEngine::Units::Convert<CoreEngine::Units::Second>(dt));
+
+                target.m_is_relative_to_racer      = true;
+                target.m_racer_position_at_publish = car_state->m_state.GetExtractedPosition();
+                target.m_racer_stamp               = car_state->m_stamp;
             }
 
             out.m_position      = m_orbital_cam_pseudo_camera.GetPosition();
@@ -146,7 +176,7 @@ namespace AsphaltTas
         }
         else if (s_current_controller_type == CameraControllerType::FRONT_CAR)
         {
-            std::optional<RacerState> car_state = ReadCurrentStateService::GetInterpolatedRacerState();
+            std::optional<ReadCurrentStateService::StampedRacerState> car_state = ReadCurrentStateService::GetInterpolatedStampedRacerState(time_now);
 
             if (! car_state.has_value())
             {
@@ -164,25 +194,70 @@ namespace AsphaltTas
                 {
                     s_front_car_camera_controller.SetOffsetForward(s_front_car_camera_controller.GetOffsetForward() + -1.0f * dt_secs.Get());
                 }
-                s_front_car_camera_controller.SetRacerState(car_state.value());
+                s_front_car_camera_controller.SetRacerState(car_state->m_state);
                 s_front_car_camera_controller.Update(m_front_car_cam_pseudo_camera, input_state, dt_secs);
+
+                target.m_is_relative_to_racer      = true;
+                target.m_racer_position_at_publish = car_state->m_state.GetExtractedPosition();
+                target.m_racer_stamp               = car_state->m_stamp;
             }
             
             out.m_position      = m_front_car_cam_pseudo_camera.GetPosition();
             out.m_rotation      = m_front_car_cam_pseudo_camera.GetRotation();
             out.m_fov_radians   = m_front_car_cam_pseudo_camera.GetFovRad();
         }
-
-        try 
+        else if (s_current_controller_type == CameraControllerType::CAMERA_RIG)
         {
-            MemoryRW::WriteCameraState(out, MemoryRW::IGNORE_FLAG_CAMERA::AspectRatio);
-        } 
-        catch (...) {}
+            if (m_baked_camera_track_is_playing && m_baked_camera_track)
+            {
+                out = m_baked_camera_track->Evaluate(time_now - m_baked_camera_track_start_time);
+
+                target.m_camera_track        = m_baked_camera_track;
+                target.m_playback_start_time = m_baked_camera_track_start_time;
+            }
+            else
+            {
+                std::optional<ReadCurrentStateService::StampedRacerState> car_state = ReadCurrentStateService::GetInterpolatedStampedRacerState(time_now);
+
+                if (! car_state.has_value())
+                {
+                    ENGINE_DEBUG_PRINT("Exited RIG Camera because of failure to obtain current Car State.");
+                    s_current_controller_type = CameraControllerType::FREE_CAM;
+
+                    out.m_position    = m_free_cam_pseudo_camera.GetPosition();
+                    out.m_rotation    = m_free_cam_pseudo_camera.GetRotation();
+                    out.m_fov_radians = m_free_cam_pseudo_camera.GetFovRad();
+                }
+                else 
+                {
+                    out = m_camera_rig_stack.EvaluateLive(car_state->m_state, time_now);
+
+                    // World fixed rigs (look at, dolly) would drift with the racer between publishes, those are written as is
+                    target.m_is_relative_to_racer      = m_camera_rig_stack.IsRacerRelative();
+                    target.m_racer_position_at_publish = car_state->m_state.GetExtractedPosition();
+                    target.m_racer_stamp               = car_state->m_stamp;
+                }
+            }
+        }
+
+        //////////////////////////////////////////////////////////
+        // Writing happens decoupled from the tool framerate on the writer thread
+        //////////////////////////////////////////////////////////
+        target.m_camera_state = out;
+        CameraWriterService::PublishCameraTarget(target);
     }
 
     void CameraToolLayer::OnRender() noexcept 
     {
+        if (! m_gui_draw_camera_path || ! m_camera_path.IsPlayable()) return;
+
+        constexpr size_t    SAMPLES_PER_SEGMENT = 32;
+        constexpr glm::vec3 PATH_COLOR {1.0f, 0.518f, 0.0f};
 
+        m_draw_lines_pipeline.SetLineData(m_camera_path.CalculateDebugLines(SAMPLES_PER_SEGMENT), PATH_COLOR);
+        m_draw_lines_pipeline.SetCameraMatrixAndFrustumCull(m_free_cam_pseudo_camera.CalculateCameraMatrix());
+        m_draw_lines_pipeline.Render();
+        m_draw_lines_pipeline.ClearAllLines();
     }
 
     void CameraToolLayer::OnImGuiRender() noexcept 
@@ -195,7 +270,8 @@ namespace AsphaltTas
         ImGuiWindowFlags flags = ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoCollapse
                                | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoBringToFrontOnFocus;
 
-        PUSH_SCOPED_STYLE_COLOR(ImGuiCol_WindowBg, GuiStyle::COLOR_BLACK);
+        // Path preview is rendered beneath the gui
+        PUSH_SCOPED_STYLE_COLOR(ImGuiCol_WindowBg, m_gui_draw_camera_path ? GuiStyle::COLOR_TRANSPARENT : GuiStyle::COLOR_BLACK);
 
         PUSH_SCOPED_STYLE_VAR(ImGuiStyleVar_WindowPadding, ImVec2(0, 0));
         PUSH_SCOPED_STYLE_VAR(ImGuiStyleVar_WindowBorderSize, 0.0f);
@@ -225,6 +301,17 @@ namespace AsphaltTas
             {
                 MouseInputService::StopThread();
             }
+            ImGui::SameLine();
+            if (ImGui::RadioButton("Path", &controller_type, static_cast<int>(CameraControllerType::CAMERA_PATH)))
+            {
+                MouseInputService::LaunchThread();
+            }
+            ImGui::SameLine();
+            if (ImGui::RadioButton("Rigs", &controller_type, static_cast<int>(CameraControllerType::CAMERA_RIG)))
+            {
+                MouseInputService::StopThread();
+                m_camera_rig_stack.ResetLiveSmoothing();
+            }
             s_current_controller_type = static_cast<CameraControllerType>(controller_type);
 
             if (s_current_controller_type == CameraControllerType::FREE_CAM)
@@ -362,15 +449,494 @@ namespace AsphaltTas
                 ImGui::TextUnformatted(("Rotation : " + CoreEngine::CommonUtility::GlmQuatToString(m_orbital_cam_pseudo_camera.GetRotation())).c_str());
                 ImGui::TextUnformatted(("Rot Euler: " + CoreEngine::CommonUtility::GlmVec3ToString(glm::degrees(glm::eulerAngles(m_orbital_cam_pseudo_camera.GetRotation())))).c_str());
             }
+            else if (s_current_controller_type == CameraControllerType::CAMERA_PATH)
+            {
+                OnImGuiRender_CameraPath();
+            }
+            else if (s_current_controller_type == CameraControllerType::CAMERA_RIG)
+            {
+                OnImGuiRender_CameraRigs();
+            }
             else 
             {
                 ENGINE_ASSERT(false && "Unkown camera controller: Should not be reachable.");
             }
+
+            if (ImGui::CollapsingHeader("Camera Writer"))
+            {
+                float write_rate = static_cast<float>(CameraWriterService::GetWriteRate());
+                if (ImGui::SliderFloat("Write Rate", &write_rate, 30.0f, 1000.0f, "%.0f Hz"))
+                {
+                    CameraWriterService::SetWriteRate(write_rate);
+                }
+
+                CoreEngine::Window* window = CoreEngine::Application::Get()->GetWindowPtr(m_handle);
+                float max_fps = window->GetMaxFramesPerSecond();
+                if (ImGui::SliderFloat("Window Max FPS", &max_fps, 0.0f, 240.0f, max_fps > 0.0f ? "%.0f" : "Uncapped"))
+                {
+                    window->SetMaxFramesPerSecond(max_fps);
+                }
+
+                bool predict = CameraWriterService::GetPredictionEnabled();
+                if (ImGui::Checkbox("Predict Car Position", &predict))
+                {
+                    CameraWriterService::SetPredictionEnabled(predict);
+                }
+
+                const CameraWriterService::WriteStatistics stats = CameraWriterService::GetWriteStatistics();
+                ImGui::Text("Writes/s     : %.1f", stats.m_writes_per_second);
+                ImGui::Text("Tick Phase   : avg %.2f ms (min %.2f / max %.2f)", stats.m_average_phase_ms, stats.m_min_phase_ms, stats.m_max_phase_ms);
+                if (stats.m_failed_writes > 0)
+                {
+                    PUSH_SCOPED_STYLE_COLOR(ImGuiCol_Text, GuiStyle::COLOR_RED);
+                    ImGui::Text("Failed Writes: %llu", static_cast<unsigned long long>(stats.m_failed_writes));
+                }
+
+                // Only writes that depend on the racer (orbital, front car & rig cameras) are measured
+                const LatencyProbe::Report latency = LatencyProbe::GetReport();
+                const auto LatencyText = [](const char* label, const LatencyProbe::Distribution& distribution) -> void
+                {
+                    ImGui::Text("%s: p50 %.2f / p90 %.2f / p99 %.2f ms (max %.2f)", label,
+                        distribution.m_p50_ms, distribution.m_p90_ms, distribution.m_p99_ms, distribution.m_max_ms);
+                };
+                LatencyText("Read -> Write", latency.m_acquisition_to_write);
+                LatencyText("Tick -> Write", latency.m_tick_to_write);
+                ImGui::Text("Skipped Ticks: %llu of %llu writes", static_cast<unsigned long long>(latency.m_skipped_ticks), static_cast<unsigned long long>(latency.m_writes));
+                ImGui::SameLine();
+                if (ImGui::SmallButton("Reset##latency"))
+                {
+                    LatencyProbe::Reset();
+                }
+            }
+
+            if (ImGui::CollapsingHeader("Target Filter"))
+            {
+                OnImGuiRender_MotionFilter();
+            }
         }
 
         ImGui::End();
     }
 
+    void CameraToolLayer::OnImGuiRender_CameraPath() noexcept
+    {
+        const bool is_playing = m_playing_camera_path != nullptr;
+
+        if (! is_playing)
+        {
+            if (ImGui::Button("Play") && m_camera_path.IsPlayable())
+            {
+                m_playing_camera_path    = std::make_shared<const CameraPath>(m_camera_path);
+                m_camera_path_start_time = CoreEngine::Timer::GetTimeSinceEpoch<CoreEngine::Units::Second>();
+            }
+        }
+        else
+        {
+            if (ImGui::Button("Stop"))
+            {
+                m_playing_camera_path = nullptr;
+            }
+            else
+            {
+                const double elapsed = (CoreEngine::Timer::GetTimeSinceEpoch<CoreEngine::Units::Second>() - m_camera_path_start_time).Get();
+                ImGui::SameLine();
+                ImGui::Text("%.2f / %.2f s", std::min(elapsed, m_playing_camera_path->GetDuration().Get()), m_playing_camera_path->GetDuration().Get());
+            }
+        }
+        ImGui::SameLine();
+        ImGui::Checkbox("Draw Path", &m_gui_draw_camera_path);
+
+        ImGui::BeginDisabled(is_playing);
+
+        int spline_type = static_cast<int>(m_camera_path.GetSplineType());
+        ImGui::RadioButton("Centripetal Catmull-Rom", &spline_type, static_cast<int>(CameraPath::SplineType::CENTRIPETAL_CATMULL_ROM));
+        ImGui::SameLine();
+        ImGui::RadioButton("Kochanek-Bartels", &spline_type, static_cast<int>(CameraPath::SplineType::KOCHANEK_BARTELS));
+        if (spline_type != static_cast<int>(m_camera_path.GetSplineType()))
+        {
+            m_camera_path.SetSplineType(static_cast<CameraPath::SplineType>(spline_type));
+        }
+
+        if (m_camera_path.GetSplineType() == CameraPath::SplineType::KOCHANEK_BARTELS)
+        {
+            CameraPath::KochanekBartelsParams params = m_camera_path.GetKochanekBartelsParams();
+            bool changed = false;
+            changed |= ImGui::SliderFloat("Tension",    &params.m_tension,    -1.0f, 1.0f);
+            changed |= ImGui::SliderFloat("Bias",       &params.m_bias,       -1.0f, 1.0f);
+            changed |= ImGui::SliderFloat("Continuity", &params.m_continuity, -1.0f, 1.0f);
+            if (changed)
+            {
+                m_camera_path.SetKochanekBartelsParams(params);
+            }
+        }
+
+        int playback_mode = static_cast<int>(m_camera_path.GetPlaybackMode());
+        if (ImGui::Combo("Timing", &playback_mode, "Keyframe Times\0Constant Speed\0Ease In/Out\0"))
+        {
+            m_camera_path.SetPlaybackMode(static_cast<CameraPath::PlaybackMode>(playback_mode));
+        }
+
+        if (ImGui::Button("Add Keyframe"))
+        {
+            const std::vector<CameraPath::Keyframe>& keyframes = m_camera_path.GetKeyframesConstRef();
+
+            CameraPath::Keyframe keyframe;
+            keyframe.m_position    = m_free_cam_pseudo_camera.GetPosition();
+            keyframe.m_rotation    = m_free_cam_pseudo_camera.GetRotation();
+            keyframe.m_fov_radians = m_free_cam_pseudo_camera.GetFovRad();
+            keyframe.m_time        = keyframes.empty() ? CoreEngine::Units::Second(0) : keyframes.back().m_time + CoreEngine::Units::Second(m_gui_keyframe_spacing_seconds);
+            m_camera_path.AddKeyframe(keyframe);
+        }
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100.0f);
+        ImGui::InputFloat("Spacing (s)", &m_gui_keyframe_spacing_seconds, 0.1f, 1.0f, "%.2f");
+        m_gui_keyframe_spacing_seconds = std::max(m_gui_keyframe_spacing_seconds, 0.01f);
+        ImGui::SameLine();
+        if (ImGui::Button("Clear"))
+        {
+            m_camera_path.ClearKeyframes();
+        }
+
+        ImGui::Text("Duration: %.2f s  Length: %.1f", m_camera_path.GetDuration().Get(), m_camera_path.GetArcLength());
+
+        std::optional<size_t> remove_index = std::nullopt;
+        std::optional<std::pair<size_t, float>> retime = std::nullopt;
+
+        const std::vector<CameraPath::Keyframe>& keyframes = m_camera_path.GetKeyframesConstRef();
+        for (size_t i = 0; i < keyframes.size(); i++)
+        {
+            ImGui::PushID(static_cast<int>(i));
+
+            float time = static_cast<float>(keyframes[i].m_time.Get());
+            ImGui::SetNextItemWidth(100.0f);
+            if (ImGui::InputFloat("##time", &time, 0.0f, 0.0f, "%.2f s", ImGuiInputTextFlags_EnterReturnsTrue))
+            {
+                retime = std::make_pair(i, time);
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Go To"))
+            {
+                m_free_cam_pseudo_camera.SetPosition(keyframes[i].m_position);
+                m_free_cam_pseudo_camera.SetRotation(keyframes[i].m_rotation);
+                m_free_cam_pseudo_camera.SetFovRad(keyframes[i].m_fov_radians);
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Remove"))
+            {
+                remove_index = i;
+            }
+            ImGui::SameLine();
+            ImGui::TextUnformatted(CoreEngine::CommonUtility::GlmVec3ToString(keyframes[i].m_position).c_str());
+
+            ImGui::PopID();
+        }
+
+        // Modified after iterating, both invalidate the keyframe reference
+        if (retime.has_value())
+        {
+            m_camera_path.SetKeyframeTime(retime->first, CoreEngine::Units::Second(retime->second));
+        }
+        else if (remove_index.has_value())
+        {
+            m_camera_path.RemoveKeyframe(remove_index.value());
+        }
+
+        ImGui::EndDisabled();
+    }
+
+    void CameraToolLayer::OnImGuiRender_CameraRigs() noexcept
+    {
+        //////////////////////////////////////////////////////////
+        // Recording & baking
+        //////////////////////////////////////////////////////////
+        const bool is_recording = ReplayRecorderService::GetThreadIsRunning();
+        if (ImGui::Button(is_recording ? "Stop Recording" : "Record Replay"))
+        {
+            if (is_recording)
+                ReplayRecorderService::StopRecordThread();
+            else
+                ReplayRecorderService::LaunchRecordThread();
+        }
+        ImGui::SameLine();
+        ImGui::Text("Frames: %zu", ReplayRecorderService::GetAmountRecordedFrames());
+        ImGui::SameLine();
+        if (ImGui::Button("Clear Replay"))
+        {
+            ReplayRecorderService::ClearAllRecordedStates();
+        }
+
+        ImGui::SetNextItemWidth(100.0f);
+        ImGui::InputFloat("Bake Rate (Hz)", &m_gui_bake_rate_hz, 10.0f, 60.0f, "%.0f");
+        m_gui_bake_rate_hz = std::clamp(m_gui_bake_rate_hz, 1.0f, 1000.0f);
+        ImGui::SameLine();
+        if (ImGui::Button("Bake"))
+        {
+            const Replay replay = ReplayRecorderService::GetReplayCopy();
+            m_baked_camera_track = std::make_shared<const CameraTrack>(m_camera_rig_stack.BakeFromReplay(replay, CoreEngine::Units::Second(1.0 / m_gui_bake_rate_hz)));
+            m_baked_camera_track_is_playing = false;
+        }
+
+        if (m_baked_camera_track && ! m_baked_camera_track->IsEmpty())
+        {
+            if (ImGui::Button(m_baked_camera_track_is_playing ? "Stop Track" : "Play Track"))
+            {
+                m_baked_camera_track_is_playing = ! m_baked_camera_track_is_playing;
+                m_baked_camera_track_start_time = CoreEngine::Timer::GetTimeSinceEpoch<CoreEngine::Units::Second>();
+            }
+            ImGui::SameLine();
+            ImGui::Text("Track: %zu samples, %.2f s", m_baked_camera_track->GetAmountSamples(), m_baked_camera_track->GetDuration().Get());
+        }
+
+        //////////////////////////////////////////////////////////
+        // Rig stack
+        //////////////////////////////////////////////////////////
+        float smoothing = static_cast<float>(m_camera_rig_stack.GetSmoothingTime().Get());
+        if (ImGui::SliderFloat("Smoothing (s)", &smoothing, 0.0f, 2.0f, "%.2f"))
+        {
+            m_camera_rig_stack.SetSmoothingTime(CoreEngine::Units::Second(smoothing));
+        }
+
+        ImGui::SetNextItemWidth(150.0f);
+        ImGui::Combo("##new_rig", &m_gui_new_rig_type, "Chase\0Hood\0Orbit\0Dolly Track\0Look At\0");
+        ImGui::SameLine();
+        if (ImGui::Button("Add Rig"))
+        {
+            switch (static_cast<Basic_CameraRig::Type>(m_gui_new_rig_type))
+            {
+                case Basic_CameraRig::Type::CHASE:       m_camera_rig_stack.PushRig(std::make_unique<Chase_CameraRig>());      break;
+                case Basic_CameraRig::Type::HOOD:        m_camera_rig_stack.PushRig(std::make_unique<Hood_CameraRig>());       break;
+                case Basic_CameraRig::Type::ORBIT:       m_camera_rig_stack.PushRig(std::make_unique<Orbit_CameraRig>());      break;
+                case Basic_CameraRig::Type::DOLLY_TRACK: m_camera_rig_stack.PushRig(std::make_unique<DollyTrack_CameraRig>()); break;
+                case Basic_CameraRig::Type::LOOK_AT:     m_camera_rig_stack.PushRig(std::make_unique<LookAt_CameraRig>());     break;
+            }
+        }
+
+        std::optional<size_t> remove_index = std::nullopt;
+        std::vector<CameraRigStack::Entry>& entries = m_camera_rig_stack.GetEntriesRef();
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            Basic_CameraRig* rig = entries[i].m_rig.get();
+            ImGui::PushID(static_cast<int>(i));
+
+            const bool open = ImGui::TreeNodeEx("##rig", ImGuiTreeNodeFlags_DefaultOpen, "%s", Basic_CameraRig::TypeToString(rig->GetType()));
+            ImGui::SameLine();
+            if (ImGui::SmallButton("Remove"))
+            {
+                remove_index = i;
+            }
+
+            if (open)
+            {
+                ImGui::SliderFloat("Weight", &entries[i].m_weight, 0.0f, 1.0f);
+
+                float fov_deg = glm::degrees(rig->GetFovRadians());
+                if (ImGui::SliderFloat("Fov", &fov_deg, 10.0f, 160.0f, "%.1f°"))
+                {
+                    rig->SetFovRadians(glm::radians(fov_deg));
+                }
+
+                switch (rig->GetType())
+                {
+                    case Basic_CameraRig::Type::CHASE:
+                    {
+                        Chase_CameraRig* chase = static_cast<Chase_CameraRig*>(rig);
+                        Chase_CameraRig::Params params = chase->GetParams();
+                        bool changed = false;
+                        changed |= ImGui::SliderFloat("Distance",       &params.m_distance,           0.5f, 30.0f);
+                        changed |= ImGui::SliderFloat("Height",         &params.m_height,            -5.0f, 15.0f);
+                        changed |= ImGui::SliderFloat("Look At Height", &params.m_look_at_height,    -5.0f, 5.0f);
+                        changed |= ImGui::SliderFloat("Follow Travel",  &params.m_velocity_alignment, 0.0f, 1.0f);
+                        if (changed) chase->SetParams(params);
+                        break;
+                    }
+                    case Basic_CameraRig::Type::HOOD:
+                    {
+                        Hood_CameraRig* hood = static_cast<Hood_CameraRig*>(rig);
+                        Hood_CameraRig::Params params = hood->GetParams();
+                        bool changed = false;
+                        changed |= ImGui::SliderFloat3("Offset", glm::value_ptr(params.m_offset), -5.0f, 5.0f);
+                        changed |= ImGui::Checkbox("Look Backwards", &params.m_look_backwards);
+                        if (changed) hood->SetParams(params);
+                        break;
+                    }
+                    case Basic_CameraRig::Type::ORBIT:
+                    {
+                        Orbit_CameraRig* orbit = static_cast<Orbit_CameraRig*>(rig);
+                        Orbit_CameraRig::Params params = orbit->GetParams();
+                        bool changed = false;
+                        changed |= ImGui::SliderFloat("Distance",      &params.m_distance,               0.5f, 30.0f);
+                        changed |= ImGui::SliderFloat("Height",        &params.m_height,                -5.0f, 15.0f);
+                        changed |= ImGui::SliderAngle("Start Angle",   &params.m_start_angle_radians);
+                        changed |= ImGui::SliderFloat("Angular Speed", &params.m_angular_speed_radians, -3.0f, 3.0f);
+                        changed |= ImGui::Checkbox("Relative To Heading", &params.m_relative_to_heading);
+                        if (changed) orbit->SetParams(params);
+                        break;
+                    }
+                    case Basic_CameraRig::Type::DOLLY_TRACK:
+                    {
+                        DollyTrack_CameraRig* dolly = static_cast<DollyTrack_CameraRig*>(rig);
+                        DollyTrack_CameraRig::Params params = dolly->GetParamsConstRef();
+                        bool changed = false;
+                        changed |= ImGui::SliderFloat("Lead Distance",  &params.m_lead_distance,  -20.0f, 20.0f);
+                        changed |= ImGui::SliderFloat("Look At Height", &params.m_look_at_height, -5.0f, 5.0f);
+                        if (ImGui::Button("Add Rail Point (Free Cam)"))
+                        {
+                            params.m_rail_points.push_back(m_free_cam_pseudo_camera.GetPosition());
+                            changed = true;
+                        }
+                        ImGui::SameLine();
+                        if (ImGui::Button("Clear Rail"))
+                        {
+                            params.m_rail_points.clear();
+                            changed = true;
+                        }
+                        ImGui::Text("Rail Points: %zu", params.m_rail_points.size());
+                        if (changed) dolly->SetParams(std::move(params));
+                        break;
+                    }
+                    case Basic_CameraRig::Type::LOOK_AT:
+                    {
+                        LookAt_CameraRig* look_at = static_cast<LookAt_CameraRig*>(rig);
+                        LookAt_CameraRig::Params params = look_at->GetParams();
+                        bool changed = false;
+                        changed |= ImGui::InputFloat3("Position", glm::value_ptr(params.m_position));
+                        if (ImGui::Button("Use Free Cam Position"))
+                        {
+                            params.m_position = m_free_cam_pseudo_camera.GetPosition();
+                            changed = true;
+                        }
+                        changed |= ImGui::SliderFloat("Look At Height", &params.m_look_at_height, -5.0f, 5.0f);
+                        if (changed) look_at->SetParams(params);
+                        break;
+                    }
+                }
+                ImGui::TreePop();
+            }
+            ImGui::PopID();
+        }
+
+        if (remove_index.has_value())
+        {
+            m_camera_rig_stack.RemoveRig(remove_index.value());
+        }
+    }
+
+    void CameraToolLayer::OnImGuiRender_MotionFilter() noexcept
+    {
+        //////////////////////////////////////////////////////////
+        // Live filter
+        //////////////////////////////////////////////////////////
+        int filter_type = static_cast<int>(m_motion_filter_type);
+        bool changed = ImGui::Combo("Filter", &filter_type, "None\0One Euro\0Critically Damped Spring\0Kalman (Constant Acceleration)\0");
+        m_motion_filter_type = static_cast<Basic_MotionFilter::Type>(filter_type);
+
+        switch (m_motion_filter_type)
+        {
+            case Basic_MotionFilter::Type::NONE:
+                break;
+            case Basic_MotionFilter::Type::ONE_EURO:
+                changed |= ImGui::SliderFloat("Min Cutoff (Hz)",        &m_one_euro_params.m_min_cutoff_hz,        0.01f, 10.0f, "%.2f");
+                changed |= ImGui::SliderFloat("Beta",                   &m_one_euro_params.m_beta,                 0.0f,  1.0f,  "%.3f");
+                changed |= ImGui::SliderFloat("Derivative Cutoff (Hz)", &m_one_euro_params.m_derivative_cutoff_hz, 0.1f,  10.0f, "%.2f");
+                break;
+            case Basic_MotionFilter::Type::SPRING:
+                changed |= ImGui::SliderFloat("Stiffness (rad/s)", &m_spring_params.m_angular_frequency, 1.0f, 100.0f, "%.1f");
+                break;
+            case Basic_MotionFilter::Type::KALMAN:
+                changed |= ImGui::SliderFloat("Process Noise",     &m_kalman_params.m_process_noise,     0.1f,    10000.0f, "%.1f", ImGuiSliderFlags_Logarithmic);
+                changed |= ImGui::SliderFloat("Measurement Noise", &m_kalman_params.m_measurement_noise, 0.00001f, 1.0f,    "%.5f", ImGuiSliderFlags_Logarithmic);
+                break;
+        }
+
+        if (changed)
+        {
+            ReadCurrentStateService::SetMotionFilter(CreateConfiguredMotionFilter(m_motion_filter_type));
+        }
+
+        //////////////////////////////////////////////////////////
+        // Capture & offline evaluation
+        //////////////////////////////////////////////////////////
+        const bool is_capturing = ReadCurrentStateService::GetSampleCaptureIsRunning();
+        if (ImGui::Button(is_capturing ? "Stop Capture" : "Capture Samples"))
+        {
+            if (is_capturing)
+            {
+                ReadCurrentStateService::StopSampleCapture();
+                m_captured_motion_samples = ReadCurrentStateService::GetCapturedSamples();
+            }
+            else
+            {
+                ReadCurrentStateService::StartSampleCapture();
+            }
+        }
+        ImGui::SameLine();
+        ImGui::Text("Samples: %zu", m_captured_motion_samples.size());
+        if (is_capturing && ReadCurrentStateService::GetAmountDroppedCapturedSamples() > 0)
+        {
+            ImGui::SameLine();
+            ImGui::Text("(full, %zu max)", ReadCurrentStateService::MAX_CAPTURED_SAMPLES);
+        }
+
+        ImGui::InputText("File", m_gui_motion_sample_file_path, sizeof(m_gui_motion_sample_file_path));
+        if (ImGui::Button("Save Samples"))
+        {
+            if (! MotionFilterHarness::SaveSamples(m_gui_motion_sample_file_path, m_captured_motion_samples))
+                ENGINE_DEBUG_PRINT("Failed to save motion samples to " << m_gui_motion_sample_file_path);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Load Samples"))
+        {
+            if (! MotionFilterHarness::LoadSamples(m_gui_motion_sample_file_path, m_captured_motion_samples))
+                ENGINE_DEBUG_PRINT("Failed to load motion samples from " << m_gui_motion_sample_file_path);
+        }
+
+        if (ImGui::Button("Evaluate All Filters"))
+        {
+            m_motion_filter_reports.clear();
+            for (const Basic_MotionFilter::Type type : {Basic_MotionFilter::Type::NONE, Basic_MotionFilter::Type::ONE_EURO, Basic_MotionFilter::Type::SPRING, Basic_MotionFilter::Type::KALMAN})
+            {
+                m_motion_filter_reports.push_back(MotionFilterHarness::Evaluate(*CreateConfiguredMotionFilter(type), m_captured_motion_samples));
+            }
+        }
+
+        if (! m_motion_filter_reports.empty() && ImGui::BeginTable("##filter_reports", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit))
+        {
+            ImGui::TableSetupColumn("Filter");
+            ImGui::TableSetupColumn("Lag (ms)");
+            ImGui::TableSetupColumn("Jitter (mm)");
+            ImGui::TableSetupColumn("Bias (mm)");
+            ImGui::TableSetupColumn("Rot Lag (ms)");
+            ImGui::TableSetupColumn("Rot Jitter (°)");
+            ImGui::TableSetupColumn("Rot Bias (°)");
+            ImGui::TableHeadersRow();
+
+            for (const MotionFilterHarness::Report& report : m_motion_filter_reports)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(Basic_MotionFilter::TypeToString(report.m_filter_type));
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", report.m_position_lag_ms);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", report.m_position_jitter_mm);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", report.m_position_bias_mm);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", report.m_rotation_lag_ms);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", report.m_rotation_jitter_degrees);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", report.m_rotation_bias_degrees);
+            }
+            ImGui::EndTable();
+        }
+    }
+
+    std::unique_ptr<Basic_MotionFilter> CameraToolLayer::CreateConfiguredMotionFilter(Basic_MotionFilter::Type type) const
+    {
+        switch (type)
+        {
+            case Basic_MotionFilter::Type::NONE:     return std::make_unique<None_MotionFilter>();
+            case Basic_MotionFilter::Type::ONE_EURO: return std::make_unique<OneEuro_MotionFilter>(m_one_euro_params);
+            case Basic_MotionFilter::Type::SPRING:   return std::make_unique<Spring_MotionFilter>(m_spring_params);
+            case Basic_MotionFilter::Type::KALMAN:   return std::make_unique<Kalman_MotionFilter>(m_kalman_params);
+        }
+        return std::make_unique<None_MotionFilter>();
+    }
+
     void CameraToolLayer::CreateInstance() noexcept
     {
         ENGINE_ASSERT( ! s_instance && "There should only ever be one FreeFlightLayer active at one time.");
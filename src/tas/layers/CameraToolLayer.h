@@ -6,11 +6,19 @@
 #include "core/scene/FollowCam_CameraController.h"
 #include "core/scene/DummyCameraController.h"
 #include "core/utility/Timer.h"
+#include "core/rendering/DrawLines3D_RenderPipeline.h"
 
 #include "tas/common/FrontCar_CameraController.h"
+#include "tas/common/CameraPath.h"
+#include "tas/common/CameraRig.h"
+#include "tas/common/CameraTrack.h"
+#include "tas/common/MotionFilter.h"
+#include "tas/common/MotionFilterHarness.h"
 
 #include "glm/glm.hpp"
 
+#include <memory>
+
 namespace AsphaltTas
 {
     class CameraToolLayer : public CoreEngine::Basic_Layer 
@@ -42,12 +50,43 @@ namespace AsphaltTas
 
         enum class CameraControllerType
         {
-            FREE_CAM, ORBITAL_CAM, FRONT_CAR
+            FREE_CAM, ORBITAL_CAM, FRONT_CAR, CAMERA_PATH, CAMERA_RIG
         };
 
         static inline CameraControllerType s_current_controller_type = CameraControllerType::FREE_CAM;
 
+        // Keyframes are placed with the free cam; playback snapshots the path so editing can't race the writer thread
+        CameraPath m_camera_path;
+        std::shared_ptr<const CameraPath> m_playing_camera_path = nullptr;
+        CoreEngine::Units::Second m_camera_path_start_time {0};
+
+        // Live evaluated against the racer, or baked from a recorded replay for a repeatable shot
+        CameraRigStack m_camera_rig_stack;
+        std::shared_ptr<const CameraTrack> m_baked_camera_track = nullptr;
+        bool m_baked_camera_track_is_playing = false;
+        CoreEngine::Units::Second m_baked_camera_track_start_time {0};
+
+        CoreEngine::DrawLines3D_RenderPipeline m_draw_lines_pipeline;
+
+        // Parameters are kept per filter type so switching back and forth keeps the tuning
+        Basic_MotionFilter::Type     m_motion_filter_type = Basic_MotionFilter::Type::NONE;
+        OneEuro_MotionFilter::Params m_one_euro_params;
+        Spring_MotionFilter::Params  m_spring_params;
+        Kalman_MotionFilter::Params  m_kalman_params;
+        std::vector<MotionSample>    m_captured_motion_samples;
+        std::vector<MotionFilterHarness::Report> m_motion_filter_reports;
+
+        void OnImGuiRender_CameraPath() noexcept;
+        void OnImGuiRender_CameraRigs() noexcept;
+        void OnImGuiRender_MotionFilter() noexcept;
+        [[nodiscard]] std::unique_ptr<Basic_MotionFilter> CreateConfiguredMotionFilter(Basic_MotionFilter::Type type) const;
+
         //Gui options relative to the specific tpype of camera controller
         glm::vec3 m_gui_free_cam_input_position {0};
+        float     m_gui_keyframe_spacing_seconds = 2.0f;
+        bool      m_gui_draw_camera_path = false;
+        int       m_gui_new_rig_type     = 0;
+        float     m_gui_bake_rate_hz     = 120.0f;
+        char      m_gui_motion_sample_file_path[256] = "motion_samples.txt";
     };
 }
\ No newline at end of file
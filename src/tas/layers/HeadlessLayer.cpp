@@ -0,0 +1,386 @@
+#include "tas/layers/HeadlessLayer.h"
+
+#include "core/application/Application.h"
+#include "core/event/ApplicationStateEvents.h"
+#include "core/event/EventDispatcher.h"
+#include "core/utility/Assert.h"
+#include "core/utility/Benchmark.h"
+#include "core/benchmarks/EngineBenchmarks.h"
+
+#include "tas/benchmarks/TasBenchmarks.h"
+
+#include "tas/common/MotionFilter.h"
+#include "tas/common/MotionFilterHarness.h"
+
+#include "tas/globalstate/GameState.h"
+
+#include "tas/memory/MemoryTrace.h"
+
+#include "tas/servicethreads/GameStateWatchdogService.h"
+#include "tas/servicethreads/MemoryAddressUpdateService.h"
+#include "tas/servicethreads/ReadCurrentStateService.h"
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace AsphaltTas
+{
+    //////////////////////////////////////////////////////////
+    // Command line
+    //////////////////////////////////////////////////////////
+    bool HeadlessLayer::CommandLineRequestsHeadless(std::span<char* const> arguments) noexcept
+    {
+        for (const char* argument : arguments)
+        {
+            if (std::strcmp(argument, "--headless") == 0) return true;
+        }
+        return false;
+    }
+
+    std::optional<HeadlessLayer::Job> HeadlessLayer::ParseCommandLine(std::span<char* const> arguments) noexcept
+    {
+        Job job {};
+        bool is_valid = true;
+
+        // Every job flag sets the type & its own file, so a second one would silently replace the first
+        const char* job_flag = nullptr;
+        const auto RequestJob = [&job, &job_flag](Job::Type type, const char* flag) -> bool
+        {
+            if (job_flag != nullptr)
+            {
+                std::cerr << "Only one job per run, " << flag << " conflicts with " << job_flag << '\n';
+                return false;
+            }
+            job_flag   = flag;
+            job.m_type = type;
+            return true;
+        };
+        std::optional<std::string> benchmark_out_path = std::nullopt;
+        // Flags of the services & capture jobs, --benchmark runs neither
+        const char* service_flag = nullptr;
+
+        // arguments[0] is the executable
+        for (size_t i = 1; i < arguments.size() && is_valid; i++)
+        {
+            const char* argument = arguments[i];
+            const bool has_value = i + 1 < arguments.size();
+
+            if (std::strcmp(argument, "--headless") == 0)
+            {
+                continue;
+            }
+            else if (std::strcmp(argument, "--capture-samples") == 0 && has_value)
+            {
+                is_valid        = RequestJob(Job::Type::CAPTURE_MOTION_SAMPLES, argument);
+                job.m_file_path = arguments[++i];
+            }
+            else if (std::strcmp(argument, "--evaluate-filters") == 0 && has_value)
+            {
+                is_valid        = RequestJob(Job::Type::EVALUATE_MOTION_FILTERS, argument);
+                job.m_file_path = arguments[++i];
+            }
+            else if (std::strcmp(argument, "--duration") == 0 && has_value)
+            {
+                service_flag = argument;
+                char* end = nullptr;
+                const double seconds = std::strtod(arguments[++i], &end);
+                is_valid = end != arguments[i] && *end == '\0' && seconds >= 0.0;
+                job.m_duration = CoreEngine::Units::Second(seconds);
+            }
+            else if (std::strcmp(argument, "--benchmark") == 0)
+            {
+                is_valid = RequestJob(Job::Type::RUN_BENCHMARKS, argument);
+            }
+            else if (std::strcmp(argument, "--benchmark-out") == 0 && has_value)
+            {
+                benchmark_out_path = arguments[++i];
+            }
+            else if (std::strcmp(argument, "--benchmark-filter") == 0 && has_value)
+            {
+                job.m_benchmark_filter = arguments[++i];
+            }
+            else if (std::strcmp(argument, "--benchmark-min-time") == 0 && has_value)
+            {
+                char* end = nullptr;
+                const double seconds = std::strtod(arguments[++i], &end);
+                is_valid = end != arguments[i] && *end == '\0' && seconds > 0.0;
+                job.m_benchmark_min_time = CoreEngine::Units::Second(seconds);
+            }
+            else if (std::strcmp(argument, "--record-memory-trace") == 0 && has_value)
+            {
+                service_flag = argument;
+                job.m_memory_trace_record_path = arguments[++i];
+            }
+            else if (std::strcmp(argument, "--replay-memory-trace") == 0 && has_value)
+            {
+                service_flag = argument;
+                job.m_memory_trace_replay_path = arguments[++i];
+            }
+            else if (std::strcmp(argument, "--target") == 0 && has_value)
+            {
+                service_flag = argument;
+                job.m_target_exe_name = arguments[++i];
+            }
+            else if (std::strcmp(argument, "--replay-time-dilation") == 0 && has_value)
+            {
+                service_flag = argument;
+                char* end = nullptr;
+                job.m_memory_trace_time_dilation = std::strtod(arguments[++i], &end);
+                is_valid = end != arguments[i] && *end == '\0' && job.m_memory_trace_time_dilation >= 0.0;
+            }
+            else
+            {
+                is_valid = false;
+            }
+        }
+        is_valid = is_valid && (job.m_memory_trace_record_path.empty() || job.m_memory_trace_replay_path.empty());
+
+        if (is_valid && benchmark_out_path.has_value())
+        {
+            if (job.m_type != Job::Type::RUN_BENCHMARKS)
+            {
+                std::cerr << "--benchmark-out requires --benchmark\n";
+                is_valid = false;
+            }
+            job.m_file_path = std::move(benchmark_out_path.value());
+        }
+
+        if (is_valid && job.m_type == Job::Type::RUN_BENCHMARKS && service_flag != nullptr)
+        {
+            std::cerr << "--benchmark starts no services, " << service_flag << " conflicts with it\n";
+            is_valid = false;
+        }
+
+        if (! is_valid)
+        {
+            std::cerr << "Usage: " << (arguments.empty() ? "AsphaltTas" : arguments[0])
+                      << " --headless [--capture-samples <file> | --evaluate-filters <file>] [--duration <seconds>]\n"
+                      << "                  [--record-memory-trace <file> | --replay-memory-trace <file> [--replay-time-dilation <factor>]]\n"
+                      << "                  [--target <exe>]\n"
+                      << "       " << (arguments.empty() ? "AsphaltTas" : arguments[0])
+                      << " --headless --benchmark [--benchmark-out <file>] [--benchmark-filter <substring>] [--benchmark-min-time <seconds>]\n";
+            return std::nullopt;
+        }
+        return job;
+    }
+
+    //////////////////////////////////////////////////////////
+    // Layer
+    //////////////////////////////////////////////////////////
+    HeadlessLayer::HeadlessLayer(CoreEngine::Window::Handle handle, Job job) noexcept : CoreEngine::Basic_Layer(handle), m_job(std::move(job))
+    {
+        ENGINE_ASSERT(CoreEngine::Application::Get()->GetIsHeadless() && "At HeadlessLayer::HeadlessLayer(): Application has to run headless.");
+    }
+
+    HeadlessLayer::~HeadlessLayer() noexcept
+    {
+        StopServices();
+    }
+
+    void HeadlessLayer::OnEvent(CoreEngine::Basic_Event& e) noexcept
+    {
+        CoreEngine::EventDispatcher dispatcher(e);
+        // Also on Ctrl+C & any other Stop(), so a capture without --duration still gets saved
+        dispatcher.Dispatch<CoreEngine::ApplicationShutdownEvent>([this](CoreEngine::ApplicationShutdownEvent&) -> bool {
+            SaveResults();
+            StopServices();
+            return false;
+        });
+    }
+
+    void HeadlessLayer::OnUpdate(CoreEngine::Units::MicroSecond dt) noexcept
+    {
+        if (! m_has_started)
+        {
+            m_has_started = true;
+            OnStart();
+            return;
+        }
+
+        m_elapsed_time += CoreEngine::Units::Convert<CoreEngine::Units::Second>(dt);
+        if (m_job.m_duration > CoreEngine::Units::Second(0.0) && m_elapsed_time >= m_job.m_duration)
+        {
+            OnFinish();
+        }
+
+        // The capture is capped, a run without a duration ends once it is full instead of dropping ticks
+        if (m_job.m_type == Job::Type::CAPTURE_MOTION_SAMPLES && ReadCurrentStateService::GetAmountDroppedCapturedSamples() > 0)
+        {
+            OnFinish();
+        }
+    }
+
+    int HeadlessLayer::GetExitCode() noexcept
+    {
+        return s_exit_code;
+    }
+
+    //////////////////////////////////////////////////////////
+    // Private
+    //////////////////////////////////////////////////////////
+    void HeadlessLayer::OnStart() noexcept
+    {
+        if (m_job.m_type == Job::Type::EVALUATE_MOTION_FILTERS)
+        {
+            EvaluateMotionFilters();
+            CoreEngine::Application::Get()->Stop();
+            return;
+        }
+
+        if (m_job.m_type == Job::Type::RUN_BENCHMARKS)
+        {
+            RunBenchmarks();
+            CoreEngine::Application::Get()->Stop();
+            return;
+        }
+
+        if (! m_job.m_target_exe_name.empty())
+        {
+            GameState::SetExeNameOverride(m_job.m_target_exe_name);
+            std::cout << "Attaching to " << m_job.m_target_exe_name << " instead of the game" << std::endl;
+        }
+
+        if (! m_job.m_memory_trace_replay_path.empty())
+        {
+            MemoryTrace::ReplayConfig config {};
+            config.m_time_dilation = m_job.m_memory_trace_time_dilation;
+            if (! MemoryTrace::StartReplay(m_job.m_memory_trace_replay_path, config))
+            {
+                std::cerr << "Failed to replay the memory trace " << m_job.m_memory_trace_replay_path << std::endl;
+                s_exit_code = 1;
+                CoreEngine::Application::Get()->Stop();
+                return;
+            }
+            std::cout << "Replaying the memory trace " << m_job.m_memory_trace_replay_path << std::endl;
+        }
+        else
+        {
+            if (! m_job.m_memory_trace_record_path.empty())
+            {
+                if (! MemoryTrace::StartRecording(m_job.m_memory_trace_record_path))
+                {
+                    std::cerr << "Failed to record the memory trace " << m_job.m_memory_trace_record_path << std::endl;
+                    s_exit_code = 1;
+                    CoreEngine::Application::Get()->Stop();
+                    return;
+                }
+                std::cout << "Recording the memory trace " << m_job.m_memory_trace_record_path << std::endl;
+            }
+            GameStateWatchdogService::LaunchThread();
+        }
+        MemoryAddressUpdateService::LaunchThread();
+        ReadCurrentStateService::LaunchThread();
+
+        if (m_job.m_type == Job::Type::CAPTURE_MOTION_SAMPLES)
+        {
+            ReadCurrentStateService::StartSampleCapture();
+            std::cout << "Capturing racer samples to " << m_job.m_file_path << std::endl;
+        }
+    }
+
+    void HeadlessLayer::OnFinish() noexcept
+    {
+        CoreEngine::Application::Get()->Stop(); // Saves the results on the ApplicationShutdownEvent
+    }
+
+    void HeadlessLayer::SaveResults() noexcept
+    {
+        if (m_has_saved_results) return;
+        m_has_saved_results = true;
+
+        if (m_job.m_type == Job::Type::CAPTURE_MOTION_SAMPLES && ReadCurrentStateService::GetSampleCaptureIsRunning())
+        {
+            ReadCurrentStateService::StopSampleCapture();
+            const std::vector<MotionSample> samples = ReadCurrentStateService::GetCapturedSamples();
+            if (ReadCurrentStateService::GetAmountDroppedCapturedSamples() > 0)
+            {
+                std::cout << "Reached the limit of " << ReadCurrentStateService::MAX_CAPTURED_SAMPLES << " samples, later ticks were not captured" << std::endl;
+            }
+            if (MotionFilterHarness::SaveSamples(m_job.m_file_path, samples))
+            {
+                std::cout << "Saved " << samples.size() << " samples to " << m_job.m_file_path << std::endl;
+            }
+            else
+            {
+                std::cerr << "Failed to save samples to " << m_job.m_file_path << std::endl;
+                s_exit_code = 1;
+            }
+        }
+        PrintMemoryTraceStatistics();
+    }
+
+    void HeadlessLayer::EvaluateMotionFilters() noexcept
+    {
+        std::vector<MotionSample> samples;
+        if (! MotionFilterHarness::LoadSamples(m_job.m_file_path, samples))
+        {
+            std::cerr << "Failed to load samples from " << m_job.m_file_path << std::endl;
+            s_exit_code = 1;
+            return;
+        }
+
+        using Type = Basic_MotionFilter::Type;
+        for (const Type type : { Type::NONE, Type::ONE_EURO, Type::SPRING, Type::KALMAN })
+        {
+            const MotionFilterHarness::Report report = MotionFilterHarness::Evaluate(*CreateMotionFilter(type), samples);
+            std::cout << Basic_MotionFilter::TypeToString(report.m_filter_type) << " (" << report.m_amount_samples << " samples)"
+                      << ": position lag " << report.m_position_lag_ms << " ms, jitter " << report.m_position_jitter_mm << " mm, bias " << report.m_position_bias_mm << " mm"
+                      << " | rotation lag " << report.m_rotation_lag_ms << " ms, jitter " << report.m_rotation_jitter_degrees << " deg, bias " << report.m_rotation_bias_degrees << " deg\n";
+        }
+        std::cout.flush();
+    }
+
+    void HeadlessLayer::RunBenchmarks() noexcept
+    {
+        CoreEngine::Benchmark::ClearRegistered();
+        CoreEngine::RegisterEngineBenchmarks();
+        RegisterTasBenchmarks();
+
+        CoreEngine::Benchmark::RunConfig config {};
+        config.m_filter   = m_job.m_benchmark_filter;
+        config.m_min_time = m_job.m_benchmark_min_time;
+
+        const std::vector<CoreEngine::Benchmark::Result> results = CoreEngine::Benchmark::RunAll(config);
+        CoreEngine::Benchmark::PrintResults(results, std::cout);
+
+        if (! m_job.m_file_path.empty())
+        {
+            if (CoreEngine::Benchmark::WriteResultsToJsonFile(m_job.m_file_path, results))
+            {
+                std::cout << "Saved " << results.size() << " results to " << m_job.m_file_path << std::endl;
+            }
+            else
+            {
+                std::cerr << "Failed to save results to " << m_job.m_file_path << std::endl;
+                s_exit_code = 1;
+            }
+        }
+    }
+
+    void HeadlessLayer::StopServices() noexcept
+    {
+        if (ReadCurrentStateService::GetSampleCaptureIsRunning())
+        {
+            ReadCurrentStateService::StopSampleCapture();
+        }
+        ReadCurrentStateService::StopThread();
+        MemoryAddressUpdateService::StopThread();
+        GameStateWatchdogService::StopThread();
+        MemoryTrace::Stop();
+    }
+
+    void HeadlessLayer::PrintMemoryTraceStatistics() const noexcept
+    {
+        if (MemoryTrace::GetMode() == MemoryTrace::Mode::OFF) return;
+
+        const MemoryTrace::Statistics statistics = MemoryTrace::GetStatistics();
+        std::cout << "Memory trace: " << statistics.m_amount_records << " records, " << statistics.m_amount_bytes << " bytes, "
+                  << statistics.m_duration.Get() << " s";
+        if (MemoryTrace::GetMode() == MemoryTrace::Mode::REPLAYING)
+        {
+            std::cout << ", " << statistics.m_amount_served << " calls served, " << statistics.m_amount_misses << " missed";
+        }
+        std::cout << std::endl;
+    }
+}
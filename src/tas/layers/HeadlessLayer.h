@@ -0,0 +1,78 @@
+#pragma once
+
+#include "core/layer/Layer.h"
+#include "core/utility/Units.h"
+
+#include <optional>
+#include <span>
+#include <string>
+
+namespace AsphaltTas
+{
+    // Runs a batch job without any window, see CoreEngine::Application::PushHeadlessLayer()
+    class HeadlessLayer : public CoreEngine::Basic_Layer
+    {
+    public:
+        struct Job
+        {
+            enum class Type
+            {
+                RUN_SERVICES,            // Service threads only, e.g. to keep addresses & state up to date for other tools
+                CAPTURE_MOTION_SAMPLES,  // Racer samples -> m_file_path, for the motion filter harness
+                EVALUATE_MOTION_FILTERS, // Samples from m_file_path through every motion filter, report to stdout
+                RUN_BENCHMARKS           // Engine & tool microbenchmarks, report to stdout and optionally JSON to m_file_path
+            };
+
+            Type                      m_type     = Type::RUN_SERVICES;
+            std::string               m_file_path;
+            CoreEngine::Units::Second m_duration {0.0}; // 0 = until the application is stopped, e.g. by Ctrl+C
+
+            std::string               m_benchmark_filter;         // Substring of the benchmark name, empty = all
+            CoreEngine::Units::Second m_benchmark_min_time {0.5}; // Per repetition
+
+            // Services & capture only, see MemoryTrace
+            std::string               m_memory_trace_record_path;
+            std::string               m_memory_trace_replay_path; // Replaces the game, the watchdog is not started
+            double                    m_memory_trace_time_dilation = 0.0; // 0 = unpaced
+
+            // Services & capture only, e.g. the stand-in (StandIn::EXE_NAME), see GameState::SetExeNameOverride()
+            std::string               m_target_exe_name; // Empty = the game
+        };
+
+        // Usage: --headless [--capture-samples <file> | --evaluate-filters <file>] [--duration <seconds>]
+        //                   [--record-memory-trace <file> | --replay-memory-trace <file> [--replay-time-dilation <factor>]]
+        //                   [--target <exe>]
+        //        --headless --benchmark [--benchmark-out <file>] [--benchmark-filter <substring>] [--benchmark-min-time <seconds>]
+        [[nodiscard]] static bool CommandLineRequestsHeadless(std::span<char* const> arguments) noexcept;
+        // Prints the usage and returns nullopt on malformed arguments
+        [[nodiscard]] static std::optional<Job> ParseCommandLine(std::span<char* const> arguments) noexcept;
+
+        explicit HeadlessLayer(CoreEngine::Window::Handle handle, Job job) noexcept;
+        virtual ~HeadlessLayer() noexcept;
+
+        virtual void OnEvent(CoreEngine::Basic_Event& e) noexcept override;
+        virtual void OnUpdate(CoreEngine::Units::MicroSecond dt) noexcept override;
+        virtual void OnRender() noexcept override {}
+        virtual void OnImGuiRender() noexcept override {}
+
+        // 0 = job succeeded
+        [[nodiscard]] static int GetExitCode() noexcept;
+
+    private:
+        void OnStart() noexcept;
+        void OnFinish() noexcept;
+        // Once, at the end of the duration or on any other shutdown
+        void SaveResults() noexcept;
+        void EvaluateMotionFilters() noexcept;
+        void RunBenchmarks() noexcept;
+        void StopServices() noexcept;
+        void PrintMemoryTraceStatistics() const noexcept;
+
+        Job                       m_job;
+        bool                      m_has_started       = false;
+        bool                      m_has_saved_results = false;
+        CoreEngine::Units::Second m_elapsed_time {0.0};
+
+        static inline int s_exit_code = 0;
+    };
+}
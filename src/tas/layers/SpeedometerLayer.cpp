@@ -5,6 +5,7 @@
 #include "core/event/InputEvents.h"
 #include "core/event/EventDispatcher.h"
 #include "core/event/WindowEvents.h"
+#include "core/utility/Timer.h"
 
 #include "tas/layers/GuiStyle.h"
 
@@ -81,6 +82,7 @@ namespace AsphaltTas
             ImGui::SetWindowFontScale(m_font_size);
 
             std::optional<RacerState> state_now = ReadCurrentStateService::GetCurrentRacerState();
+            m_drawn_racer_tick_timestamp = ReadCurrentStateService::GetLatestRacerTickTimestamp();
 
             if (state_now.has_value())
             {
@@ -122,6 +124,32 @@ namespace AsphaltTas
 
     }
 
+    CoreEngine::Units::MicroSecond SpeedometerLayer::GetTimeUntilNextRedraw() const noexcept
+    {
+        constexpr CoreEngine::Units::MicroSecond NO_RACER_REFRESH   (250'000L);
+        constexpr CoreEngine::Units::MicroSecond EXPECTED_TICK_TIME (16'667L);
+        constexpr CoreEngine::Units::MicroSecond MIN_POLL_TIME      (1'000L);
+        constexpr CoreEngine::Units::MicroSecond OVERDUE_POLL_TIME  (8'000L);
+
+        const std::optional<CoreEngine::Units::Second> latest_tick = ReadCurrentStateService::GetLatestRacerTickTimestamp();
+        if (! latest_tick.has_value())
+        {
+            return m_drawn_racer_tick_timestamp.has_value() ? CoreEngine::Units::MicroSecond(0) : NO_RACER_REFRESH;
+        }
+        if (latest_tick != m_drawn_racer_tick_timestamp)
+        {
+            return CoreEngine::Units::MicroSecond(0);
+        }
+
+        // Wake up around the next expected tick; a paused game would otherwise have us poll at 1ms
+        const CoreEngine::Units::MicroSecond since_tick = CoreEngine::Units::Convert<CoreEngine::Units::MicroSecond>(CoreEngine::Timer::GetTimeSinceEpoch<CoreEngine::Units::Second>() - latest_tick.value());
+        if (since_tick > EXPECTED_TICK_TIME)
+        {
+            return OVERDUE_POLL_TIME;
+        }
+        return std::max(EXPECTED_TICK_TIME - since_tick, MIN_POLL_TIME);
+    }
+
     void SpeedometerLayer::CreateInstance() noexcept
     {
         ENGINE_ASSERT( ! s_instance && "There should only ever be one SpeedometerLayer active at one time.");
@@ -2,6 +2,8 @@
 
 #include "core/layer/Layer.h"
 
+#include <optional>
+
 namespace AsphaltTas
 {
     class SpeedometerLayer : public CoreEngine::Basic_Layer
@@ -14,6 +16,7 @@ namespace AsphaltTas
         virtual void OnUpdate(CoreEngine::Units::MicroSecond dt) noexcept override;
         virtual void OnRender() noexcept override;
         virtual void OnImGuiRender() noexcept override;
+        [[nodiscard]] virtual CoreEngine::Units::MicroSecond GetTimeUntilNextRedraw() const noexcept override;
 
         static void CreateInstance() noexcept;
         [[nodiscard]] static bool InstanceExists() noexcept;
@@ -27,5 +30,8 @@ namespace AsphaltTas
         float m_font_size = 5.0f;
         bool m_is_locked  = false;
         bool m_left_mouse_pressed_after_unlock_disable_gui_input = false;
+
+        // Redraws follow the game ticks, nothing changes in between
+        std::optional<CoreEngine::Units::Second> m_drawn_racer_tick_timestamp = std::nullopt;
     };
 }
\ No newline at end of file
@@ -6,12 +6,16 @@
 #include "core/event/EventDispatcher.h"
 #include "core/utility/Assert.h"
 #include "core/utility/Performance.h"
+#include "core/utility/AllocationTracker.h"
+#include "core/utility/FrameArena.h"
+#include "core/rendering/GpuProfiler.h"
 #include "core/scene/DummyCameraController.h"
 #include "core/scene/FreeCam_CameraController.h"
 #include "core/application/Application.h"
 
 #include "tas/memory/MemoryUtility.h"
 #include "tas/memory/MemoryRW.h"
+#include "tas/memory/MemoryTrace.h"
 
 #include "tas/globalstate/MemoryAddressState.h"
 #include "tas/globalstate/GameState.h"
@@ -24,6 +28,7 @@
 #include "tas/servicethreads/MemoryAddressUpdateService.h"
 #include "tas/servicethreads/MouseInputService.h"
 #include "tas/servicethreads/ReplayRecorderService.h"
+#include "tas/servicethreads/CameraWriterService.h"
 
 #include "tas/layers/GuiStyle.h"
 #include "tas/layers/CameraToolLayer.h"
@@ -71,7 +76,19 @@ namespace AsphaltTas
 
     void TasLayer::OnUpdate(CoreEngine::Units::MicroSecond dt) noexcept
     {
+    #ifdef _WIN32
+        // Low bit = pressed since the last call, so short presses between the (slow) updates still count; works with the game focussed
+        if (GetAsyncKeyState(VK_F9) & 0x0001)
+        {
+            ToggleTrace();
+        }
+    #endif
+    }
 
+    CoreEngine::Units::MicroSecond TasLayer::GetTimeUntilNextRedraw() const noexcept
+    {
+        constexpr CoreEngine::Units::MicroSecond REFRESH_INTERVAL (250'000L);
+        return std::max(REFRESH_INTERVAL - m_gui_refresh_timer.GetElapsed<CoreEngine::Units::MicroSecond>(), CoreEngine::Units::MicroSecond(0));
     }
 
     void TasLayer::OnRender() noexcept
@@ -81,6 +98,8 @@ namespace AsphaltTas
 
     void TasLayer::OnImGuiRender() noexcept
     {   
+        m_gui_refresh_timer.Restart();
+
         ImVec2 display = ImGui::GetIO().DisplaySize;
 
         ImGui::SetNextWindowPos(ImVec2(0, 0));
@@ -169,6 +188,12 @@ namespace AsphaltTas
                     }
                 }
 
+                if (const std::string exe_name_override = GameState::GetExeNameOverride(); ! exe_name_override.empty())
+                {
+                    PUSH_SCOPED_STYLE_COLOR(ImGuiCol_Text, GuiStyle::COLOR_ORANGE);
+                    ImGui::Text("Target: %s", exe_name_override.c_str());
+                }
+
                 ImGui::TextUnformatted("Camera:");
                 PUSH_SCOPED_STYLE_COLOR(ImGuiCol_Text, CameraStateAddresses::AddressesAreValid() ? GuiStyle::COLOR_GREEN : GuiStyle::COLOR_RED);
                 ImGui::TextUnformatted(CameraStateAddresses::ToString().c_str());
@@ -177,15 +202,36 @@ namespace AsphaltTas
                 PUSH_SCOPED_STYLE_COLOR(ImGuiCol_Text, RacerStateAddresses::AddressesAreValid() ? GuiStyle::COLOR_GREEN : GuiStyle::COLOR_RED);
                 ImGui::TextUnformatted(RacerStateAddresses::ToString().c_str());
             }
+
+            if (ImGui::CollapsingHeader("Memory Trace"))
+            {
+                OnImGuiRenderMemoryTrace();
+            }
             
             if (ImGui::CollapsingHeader("Tool Performance", ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_Leaf))
             {
-                ImGui::Text("Tool FPS: %.0f", ImGui::GetIO().Framerate);
+                CoreEngine::Application* application = CoreEngine::Application::Get();
+                const CoreEngine::Application::FramePacingStatistics pacing = application->GetFramePacingStatistics();
+                ImGui::Text("Tool FPS: %.0f (Loops/s: %.0f, Idle: %.1f%%)", pacing.m_frames_per_second, pacing.m_loop_iterations_per_second, pacing.m_idle_cpu_percentage);
 
-                bool vsync_is_on = CoreEngine::Application::Get()->GetVsyncIsOn();
+                bool vsync_is_on = application->GetVsyncIsOn();
                 if (ImGui::Checkbox("VSync", &vsync_is_on))
                 {
-                    CoreEngine::Application::Get()->SetVsync(vsync_is_on);
+                    application->SetVsync(vsync_is_on);
+                }
+
+                ImGui::SameLine();
+                bool idle_pacing_is_on = application->GetIdleFramePacingIsOn();
+                if (ImGui::Checkbox("Idle Frame Pacing", &idle_pacing_is_on))
+                {
+                    application->SetIdleFramePacing(idle_pacing_is_on);
+                }
+
+                CoreEngine::Window* window = application->GetWindowPtr(m_handle);
+                float max_fps = window->GetMaxFramesPerSecond();
+                if (ImGui::SliderFloat("Window Max FPS", &max_fps, 0.0f, 240.0f, max_fps > 0.0f ? "%.0f" : "Uncapped"))
+                {
+                    window->SetMaxFramesPerSecond(max_fps);
                 }
 
                 if (ImGui::CollapsingHeader("Thread Status", ImGuiTreeNodeFlags_DefaultOpen ))
@@ -203,14 +249,117 @@ namespace AsphaltTas
                     LogThreadStatus("Mouse Input Service   : ", MouseInputService::GetThreadIsRunning());
                     LogThreadStatus("Read Current State    : ", ReadCurrentStateService::GetThreadIsRunning());
                     LogThreadStatus("Replay Recorder       : ", ReplayRecorderService::GetThreadIsRunning());
+                    LogThreadStatus("Camera Writer         : ", CameraWriterService::GetThreadIsRunning());
                 }
 
                 if (ImGui::CollapsingHeader("Frame Times", ImGuiTreeNodeFlags_DefaultOpen ))
                 {
-                    const std::vector<CoreEngine::PerFrameScopeTimes::ScopeTimeData>& scope_times = CoreEngine::PerFrameScopeTimes::GetScopeTimeDataConstRef();
-                    for (const CoreEngine::PerFrameScopeTimes::ScopeTimeData& data : scope_times)
+                    bool profiler_is_enabled = CoreEngine::ScopeProfiler::GetIsEnabled();
+                    if (ImGui::Checkbox("Profile Scopes", &profiler_is_enabled))
+                    {
+                        CoreEngine::ScopeProfiler::SetEnabled(profiler_is_enabled);
+                    }
+                    ImGui::SameLine();
+                    if (ImGui::Button("Reset"))
+                    {
+                        CoreEngine::ScopeProfiler::ResetStatistics();
+                    }
+                    if (const uint64_t dropped = CoreEngine::ScopeProfiler::GetAmountDroppedEvents(); dropped > 0)
                     {
-                        ImGui::TextUnformatted(data.ToString().c_str());
+                        ImGui::SameLine();
+                        PUSH_SCOPED_STYLE_COLOR(ImGuiCol_Text, GuiStyle::COLOR_RED);
+                        ImGui::Text("Dropped: %llu", static_cast<unsigned long long>(dropped));
+                    }
+
+                    // GPU scopes show up in the table below, a few frames late; per window totals decide whether it is GPU bound
+                    for (const CoreEngine::GpuProfiler::ContextStatistics& context : CoreEngine::GpuProfiler::GetContextStatistics())
+                    {
+                        const std::string tag_name = CoreEngine::ScopeProfiler::GetTagName(context.m_tag);
+                        if (! context.m_is_available)
+                        {
+                            PUSH_SCOPED_STYLE_COLOR(ImGuiCol_Text, GuiStyle::COLOR_RED);
+                            ImGui::Text("GPU @ %s: no timer queries", tag_name.c_str());
+                            continue;
+                        }
+                        ImGui::Text("GPU @ %s: %.1f µs/frame, %zu queries (%zu pending)", tag_name.c_str(), context.m_last_readback_us, context.m_amount_queries, context.m_amount_pending);
+                        if (context.m_skipped_scopes > 0)
+                        {
+                            ImGui::SameLine();
+                            PUSH_SCOPED_STYLE_COLOR(ImGuiCol_Text, GuiStyle::COLOR_RED);
+                            ImGui::Text("Skipped: %llu", static_cast<unsigned long long>(context.m_skipped_scopes));
+                        }
+                    }
+
+                    if (ImGui::BeginTable("##scope_times", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit))
+                    {
+                        ImGui::TableSetupColumn("Scope");
+                        ImGui::TableSetupColumn("Calls");
+                        ImGui::TableSetupColumn("Frame µs");
+                        ImGui::TableSetupColumn("Call µs min/avg/max");
+                        ImGui::TableSetupColumn("History");
+                        ImGui::TableHeadersRow();
+
+                        for (const CoreEngine::ScopeProfiler::ScopeStatistics& statistics : CoreEngine::ScopeProfiler::GetStatisticsConstRef())
+                        {
+                            const std::string tag_name = CoreEngine::ScopeProfiler::GetTagName(statistics.m_tag);
+
+                            ImGui::TableNextRow();
+                            ImGui::TableNextColumn();
+                            if (statistics.m_kind == CoreEngine::ScopeProfiler::EventKind::GPU)
+                            {
+                                {
+                                    PUSH_SCOPED_STYLE_COLOR(ImGuiCol_Text, GuiStyle::COLOR_ORANGE);
+                                    ImGui::TextUnformatted("GPU");
+                                }
+                                ImGui::SameLine();
+                            }
+                            ImGui::TextUnformatted(CoreEngine::ScopeProfiler::GetScopeName(statistics.m_scope_id));
+                            if (! tag_name.empty())
+                            {
+                                ImGui::SameLine();
+                                ImGui::TextDisabled("%s", tag_name.c_str());
+                            }
+                            ImGui::TableNextColumn(); ImGui::Text("%u", statistics.m_calls);
+                            ImGui::TableNextColumn(); ImGui::Text("%.1f", statistics.m_total_us);
+                            ImGui::TableNextColumn(); ImGui::Text("%.1f / %.1f / %.1f", statistics.m_min_call_us, statistics.m_average_call_us, statistics.m_max_call_us);
+                            ImGui::TableNextColumn();
+                            ImGui::PushID(&statistics);
+                            ImGui::PlotLines("##history", statistics.m_history_total_us.data(), static_cast<int>(statistics.m_history_total_us.size()),
+                                static_cast<int>(statistics.m_history_head), nullptr, 0.0f, statistics.m_history_max_us, ImVec2(120.0f, 20.0f));
+                            if (ImGui::IsItemHovered())
+                            {
+                                ImGui::SetTooltip("Frame totals, last %zu frames\nmin %.1f / avg %.1f / max %.1f µs",
+                                    CoreEngine::ScopeProfiler::HISTORY_FRAMES, statistics.m_history_min_us, statistics.m_history_avg_us, statistics.m_history_max_us);
+                            }
+                            ImGui::PopID();
+                        }
+                        ImGui::EndTable();
+                    }
+                }
+
+                if (ImGui::CollapsingHeader("Allocations"))
+                {
+                    OnImGuiRenderAllocations();
+                }
+
+                if (ImGui::CollapsingHeader("Trace", ImGuiTreeNodeFlags_DefaultOpen ))
+                {
+                    const bool is_tracing = CoreEngine::ScopeProfiler::GetIsTracing();
+                    const bool is_unsaved = CoreEngine::ScopeProfiler::GetHasUnsavedTrace();
+                    ImGui::BeginDisabled(is_tracing);
+                    ImGui::InputText("File", m_gui_trace_file_path, sizeof(m_gui_trace_file_path));
+                    ImGui::EndDisabled();
+
+                    const char* button_label = is_tracing ? "Stop & Save Trace (F9)" : is_unsaved ? "Save Full Trace (F9)" : "Start Trace (F9)";
+                    if (ImGui::Button(button_label))
+                    {
+                        ToggleTrace();
+                    }
+                    ImGui::SameLine();
+                    ImGui::Text("Events: %zu / %zu", CoreEngine::ScopeProfiler::GetAmountTraceEvents(), CoreEngine::ScopeProfiler::MAX_TRACE_EVENTS);
+                    if (! m_trace_status.empty())
+                    {
+                        ImGui::TextDisabled("%s", m_trace_status.c_str());
                     }
                 }
             }
@@ -219,6 +368,155 @@ namespace AsphaltTas
         ImGui::End();
     }
 
+    void TasLayer::OnImGuiRenderMemoryTrace() noexcept
+    {
+        const MemoryTrace::Mode mode = MemoryTrace::GetMode();
+
+        ImGui::BeginDisabled(mode != MemoryTrace::Mode::OFF);
+        ImGui::InputText("Trace File", m_gui_memory_trace_file_path, sizeof(m_gui_memory_trace_file_path));
+        ImGui::SliderFloat("Time Dilation", &m_gui_memory_trace_time_dilation, 0.0f, 4.0f, m_gui_memory_trace_time_dilation > 0.0f ? "%.2fx" : "Unpaced");
+        ImGui::EndDisabled();
+
+        if (mode == MemoryTrace::Mode::OFF)
+        {
+            ImGui::BeginDisabled(GameState::GetHasValidCurrentPlatform());
+            if (ImGui::Button("Record"))
+            {
+                m_memory_trace_status = MemoryTrace::StartRecording(m_gui_memory_trace_file_path) ? "" : "Failed to start recording.";
+            }
+            ImGui::EndDisabled();
+            if (GameState::GetHasValidCurrentPlatform() && ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+            {
+                ImGui::SetTooltip("Recording has to start before the game is launched.");
+            }
+
+            ImGui::SameLine();
+            if (ImGui::Button("Replay"))
+            {
+                MemoryTrace::ReplayConfig config {};
+                config.m_time_dilation = static_cast<double>(m_gui_memory_trace_time_dilation);
+                m_memory_trace_status = MemoryTrace::StartReplay(m_gui_memory_trace_file_path, config) ? "" : "Failed to load the trace.";
+            }
+        }
+        else
+        {
+            PUSH_SCOPED_STYLE_COLOR(ImGuiCol_Text, mode == MemoryTrace::Mode::RECORDING ? GuiStyle::COLOR_RED : GuiStyle::COLOR_GREEN);
+            if (ImGui::Button(mode == MemoryTrace::Mode::RECORDING ? "Stop Recording" : "Stop Replay"))
+            {
+                MemoryTrace::Stop();
+            }
+        }
+
+        const MemoryTrace::Statistics statistics = MemoryTrace::GetStatistics();
+        if (mode != MemoryTrace::Mode::OFF)
+        {
+            ImGui::Text("%llu records, %.1f KiB, %.1f s", static_cast<unsigned long long>(statistics.m_amount_records),
+                static_cast<double>(statistics.m_amount_bytes) / 1024.0, statistics.m_duration.Get());
+        }
+        if (mode == MemoryTrace::Mode::REPLAYING)
+        {
+            PUSH_SCOPED_STYLE_COLOR(ImGuiCol_Text, statistics.m_amount_misses > 0 ? GuiStyle::COLOR_ORANGE : GuiStyle::COLOR_GREEN);
+            ImGui::Text("Served %llu calls, %llu missed", static_cast<unsigned long long>(statistics.m_amount_served), static_cast<unsigned long long>(statistics.m_amount_misses));
+        }
+        if (! m_memory_trace_status.empty())
+        {
+            ImGui::TextDisabled("%s", m_memory_trace_status.c_str());
+        }
+    }
+
+    void TasLayer::OnImGuiRenderAllocations() noexcept
+    {
+        using CoreEngine::AllocationTracker;
+        const CoreEngine::FrameArena& frame_arena = CoreEngine::FrameArena::GetThreadLocal();
+        ImGui::Text("Frame arena: peak %.1f / %.1f KiB", static_cast<double>(frame_arena.GetPeakBytesUsed()) / 1024.0, static_cast<double>(frame_arena.GetCapacity()) / 1024.0);
+
+        if constexpr (! AllocationTracker::GetIsAvailable())
+        {
+            ImGui::TextDisabled("Build with ENGINE_ENABLE_ALLOCATION_TRACKING to count allocations.");
+            return;
+        }
+
+        bool tracking_is_enabled = AllocationTracker::GetIsEnabled();
+        if (ImGui::Checkbox("Track Allocations", &tracking_is_enabled))
+        {
+            AllocationTracker::SetEnabled(tracking_is_enabled);
+        }
+        ImGui::SameLine();
+        int budget = static_cast<int>(AllocationTracker::GetFrameBudget());
+        ImGui::SetNextItemWidth(100.0f);
+        if (ImGui::InputInt("Frame Budget", &budget))
+        {
+            AllocationTracker::SetFrameBudget(static_cast<uint64_t>(std::max(budget, 0)));
+        }
+
+        const AllocationTracker::FrameStatistics& frame = AllocationTracker::GetLastFrameConstRef();
+        ImGui::Text("Last frame: %llu allocations (%.1f KiB), %llu frees", static_cast<unsigned long long>(frame.m_allocations),
+            static_cast<double>(frame.m_bytes) / 1024.0, static_cast<unsigned long long>(frame.m_deallocations));
+        if (frame.m_frames_over_budget > 0)
+        {
+            PUSH_SCOPED_STYLE_COLOR(ImGuiCol_Text, AllocationTracker::GetLastFrameIsOverBudget() ? GuiStyle::COLOR_RED : GuiStyle::COLOR_ORANGE);
+            ImGui::Text("Over budget in %u of the last %zu frames", frame.m_frames_over_budget, AllocationTracker::HISTORY_FRAMES);
+        }
+        ImGui::PlotHistogram("##allocation_history", frame.m_history_allocations.data(), static_cast<int>(frame.m_history_allocations.size()),
+            static_cast<int>(frame.m_history_head), "Allocations / Frame", 0.0f, std::max(frame.m_history_max, 1.0f), ImVec2(0.0f, 40.0f));
+
+        if (ImGui::BeginTable("##allocation_size_classes", 2, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit))
+        {
+            ImGui::TableSetupColumn("Size");
+            ImGui::TableSetupColumn("Allocations");
+            ImGui::TableHeadersRow();
+            for (size_t size_class = 0; size_class < AllocationTracker::AMOUNT_SIZE_CLASSES; size_class++)
+            {
+                if (frame.m_size_classes[size_class] == 0) continue;
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                if (size_class + 1 < AllocationTracker::AMOUNT_SIZE_CLASSES)
+                    ImGui::Text("<= %zu B", AllocationTracker::GetSizeClassLimit(size_class));
+                else
+                    ImGui::Text("> %zu B", AllocationTracker::GetSizeClassLimit(size_class - 1));
+                ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(frame.m_size_classes[size_class]));
+            }
+            ImGui::EndTable();
+        }
+
+        if (ImGui::BeginTable("##allocation_scopes", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit))
+        {
+            ImGui::TableSetupColumn("Scope");
+            ImGui::TableSetupColumn("Allocations");
+            ImGui::TableSetupColumn("KiB");
+            ImGui::TableHeadersRow();
+            for (const AllocationTracker::ScopeAllocations& scope : frame.m_scopes)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                if (scope.m_scope_id == CoreEngine::ScopeProfiler::NO_SCOPE)
+                    ImGui::TextDisabled("Outside of any scope");
+                else
+                    ImGui::TextUnformatted(CoreEngine::ScopeProfiler::GetScopeName(scope.m_scope_id));
+                ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(scope.m_allocations));
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", static_cast<double>(scope.m_bytes) / 1024.0);
+            }
+            ImGui::EndTable();
+        }
+    }
+
+    void TasLayer::ToggleTrace() noexcept
+    {
+        // A trace that stopped by itself once full is saved first, not overwritten by a new one
+        if (! CoreEngine::ScopeProfiler::GetIsTracing() && ! CoreEngine::ScopeProfiler::GetHasUnsavedTrace())
+        {
+            CoreEngine::ScopeProfiler::StartTrace();
+            m_trace_status = "Tracing...";
+            return;
+        }
+
+        CoreEngine::ScopeProfiler::StopTrace();
+        CoreEngine::ScopeProfiler::FlushThreadBuffers(); // Pick up what the threads recorded since the last drain
+        m_trace_status = CoreEngine::ScopeProfiler::WriteTraceToFile(m_gui_trace_file_path)
+                       ? std::string("Saved to ") + m_gui_trace_file_path + " (open in ui.perfetto.dev or chrome://tracing)"
+                       : std::string("Failed to write ") + m_gui_trace_file_path;
+    }
+
     void TasLayer::OnRenderGhostExperimental() noexcept
     {
         static CoreEngine::CameraReverseZ s_pseudo_game_camera (glm::vec3(0.0f), CoreEngine::Application::Get()->GetWindowPtr(m_handle)->GetAspectRatio(), 55.0f, 0.1f);
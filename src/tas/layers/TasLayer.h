@@ -9,6 +9,8 @@
 
 #include "imgui/imgui.h"
 
+#include <string>
+
 namespace AsphaltTas
 {
     class TasLayer : public CoreEngine::Basic_Layer
@@ -21,8 +23,22 @@ namespace AsphaltTas
         virtual void OnUpdate(CoreEngine::Units::MicroSecond dt) noexcept override;
         virtual void OnRender() noexcept override;
         virtual void OnImGuiRender() noexcept override;
+        [[nodiscard]] virtual CoreEngine::Units::MicroSecond GetTimeUntilNextRedraw() const noexcept override;
 
     private:
         void OnRenderGhostExperimental() noexcept;
+        void OnImGuiRenderAllocations() noexcept;
+        void OnImGuiRenderMemoryTrace() noexcept;
+        void ToggleTrace() noexcept;
+
+        // Everything shown is status text, a few refreshes per second are plenty
+        CoreEngine::Timer m_gui_refresh_timer {};
+
+        char        m_gui_trace_file_path[256] = "trace.json";
+        std::string m_trace_status;
+
+        char        m_gui_memory_trace_file_path[256] = "session.memtrace";
+        float       m_gui_memory_trace_time_dilation  = 1.0f;
+        std::string m_memory_trace_status;
     };
 }
\ No newline at end of file
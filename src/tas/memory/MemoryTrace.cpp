@@ -0,0 +1,699 @@
+#include "tas/memory/MemoryTrace.h"
+
+#include "tas/globalstate/GameState.h"
+
+#include "libmem/libmem.h"
+
+#include "core/utility/Assert.h"
+#include "core/utility/Timer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace AsphaltTas::MemoryTrace
+{
+namespace
+{
+//////////////////////////////////////////////////////////
+// Log format
+//////////////////////////////////////////////////////////
+    // Header: MAGIC, VERSION
+    // Record: tag, time since the previous record in µs, a, b, [text], [payload]
+    //   - integers are LEB128 varints, text & payload are a varint length followed by the bytes
+    //   - a & b are the request: address & size for reads/writes/frees, size & protection for allocs, begin & size for scans
+    //   - the payload is the response (read data, found address, process/module), or the written data for writes
+    //   - a payload equal to the previous one of the same request is left out, most reads return what they did last time
+    constexpr char    MAGIC[4] = { 'A', 'T', 'M', 'T' };
+    constexpr uint8_t VERSION  = 1;
+
+    enum class Operation : uint8_t
+    {
+        FIND_PROCESS, FIND_MODULE, SCAN, ALLOC, FREE, READ, WRITE
+    };
+
+    constexpr uint8_t TAG_OPERATION_MASK = 0x0F;
+    constexpr uint8_t TAG_SUCCEEDED      = 1 << 4;
+    constexpr uint8_t TAG_HAS_TEXT       = 1 << 5;
+    constexpr uint8_t TAG_HAS_PAYLOAD    = 1 << 6;
+    constexpr uint8_t TAG_SAME_PAYLOAD   = 1 << 7;
+
+    constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+
+    struct RequestKey
+    {
+        Operation   m_operation;
+        uint64_t    m_a;
+        uint64_t    m_b;
+        std::string m_text;
+
+        [[nodiscard]] bool operator==(const RequestKey&) const noexcept = default;
+    };
+
+    struct RequestKeyHash
+    {
+        [[nodiscard]] size_t operator()(const RequestKey& key) const noexcept
+        {
+            size_t hash = std::hash<uint64_t>{}(key.m_a);
+            hash ^= std::hash<uint64_t>{}(key.m_b) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+            hash ^= static_cast<size_t>(key.m_operation) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+            if (! key.m_text.empty())
+                hash ^= std::hash<std::string>{}(key.m_text) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+    };
+
+    void AppendVarint(std::vector<std::byte>& out, uint64_t value) noexcept
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<std::byte>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::byte>(value));
+    }
+
+    void AppendBytes(std::vector<std::byte>& out, std::span<const std::byte> bytes) noexcept
+    {
+        AppendVarint(out, bytes.size());
+        out.insert(out.end(), bytes.begin(), bytes.end());
+    }
+
+    void AppendString(std::vector<std::byte>& out, std::string_view text) noexcept
+    {
+        AppendBytes(out, std::as_bytes(std::span(text.data(), text.size())));
+    }
+
+    class Reader
+    {
+    public:
+        explicit Reader(std::span<const std::byte> data) noexcept : m_data(data) {}
+
+        [[nodiscard]] bool ReadVarint(uint64_t& out) noexcept
+        {
+            out = 0;
+            for (uint32_t shift = 0; shift < 64 && m_offset < m_data.size(); shift += 7)
+            {
+                const uint8_t byte = static_cast<uint8_t>(m_data[m_offset++]);
+                out |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) return true;
+            }
+            return false;
+        }
+
+        [[nodiscard]] bool ReadBytes(std::span<const std::byte>& out) noexcept
+        {
+            uint64_t size = 0;
+            if (! ReadVarint(size) || size > m_data.size() - m_offset) return false;
+            out = m_data.subspan(m_offset, size);
+            m_offset += size;
+            return true;
+        }
+
+        [[nodiscard]] bool ReadString(std::string& out) noexcept
+        {
+            std::span<const std::byte> bytes;
+            if (! ReadBytes(bytes)) return false;
+            out.assign(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+            return true;
+        }
+
+        [[nodiscard]] bool ReadByte(uint8_t& out) noexcept
+        {
+            if (m_offset >= m_data.size()) return false;
+            out = static_cast<uint8_t>(m_data[m_offset++]);
+            return true;
+        }
+
+        [[nodiscard]] bool IsAtEnd() const noexcept { return m_offset == m_data.size(); }
+        [[nodiscard]] size_t GetOffset() const noexcept { return m_offset; }
+
+    private:
+        std::span<const std::byte> m_data;
+        size_t m_offset = 0;
+    };
+
+    [[nodiscard]] int64_t GetTimeUs() noexcept
+    {
+        return CoreEngine::Timer::GetTimeSinceEpoch<CoreEngine::Units::MicroSecond>().Get();
+    }
+
+    template <size_t N>
+    void CopyToCString(char (&destination)[N], std::string_view source) noexcept
+    {
+        const size_t size = std::min(source.size(), N - 1);
+        std::memcpy(destination, source.data(), size);
+        destination[size] = '\0';
+    }
+
+//////////////////////////////////////////////////////////
+// Recording
+//////////////////////////////////////////////////////////
+    struct Recorder
+    {
+        std::ofstream          m_file;
+        std::vector<std::byte> m_buffer;
+        std::unordered_map<RequestKey, std::vector<std::byte>, RequestKeyHash> m_last_payloads;
+        int64_t                m_last_time_us = 0;
+        int64_t                m_started_at_us = 0;
+        uint64_t               m_amount_records = 0;
+        uint64_t               m_amount_bytes   = 0;
+    };
+
+    std::atomic<Mode>       g_mode = Mode::OFF;
+    std::mutex              g_recorder_mutex;
+    std::optional<Recorder> g_recorder = std::nullopt;
+
+    void FlushRecorder(Recorder& recorder) noexcept
+    {
+        recorder.m_file.write(reinterpret_cast<const char*>(recorder.m_buffer.data()), static_cast<std::streamsize>(recorder.m_buffer.size()));
+        recorder.m_amount_bytes += recorder.m_buffer.size();
+        recorder.m_buffer.clear();
+    }
+
+    void Record(Operation operation, uint64_t a, uint64_t b, std::string_view text, bool succeeded, std::optional<std::span<const std::byte>> payload) noexcept
+    {
+        std::scoped_lock lock(g_recorder_mutex);
+        if (! g_recorder) return;
+        Recorder& recorder = g_recorder.value();
+
+        // Taken under the lock, so the deltas never go negative
+        const int64_t time_us = GetTimeUs();
+        const int64_t delta_us = std::max<int64_t>(time_us - recorder.m_last_time_us, 0);
+        recorder.m_last_time_us = time_us;
+
+        uint8_t tag = static_cast<uint8_t>(operation);
+        if (succeeded)     tag |= TAG_SUCCEEDED;
+        if (! text.empty()) tag |= TAG_HAS_TEXT;
+
+        bool payload_is_same = false;
+        if (payload.has_value())
+        {
+            tag |= TAG_HAS_PAYLOAD;
+            std::vector<std::byte>& last_payload = recorder.m_last_payloads[RequestKey{ operation, a, b, std::string(text) }];
+            payload_is_same = last_payload.size() == payload->size() && std::equal(last_payload.begin(), last_payload.end(), payload->begin());
+            if (payload_is_same)
+                tag |= TAG_SAME_PAYLOAD;
+            else
+                last_payload.assign(payload->begin(), payload->end());
+        }
+
+        recorder.m_buffer.push_back(static_cast<std::byte>(tag));
+        AppendVarint(recorder.m_buffer, static_cast<uint64_t>(delta_us));
+        AppendVarint(recorder.m_buffer, a);
+        AppendVarint(recorder.m_buffer, b);
+        if (! text.empty()) AppendString(recorder.m_buffer, text);
+        if (payload.has_value() && ! payload_is_same) AppendBytes(recorder.m_buffer, payload.value());
+        recorder.m_amount_records++;
+
+        if (recorder.m_buffer.size() >= FLUSH_THRESHOLD)
+        {
+            FlushRecorder(recorder);
+        }
+    }
+
+    [[nodiscard]] std::vector<std::byte> EncodeAddress(libmem::Address address) noexcept
+    {
+        std::vector<std::byte> payload;
+        AppendVarint(payload, address);
+        return payload;
+    }
+
+//////////////////////////////////////////////////////////
+// Replaying
+//////////////////////////////////////////////////////////
+    struct Response
+    {
+        int64_t  m_time_us;        // Since the start of the recording
+        bool     m_succeeded;
+        uint64_t m_payload_offset; // Into ReplayLog::m_payloads
+        uint64_t m_payload_size;
+    };
+
+    struct ResponseStream
+    {
+        std::vector<Response>       m_responses;
+        mutable std::atomic<size_t> m_cursor = 0; // Unpaced replay only
+    };
+
+    struct ReplayLog
+    {
+        std::unordered_map<RequestKey, ResponseStream, RequestKeyHash> m_streams;
+        std::vector<std::byte> m_payloads;
+        ReplayConfig m_config;
+        int64_t      m_duration_us   = 0;
+        int64_t      m_started_at_us = 0;
+        uint64_t     m_amount_records = 0;
+        uint64_t     m_amount_bytes   = 0;
+        std::optional<GameState::GamePlatform> m_platform = std::nullopt;
+        std::string  m_exe_name_override; // Recorded against another target than the game, e.g. the stand-in
+    };
+
+    std::atomic<std::shared_ptr<const ReplayLog>> g_replay_log;
+    std::atomic<uint64_t> g_amount_served = 0;
+    std::atomic<uint64_t> g_amount_misses = 0;
+    std::atomic<bool>     g_replay_has_set_exe_name_override = false;
+
+    [[nodiscard]] std::shared_ptr<ReplayLog> ParseLog(std::span<const std::byte> data) noexcept
+    {
+        if (data.size() < sizeof(MAGIC) + 1 || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0)
+        {
+            ENGINE_DEBUG_PRINT("MemoryTrace: Not a memory trace.");
+            return nullptr;
+        }
+        if (static_cast<uint8_t>(data[sizeof(MAGIC)]) != VERSION)
+        {
+            ENGINE_DEBUG_PRINT("MemoryTrace: Unsupported version " << static_cast<int>(data[sizeof(MAGIC)]) << '.');
+            return nullptr;
+        }
+
+        std::shared_ptr<ReplayLog> log = std::make_shared<ReplayLog>();
+        log->m_amount_bytes = data.size();
+        log->m_payloads.reserve(data.size());
+
+        Reader reader (data.subspan(sizeof(MAGIC) + 1));
+        int64_t time_us = 0;
+        while (! reader.IsAtEnd())
+        {
+            uint8_t tag = 0;
+            uint64_t delta_us = 0;
+            RequestKey key {};
+            std::span<const std::byte> payload;
+
+            bool is_valid = reader.ReadByte(tag) && reader.ReadVarint(delta_us) && reader.ReadVarint(key.m_a) && reader.ReadVarint(key.m_b);
+            is_valid = is_valid && (! (tag & TAG_HAS_TEXT) || reader.ReadString(key.m_text));
+            is_valid = is_valid && (! (tag & TAG_HAS_PAYLOAD) || (tag & TAG_SAME_PAYLOAD) || reader.ReadBytes(payload));
+            is_valid = is_valid && (tag & TAG_OPERATION_MASK) <= static_cast<uint8_t>(Operation::WRITE);
+            if (! is_valid)
+            {
+                // A recording that was not stopped cleanly, keep what is complete
+                ENGINE_DEBUG_PRINT("MemoryTrace: Log is truncated at byte " << reader.GetOffset() << ", replaying the " << log->m_amount_records << " records before.");
+                break;
+            }
+
+            key.m_operation = static_cast<Operation>(tag & TAG_OPERATION_MASK);
+            time_us += static_cast<int64_t>(delta_us);
+
+            ResponseStream& stream = log->m_streams[key];
+            Response response { time_us, (tag & TAG_SUCCEEDED) != 0, 0, 0 };
+            if (tag & TAG_SAME_PAYLOAD)
+            {
+                if (stream.m_responses.empty())
+                {
+                    ENGINE_DEBUG_PRINT("MemoryTrace: Record " << log->m_amount_records << " repeats a payload that was never recorded.");
+                    return nullptr;
+                }
+                response.m_payload_offset = stream.m_responses.back().m_payload_offset;
+                response.m_payload_size   = stream.m_responses.back().m_payload_size;
+            }
+            else if (tag & TAG_HAS_PAYLOAD)
+            {
+                response.m_payload_offset = log->m_payloads.size();
+                response.m_payload_size   = payload.size();
+                log->m_payloads.insert(log->m_payloads.end(), payload.begin(), payload.end());
+            }
+            stream.m_responses.push_back(response);
+
+            if (key.m_operation == Operation::FIND_PROCESS && response.m_succeeded && ! log->m_platform.has_value())
+            {
+                if (key.m_text == GameState::ASPHALT_EXE_NAME_MS)
+                {
+                    log->m_platform = GameState::GamePlatform::MS;
+                }
+                else
+                {
+                    log->m_platform = GameState::GamePlatform::STEAM;
+                    if (key.m_text != GameState::ASPHALT_EXE_NAME_STEAM) log->m_exe_name_override = key.m_text;
+                }
+            }
+            log->m_amount_records++;
+        }
+
+        log->m_duration_us = time_us;
+        return log;
+    }
+
+    struct Served
+    {
+        std::shared_ptr<const ReplayLog> m_log; // Keeps the payload alive
+        const Response* m_response = nullptr;
+
+        [[nodiscard]] std::span<const std::byte> GetPayload() const noexcept
+        {
+            return std::span(m_log->m_payloads).subspan(m_response->m_payload_offset, m_response->m_payload_size);
+        }
+    };
+
+    [[nodiscard]] std::optional<Served> Serve(const RequestKey& key) noexcept
+    {
+        std::shared_ptr<const ReplayLog> log = g_replay_log.load(std::memory_order::acquire);
+        if (! log)
+        {
+            g_amount_misses.fetch_add(1, std::memory_order::relaxed);
+            return std::nullopt;
+        }
+
+        const auto it = log->m_streams.find(key);
+        if (it == log->m_streams.end() || it->second.m_responses.empty())
+        {
+            g_amount_misses.fetch_add(1, std::memory_order::relaxed);
+            return std::nullopt;
+        }
+
+        const std::vector<Response>& responses = it->second.m_responses;
+        const Response* response = nullptr;
+        if (log->m_config.m_time_dilation <= 0.0)
+        {
+            const size_t index = it->second.m_cursor.fetch_add(1, std::memory_order::relaxed);
+            response = &responses[log->m_config.m_loop ? index % responses.size() : std::min(index, responses.size() - 1)];
+        }
+        else
+        {
+            int64_t time_us = static_cast<int64_t>(static_cast<double>(GetTimeUs() - log->m_started_at_us) * log->m_config.m_time_dilation);
+            if (log->m_config.m_loop) time_us %= log->m_duration_us + 1;
+
+            const auto next = std::upper_bound(responses.begin(), responses.end(), time_us,
+                [](int64_t time, const Response& r) { return time < r.m_time_us; });
+            response = next == responses.begin() ? &responses.front() : &*(next - 1);
+        }
+
+        g_amount_served.fetch_add(1, std::memory_order::relaxed);
+        return Served{ std::move(log), response };
+    }
+
+    [[nodiscard]] std::optional<libmem::Address> ServeAddress(const RequestKey& key) noexcept
+    {
+        const std::optional<Served> served = Serve(key);
+        if (! served || ! served->m_response->m_succeeded) return std::nullopt;
+
+        Reader reader (served->GetPayload());
+        uint64_t address = 0;
+        if (! reader.ReadVarint(address)) return std::nullopt;
+        return static_cast<libmem::Address>(address);
+    }
+}
+
+//////////////////////////////////////////////////////////
+// Control
+//////////////////////////////////////////////////////////
+    bool StartRecording(const std::string& file_path) noexcept
+    {
+        Stop();
+        if (GameState::GetHasValidCurrentPlatform())
+        {
+            ENGINE_DEBUG_PRINT("MemoryTrace: Recording has to start before the game is attached.");
+            return false;
+        }
+
+        Recorder recorder;
+        recorder.m_file.open(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (! recorder.m_file.is_open())
+        {
+            ENGINE_DEBUG_PRINT("MemoryTrace: Failed to open " << file_path << " for recording.");
+            return false;
+        }
+
+        recorder.m_buffer.reserve(FLUSH_THRESHOLD * 2);
+        recorder.m_buffer.insert(recorder.m_buffer.end(), reinterpret_cast<const std::byte*>(MAGIC), reinterpret_cast<const std::byte*>(MAGIC) + sizeof(MAGIC));
+        recorder.m_buffer.push_back(static_cast<std::byte>(VERSION));
+        recorder.m_started_at_us = GetTimeUs();
+        recorder.m_last_time_us  = recorder.m_started_at_us;
+
+        {
+            std::scoped_lock lock(g_recorder_mutex);
+            g_recorder.emplace(std::move(recorder));
+        }
+        g_mode.store(Mode::RECORDING, std::memory_order::release);
+        return true;
+    }
+
+    bool StartReplay(const std::string& file_path, ReplayConfig config) noexcept
+    {
+        Stop();
+
+        std::ifstream file (file_path, std::ios::in | std::ios::binary | std::ios::ate);
+        if (! file.is_open())
+        {
+            ENGINE_DEBUG_PRINT("MemoryTrace: Failed to open " << file_path << " for replaying.");
+            return false;
+        }
+
+        std::vector<std::byte> data (static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        if (! file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())))
+        {
+            ENGINE_DEBUG_PRINT("MemoryTrace: Failed to read " << file_path << '.');
+            return false;
+        }
+
+        std::shared_ptr<ReplayLog> log = ParseLog(data);
+        if (! log) return false;
+        log->m_config = config;
+
+        // Everything cached so far belongs to the live process (if any)
+        GameState::OnInvalidateAllCaches();
+        g_amount_served.store(0, std::memory_order::relaxed);
+        g_amount_misses.store(0, std::memory_order::relaxed);
+
+        log->m_started_at_us = GetTimeUs();
+        const std::optional<GameState::GamePlatform> platform = log->m_platform;
+        std::string exe_name_override = log->m_exe_name_override;
+        g_replay_log.store(std::move(log), std::memory_order::release);
+        g_mode.store(Mode::REPLAYING, std::memory_order::release);
+
+        const bool sets_exe_name_override = ! exe_name_override.empty() && exe_name_override != GameState::GetExeNameOverride();
+        g_replay_has_set_exe_name_override.store(sets_exe_name_override);
+        if (sets_exe_name_override)
+        {
+            GameState::SetExeNameOverride(std::move(exe_name_override));
+        }
+        if (platform.has_value())
+        {
+            GameState::SetCurrentPlatform(platform.value());
+        }
+        return true;
+    }
+
+    void Stop() noexcept
+    {
+        const Mode mode = GetMode();
+
+        if (mode == Mode::RECORDING)
+        {
+            g_mode.store(Mode::OFF, std::memory_order::release);
+            std::scoped_lock lock(g_recorder_mutex);
+            if (g_recorder)
+            {
+                FlushRecorder(g_recorder.value());
+                g_recorder->m_file.close();
+                g_recorder.reset();
+            }
+        }
+        else if (mode == Mode::REPLAYING)
+        {
+            // Still replaying while invalidating, freeing the replayed allocations must not reach a live process
+            GameState::OnInvalidateAllCaches();
+            g_mode.store(Mode::OFF, std::memory_order::release);
+            g_replay_log.store(nullptr, std::memory_order::release);
+
+            if (g_replay_has_set_exe_name_override.exchange(false))
+            {
+                GameState::SetExeNameOverride({});
+            }
+        }
+    }
+
+    Mode GetMode() noexcept
+    {
+        return g_mode.load(std::memory_order::acquire);
+    }
+
+    Statistics GetStatistics() noexcept
+    {
+        Statistics statistics;
+        if (GetMode() == Mode::RECORDING)
+        {
+            std::scoped_lock lock(g_recorder_mutex);
+            if (g_recorder)
+            {
+                statistics.m_amount_records = g_recorder->m_amount_records;
+                statistics.m_amount_bytes   = g_recorder->m_amount_bytes + g_recorder->m_buffer.size();
+                statistics.m_duration       = CoreEngine::Units::Convert<CoreEngine::Units::Second>(CoreEngine::Units::MicroSecond(g_recorder->m_last_time_us - g_recorder->m_started_at_us));
+            }
+        }
+        else if (const std::shared_ptr<const ReplayLog> log = g_replay_log.load(std::memory_order::acquire))
+        {
+            statistics.m_amount_records = log->m_amount_records;
+            statistics.m_amount_bytes   = log->m_amount_bytes;
+            statistics.m_amount_served  = g_amount_served.load(std::memory_order::relaxed);
+            statistics.m_amount_misses  = g_amount_misses.load(std::memory_order::relaxed);
+            statistics.m_duration       = CoreEngine::Units::Convert<CoreEngine::Units::Second>(CoreEngine::Units::MicroSecond(log->m_duration_us));
+        }
+        return statistics;
+    }
+
+//////////////////////////////////////////////////////////
+// Record
+//////////////////////////////////////////////////////////
+    void RecordFindProcess(const char* name, const std::optional<libmem::Process>& result) noexcept
+    {
+        if (! result)
+        {
+            Record(Operation::FIND_PROCESS, 0, 0, name, false, std::nullopt);
+            return;
+        }
+
+        std::vector<std::byte> payload;
+        AppendVarint(payload, result->pid);
+        AppendVarint(payload, result->ppid);
+        AppendVarint(payload, static_cast<uint64_t>(result->arch));
+        AppendVarint(payload, result->bits);
+        AppendVarint(payload, result->start_time);
+        AppendString(payload, result->path);
+        AppendString(payload, result->name);
+        Record(Operation::FIND_PROCESS, 0, 0, name, true, payload);
+    }
+
+    void RecordFindModule(const char* name, const std::optional<libmem::Module>& result) noexcept
+    {
+        if (! result)
+        {
+            Record(Operation::FIND_MODULE, 0, 0, name, false, std::nullopt);
+            return;
+        }
+
+        std::vector<std::byte> payload;
+        AppendVarint(payload, result->base);
+        AppendVarint(payload, result->end);
+        AppendVarint(payload, result->size);
+        AppendString(payload, result->path);
+        AppendString(payload, result->name);
+        Record(Operation::FIND_MODULE, 0, 0, name, true, payload);
+    }
+
+    void RecordScan(const char* pattern, libmem::Address begin, size_t size, std::optional<libmem::Address> result) noexcept
+    {
+        if (! result)
+            Record(Operation::SCAN, begin, size, pattern, false, std::nullopt);
+        else
+            Record(Operation::SCAN, begin, size, pattern, true, EncodeAddress(result.value()));
+    }
+
+    void RecordAlloc(size_t size, libmem::Prot protection, std::optional<libmem::Address> result) noexcept
+    {
+        if (! result)
+            Record(Operation::ALLOC, size, static_cast<uint64_t>(protection), {}, false, std::nullopt);
+        else
+            Record(Operation::ALLOC, size, static_cast<uint64_t>(protection), {}, true, EncodeAddress(result.value()));
+    }
+
+    void RecordFree(libmem::Address address, size_t size, bool succeeded) noexcept
+    {
+        Record(Operation::FREE, address, size, {}, succeeded, std::nullopt);
+    }
+
+    void RecordRead(libmem::Address address, std::span<const std::byte> data, bool succeeded) noexcept
+    {
+        if (succeeded)
+            Record(Operation::READ, address, data.size(), {}, true, data);
+        else
+            Record(Operation::READ, address, data.size(), {}, false, std::nullopt);
+    }
+
+    void RecordWrite(libmem::Address address, std::span<const std::byte> data, bool succeeded) noexcept
+    {
+        Record(Operation::WRITE, address, data.size(), {}, succeeded, data);
+    }
+
+//////////////////////////////////////////////////////////
+// Replay
+//////////////////////////////////////////////////////////
+    std::optional<libmem::Process> ReplayFindProcess(const char* name) noexcept
+    {
+        const std::optional<Served> served = Serve(RequestKey{ Operation::FIND_PROCESS, 0, 0, name });
+        if (! served || ! served->m_response->m_succeeded) return std::nullopt;
+
+        Reader reader (served->GetPayload());
+        uint64_t pid = 0, ppid = 0, arch = 0, bits = 0, start_time = 0;
+        std::string path, process_name;
+        if (! (reader.ReadVarint(pid) && reader.ReadVarint(ppid) && reader.ReadVarint(arch) && reader.ReadVarint(bits)
+            && reader.ReadVarint(start_time) && reader.ReadString(path) && reader.ReadString(process_name)))
+            return std::nullopt;
+
+        // Paths are LM_PATH_MAX long, too large for the stack of the service threads
+        std::unique_ptr<lm_process_t> process = std::make_unique<lm_process_t>();
+        process->pid        = static_cast<lm_pid_t>(pid);
+        process->ppid       = static_cast<lm_pid_t>(ppid);
+        process->arch       = static_cast<lm_arch_t>(arch);
+        process->bits       = static_cast<lm_size_t>(bits);
+        process->start_time = static_cast<lm_time_t>(start_time);
+        CopyToCString(process->path, path);
+        CopyToCString(process->name, process_name);
+        return libmem::Process(process.get());
+    }
+
+    std::optional<libmem::Module> ReplayFindModule(const char* name) noexcept
+    {
+        const std::optional<Served> served = Serve(RequestKey{ Operation::FIND_MODULE, 0, 0, name });
+        if (! served || ! served->m_response->m_succeeded) return std::nullopt;
+
+        Reader reader (served->GetPayload());
+        uint64_t base = 0, end = 0, size = 0;
+        std::string path, module_name;
+        if (! (reader.ReadVarint(base) && reader.ReadVarint(end) && reader.ReadVarint(size) && reader.ReadString(path) && reader.ReadString(module_name)))
+            return std::nullopt;
+
+        std::unique_ptr<lm_module_t> module = std::make_unique<lm_module_t>();
+        module->base = static_cast<lm_address_t>(base);
+        module->end  = static_cast<lm_address_t>(end);
+        module->size = static_cast<lm_size_t>(size);
+        CopyToCString(module->path, path);
+        CopyToCString(module->name, module_name);
+        return libmem::Module(module.get());
+    }
+
+    std::optional<libmem::Address> ReplayScan(const char* pattern, libmem::Address begin, size_t size) noexcept
+    {
+        return ServeAddress(RequestKey{ Operation::SCAN, begin, size, pattern });
+    }
+
+    std::optional<libmem::Address> ReplayAlloc(size_t size, libmem::Prot protection) noexcept
+    {
+        return ServeAddress(RequestKey{ Operation::ALLOC, size, static_cast<uint64_t>(protection), {} });
+    }
+
+    bool ReplayFree(libmem::Address address, size_t size) noexcept
+    {
+        const std::optional<Served> served = Serve(RequestKey{ Operation::FREE, address, size, {} });
+        return served.has_value() && served->m_response->m_succeeded;
+    }
+
+    bool ReplayRead(libmem::Address address, std::span<std::byte> out) noexcept
+    {
+        const std::optional<Served> served = Serve(RequestKey{ Operation::READ, address, out.size(), {} });
+        if (! served || ! served->m_response->m_succeeded) return false;
+
+        const std::span<const std::byte> payload = served->GetPayload();
+        if (payload.size() != out.size()) return false;
+        std::memcpy(out.data(), payload.data(), payload.size());
+        return true;
+    }
+
+    bool ReplayWrite(libmem::Address address, size_t size) noexcept
+    {
+        std::shared_ptr<const ReplayLog> log = g_replay_log.load(std::memory_order::acquire);
+        if (log && ! log->m_streams.contains(RequestKey{ Operation::WRITE, address, size, {} }))
+        {
+            g_amount_served.fetch_add(1, std::memory_order::relaxed);
+            return true;
+        }
+
+        const std::optional<Served> served = Serve(RequestKey{ Operation::WRITE, address, size, {} });
+        return served.has_value() && served->m_response->m_succeeded;
+    }
+}
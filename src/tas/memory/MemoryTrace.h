@@ -0,0 +1,79 @@
+#pragma once
+
+#include "libmem/libmem.hpp"
+
+#include "core/utility/Units.h"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace AsphaltTas
+{
+    // Record & replay of everything MemoryUtility does to the game process.
+    // Recording passes every call through and appends it with its response to a compact binary log; replaying answers
+    // every call from such a log instead, so the services, camera tool and recorder run deterministically without the game.
+    //
+    // Replay matches calls by what they ask for (operation, address, size, pattern or name), not by their global order,
+    // so the service threads don't have to interleave like they did while recording.
+    namespace MemoryTrace
+    {
+        enum class Mode : uint8_t
+        {
+            OFF, RECORDING, REPLAYING
+        };
+
+        struct ReplayConfig
+        {
+            // 0  = unpaced: every call gets the next response recorded for the same request, as fast as it is asked.
+            //      The sequence each request sees is the recorded one, independent of timing.
+            // >0 = paced: every call gets the latest response recorded at or before (time since replay start * dilation),
+            //      1 = real time, 2 = twice as fast
+            double m_time_dilation = 0.0;
+            bool   m_loop          = true; // Start over once the log is exhausted, else keep answering with the last responses
+        };
+
+        struct Statistics
+        {
+            uint64_t m_amount_records = 0; // Written while recording, loaded while replaying
+            uint64_t m_amount_bytes   = 0; // Size of the log
+            uint64_t m_amount_served  = 0; // Replayed calls answered from the log
+            uint64_t m_amount_misses  = 0; // Replayed calls the log has no response for, they fail like the real call would
+            CoreEngine::Units::Second m_duration {0.0}; // Covered by the log
+        };
+
+        // Has to be started before the game is attached (no platform set), else the process lookup, pattern scans and
+        // allocations that resolve the addresses are cached already and missing from the log.
+        [[nodiscard]] bool StartRecording(const std::string& file_path) noexcept;
+        // Invalidates all game state caches and sets the platform the log was recorded on. A log recorded against another
+        // target (e.g. the stand-in) also sets that target as GameState exe name override until Stop().
+        [[nodiscard]] bool StartReplay(const std::string& file_path, ReplayConfig config = {}) noexcept;
+        // Flushes & closes a recording, or ends a replay and invalidates all game state caches again
+        void Stop() noexcept;
+
+        [[nodiscard]] Mode GetMode() noexcept;
+        [[nodiscard]] Statistics GetStatistics() noexcept;
+
+    //////////////////////////////////////////////////////////
+    // Backend, only called by MemoryUtility
+    //////////////////////////////////////////////////////////
+        void RecordFindProcess(const char* name, const std::optional<libmem::Process>& result) noexcept;
+        void RecordFindModule(const char* name, const std::optional<libmem::Module>& result) noexcept;
+        void RecordScan(const char* pattern, libmem::Address begin, size_t size, std::optional<libmem::Address> result) noexcept;
+        void RecordAlloc(size_t size, libmem::Prot protection, std::optional<libmem::Address> result) noexcept;
+        void RecordFree(libmem::Address address, size_t size, bool succeeded) noexcept;
+        void RecordRead(libmem::Address address, std::span<const std::byte> data, bool succeeded) noexcept;
+        void RecordWrite(libmem::Address address, std::span<const std::byte> data, bool succeeded) noexcept;
+
+        [[nodiscard]] std::optional<libmem::Process> ReplayFindProcess(const char* name) noexcept;
+        [[nodiscard]] std::optional<libmem::Module>  ReplayFindModule(const char* name) noexcept;
+        [[nodiscard]] std::optional<libmem::Address> ReplayScan(const char* pattern, libmem::Address begin, size_t size) noexcept;
+        [[nodiscard]] std::optional<libmem::Address> ReplayAlloc(size_t size, libmem::Prot protection) noexcept;
+        [[nodiscard]] bool ReplayFree(libmem::Address address, size_t size) noexcept;
+        [[nodiscard]] bool ReplayRead(libmem::Address address, std::span<std::byte> out) noexcept;
+        // The written data is not compared, only the recorded result is returned; writes the log hasn't seen succeed
+        [[nodiscard]] bool ReplayWrite(libmem::Address address, size_t size) noexcept;
+    }
+}
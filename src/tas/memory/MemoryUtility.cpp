@@ -1,4 +1,5 @@
 #include "tas/memory/MemoryUtility.h"
+#include "tas/memory/MemoryTrace.h"
 
 #ifdef _WIN32
     #define WIN32_LEAN_AND_MEAN
@@ -8,6 +9,7 @@
 
 #include <thread>
 #include <atomic>
+#include <chrono>
 
 namespace AsphaltTas::MemoryUtility
 {
@@ -19,6 +21,27 @@ namespace AsphaltTas::MemoryUtility
     static std::atomic<bool> g_HAS_CACHED_PROCESS = false;
     static std::atomic<bool> g_HAS_CACHED_MODULE  = false;
 
+    // Every call into the game goes through MemoryTrace: passed through & logged while recording, answered from the log while replaying
+    static std::optional<libmem::Process> FindProcessTraced(const char* name) noexcept
+    {
+        const MemoryTrace::Mode mode = MemoryTrace::GetMode();
+        if (mode == MemoryTrace::Mode::REPLAYING) return MemoryTrace::ReplayFindProcess(name);
+
+        std::optional<libmem::Process> process = libmem::FindProcess(name);
+        if (mode == MemoryTrace::Mode::RECORDING) MemoryTrace::RecordFindProcess(name, process);
+        return process;
+    }
+
+    static std::optional<libmem::Module> FindModuleTraced(const libmem::Process* process, const char* name) noexcept
+    {
+        const MemoryTrace::Mode mode = MemoryTrace::GetMode();
+        if (mode == MemoryTrace::Mode::REPLAYING) return MemoryTrace::ReplayFindModule(name);
+
+        std::optional<libmem::Module> module = libmem::FindModule(process, name);
+        if (mode == MemoryTrace::Mode::RECORDING) MemoryTrace::RecordFindModule(name, module);
+        return module;
+    }
+
     libmem::Process GetAsphaltProcessOrThrow()
     {
         if (! GameState::GetHasValidCurrentPlatform())
@@ -29,9 +52,9 @@ namespace AsphaltTas::MemoryUtility
             return g_GAME_PROCESS_OPT.value();
         }
 
-        const GameState::GamePlatform platform = GameState::GetCurrentPlatform();
+        const std::string exe_name = GameState::GetGameExeName(GameState::GetCurrentPlatform());
 
-        g_GAME_PROCESS_OPT = libmem::FindProcess(GameState::GetGameExeNameFromPlatform(platform));
+        g_GAME_PROCESS_OPT = FindProcessTraced(exe_name.c_str());
         if (! g_GAME_PROCESS_OPT.has_value()) 
             throw MemoryManipFailedException("MemoryUtility: Failed to open process.");
 
@@ -50,13 +73,13 @@ namespace AsphaltTas::MemoryUtility
             return { g_GAME_PROCESS_OPT.value(), g_GAME_MODULE_OPT.value() };
         }
 
-        GameState::GamePlatform platform = GameState::GetCurrentPlatform();
+        const std::string exe_name = GameState::GetGameExeName(GameState::GetCurrentPlatform());
 
-        g_GAME_PROCESS_OPT = libmem::FindProcess(GameState::GetGameExeNameFromPlatform(platform));
+        g_GAME_PROCESS_OPT = FindProcessTraced(exe_name.c_str());
         if (!g_GAME_PROCESS_OPT) throw MemoryManipFailedException("MemoryUtility: Failed to open process.");
         g_HAS_CACHED_PROCESS.store(true, std::memory_order::release);
 
-        g_GAME_MODULE_OPT = libmem::FindModule(&g_GAME_PROCESS_OPT.value(), GameState::GetGameExeNameFromPlatform(platform));
+        g_GAME_MODULE_OPT = FindModuleTraced(&g_GAME_PROCESS_OPT.value(), exe_name.c_str());
         if (!g_GAME_MODULE_OPT) throw MemoryManipFailedException("MemoryUtility: Failed to open process.");
         g_HAS_CACHED_MODULE.store(true, std::memory_order::release);
 
@@ -68,7 +91,17 @@ namespace AsphaltTas::MemoryUtility
 //////////////////////////////////////////////////////////
     libmem::Address AOBScanOrThrow(const libmem::Process* process, const char* pattern, libmem::Address begin, size_t size)
     {
-        std::optional<libmem::Address> opt_addr = libmem::SigScan(process, pattern, begin, size);
+        std::optional<libmem::Address> opt_addr;
+        const MemoryTrace::Mode mode = MemoryTrace::GetMode();
+        if (mode == MemoryTrace::Mode::REPLAYING)
+        {
+            opt_addr = MemoryTrace::ReplayScan(pattern, begin, size);
+        }
+        else
+        {
+            opt_addr = libmem::SigScan(process, pattern, begin, size);
+            if (mode == MemoryTrace::Mode::RECORDING) MemoryTrace::RecordScan(pattern, begin, size, opt_addr);
+        }
         if (! opt_addr) throw MemoryManipFailedException("MemoryUtility: Failed to find aob pattern.");
         return opt_addr.value();
     }
@@ -78,7 +111,17 @@ namespace AsphaltTas::MemoryUtility
 //////////////////////////////////////////////////////////
     libmem::Address AllocMemoryOrThrow(const libmem::Process* process, size_t size, libmem::Prot protection)
     {
-        std::optional<libmem::Address> opt_addr = libmem::AllocMemory(process, size, protection);
+        std::optional<libmem::Address> opt_addr;
+        const MemoryTrace::Mode mode = MemoryTrace::GetMode();
+        if (mode == MemoryTrace::Mode::REPLAYING)
+        {
+            opt_addr = MemoryTrace::ReplayAlloc(size, protection);
+        }
+        else
+        {
+            opt_addr = libmem::AllocMemory(process, size, protection);
+            if (mode == MemoryTrace::Mode::RECORDING) MemoryTrace::RecordAlloc(size, protection, opt_addr);
+        }
         if (!opt_addr) throw MemoryManipFailedException("MemoryUtility: Failed to allocate memory.");
         return opt_addr.value();
     }
@@ -94,7 +137,11 @@ namespace AsphaltTas::MemoryUtility
 
     bool TryFreeMemoryOrNothing(const libmem::Process* process, libmem::Address address, size_t size) noexcept
     {
+        const MemoryTrace::Mode mode = MemoryTrace::GetMode();
+        if (mode == MemoryTrace::Mode::REPLAYING) return MemoryTrace::ReplayFree(address, size);
+
         bool result = libmem::FreeMemory(process, address, size);
+        if (mode == MemoryTrace::Mode::RECORDING) MemoryTrace::RecordFree(address, size, result);
         if (! result) ENGINE_DEBUG_PRINT("Warning: Failed to free memory at address: " << address << " with size: " << size);
         return result;
     }
@@ -110,7 +157,12 @@ namespace AsphaltTas::MemoryUtility
 
     bool TryReadMemoryOrNothing(const libmem::Process* process, libmem::Address address, void* begin, size_t size) noexcept
     {
-        return libmem::ReadMemory(process, address, reinterpret_cast<uint8_t*>(begin), size) == size;
+        const MemoryTrace::Mode mode = MemoryTrace::GetMode();
+        if (mode == MemoryTrace::Mode::REPLAYING) return MemoryTrace::ReplayRead(address, std::span(reinterpret_cast<std::byte*>(begin), size));
+
+        const bool result = libmem::ReadMemory(process, address, reinterpret_cast<uint8_t*>(begin), size) == size;
+        if (mode == MemoryTrace::Mode::RECORDING) MemoryTrace::RecordRead(address, std::span(reinterpret_cast<const std::byte*>(begin), size), result);
+        return result;
     }
 
     void ReadFloatOrThrow(const libmem::Process* process, libmem::Address address, float& out)
@@ -123,13 +175,18 @@ namespace AsphaltTas::MemoryUtility
 //////////////////////////////////////////////////////////
     void WriteMemoryOrThrow(const libmem::Process* process,  libmem::Address address, void* begin, size_t size)
     {
-        if (libmem::WriteMemory(process, address, reinterpret_cast<uint8_t*>(begin), size) != size)
+        if (! TryWriteMemoryOrNothing(process, address, begin, size))
             throw MemoryManipFailedException("MemoryUtility: Failed to write memory.");
     }
 
     bool TryWriteMemoryOrNothing(const libmem::Process* process,  libmem::Address address, void* begin, size_t size) noexcept
     {
-        return libmem::WriteMemory(process, address, reinterpret_cast<uint8_t*>(begin), size) == size;
+        const MemoryTrace::Mode mode = MemoryTrace::GetMode();
+        if (mode == MemoryTrace::Mode::REPLAYING) return MemoryTrace::ReplayWrite(address, size);
+
+        const bool result = libmem::WriteMemory(process, address, reinterpret_cast<uint8_t*>(begin), size) == size;
+        if (mode == MemoryTrace::Mode::RECORDING) MemoryTrace::RecordWrite(address, std::span(reinterpret_cast<const std::byte*>(begin), size), result);
+        return result;
     }
 
     void WriteFloatOrThrow(const libmem::Process* process, libmem::Address address, float data)
@@ -268,6 +325,32 @@ namespace AsphaltTas::MemoryUtility
         }).detach();
     }
 
+#else
+//////////////////////////////////////////////////////////
+// Fallbacks, e.g. for the stand-in target (no windows, no process handles)
+//////////////////////////////////////////////////////////
+    bool ProcessIsInForeground(libmem::Pid) noexcept
+    {
+        return false;
+    }
+
+    HWND GetHWNDFromPID(libmem::Pid) noexcept
+    {
+        return nullptr;
+    }
+
+    void LaunchApplicationShutdownWatchdogThread(libmem::Pid pid, const std::function<void()>& callback) noexcept
+    {
+        std::optional<libmem::Process> process = libmem::GetProcess(pid);
+        if (! process) return;
+
+        std::thread([process = *process, callback]()
+        {
+            while (libmem::IsProcessAlive(&process))
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            callback();
+        }).detach();
+    }
 #endif
 
 //////////////////////////////////////////////////////////
@@ -9,10 +9,8 @@
 
 #include <functional>
 
-#ifdef _WIN32
-    struct HWND__;
-    using HWND = HWND__*;
-#endif
+struct HWND__;
+using HWND = HWND__*;
 
 namespace AsphaltTas
 {
@@ -90,23 +88,22 @@ namespace AsphaltTas
         };
 
         [[nodiscard]] std::optional<SuspendedProcess> SuspendProcess(libmem::Pid process_id) noexcept;
+#endif
 
     //////////////////////////////////////////////////////////
-    // Process visibility state (Windows API required)
+    // Process visibility state (always false off Windows, there is no window to compare against)
     //////////////////////////////////////////////////////////
         [[nodiscard]] bool ProcessIsInForeground(libmem::Pid process_id) noexcept;
 
     //////////////////////////////////////////////////////////
-    // Get HWND from pid (Windows API required)
+    // Get HWND from pid (nullptr off Windows)
     //////////////////////////////////////////////////////////    
         [[nodiscard]] HWND GetHWNDFromPID(libmem::Pid process_id) noexcept;
 
     //////////////////////////////////////////////////////////
-    // Call callback once external application closes (Windows API required)
+    // Call callback once external application closes (polls off Windows)
     //////////////////////////////////////////////////////////
         void LaunchApplicationShutdownWatchdogThread(libmem::Pid process_id, const std::function<void()>& callback) noexcept;
-;
-#endif
 
     //////////////////////////////////////////////////////////
     // Invalidate any cache
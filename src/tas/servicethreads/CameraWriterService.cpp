@@ -0,0 +1,224 @@
+#include "tas/servicethreads/CameraWriterService.h"
+
+#include "tas/servicethreads/ReadCurrentStateService.h"
+#include "tas/memory/MemoryRW.h"
+
+#include "core/utility/Timer.h"
+#include "core/utility/TripleBuffer.h"
+#include "core/utility/Performance.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <limits>
+
+namespace AsphaltTas::CameraWriterService
+{
+namespace
+{
+    std::atomic<bool>   g_thread_is_running  = false;
+    std::atomic<bool>   g_thread_has_exited  = true; // Detached like the other services, StopThread() waits on this instead
+    std::atomic<double> g_writes_per_second  = 240.0;
+    std::atomic<bool>   g_prediction_enabled = true;
+
+    CoreEngine::TripleBuffer<CameraTarget> g_camera_target_handoff;
+    std::atomic<bool> g_has_camera_target = false;
+
+    std::mutex      g_statistics_mutex;
+    WriteStatistics g_statistics;
+
+    constexpr double MIN_WRITES_PER_SECOND = 30.0;
+    constexpr double MAX_WRITES_PER_SECOND = 1000.0;
+
+    // Writes further away from a tick than this are not counted (game paused, loading, ...)
+    constexpr double MAX_COUNTED_PHASE_SECONDS = 2.0 / 60.0;
+
+    constexpr CoreEngine::Units::Second STATISTICS_WINDOW {0.5};
+
+    struct StatisticsAccumulator
+    {
+        std::uint64_t m_writes        = 0;
+        std::uint64_t m_phase_samples = 0;
+        double m_phase_sum = 0.0;
+        double m_phase_min = std::numeric_limits<double>::max();
+        double m_phase_max = 0.0;
+
+        void AddPhaseSample(double phase_seconds) noexcept
+        {
+            m_phase_sum += phase_seconds;
+            m_phase_min  = std::min(m_phase_min, phase_seconds);
+            m_phase_max  = std::max(m_phase_max, phase_seconds);
+            ++m_phase_samples;
+        }
+    };
+
+    void WaitUntil(CoreEngine::Units::Second deadline) noexcept
+    {
+        // Sleeping is too coarse for a few millisecond periods, so only the bulk is slept and the rest is yielded away
+        constexpr CoreEngine::Units::Second SPIN_THRESHOLD {0.002};
+
+        CoreEngine::Units::Second now = CoreEngine::Timer::GetTimeSinceEpoch<CoreEngine::Units::Second>();
+        while (now < deadline)
+        {
+            if (deadline - now > SPIN_THRESHOLD)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            else
+                std::this_thread::yield();
+
+            now = CoreEngine::Timer::GetTimeSinceEpoch<CoreEngine::Units::Second>();
+        }
+    }
+}
+    void LaunchThread() noexcept
+    {
+        if (GetThreadIsRunning()) return;
+
+        g_thread_has_exited.store(false, std::memory_order::release);
+        g_thread_is_running.store(true, std::memory_order::release);
+        std::thread([]()
+        {
+            using CoreEngine::Units::Second;
+
+            CoreEngine::ScopeProfiler::SetThreadName("CameraWriter");
+
+            CameraTarget target;
+            StatisticsAccumulator accumulator;
+            std::uint64_t failed_writes = 0;
+
+            CoreEngine::Timer statistics_timer;
+            Second next_deadline = CoreEngine::Timer::GetTimeSinceEpoch<Second>();
+
+            while (GetThreadIsRunning())
+            {
+                const Second period (1.0 / GetWriteRate());
+                next_deadline += period;
+
+                Second now = CoreEngine::Timer::GetTimeSinceEpoch<Second>();
+                if (now - next_deadline > period) // fell behind by more than a period -> resync instead of bursting
+                    next_deadline = now;
+
+                WaitUntil(next_deadline);
+                now = CoreEngine::Timer::GetTimeSinceEpoch<Second>();
+                ENGINE_PERFORMANCE_TRACE_COUNTER("CameraWriter: Wake Up Late µs", (now - next_deadline).Get() * 1e6);
+
+                if (! g_has_camera_target.load(std::memory_order::acquire))
+                    continue;
+
+                static_cast<void>(g_camera_target_handoff.ConsumeLatest(target));
+
+                CameraState out = target.m_camera_state;
+                std::optional<LatencyStamp> racer_stamp = target.m_racer_stamp;
+
+                if (target.m_camera_path)
+                {
+                    out = target.m_camera_path->Evaluate(now - target.m_playback_start_time);
+                }
+                else if (target.m_camera_track)
+                {
+                    out = target.m_camera_track->Evaluate(now - target.m_playback_start_time);
+                }
+                else if (target.m_is_relative_to_racer && GetPredictionEnabled())
+                {
+                    if (std::optional<ReadCurrentStateService::StampedRacerState> predicted = ReadCurrentStateService::GetInterpolatedStampedRacerState(now))
+                    {
+                        out.m_position += predicted->m_state.GetExtractedPosition() - target.m_racer_position_at_publish;
+                        racer_stamp     = predicted->m_stamp;
+                    }
+                }
+
+                try
+                {
+                    ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("CameraWriter: WriteCameraState()");
+                    MemoryRW::WriteCameraState(out, MemoryRW::IGNORE_FLAG_CAMERA::AspectRatio);
+                    ++accumulator.m_writes;
+
+                    if (racer_stamp.has_value())
+                        LatencyProbe::RecordWrite(racer_stamp.value(), CoreEngine::Timer::GetTimeSinceEpoch<Second>());
+
+                    if (std::optional<Second> last_tick = ReadCurrentStateService::GetLatestRacerTickTimestamp())
+                    {
+                        const double phase = (now - last_tick.value()).Get();
+                        if (phase >= 0.0 && phase < MAX_COUNTED_PHASE_SECONDS)
+                            accumulator.AddPhaseSample(phase);
+                    }
+                }
+                catch (...)
+                {
+                    ++failed_writes;
+                }
+
+                const Second window = statistics_timer.GetElapsed<Second>();
+                if (window > STATISTICS_WINDOW)
+                {
+                    statistics_timer.Restart();
+
+                    std::scoped_lock lock(g_statistics_mutex);
+                    g_statistics.m_writes_per_second = static_cast<double>(accumulator.m_writes) / window.Get();
+                    g_statistics.m_failed_writes     = failed_writes;
+                    if (accumulator.m_phase_samples > 0)
+                    {
+                        g_statistics.m_average_phase_ms = accumulator.m_phase_sum / static_cast<double>(accumulator.m_phase_samples) * 1000.0;
+                        g_statistics.m_min_phase_ms     = accumulator.m_phase_min * 1000.0;
+                        g_statistics.m_max_phase_ms     = accumulator.m_phase_max * 1000.0;
+                    }
+                    accumulator = StatisticsAccumulator{};
+                }
+            }
+
+            g_has_camera_target.store(false, std::memory_order::release);
+            {
+                std::scoped_lock lock(g_statistics_mutex);
+                g_statistics = WriteStatistics{};
+            }
+
+            g_thread_has_exited.store(true, std::memory_order::release);
+            g_thread_has_exited.notify_all();
+        }).detach();
+    }
+
+    void StopThread() noexcept
+    {
+        g_thread_is_running.store(false, std::memory_order::release);
+
+        // Waited for so callers can rely on no write happening anymore, e.g. before the original camera code is restored
+        g_thread_has_exited.wait(false, std::memory_order::acquire);
+    }
+
+    bool GetThreadIsRunning() noexcept
+    {
+        return g_thread_is_running.load(std::memory_order::acquire);
+    }
+
+    void PublishCameraTarget(const CameraTarget& target) noexcept
+    {
+        g_camera_target_handoff.Publish(target);
+        g_has_camera_target.store(true, std::memory_order::release);
+    }
+
+    void SetWriteRate(double writes_per_second) noexcept
+    {
+        g_writes_per_second.store(std::clamp(writes_per_second, MIN_WRITES_PER_SECOND, MAX_WRITES_PER_SECOND), std::memory_order::relaxed);
+    }
+
+    double GetWriteRate() noexcept
+    {
+        return g_writes_per_second.load(std::memory_order::relaxed);
+    }
+
+    void SetPredictionEnabled(bool enable) noexcept
+    {
+        g_prediction_enabled.store(enable, std::memory_order::relaxed);
+    }
+
+    bool GetPredictionEnabled() noexcept
+    {
+        return g_prediction_enabled.load(std::memory_order::relaxed);
+    }
+
+    WriteStatistics GetWriteStatistics() noexcept
+    {
+        std::scoped_lock lock(g_statistics_mutex);
+        return g_statistics;
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "tas/common/CameraState.h"
+#include "tas/common/CameraPath.h"
+#include "tas/common/CameraTrack.h"
+#include "tas/common/LatencyProbe.h"
+
+#include "core/utility/Units.h"
+
+#include "glm/glm.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace AsphaltTas
+{
+    namespace CameraWriterService
+    {
+        // Output of a camera controller, handed from the UI thread to the writer thread
+        struct CameraTarget
+        {
+            CameraState m_camera_state;
+
+            // If set, the camera is moved along with the predicted racer position between two publishes
+            bool      m_is_relative_to_racer = false;
+            glm::vec3 m_racer_position_at_publish {0};
+            // Of the racer sample the controller used, unset if the camera doesn't depend on the racer
+            std::optional<LatencyStamp> m_racer_stamp = std::nullopt;
+
+            // If set, the path or track is evaluated on the writer thread at every write instead of using m_camera_state
+            std::shared_ptr<const CameraPath>  m_camera_path  = nullptr;
+            std::shared_ptr<const CameraTrack> m_camera_track = nullptr;
+            CoreEngine::Units::Second          m_playback_start_time {0};
+        };
+
+        struct WriteStatistics
+        {
+            double m_writes_per_second  = 0.0;
+
+            // Time between the last observed game tick and the write; a stable value means the writes are in phase with the game
+            double m_average_phase_ms   = 0.0;
+            double m_min_phase_ms       = 0.0;
+            double m_max_phase_ms       = 0.0;
+
+            std::uint64_t m_failed_writes = 0;
+        };
+
+        void LaunchThread() noexcept;
+        // Blocks until the writer thread has exited, at most one write period
+        void StopThread() noexcept;
+        [[nodiscard]] bool GetThreadIsRunning() noexcept;
+
+        // Must only be called from one thread (the UI thread)
+        void PublishCameraTarget(const CameraTarget& target) noexcept;
+
+        void SetWriteRate(double writes_per_second) noexcept;
+        [[nodiscard]] double GetWriteRate() noexcept;
+
+        void SetPredictionEnabled(bool enable) noexcept;
+        [[nodiscard]] bool GetPredictionEnabled() noexcept;
+
+        [[nodiscard]] WriteStatistics GetWriteStatistics() noexcept;
+    }
+}
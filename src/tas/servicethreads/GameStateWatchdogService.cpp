@@ -6,6 +6,7 @@
 #include "libmem/libmem.hpp"
 
 #include <atomic>
+#include <string>
 #include <thread>
 
 namespace AsphaltTas::GameStateWatchdogService
@@ -35,8 +36,17 @@ namespace
             while (GetThreadIsRunning())
             {
                 std::optional<libmem::Process> opt_process;
+                const std::string exe_name_override = GameState::GetExeNameOverride();
 
-                if ( (opt_process = libmem::FindProcess(GameState::GetGameExeNameFromPlatform(GameState::GamePlatform::STEAM))) )
+                if (! exe_name_override.empty())
+                {
+                    // Stand-in or other target, the platform only has to be valid
+                    if ( (opt_process = libmem::FindProcess(exe_name_override.c_str())) )
+                    {
+                        GameState::SetCurrentPlatform(GameState::GamePlatform::STEAM);
+                    }
+                }
+                else if ( (opt_process = libmem::FindProcess(GameState::GetGameExeNameFromPlatform(GameState::GamePlatform::STEAM))) )
                 {
                     GameState::SetCurrentPlatform(GameState::GamePlatform::STEAM);
                 }
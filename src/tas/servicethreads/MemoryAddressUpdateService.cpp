@@ -4,6 +4,7 @@
 #include "tas/globalstate/MemoryAddressState.h"
 
 #include "core/utility/Assert.h"
+#include "core/utility/Performance.h"
 
 #include <thread>
 #include <atomic>
@@ -21,10 +22,12 @@ namespace
         g_thread_is_running.store(true);
         std::thread([]()
         {
+            CoreEngine::ScopeProfiler::SetThreadName("MemoryAddressUpdate");
             while (GetThreadIsRunning())
             {
                 try 
                 {
+                    ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("MemoryAddressUpdate: FindRacerStateBaseAddress()");
                     RacerStateAddresses::ManuallySetAddresses(MemoryAddressFinder::FindRacerStateBaseAddress());
                 } 
                 catch (...) 
@@ -33,6 +36,7 @@ namespace
                 }
                 try 
                 {
+                    ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("MemoryAddressUpdate: FindCameraStateAddresses()");
                     CameraStateAddresses::ManuallySetAddresses(MemoryAddressFinder::FindCameraStateAddresses());
                 } 
                 catch (...)
@@ -5,7 +5,9 @@
 #include "core/utility/Assert.h"
 
 #include "core/utility/Timer.h"
+#include "core/utility/Performance.h"
 
+#include <algorithm>
 #include <atomic>
 #include <thread>
 #include <mutex>
@@ -16,8 +18,8 @@ namespace
 {
     struct TimestampedRacerState 
     {
-        RacerState m_state;
-        CoreEngine::Units::Second m_timestamp;
+        RacerState   m_state;
+        LatencyStamp m_stamp;
     };
 
     std::atomic<bool> g_thread_is_running = false;
@@ -26,6 +28,17 @@ namespace
     std::optional<TimestampedRacerState> g_previous_racer_state = std::nullopt;
     std::optional<TimestampedRacerState> g_latest_racer_state   = std::nullopt;
     std::optional<CameraState> g_latest_camera_state            = std::nullopt;
+    uint64_t g_observed_ticks                                   = 0;
+
+    std::unique_ptr<Basic_MotionFilter> g_motion_filter = std::make_unique<None_MotionFilter>();
+    std::optional<MotionSample> g_filtered_sample       = std::nullopt;
+    bool g_sample_capture_is_running                    = false;
+    std::vector<MotionSample> g_captured_samples;
+    uint64_t g_dropped_captured_samples                 = 0;
+
+    constexpr float PHYSICS_STEP        = 1.0f / 60.0f;
+    constexpr float HALF_TICK           = PHYSICS_STEP * 0.5f;
+    constexpr float MAX_PREDICTION_TIME = PHYSICS_STEP * 2.0f;
 }
     void LaunchThread() noexcept
     {
@@ -34,29 +47,49 @@ namespace
         g_thread_is_running.store(true);
         std::thread([]()
         {
+            CoreEngine::ScopeProfiler::SetThreadName("ReadCurrentState");
             CoreEngine::Timer racer_sync_60_pf_timer;
             while (GetThreadIsRunning())
             {
                 //if (racer_sync_60_pf_timer.GetElapsed<CoreEngine::Units::MilliSecond>() > CoreEngine::Units::MilliSecond(16))
                 {
                     racer_sync_60_pf_timer.Restart();
+                    ENGINE_PERFORMANCE_MEASURE_SCOPE_TIME("ReadCurrentState: ReadRacerState()");
                     std::scoped_lock lock(g_racer_state_mutex);
                     try 
                     {
+                        // Counter first: a tick between the two reads then only makes the state newer than its stamp
+                        const std::optional<uint64_t> tick_counter = LatencyProbe::TryReadTickCounter();
+                        const CoreEngine::Units::Second acquired_at = CoreEngine::Timer::GetTimeSinceEpoch<CoreEngine::Units::Second>();
                         const RacerState new_state = MemoryRW::ReadRacerState();
 
-                        const bool changed = !g_latest_racer_state || !g_latest_racer_state->m_state.Equals(new_state);
+                        const bool changed = !g_latest_racer_state || (tick_counter.has_value()
+                            ? g_latest_racer_state->m_stamp.m_tick_index != tick_counter.value()
+                            : !g_latest_racer_state->m_state.Equals(new_state));
 
                         if (changed)
                         {
+                            const LatencyStamp stamp { acquired_at, CoreEngine::Timer::GetTimeSinceEpoch<CoreEngine::Units::Second>(), tick_counter.has_value() ? tick_counter.value() : ++g_observed_ticks };
                             g_previous_racer_state  = g_latest_racer_state;
-                            g_latest_racer_state    = { new_state, CoreEngine::Timer::GetTimeSinceEpoch<CoreEngine::Units::Second>() };
+                            g_latest_racer_state    = { new_state, stamp };
+
+                            const MotionSample raw_sample { new_state.GetExtractedPosition() - new_state.GetVelocity() * HALF_TICK, new_state.GetExtractedRotation(), stamp.m_tick_observed_at };
+                            if (g_sample_capture_is_running)
+                            {
+                                if (g_captured_samples.size() < MAX_CAPTURED_SAMPLES)
+                                    g_captured_samples.push_back(raw_sample);
+                                else
+                                    ++g_dropped_captured_samples;
+                            }
+                            g_filtered_sample = g_motion_filter->Filter(raw_sample);
                         }
     
                     } catch (...)
                     {
                         g_previous_racer_state = std::nullopt;
                         g_latest_racer_state = std::nullopt;
+                        g_filtered_sample = std::nullopt;
+                        g_motion_filter->Reset();
                     }
                 }
 
@@ -76,6 +109,8 @@ namespace
             std::scoped_lock lock (g_racer_state_mutex, g_camera_state_mutex);
             g_latest_racer_state  = std::nullopt;
             g_latest_camera_state = std::nullopt;
+            g_filtered_sample     = std::nullopt;
+            g_motion_filter->Reset();
         }).detach();
     }
 
@@ -90,6 +125,32 @@ namespace
     }
 
     std::optional<RacerState> GetInterpolatedRacerState() noexcept
+    {
+        std::scoped_lock lock(g_racer_state_mutex);
+        if (! g_latest_racer_state.has_value())
+            return std::nullopt;
+
+        RacerState copy = g_latest_racer_state.value().m_state;
+        if (g_filtered_sample.has_value())
+        {
+            // Without a filter this is the latest position moved back half a tick
+            copy.SetPosition(g_filtered_sample->m_position);
+            if (g_motion_filter->GetType() != Basic_MotionFilter::Type::NONE)
+                copy.SetRotation(g_filtered_sample->m_rotation);
+        }
+        return copy;
+    }
+
+    std::optional<RacerState> GetInterpolatedRacerState(CoreEngine::Units::Second predict_to_time) noexcept
+    {
+        std::optional<StampedRacerState> stamped = GetInterpolatedStampedRacerState(predict_to_time);
+        if (! stamped.has_value())
+            return std::nullopt;
+
+        return stamped->m_state;
+    }
+
+    std::optional<StampedRacerState> GetInterpolatedStampedRacerState(CoreEngine::Units::Second predict_to_time) noexcept
     {
         std::scoped_lock lock(g_racer_state_mutex);
         if (! g_latest_racer_state.has_value())
@@ -97,14 +158,25 @@ namespace
 
         const auto& state = g_latest_racer_state.value().m_state;
 
-        constexpr float PHYSICS_STEP = 1.0f / 60.0f;
-        constexpr float HALF_TICK    = PHYSICS_STEP * 0.5f;
+        // Clamped, as a paused game (or a stalled read) would otherwise let the car run off along its last velocity
+        const float lead_time = std::clamp(static_cast<float>((predict_to_time - g_latest_racer_state->m_stamp.m_tick_observed_at).Get()), 0.0f, MAX_PREDICTION_TIME);
+
+        const glm::vec3 base_pos = g_filtered_sample.has_value() ? g_filtered_sample->m_position : state.GetExtractedPosition() - state.GetVelocity() * HALF_TICK;
 
-        const glm::vec3 interpolated_pos = state.GetExtractedPosition() - state.GetVelocity() * HALF_TICK;
-        
         RacerState copy = state;
-        copy.SetPosition(interpolated_pos);
-        return copy;
+        copy.SetPosition(base_pos + state.GetVelocity() * lead_time);
+        if (g_filtered_sample.has_value() && g_motion_filter->GetType() != Basic_MotionFilter::Type::NONE)
+            copy.SetRotation(g_filtered_sample->m_rotation);
+        return StampedRacerState{ copy, g_latest_racer_state->m_stamp };
+    }
+
+    std::optional<CoreEngine::Units::Second> GetLatestRacerTickTimestamp() noexcept
+    {
+        std::scoped_lock lock(g_racer_state_mutex);
+        if (! g_latest_racer_state.has_value())
+            return std::nullopt;
+
+        return g_latest_racer_state->m_stamp.m_tick_observed_at;
     }
 
     std::optional<RacerState> GetCurrentRacerState() noexcept
@@ -121,4 +193,52 @@ namespace
         std::scoped_lock lock(g_camera_state_mutex);
         return g_latest_camera_state;
     }
+
+    void SetMotionFilter(std::unique_ptr<Basic_MotionFilter> filter) noexcept
+    {
+        ENGINE_ASSERT(filter && "At ReadCurrentStateService::SetMotionFilter(): Filter must not be null");
+
+        std::scoped_lock lock(g_racer_state_mutex);
+        g_motion_filter   = std::move(filter);
+        g_filtered_sample = std::nullopt;
+    }
+
+    std::unique_ptr<Basic_MotionFilter> GetMotionFilterCopy() noexcept
+    {
+        std::scoped_lock lock(g_racer_state_mutex);
+        return g_motion_filter->Copy();
+    }
+
+    void StartSampleCapture() noexcept
+    {
+        std::scoped_lock lock(g_racer_state_mutex);
+        g_captured_samples.clear();
+        g_captured_samples.reserve(MAX_CAPTURED_SAMPLES);
+        g_dropped_captured_samples  = 0;
+        g_sample_capture_is_running = true;
+    }
+
+    void StopSampleCapture() noexcept
+    {
+        std::scoped_lock lock(g_racer_state_mutex);
+        g_sample_capture_is_running = false;
+    }
+
+    bool GetSampleCaptureIsRunning() noexcept
+    {
+        std::scoped_lock lock(g_racer_state_mutex);
+        return g_sample_capture_is_running;
+    }
+
+    std::vector<MotionSample> GetCapturedSamples() noexcept
+    {
+        std::scoped_lock lock(g_racer_state_mutex);
+        return g_captured_samples;
+    }
+
+    uint64_t GetAmountDroppedCapturedSamples() noexcept
+    {
+        std::scoped_lock lock(g_racer_state_mutex);
+        return g_dropped_captured_samples;
+    }
 }
\ No newline at end of file
@@ -2,8 +2,16 @@
 
 #include "tas/common/RacerState.h"
 #include "tas/common/CameraState.h"
+#include "tas/common/MotionFilter.h"
+#include "tas/common/LatencyProbe.h"
 
+#include "core/utility/Units.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <optional>
+#include <vector>
 
 namespace AsphaltTas
 {
@@ -13,8 +21,32 @@ namespace AsphaltTas
         void StopThread() noexcept;
         [[nodiscard]] bool GetThreadIsRunning() noexcept;
 
+        struct StampedRacerState
+        {
+            RacerState   m_state;
+            LatencyStamp m_stamp; // Of the sample the state was interpolated from
+        };
+
         [[nodiscard]] std::optional<RacerState> GetInterpolatedRacerState() noexcept;
+        // Additionally extrapolates the position along the latest velocity up to the given time (Timer::GetTimeSinceEpoch)
+        [[nodiscard]] std::optional<RacerState> GetInterpolatedRacerState(CoreEngine::Units::Second predict_to_time) noexcept;
+        [[nodiscard]] std::optional<StampedRacerState> GetInterpolatedStampedRacerState(CoreEngine::Units::Second predict_to_time) noexcept;
+        // Time (Timer::GetTimeSinceEpoch) at which the latest change of the racer state (= game tick) was observed
+        [[nodiscard]] std::optional<CoreEngine::Units::Second> GetLatestRacerTickTimestamp() noexcept;
         [[nodiscard]] std::optional<RacerState> GetCurrentRacerState() noexcept;
         [[nodiscard]] std::optional<CameraState> GetCurrentCameraState() noexcept;
+
+        // Every new racer tick runs through the filter; the interpolated getters then return the filtered position & rotation
+        void SetMotionFilter(std::unique_ptr<Basic_MotionFilter> filter) noexcept;
+        [[nodiscard]] std::unique_ptr<Basic_MotionFilter> GetMotionFilterCopy() noexcept;
+
+        // Records the unfiltered samples fed to the filter, for offline tuning (MotionFilterHarness). The capacity is reserved
+        // on start, so ticks never reallocate under the state lock; ticks past it are dropped and counted
+        static constexpr size_t MAX_CAPTURED_SAMPLES = 60 * 60 * 30; // 30 minutes of 60 Hz ticks, ~4 MB
+        void StartSampleCapture() noexcept;
+        void StopSampleCapture() noexcept;
+        [[nodiscard]] bool GetSampleCaptureIsRunning() noexcept;
+        [[nodiscard]] std::vector<MotionSample> GetCapturedSamples() noexcept;
+        [[nodiscard]] uint64_t GetAmountDroppedCapturedSamples() noexcept; // Since the last StartSampleCapture()
     }
 }
\ No newline at end of file